@@ -0,0 +1,89 @@
+#if defined(HWGAUGE_USE_CLUSTER) && defined(HWGAUGE_USE_POSTGRESQL)
+
+#include "Aggregator.hpp"
+
+#include "spdlog/spdlog.h"
+#include "Collector/Common/Log.hpp"
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace hwgauge
+{
+    Aggregator::Aggregator(const ClusterConfig& cluster, const StreamConfig& stream,
+                           const DBConfig& db, const std::string& table_name_prefix)
+        : consumer(std::make_unique<RedisStreamConsumer>(cluster, stream)),
+          database(std::make_unique<BatchDatabase>(db, table_name_prefix))
+    {
+        spdlog::info("[Aggregator] Initialize successfully");
+    }
+
+    void Aggregator::run()
+    {
+        running.store(true, std::memory_order_release);
+
+        std::vector<StreamEntry> entries;
+        std::vector<const MetricBatch*> batches;
+        std::vector<size_t> batchEntries;   // batches[i] 对应 entries[batchEntries[i]]
+        std::vector<BatchFailure> failures;
+        while (running.load(std::memory_order_acquire))
+        {
+            flushLogStats();
+
+            // Redis 不可用，稍后重连
+            if (!consumer->read(entries))
+            {
+                std::this_thread::sleep_for(std::chrono::seconds(1));
+                continue;
+            }
+            if (entries.empty())continue;
+
+            // 被裁剪的空记录直接确认
+            batches.clear();
+            batchEntries.clear();
+            for (size_t i = 0; i < entries.size(); i++)
+            {
+                if (entries[i].batch.type.empty())continue;
+                batches.push_back(&entries[i].batch);
+                batchEntries.push_back(i);
+            }
+
+            // 连接断开等整体失败时不确认，下次从未确认的记录开始重新投递
+            failures.clear();
+            if (!database->write(batches, &failures))
+            {
+                consumer->rewind();
+                std::this_thread::sleep_for(std::chrono::seconds(1));
+                continue;
+            }
+
+            // 单批写入失败的记录转存到死信 Stream 后确认；转存失败的保留，下次重新投递
+            bool kept = false;
+            for (const auto& failure : failures)
+            {
+                StreamEntry& entry = entries[batchEntries[failure.index]];
+                if (!consumer->deadLetter(entry, failure.reason))
+                {
+                    entry.id.clear();
+                    kept = true;
+                }
+            }
+            if (kept)
+            {
+                entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                             [](const StreamEntry& entry) { return entry.id.empty(); }),
+                              entries.end());
+            }
+            if (!consumer->ack(entries) || kept)consumer->rewind();
+        }
+        spdlog::info("[Aggregator] Stopped");
+    }
+
+    void Aggregator::stop()
+    {
+        running.store(false, std::memory_order_release);
+    }
+}
+
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+
+#if defined(HWGAUGE_USE_CLUSTER) && defined(HWGAUGE_USE_POSTGRESQL)
+
+#include "Collector/Common/Config.hpp"
+#include "Forwarder/RedisStream.hpp"
+#include "Forwarder/BatchDatabase.hpp"
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+namespace hwgauge
+{
+    /**
+     * 聚合器模式：通过消费组读取各节点写入 Redis Stream 的数据，批量写入 PostgreSQL
+     * 成千上万个节点只需共享聚合器持有的少量数据库连接；多个聚合器可使用同一消费组水平扩展。
+     */
+    class Aggregator
+    {
+    public:
+        Aggregator(const ClusterConfig& cluster, const StreamConfig& stream,
+                   const DBConfig& db, const std::string& table_name_prefix);
+
+        void run();
+        void stop();
+
+    private:
+        std::atomic<bool> running = false;
+        std::unique_ptr<RedisStreamConsumer> consumer;
+        std::unique_ptr<BatchDatabase> database;
+    };
+}
+
+#endif
@@ -0,0 +1,272 @@
+#include "AlertAction.hpp"
+#include "Collector/Common/Exception.hpp"
+#include "Collector/Common/Log.hpp"
+
+#include "spdlog/spdlog.h"
+
+#include <chrono>
+#include <utility>
+
+#ifdef __linux__
+#include "Forwarder/RelayProtocol.hpp"
+
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char** environ;
+#endif
+
+namespace hwgauge
+{
+    namespace
+    {
+        const char* stateName(const AlertEvent& event) { return event.firing ? "firing" : "resolved"; }
+    }
+
+    FileAlertAction::FileAlertAction(const std::string& path_) : path(path_), out(path_, std::ios::app)
+    {
+        if (!out.is_open())throw FatalError("[AlertFile] Failed to open " + path);
+    }
+
+    void FileAlertAction::fire(const AlertEvent& event)
+    {
+        out << formatter.format(event.time) << ' ' << (event.firing ? "FIRING " : "RESOLVED ") << event.rule;
+        if (!event.device.empty())out << " device=" << event.device;
+        out << fmt::format(" value={} threshold={} node={} seq={} rule: ", event.value, event.threshold, event.node, event.seq)
+            << event.condition << '\n';
+        out.flush();
+        if (!out)
+        {
+            HWGAUGE_ERROR_LIMITED("[AlertFile] Failed to write {}", path);
+            out.clear();
+        }
+    }
+
+#ifdef __linux__
+    CommandAlertAction::CommandAlertAction(std::string command_) : command(std::move(command_)) {}
+
+    void CommandAlertAction::fire(const AlertEvent& event)
+    {
+        std::vector<std::string> vars = {
+            "HWGAUGE_ALERT_NAME=" + event.rule,
+            std::string("HWGAUGE_ALERT_STATE=") + stateName(event),
+            fmt::format("HWGAUGE_ALERT_VALUE={}", event.value),
+            fmt::format("HWGAUGE_ALERT_THRESHOLD={}", event.threshold),
+            "HWGAUGE_ALERT_RULE=" + event.condition,
+            "HWGAUGE_ALERT_NODE=" + event.node,
+            "HWGAUGE_ALERT_DEVICE=" + event.device,
+            "HWGAUGE_ALERT_SEQ=" + std::to_string(event.seq),
+            "HWGAUGE_ALERT_TIME=" + std::string(formatter.format(event.time)),
+        };
+        std::vector<char*> envp;
+        for (char** e = environ; *e; e++)envp.push_back(*e);
+        for (auto& v : vars)envp.push_back(v.data());
+        envp.push_back(nullptr);
+
+        // 采集进程屏蔽了 SIGINT / SIGTERM（由 signalfd 接收），子进程恢复默认的掩码与处理方式
+        posix_spawnattr_t attr;
+        posix_spawnattr_init(&attr);
+        sigset_t mask;
+        sigemptyset(&mask);
+        posix_spawnattr_setsigmask(&attr, &mask);
+        sigaddset(&mask, SIGINT);
+        sigaddset(&mask, SIGTERM);
+        sigaddset(&mask, SIGPIPE);
+        posix_spawnattr_setsigdefault(&attr, &mask);
+        posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+
+        char sh[] = "/bin/sh";
+        char dashC[] = "-c";
+        char* argv[] = { sh, dashC, command.data(), nullptr };
+        pid_t pid = 0;
+        int rc = posix_spawn(&pid, sh, nullptr, &attr, argv, envp.data());
+        posix_spawnattr_destroy(&attr);
+        if (rc != 0)
+        {
+            HWGAUGE_ERROR_LIMITED("[AlertCommand] Failed to run \"{}\": {}", command, std::strerror(rc));
+            return;
+        }
+        children.push_back(pid);
+        poll();
+    }
+
+    void CommandAlertAction::poll()
+    {
+        for (std::size_t i = 0; i < children.size();)
+        {
+            int status = 0;
+            pid_t rc = ::waitpid(children[i], &status, WNOHANG);
+            if (rc == 0) { i++; continue; }
+            if (rc > 0 && !(WIFEXITED(status) && WEXITSTATUS(status) == 0))
+            {
+                HWGAUGE_WARN_LIMITED("[AlertCommand] \"{}\" {} {}", command,
+                    WIFEXITED(status) ? "exited with status" : "killed by signal",
+                    WIFEXITED(status) ? WEXITSTATUS(status) : WTERMSIG(status));
+            }
+            children[i] = children.back();
+            children.pop_back();
+        }
+    }
+
+    WebhookAlertAction::WebhookAlertAction(const std::string& url)
+    {
+        std::string rest = url;
+        const std::string scheme = "http://";
+        if (rest.compare(0, scheme.size(), scheme) == 0)rest.erase(0, scheme.size());
+        else if (rest.find("://") != std::string::npos)
+            throw FatalError("[AlertWebhook] Only http:// is supported, got " + url);
+
+        auto slash = rest.find('/');
+        path = slash == std::string::npos ? "/" : rest.substr(slash);
+        std::string authority = rest.substr(0, slash);
+        if (authority.find(':') == std::string::npos)host = authority;
+        else if (!parseHostPort(authority, "127.0.0.1", host, port))
+            throw FatalError("[AlertWebhook] Invalid webhook address " + url);
+        if (host.empty())throw FatalError("[AlertWebhook] Invalid webhook address " + url);
+    }
+
+    void WebhookAlertAction::fire(const AlertEvent& event)
+    {
+        auto quote = [](const std::string& s) {
+            std::string out = "\"";
+            for (char c : s)
+            {
+                if (c == '"' || c == '\\')out += '\\';
+                if (static_cast<unsigned char>(c) >= 0x20)out += c;
+            }
+            return out + '"';
+        };
+        std::string body = fmt::format(
+            "{{\"alert\":{},\"state\":\"{}\",\"value\":{},\"threshold\":{},\"rule\":{},\"node\":{},\"device\":{},\"seq\":{},\"time\":\"{}\"}}",
+            quote(event.rule), stateName(event), event.value, event.threshold, quote(event.condition), quote(event.node),
+            quote(event.device), event.seq, formatter.format(event.time));
+        std::string request = fmt::format(
+            "POST {} HTTP/1.1\r\nHost: {}:{}\r\nContent-Type: application/json\r\nContent-Length: {}\r\nConnection: close\r\n\r\n{}",
+            path, host, port, body.size(), body);
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* res = nullptr;
+        const std::string service = std::to_string(port);
+        int rc = ::getaddrinfo(host.c_str(), service.c_str(), &hints, &res);
+        if (rc != 0)
+        {
+            HWGAUGE_WARN_LIMITED("[AlertWebhook] Failed to resolve {}: {}", host, gai_strerror(rc));
+            return;
+        }
+
+        int fd = -1;
+        for (addrinfo* ai = res; ai != nullptr; ai = ai->ai_next)
+        {
+            fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+            if (fd < 0)continue;
+            // 连接、发送与等待响应各 2 秒，接收端无响应时不会长期占住分发线程
+            timeval timeout = { 2, 0 };
+            ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+            ::setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+            if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0)break;
+            ::close(fd);
+            fd = -1;
+        }
+        ::freeaddrinfo(res);
+        if (fd < 0)
+        {
+            HWGAUGE_WARN_LIMITED("[AlertWebhook] Connection failed to {}:{}", host, port);
+            return;
+        }
+
+        std::size_t sent = 0;
+        while (sent < request.size())
+        {
+            ssize_t n = ::send(fd, request.data() + sent, request.size() - sent, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR)continue;
+            if (n <= 0)break;
+            sent += static_cast<std::size_t>(n);
+        }
+
+        // 只读取状态行 "HTTP/1.1 200 OK"
+        char status[64] = {};
+        std::size_t got = 0;
+        while (sent == request.size() && got < sizeof(status) - 1)
+        {
+            ssize_t n = ::recv(fd, status + got, sizeof(status) - 1 - got, 0);
+            if (n < 0 && errno == EINTR)continue;
+            if (n <= 0)break;
+            got += static_cast<std::size_t>(n);
+            if (std::memchr(status, '\n', got))break;
+        }
+        ::close(fd);
+
+        if (sent != request.size())
+        {
+            HWGAUGE_WARN_LIMITED("[AlertWebhook] Send failed to {}:{}: {}", host, port, std::strerror(errno));
+            return;
+        }
+        const char* space = std::strchr(status, ' ');
+        int code = space ? std::atoi(space + 1) : 0;
+        if (code < 200 || code >= 300)
+            HWGAUGE_WARN_LIMITED("[AlertWebhook] {}:{}{} answered \"{}\"", host, port, path,
+                std::string(status, std::strcspn(status, "\r\n")));
+    }
+#endif
+
+    AlertDispatcher::AlertDispatcher(std::vector<std::unique_ptr<AlertAction>> actions_)
+        : actions(std::move(actions_)), worker(&AlertDispatcher::run, this)
+    {
+    }
+
+    AlertDispatcher::~AlertDispatcher()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_one();
+        worker.join();
+    }
+
+    void AlertDispatcher::post(AlertEvent event)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (queue.size() >= kMaxQueued)
+            {
+                HWGAUGE_WARN_LIMITED("[AlertDispatcher] Queue full, dropped {} event of {}", stateName(queue.front()), queue.front().rule);
+                queue.pop_front();
+            }
+            queue.push_back(std::move(event));
+        }
+        wake.notify_one();
+    }
+
+    void AlertDispatcher::run()
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            // 空闲时每秒让动作回收子进程等
+            wake.wait_for(lock, std::chrono::seconds(1), [this] { return stopping || !queue.empty(); });
+            while (!queue.empty())
+            {
+                AlertEvent event = std::move(queue.front());
+                queue.pop_front();
+                lock.unlock();
+                for (auto& action : actions)action->fire(event);
+                lock.lock();
+            }
+            if (stopping)return;
+            lock.unlock();
+            for (auto& action : actions)action->poll();
+            lock.lock();
+        }
+    }
+}
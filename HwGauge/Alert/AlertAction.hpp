@@ -0,0 +1,116 @@
+#pragma once
+
+#include "Collector/Common/Time.hpp"
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/types.h>
+#endif
+
+namespace hwgauge
+{
+    /* 一次告警状态变化，只在触发 / 恢复时产生 */
+    struct AlertEvent
+    {
+        std::string rule;
+        std::string condition;
+        std::string node;
+        std::string device;            // 按设备求值的规则为设备标识，例如 gpu{index=0}，否则为空
+        bool firing = true;            // false 为恢复
+        double value = 0.0;
+        double threshold = 0.0;
+        std::uint64_t seq = 0;
+        TimePoint time;
+    };
+
+    /* 告警动作，在 AlertDispatcher 的后台线程中依次调用，可以阻塞 */
+    class AlertAction
+    {
+    public:
+        virtual ~AlertAction() = default;
+        virtual void fire(const AlertEvent& event) = 0;
+        // 后台线程空闲时定期调用（回收子进程等）
+        virtual void poll() {}
+    };
+
+    /* 追加写入告警日志，每个事件一行 */
+    class FileAlertAction : public AlertAction
+    {
+    public:
+        explicit FileAlertAction(const std::string& path);   // 无法打开时抛出 FatalError
+        void fire(const AlertEvent& event) override;
+
+    private:
+        std::string path;
+        std::ofstream out;
+        TimestampFormatter formatter;
+    };
+
+#ifdef __linux__
+    /* 通过 /bin/sh -c 执行命令，事件内容放在 HWGAUGE_ALERT_* 环境变量中；不等待命令结束 */
+    class CommandAlertAction : public AlertAction
+    {
+    public:
+        explicit CommandAlertAction(std::string command);
+        void fire(const AlertEvent& event) override;
+        void poll() override;
+
+    private:
+        std::string command;
+        std::vector<pid_t> children;     // 尚未回收的子进程，只回收自己启动的，不影响 popen 等
+        TimestampFormatter formatter{ TimestampFormatter::Utc };
+    };
+
+    /* 以 JSON POST 到 http://host[:port]/path，只支持明文 HTTP，面向本机或内网的接收端 */
+    class WebhookAlertAction : public AlertAction
+    {
+    public:
+        explicit WebhookAlertAction(const std::string& url);  // 地址无效时抛出 FatalError
+        void fire(const AlertEvent& event) override;
+
+    private:
+        std::string host;
+        int port = 80;
+        std::string path;
+        TimestampFormatter formatter{ TimestampFormatter::Utc };
+    };
+#endif
+
+    /**
+     * 告警分发：采集线程只把事件放入队列，后台线程依次交给各个动作
+     * 动作阻塞（命令、webhook 超时）不会拖慢采集；队列超过上限时丢弃最旧的事件
+     */
+    class AlertDispatcher
+    {
+    public:
+        explicit AlertDispatcher(std::vector<std::unique_ptr<AlertAction>> actions);
+        // 处理完队列中剩余的事件后退出
+        ~AlertDispatcher();
+
+        void post(AlertEvent event);
+
+        AlertDispatcher(const AlertDispatcher&) = delete;
+        AlertDispatcher& operator=(const AlertDispatcher&) = delete;
+
+    private:
+        void run();
+
+        static constexpr std::size_t kMaxQueued = 1024;
+
+        std::vector<std::unique_ptr<AlertAction>> actions;
+        std::mutex mutex;
+        std::condition_variable wake;
+        std::deque<AlertEvent> queue;
+        bool stopping = false;
+        std::thread worker;
+    };
+}
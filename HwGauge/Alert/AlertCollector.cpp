@@ -0,0 +1,75 @@
+#include "AlertCollector.hpp"
+#include "Collector/Common/Context.hpp"
+#include "Collector/Common/Exception.hpp"
+
+#include "spdlog/spdlog.h"
+
+namespace hwgauge
+{
+    AlertCollector::AlertCollector(const CollectorConfig& cfg) : node(cfg.nodeId)
+    {
+        const AlertConfig& config = cfg.alertConfig;
+        rules.reserve(config.rules.size());
+        for (const auto& spec : config.rules)
+        {
+            rules.emplace_back(spec);
+            for (std::size_t i = 0; i + 1 < rules.size(); i++)
+                if (rules[i].name() == rules.back().name())
+                    throw FatalError("[AlertCollector] Duplicate rule name \"" + rules.back().name() + "\"");
+        }
+        if (rules.empty())throw RecoverableError("[AlertCollector] No alert rules configured");
+
+        std::vector<std::unique_ptr<AlertAction>> actions;
+        if (!config.file.empty())actions.push_back(std::make_unique<FileAlertAction>(config.file));
+#ifdef __linux__
+        if (!config.command.empty())actions.push_back(std::make_unique<CommandAlertAction>(config.command));
+        if (!config.webhook.empty())actions.push_back(std::make_unique<WebhookAlertAction>(config.webhook));
+#endif
+        // 没有动作时只输出日志（与 Prometheus 状态）
+        if (!actions.empty())dispatcher = std::make_unique<AlertDispatcher>(std::move(actions));
+
+#ifdef HWGAUGE_USE_PROMETHEUS
+        if (cfg.pmEnable)
+        {
+            auto& family = prometheus::BuildGauge()
+                .Name("hwgauge_alert_firing")
+                .Help("1 while the --alert rule is firing on any device, 0 otherwise")
+                .Register(*cfg.registry);
+            for (const auto& rule : rules)
+            {
+                firing.push_back(&family.Add({ {"rule", rule.name()} }));
+                firing.back()->Set(0);
+            }
+        }
+#endif
+        spdlog::info("[AlertCollector] Loaded {} alert rules", rules.size());
+    }
+
+    void AlertCollector::publish(const Tick& tick)
+    {
+        if (!tick.context)return;
+
+        for (std::size_t i = 0; i < rules.size(); i++)
+        {
+            AlertRule& rule = rules[i];
+            const auto& changes = rule.evaluate(*tick.context, tick.time);
+            if (changes.empty())continue;
+
+            for (const auto& change : changes)
+            {
+                bool fired = change.transition == AlertRule::Transition::Fired;
+                std::string device(change.device);
+                std::string where = device.empty() ? std::string() : " on " + device;
+                if (fired)spdlog::warn("[Alert] {} firing{}: value {} ({})", rule.name(), where, change.value, rule.text());
+                else spdlog::info("[Alert] {} resolved{}: value {} ({})", rule.name(), where, change.value, rule.text());
+                if (dispatcher)
+                {
+                    dispatcher->post(AlertEvent{ rule.name(), rule.text(), node, std::move(device), fired, change.value, rule.threshold(), tick.seq, tick.time });
+                }
+            }
+#ifdef HWGAUGE_USE_PROMETHEUS
+            if (!firing.empty())firing[i]->Set(rule.firing() ? 1 : 0);
+#endif
+        }
+    }
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "Alert/AlertAction.hpp"
+#include "Alert/AlertRule.hpp"
+#include "Collector/Base/Collector.hpp"
+#include "Collector/Common/Config.hpp"
+
+#ifdef HWGAUGE_USE_PROMETHEUS
+#include <prometheus/gauge.h>
+#endif
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /**
+     * 本地阈值告警：每轮 publish 时对本轮各采集器的指标视图逐条计算规则，
+     * 只在触发 / 恢复时把事件交给后台线程执行动作（写文件、执行命令、webhook）。
+     * 读取 kMetricViews，Exposer 把它排在所有采集器（含派生指标）之后
+     */
+    class AlertCollector : public Collector
+    {
+    public:
+        // 规则语法错误、动作无法创建时抛出 FatalError
+        explicit AlertCollector(const CollectorConfig& cfg);
+
+        std::string name() override { return "alert"; }
+        unsigned contextConsumes() const override { return kMetricViews; }
+        void publish(const Tick& tick) override;
+
+    private:
+        std::vector<AlertRule> rules;
+        std::string node;
+#ifdef HWGAUGE_USE_PROMETHEUS
+        std::vector<prometheus::Gauge*> firing;     // 与 rules 一一对应，未启用 Prometheus 时为空
+#endif
+        // 最后析构：先处理完队列中的事件
+        std::unique_ptr<AlertDispatcher> dispatcher;
+    };
+}
@@ -0,0 +1,193 @@
+#include "AlertRule.hpp"
+#include "Collector/Common/Exception.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+namespace hwgauge
+{
+    namespace
+    {
+        std::string trim(const std::string& s)
+        {
+            auto begin = s.find_first_not_of(" \t");
+            if (begin == std::string::npos)return std::string();
+            return s.substr(begin, s.find_last_not_of(" \t") - begin + 1);
+        }
+
+        bool parseNumber(const std::string& token, double& value)
+        {
+            if (token.empty())return false;
+            char* end = nullptr;
+            value = std::strtod(token.c_str(), &end);
+            return end == token.c_str() + token.size() && std::isfinite(value);
+        }
+    }
+
+    AlertRule::Parsed AlertRule::parse(const std::string& spec)
+    {
+        Parsed p;
+        auto colon = spec.find(':');
+        if (colon == std::string::npos)
+            throw FatalError("[AlertRule] Expected \"name: expression op threshold\", got \"" + spec + "\"");
+
+        // 名称用作日志、通知与 Prometheus 标签，只允许字母、数字和下划线
+        p.name = trim(spec.substr(0, colon));
+        bool valid = !p.name.empty() && std::all_of(p.name.begin(), p.name.end(),
+            [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; });
+        if (!valid)
+            throw FatalError("[AlertRule] Invalid rule name \"" + p.name + "\" (letters, digits and _ only)");
+
+        p.condition = trim(spec.substr(colon + 1));
+        const std::string& rest = p.condition;
+        auto at = rest.find_first_of("<>=!");
+        if (at == std::string::npos)
+            throw FatalError("[AlertRule] " + p.name + ": expected a comparison (> >= < <= == !=) in \"" + rest + "\"");
+        p.expression = trim(rest.substr(0, at));
+
+        // 表达式语法中没有这些字符，第一个比较符之前都是表达式
+        char c = rest[at];
+        bool eq = at + 1 < rest.size() && rest[at + 1] == '=';
+        if (c == '>')p.op = eq ? Op::Ge : Op::Gt;
+        else if (c == '<')p.op = eq ? Op::Le : Op::Lt;
+        else if (c == '=' && eq)p.op = Op::Eq;
+        else if (c == '!' && eq)p.op = Op::Ne;
+        else throw FatalError("[AlertRule] " + p.name + ": invalid comparison at position " + std::to_string(at + 1) + " in \"" + rest + "\"");
+
+        std::istringstream tail(rest.substr(at + (eq ? 2 : 1)));
+        std::string token;
+        if (!(tail >> token) || !parseNumber(token, p.limit))
+            throw FatalError("[AlertRule] " + p.name + ": expected a numeric threshold in \"" + rest + "\"");
+        p.clearLimit = p.limit;
+
+        bool hasClear = false;
+        while (tail >> token)
+        {
+            std::string arg;
+            if (!(tail >> arg))throw FatalError("[AlertRule] " + p.name + ": missing value after '" + token + "'");
+            if (token == "for")
+            {
+                // "3" 为轮数，"30s" 为秒数
+                double n = 0.0;
+                bool seconds = arg.back() == 's';
+                if (!parseNumber(seconds ? arg.substr(0, arg.size() - 1) : arg, n) || n <= 0 || (!seconds && n != std::floor(n)))
+                    throw FatalError("[AlertRule] " + p.name + ": invalid duration '" + arg + "' (N ticks or Ns seconds)");
+                if (seconds)p.forTime = std::chrono::duration<double>(n);
+                else p.forTicks = static_cast<std::uint64_t>(n);
+            }
+            else if (token == "clear")
+            {
+                if (!parseNumber(arg, p.clearLimit))
+                    throw FatalError("[AlertRule] " + p.name + ": invalid clear threshold '" + arg + "'");
+                hasClear = true;
+            }
+            else throw FatalError("[AlertRule] " + p.name + ": unexpected '" + token + "' (expected for or clear)");
+        }
+
+        if (hasClear)
+        {
+            bool ok = ((p.op == Op::Gt || p.op == Op::Ge) && p.clearLimit <= p.limit)
+                || ((p.op == Op::Lt || p.op == Op::Le) && p.clearLimit >= p.limit);
+            if (!ok)throw FatalError("[AlertRule] " + p.name + ": clear threshold must lie on the non-firing side of the threshold (not allowed with == / !=)");
+        }
+        return p;
+    }
+
+    AlertRule::AlertRule(const std::string& spec) : AlertRule(parse(spec)) {}
+
+    AlertRule::AlertRule(Parsed p)
+        : ruleName(std::move(p.name)), condition(std::move(p.condition)), expression(std::move(p.expression), true),
+        op(p.op), limit(p.limit), clearLimit(p.clearLimit), forTicks(p.forTicks), forTime(p.forTime)
+    {
+    }
+
+    bool AlertRule::holds(double v) const
+    {
+        switch (op)
+        {
+        case Op::Gt: return v > limit;
+        case Op::Ge: return v >= limit;
+        case Op::Lt: return v < limit;
+        case Op::Le: return v <= limit;
+        case Op::Eq: return v == limit;
+        default: return v != limit;
+        }
+    }
+
+    bool AlertRule::cleared(double v) const
+    {
+        switch (op)
+        {
+        case Op::Gt: return v <= clearLimit;
+        case Op::Ge: return v < clearLimit;
+        case Op::Lt: return v >= clearLimit;
+        case Op::Le: return v > clearLimit;
+        default: return !holds(v);
+        }
+    }
+
+    bool AlertRule::firing() const
+    {
+        return std::any_of(states.begin(), states.end(), [](const DeviceState& s) { return s.current == State::Firing; });
+    }
+
+    const std::vector<AlertRule::Change>& AlertRule::evaluate(const TickContext& context, TimePoint time)
+    {
+        changes.clear();
+        if (expression.deviceSource().empty())
+        {
+            states.resize(1);
+            step(states[0], expression.evaluate(context), time, {});
+            return changes;
+        }
+
+        // 数据源本轮缺失时各设备保持当前状态（求值一次以提示缺失）
+        const MetricView* view = context.metrics(expression.deviceSource());
+        if (!view)
+        {
+            expression.evaluate(context);
+            return changes;
+        }
+        states.resize(view->count);
+        for (std::size_t i = 0; i < view->count; i++)
+        {
+            std::string_view device = view->devices ? std::string_view(view->devices[i]) : std::string_view();
+            step(states[i], expression.evaluate(context, i), time, device);
+        }
+        return changes;
+    }
+
+    void AlertRule::step(DeviceState& state, double v, TimePoint time, std::string_view device)
+    {
+        if (std::isnan(v))return;
+
+        if (state.current == State::Firing)
+        {
+            if (!cleared(v))return;
+            state.current = State::Inactive;
+            changes.push_back(Change{ Transition::Resolved, v, device });
+            return;
+        }
+
+        if (!holds(v))
+        {
+            state.current = State::Inactive;
+            return;
+        }
+        if (state.current == State::Inactive)
+        {
+            state.current = State::Pending;
+            state.pendingTicks = 0;
+            state.pendingSince = time;
+        }
+        state.pendingTicks++;
+
+        bool due = forTime.count() > 0 ? time - state.pendingSince >= forTime : state.pendingTicks >= forTicks;
+        if (!due)return;
+        state.current = State::Firing;
+        changes.push_back(Change{ Transition::Fired, v, device });
+    }
+}
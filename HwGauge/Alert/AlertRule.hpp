@@ -0,0 +1,93 @@
+#pragma once
+
+#include "Collector/Common/Context.hpp"
+#include "Collector/Common/Time.hpp"
+#include "Collector/DerivedCollector/Expression.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace hwgauge
+{
+    /**
+     * 阈值告警规则 "name: expression op threshold [for N|Ns] [clear value]"
+     *   expression 与 --derive 相同；op 为 > >= < <= == !=
+     *   不带函数的引用按设备分别求值，例如 gpu.temperature > 85 对每块 GPU 单独判断、单独触发与恢复；
+     *   带函数的引用（max(gpu.temperature)）与 --derive 相同，汇总为一个值
+     *   for   条件连续满足 N 轮（或 N 秒）后才触发，默认满足即触发
+     *   clear 回差：> / >= 规则回落到 clear 以下、< / <= 规则回升到 clear 以上才恢复，默认等于阈值
+     * 表达式本轮无法计算（数据源缺失、没有可用设备）时保持当前状态，不触发也不恢复
+     */
+    class AlertRule
+    {
+    public:
+        enum class State { Inactive, Pending, Firing };
+        enum class Transition { Fired, Resolved };
+
+        /* 一个设备的状态变化 */
+        struct Change
+        {
+            Transition transition;
+            double value;
+            std::string_view device;    // 设备标识，只在本轮有效；汇总规则或采集器没有设备标识时为空
+        };
+
+        // 语法错误抛出 FatalError
+        explicit AlertRule(const std::string& spec);
+
+        // 每轮调用一次，返回本轮各设备的状态变化；设备数不变时不分配内存
+        const std::vector<Change>& evaluate(const TickContext& context, TimePoint time);
+
+        const std::string& name() const { return ruleName; }
+        const std::string& text() const { return condition; }
+        double threshold() const { return limit; }
+        // 任一设备处于触发状态
+        bool firing() const;
+
+    private:
+        enum class Op { Gt, Ge, Lt, Le, Eq, Ne };
+
+        struct Parsed
+        {
+            std::string name;
+            std::string expression;
+            std::string condition;
+            Op op = Op::Gt;
+            double limit = 0.0;
+            double clearLimit = 0.0;
+            std::uint64_t forTicks = 1;
+            std::chrono::duration<double> forTime{ 0.0 };
+        };
+
+        static Parsed parse(const std::string& spec);
+        explicit AlertRule(Parsed parsed);
+
+        /* 单个设备（汇总规则只有一个）的状态 */
+        struct DeviceState
+        {
+            State current = State::Inactive;
+            std::uint64_t pendingTicks = 0;
+            TimePoint pendingSince;
+        };
+
+        bool holds(double v) const;      // 触发条件
+        bool cleared(double v) const;    // 恢复条件（含回差）
+        void step(DeviceState& state, double v, TimePoint time, std::string_view device);
+
+        std::string ruleName;
+        std::string condition;           // 冒号之后的规则原文，用于日志与通知
+        Expression expression;
+        Op op;
+        double limit;
+        double clearLimit;
+        std::uint64_t forTicks;          // forTime 为 0 时按轮数计
+        std::chrono::duration<double> forTime;
+
+        // 按设备下标对应；设备数变化时按下标保留，减少的设备直接丢弃
+        std::vector<DeviceState> states;
+        std::vector<Change> changes;
+    };
+}
@@ -1,10 +1,23 @@
 #pragma once
 
+#include "Collector/Common/Time.hpp"
+
 #include <string>
 #include <memory>
+#include <cstdint>
 
 namespace hwgauge
 {
+	class TickContext;
+
+	/* 一轮采集的时刻：seq 从 1 开始按调度槽位递增，跳过的轮次也占用序号，下游据此发现缺失 */
+	struct Tick
+	{
+		std::uint64_t seq = 0;
+		TimePoint time;       // 采样时刻，需要文本的下游自行格式化并缓存
+		TickContext* context = nullptr;   // 本轮共享上下文，回放等不汇总的场景为空
+	};
+
 	class Collector
     {
     public:
@@ -13,7 +26,22 @@ namespace hwgauge
         virtual ~Collector() = default;
         
         virtual std::string name() = 0;
-        virtual void collect(const std::string& cur_time) = 0;
+
+        // 第一阶段：读取硬件，只写入采集器自己的缓冲区；Exposer 让所有采集器在同一时刻并行执行
+        virtual void capture(const Tick&) {}
+        // 第二阶段：计算派生值、汇总共享上下文并写入下游，按 contextProvides / contextConsumes 排序后依次执行
+        virtual void publish(const Tick& tick) = 0;
+
+        // 向本轮上下文提供 / 从中读取的功率来源（powerBit 位掩码）
+        virtual unsigned contextProvides() const { return 0; }
+        virtual unsigned contextConsumes() const { return 0; }
+
+        // 单独使用时（回放、基准测试）依次执行两个阶段
+        void collect(const Tick& tick)
+        {
+            capture(tick);
+            publish(tick);
+        }
 
         Collector(const Collector&) = delete;
         Collector& operator=(const Collector&) = delete;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "Collector/Common/Exception.hpp"
+#include "Collector/Common/Log.hpp"
+#include "Collector/Common/Time.hpp"
 #include "spdlog/spdlog.h"
 
 #include <string>
@@ -63,13 +65,14 @@ namespace hwgauge
             else spdlog::debug("[CsvLogger] Appending to existing file.");
         }
 
-        void write(const std::string& timestamp, 
+        void write(TimePoint time, 
                 const std::vector<LabelT>& labels, 
                 const std::vector<MetricT>& metrics) 
         {
             std::lock_guard<std::mutex> lock(m_mutex);
             try
             {
+                std::string_view timestamp = m_timeFormatter.format(time);
                 for (size_t i = 0; i < labels.size(); ++i)
                 {
                     m_ofs << timestamp << ",";
@@ -79,10 +82,10 @@ namespace hwgauge
             } 
             catch (const std::exception& e)
             {
-                spdlog::error("[CsvLogger] Exception during write: {}", e.what());
+                HWGAUGE_ERROR_LIMITED("[CsvLogger] Exception during write: {}", e.what());
                 throw RecoverableError("Write operation failed");
             }
-            spdlog::info("[CsvLogger]  Successfully inserted {} records into {}",labels.size(),m_filepath);
+            HWGAUGE_LOG_COUNT("CSV records", labels.size());
         }
 
     protected:
@@ -92,5 +95,6 @@ namespace hwgauge
         std::string m_filepath;
         std::ofstream m_ofs;
         std::mutex m_mutex;
+        TimestampFormatter m_timeFormatter;     // 本地时间，与旧版本文件格式一致
     };
 }
\ No newline at end of file
@@ -4,18 +4,57 @@
 
 #include "Collector/Common/Config.hpp"
 #include "Collector/Common/Exception.hpp"
+#include "Collector/Common/Log.hpp"
+#include "Collector/Common/Time.hpp"
 #include "spdlog/spdlog.h"
+#include "spdlog/fmt/fmt.h"
 
 #include <libpq-fe.h>
+#include <cstdint>
 #include <vector>
 #include <chrono>
 #include <sstream>
 #include <iomanip>
 #include <string>
 #include <memory>
+#include <iterator>
 
 namespace hwgauge
 {
+    /* 按配置建立数据库连接，失败返回nullptr */
+    inline PGconn* connectDatabase(const DBConfig& config)
+    {
+        std::string conn_info = "host=" + config.host +
+                " port=" + config.port +
+                " dbname=" + config.dbname +
+                " user=" + config.user;
+        if (!config.password.empty())conn_info += " password=" + config.password;
+        conn_info += " connect_timeout=" + std::to_string(config.connect_timeout);
+
+        PGconn* conn = PQconnectdb(conn_info.c_str());
+        if (PQstatus(conn) != CONNECTION_OK)
+        {
+            spdlog::warn("[Database] Failed to connect to database: {}",std::string(PQerrorMessage(conn)));
+            PQfinish(conn);
+            return nullptr;
+        }
+        spdlog::info("[Database] Connected to database {}",config.dbname);
+        return conn;
+    }
+
+    /* 以二进制格式绑定的 TIMESTAMPTZ 参数：2000-01-01 UTC 起的微秒，大端 int64 */
+    struct PgTimestamp
+    {
+        explicit PgTimestamp(TimePoint time)
+        {
+            constexpr std::int64_t kPgEpochMicros = 946684800LL * 1000000;
+            auto value = static_cast<std::uint64_t>(toEpochMicros(time) - kPgEpochMicros);
+            for (int i = 7; i >= 0; i--, value >>= 8)bytes[i] = static_cast<char>(value & 0xFF);
+        }
+
+        char bytes[8];
+    };
+
     /* 数据库基类 （使用libpq C API）*/
     template<typename LabelType, typename MetricsType>
     class Database
@@ -23,16 +62,23 @@ namespace hwgauge
         public:
             /* 构造函数：建立连接 */
             explicit Database(const DBConfig& config_)
-                : conn(nullptr), config(config_)
+                : conn(nullptr), config(config_), ownsConn(true)
             {
                 // 建立连接
                 if (!connect())throw hwgauge::FatalError("[Database] Connecect Failed");
             }
+
+            /* 构造函数：复用外部连接，由调用方负责断开（聚合器多表共享同一连接） */
+            Database(PGconn* shared_conn, const DBConfig& config_)
+                : conn(shared_conn), config(config_), ownsConn(false)
+            {
+                if (!isConnected())throw hwgauge::FatalError("[Database] Shared connection is not available");
+            }
             
             /* 析构函数，断开连接 */
             virtual ~Database()
             {
-                disconnect();
+                if (ownsConn)disconnect();
             }
             
             /* 禁用拷贝 */
@@ -50,13 +96,13 @@ namespace hwgauge
                 if(conn != nullptr && PQstatus(conn) == CONNECTION_OK)return true;
                 else
                 {
-                    spdlog::warn("[Database] Database has not connected");
+                    HWGAUGE_WARN_LIMITED("[Database] Database has not connected");
                     return false;
                 }
             }
             
-            /* 写入指标数据 - 纯虚函数，子类必须实现 */
-            virtual void writeMetric(const std::string&cur_time,
+            /* 写入指标数据 - 纯虚函数，子类必须实现；seq 为采集轮次，0 表示未知（写为 NULL） */
+            virtual void writeMetric(TimePoint cur_time, std::uint64_t seq,
                                     const std::vector<LabelType>& label_list,
                                     const std::vector<MetricsType>& metric_list,
                                     bool useTransaction = true) = 0;
@@ -68,30 +114,18 @@ namespace hwgauge
         protected:
             PGconn* conn;               // PostgreSQL连接对象指针
             DBConfig config;    // 连接配置
+            bool ownsConn;      // 是否由本对象负责断开连接
             std::string metric_table_name;      // 指标数据表名
             std::string info_table_name;        // 静态数据表名
             std::string metric_insert_sql;      // 指标数据插入语句
             std::string info_insert_sql;        // 静态数据插入语句
+            TimestampFormatter copyTime{ TimestampFormatter::Utc };
             
             /* 连接到数据库 */
             bool connect()
             {
-                std::string conn_info = "host=" + config.host +
-                        " port=" + config.port +
-                        " dbname=" + config.dbname +
-                        " user=" + config.user;
-                if (!config.password.empty())conn_info += " password=" + config.password;
-                conn_info += " connect_timeout=" + std::to_string(config.connect_timeout);
-
-                conn = PQconnectdb(conn_info.c_str());
-                if (PQstatus(conn) != CONNECTION_OK)
-                {
-                    disconnect();
-                    spdlog::warn("[Database] Failed to connect to database: {}",std::string(PQerrorMessage(conn)));
-                    return false;
-                }
-                spdlog::info("[Database] Connected to database {}",config.dbname);
-                return true;
+                conn = connectDatabase(config);
+                return conn != nullptr;
             }
             /* 断开数据库连接 */
             void disconnect()
@@ -127,17 +161,130 @@ namespace hwgauge
                         0
                     );
                 }
-                // 判断执行结果
+                // 判断执行结果；按语句分别抑制（各表的语句固定），一张表持续失败不会掩盖其他表的错误
                 if (!res || PQresultStatus(res) != PGRES_COMMAND_OK)
                 {
                     PQclear(res);
-                    spdlog::warn("[Database] SQL execution failed: {}", std::string(PQerrorMessage(conn)));
+                    HWGAUGE_WARN_LIMITED_BY(sql, "[Database] SQL execution failed: {}", std::string(PQerrorMessage(conn)));
                     return false;
                 }
                 PQclear(res);
                 return true;
             }
             
+            /* 执行以时间戳开头的语句：$1 为二进制 TIMESTAMPTZ，params 依次为 $2 起的文本参数 */
+            bool execSQL(const std::string& sql, const PgTimestamp& time, const std::vector<const char*>& params)
+            {
+                std::vector<const char*> values;
+                values.reserve(params.size() + 1);
+                values.push_back(time.bytes);
+                values.insert(values.end(), params.begin(), params.end());
+                std::vector<int> lengths(values.size(), 0);
+                std::vector<int> formats(values.size(), 0);
+                lengths[0] = static_cast<int>(sizeof(time.bytes));
+                formats[0] = 1;
+
+                PGresult* res = PQexecParams(
+                    conn,
+                    sql.c_str(),
+                    static_cast<int>(values.size()),
+                    nullptr,
+                    values.data(),
+                    lengths.data(),
+                    formats.data(),
+                    0
+                );
+                if (!res || PQresultStatus(res) != PGRES_COMMAND_OK)
+                {
+                    PQclear(res);
+                    HWGAUGE_WARN_LIMITED_BY(sql, "[Database] SQL execution failed: {}", std::string(PQerrorMessage(conn)));
+                    return false;
+                }
+                PQclear(res);
+                return true;
+            }
+
+            /**
+             * 旧版本的 timestamp 列为不带时区的 TIMESTAMP（写入的是采集端本地时间），
+             * 转换为 TIMESTAMPTZ，已有数据按会话时区（PGTZ 或服务端 TimeZone）解释
+             */
+            bool upgradeTimestampColumn(const std::string& table)
+            {
+                const std::string sql =
+                    "DO $$ BEGIN "
+                    "IF EXISTS (SELECT 1 FROM information_schema.columns "
+                    "WHERE table_name = lower('" + table + "') AND column_name = 'timestamp' "
+                    "AND data_type = 'timestamp without time zone') THEN "
+                    "ALTER TABLE " + table + " ALTER COLUMN timestamp TYPE TIMESTAMPTZ; "
+                    "END IF; END $$;";
+                return execSQL(sql);
+            }
+
+            /* 旧版本的指标表没有 seq 列，补上（已有数据为 NULL） */
+            bool addSeqColumn(const std::string& table)
+            {
+                return execSQL("ALTER TABLE " + table + " ADD COLUMN IF NOT EXISTS seq BIGINT;");
+            }
+            // seq 0 表示未知，转换为 -1 以写为 NULL
+            static long long seqValue(std::uint64_t seq)
+            {
+                return seq == 0 ? -1 : static_cast<long long>(seq);
+            }
+
+            /* COPY ... FROM STDIN 批量写入（文本格式），rows 为制表符分隔、换行结尾的多行数据 */
+            bool copyIn(const std::string& copy_sql, const std::string& rows)
+            {
+                PGresult* res = PQexec(conn, copy_sql.c_str());
+                if (PQresultStatus(res) != PGRES_COPY_IN)
+                {
+                    PQclear(res);
+                    HWGAUGE_WARN_LIMITED_BY(copy_sql, "[Database] COPY start failed: {}", std::string(PQerrorMessage(conn)));
+                    return false;
+                }
+                PQclear(res);
+
+                if (PQputCopyData(conn, rows.data(), static_cast<int>(rows.size())) != 1)
+                    PQputCopyEnd(conn, "client write failed");
+                else
+                    PQputCopyEnd(conn, nullptr);
+
+                // 读取 COPY 的最终结果
+                bool ok = true;
+                while ((res = PQgetResult(conn)) != nullptr)
+                {
+                    if (PQresultStatus(res) != PGRES_COMMAND_OK)ok = false;
+                    PQclear(res);
+                }
+                if (!ok)HWGAUGE_WARN_LIMITED_BY(copy_sql, "[Database] COPY failed: {}", std::string(PQerrorMessage(conn)));
+                return ok;
+            }
+
+            /* COPY 文本格式字段，-1 写为 NULL (\N)，调用方负责分隔符 */
+            static void appendCopyField(std::string& row, double value)
+            {
+                if (value == -1.0)row += "\\N";
+                else fmt::format_to(std::back_inserter(row), "{}", value);
+            }
+            static void appendCopyField(std::string& row, long long value)
+            {
+                if (value == -1)row += "\\N";
+                else fmt::format_to(std::back_inserter(row), "{}", value);
+            }
+            // 时间戳写为带 +00 的 UTC 文本，同一秒内复用格式化结果
+            void appendCopyField(std::string& row, TimePoint value)
+            {
+                row += copyTime.format(value);
+            }
+            static void appendCopyField(std::string& row, const std::string& value)
+            {
+                if (value.empty()) { row += "\\N"; return; }
+                for (char c : value)
+                {
+                    if (c == '\\' || c == '\t' || c == '\n' || c == '\r')row.push_back('\\');
+                    row.push_back(c == '\t' ? 't' : c == '\n' ? 'n' : c == '\r' ? 'r' : c);
+                }
+            }
+
             /* 开始事务 */
             bool startTransaction()
             {
@@ -1,9 +1,16 @@
 #pragma once
 
 #include "Collector/Base/Collector.hpp"
+#include "Collector/Common/Config.hpp"
 #include "Collector/Common/Context.hpp"
 #include "Collector/Base/HttpApi.hpp"
+#include "Collector/Common/Codec.hpp"
+#include "Forwarder/BatchSink.hpp"
+#include "Jobs/JobTracker.hpp"
 #include <memory>
+#include <type_traits>
+#include <utility>
+#include <string>
 #include <vector>
 #include <iostream>
 
@@ -16,9 +23,57 @@ namespace hwgauge
     template<typename L, typename M>
     void printMetric(const L& label, const M& metric);
 
-    // 向外提供/获取全局信息，需要在外部重载
+    // 向本轮上下文提供/获取信息，需要在外部重载
     template<typename L, typename M>
-    void setContextInfo(std::vector<L>& label, std::vector<M>& metric);
+    void setContextInfo(std::vector<L>& label, std::vector<M>& metric, TickContext& context);
+
+    // setContextInfo 写入 / 读取的功率来源，决定 publish 的先后，默认不参与，需要时在外部特化
+    template<typename L, typename M>
+    struct ContextDeps
+    {
+        static constexpr unsigned provides = 0;
+        static constexpr unsigned consumes = 0;
+    };
+
+    // 向作业能耗统计提供每个设备的能耗/功耗/利用率，默认不参与，需要时在外部特化
+    template<typename L, typename M>
+    void jobSamples(const std::vector<L>&, const std::vector<M>&, std::vector<JobSample>&) {}
+
+    // 实现类提供 bool rawSamples(std::string& payload) 时，每轮额外发送 "<name>_samples" 批量数据
+    template<typename T, typename = void>
+    struct HasRawSamples : std::false_type {};
+
+    template<typename T>
+    struct HasRawSamples<T, std::void_t<decltype(std::declval<T&>().rawSamples(std::declval<std::string&>()))>> : std::true_type {};
+
+    // 实现类提供 void evaluate(const TickContext&, labels, metrics) 时，在第二阶段依据其他采集器本轮的指标计算（派生指标）
+    template<typename T, typename L, typename M, typename = void>
+    struct HasEvaluate : std::false_type {};
+
+    template<typename T, typename L, typename M>
+    struct HasEvaluate<T, L, M, std::void_t<decltype(std::declval<T&>().evaluate(std::declval<const TickContext&>(),
+        std::declval<std::vector<L>&>(), std::declval<std::vector<M>&>()))>> : std::true_type {};
+
+    // 设备标识：采集器名加上标签中排在最前的整数字段，例如 gpu{index=0}、npu{card_id=1,device_id=0}；没有整数字段时为空
+    template<typename L>
+    std::string deviceId(const std::string& source, const L& label)
+    {
+        std::string id;
+        bool done = false;
+        Fields<L>::visit(label, [&](const char* name, const auto& field, auto...) {
+            using F = std::decay_t<decltype(field)>;
+            if constexpr (std::is_integral_v<F> && !std::is_same_v<F, bool>)
+            {
+                if (done)return;
+                id += id.empty() ? "" : ",";
+                id += name;
+                id += '=';
+                id += std::to_string(field);
+            }
+            else done = true;
+        });
+        return id.empty() ? id : source + "{" + id + "}";
+    }
 
     /**
      * @tparam LabelT : 标签结构 (GPULabel)
@@ -41,11 +96,25 @@ namespace hwgauge
     {
     public:
         explicit DeviceCollector(const CollectorConfig& cfg)
-            : impl(std::make_unique<ImplT>()),
+            : DeviceCollector(cfg, makeImpl(cfg)) {}
+
+        // 使用已构造的实现类（回放等不从硬件采样的数据源）
+        // useContext 为 false 时不读写本轮上下文：回放的录制值（整机总功率等）原样输出，也不影响其他采集器
+        DeviceCollector(const CollectorConfig& cfg, std::unique_ptr<ImplT> impl_, bool useContext_ = true)
+            : impl(std::move(impl_)),
+              useContext(useContext_),
               outTer(cfg.outTer),
-              outFile(cfg.outFile)
+              outFile(cfg.outFile),
+              batchSinks(cfg.batchSinks),
+              rawSamples(cfg.rawSamples),
+              jobTracker(cfg.jobTracker)
         {
             label_list = labels();
+            batch.node = cfg.nodeId;
+            batch.type = impl->name();
+            for(const auto& label : label_list) device_ids.push_back(deviceId(batch.type, label));
+            rawBatch.node = cfg.nodeId;
+            rawBatch.type = impl->name() + "_samples";
 
             if(outFile)
             {
@@ -77,43 +146,101 @@ namespace hwgauge
         
         virtual ~DeviceCollector() = default;
 
-        void collect(const std::string& cur_time) override
+        void capture(const Tick&) override
         {
-            auto metric_list = sample(label_list);
+            // 指标缓冲区随采集器常驻，设备数不变时每轮不再分配
+            metric_list.resize(label_list.size());
+            sample(label_list, metric_list);
+        }
 
-            setContextInfo(label_list, metric_list);
+        void publish(const Tick& tick) override
+        {
+            if(useContext && tick.context)
+            {
+                if constexpr (HasEvaluate<ImplT, LabelT, MetricT>::value)
+                    impl->evaluate(*tick.context, label_list, metric_list);
+                setContextInfo(label_list, metric_list, *tick.context);
+                tick.context->addMetrics(batch.type, metric_list, &device_ids);
+            }
+
+            if(jobTracker)
+            {
+                jobBuffer.clear();
+                jobSamples(label_list, metric_list, jobBuffer);
+                jobTracker->record(jobBuffer);
+            }
 
             for(size_t i=0; i<label_list.size(); i++) 
             {
                 if(outTer)printMetric(label_list[i], metric_list[i]);
             }
 
-            if(outFile && cl) cl->write(cur_time, label_list, metric_list);
+            if(outFile && cl) cl->write(tick.time, label_list, metric_list);
+
+            // 编码一次，发送给所有批量下游
+            if(!batchSinks.empty())
+            {
+                batch.time = tick.time;
+                batch.seq = tick.seq;
+                encodePayload(batch.payload, label_list, metric_list);
+                for(auto& sink : batchSinks) sink->publish(batch);
+
+                if constexpr (HasRawSamples<ImplT>::value)
+                {
+                    rawBatch.time = tick.time;
+                    rawBatch.seq = tick.seq;
+                    if(rawSamples && impl->rawSamples(rawBatch.payload))
+                        for(auto& sink : batchSinks) sink->publish(rawBatch);
+                }
+            }
 
 #ifdef HWGAUGE_USE_PROMETHEUS
             if(pmEnable && pm) pm->write(label_list, metric_list);
 #endif
 #ifdef HWGAUGE_USE_POSTGRESQL
-            if(dbEnable && db) db->writeMetric(cur_time, label_list, metric_list);
+            if(dbEnable && db) db->writeMetric(tick.time, tick.seq, label_list, metric_list);
 #endif
 #ifdef HWGAUGE_USE_LOCAL_HTTP
             // 每次收集完，更新 HTTP 模块缓存的最新的数据
-            if(httpEnable && httpApi) httpApi->write(cur_time, label_list, metric_list);
+            if(httpEnable && httpApi) httpApi->write(tick.time, label_list, metric_list);
 #endif
         }
 
         std::string name() override { return impl->name(); }
+        unsigned contextProvides() const override { return ContextDeps<LabelT, MetricT>::provides | kMetricViews; }
+        unsigned contextConsumes() const override { return ContextDeps<LabelT, MetricT>::consumes; }
         std::vector<LabelT> labels() { return impl->labels(); }
-        std::vector<MetricT> sample(std::vector<LabelT>& labels) { return impl->sample(labels); }
+        // 实现类逐项覆盖写入 metrics（已按 labels 大小分配），不改变其大小
+        void sample(std::vector<LabelT>& labels, std::vector<MetricT>& metrics) { impl->sample(labels, metrics); }
 
     private:
+        // 需要配置（数据源根目录等）的实现提供 ImplT(const CollectorConfig&) 构造函数
+        static std::unique_ptr<ImplT> makeImpl(const CollectorConfig& cfg)
+        {
+            if constexpr (std::is_constructible_v<ImplT, const CollectorConfig&>)
+                return std::make_unique<ImplT>(cfg);
+            else
+                return std::make_unique<ImplT>();
+        }
+
         std::unique_ptr<ImplT> impl;
+        bool useContext;
         std::vector<LabelT> label_list;
+        std::vector<MetricT> metric_list;
+        std::vector<std::string> device_ids;    // 与 label_list 对应，供告警规则标识设备
 
         bool outTer;
 
         bool outFile;
         std::unique_ptr<CsvT> cl; 
+
+        std::vector<std::shared_ptr<BatchSink>> batchSinks;
+        MetricBatch batch;
+        bool rawSamples;
+        MetricBatch rawBatch;
+
+        std::shared_ptr<JobTracker> jobTracker;
+        std::vector<JobSample> jobBuffer;
 #ifdef HWGAUGE_USE_PROMETHEUS
         bool pmEnable;
         std::unique_ptr<PromT> pm;
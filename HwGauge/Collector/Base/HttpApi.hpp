@@ -10,6 +10,7 @@
 #include "spdlog/spdlog.h"
 #include "nlohmann/json.hpp"
 #include "httplib.h"
+#include "Collector/Common/Time.hpp"
 
 
 
@@ -64,7 +65,8 @@ namespace hwgauge {
                 nlohmann::json response;
                 {
                     std::lock_guard<std::mutex> lock(data_mutex_);
-                    response["timestamp"] = last_time_;
+                    // 只在有请求时格式化，尚未采集时为空
+                    response["timestamp"] = last_time_ == TimePoint{} ? std::string() : std::string(time_formatter_.format(last_time_));
                     response["data"] = nlohmann::json::array();
 
                     for (size_t i = 0; i < last_labels_.size(); ++i) {
@@ -80,7 +82,9 @@ namespace hwgauge {
             spdlog::info("Registered HTTP endpoint: {}", path_);
         }
 
-        void write(const std::string& cur_time, const std::vector<LabelT>& labels, const std::vector<MetricT>& metrics) {
+        void write(TimePoint cur_time, const std::vector<LabelT>& labels, const std::vector<MetricT>& metrics) {
+            // 请求在 HTTP 线程中处理，而采集器的缓冲区下一轮即被覆盖，这里保留一份快照（每轮拷贝一次）；
+            // 拷贝赋值复用已有容量，设备集合不变时不再分配
             std::lock_guard<std::mutex> lock(data_mutex_);
             last_time_ = cur_time;
             last_labels_ = labels;
@@ -92,7 +96,8 @@ namespace hwgauge {
         std::string path_;
         
         std::mutex data_mutex_;
-        std::string last_time_;
+        TimePoint last_time_;
+        TimestampFormatter time_formatter_;    // 受 data_mutex_ 保护
         std::vector<LabelT> last_labels_;
         std::vector<MetricT> last_metrics_;
     };
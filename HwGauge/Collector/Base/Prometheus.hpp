@@ -3,9 +3,12 @@
 #ifdef HWGAUGE_USE_PROMETHEUS
 
 #include "prometheus/gauge.h"
+#include "prometheus/counter.h"
 #include "prometheus/family.h"
 #include "prometheus/exposer.h"
+#include <map>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -26,6 +29,47 @@ namespace hwgauge
     protected:
         std::shared_ptr<prometheus::Registry> registry;
     };
+
+    /**
+     * 按设备缓存 Family::Add 返回的序列。
+     * prometheus-cpp 的 Add 每次调用都会构造新对象并复制标签，设备集合不变时每个序列只在第一次用到时 Add，之后每轮只 Set。
+     */
+    template<typename T>
+    class SeriesCache
+    {
+    public:
+        // 设备数变化时清空并返回 true，调用方随后填写各设备的 labels(i)
+        bool resize(std::size_t n)
+        {
+            if (rows.size() == n)return false;
+            labelSets.assign(n, {});
+            rows.assign(n, {});
+            return true;
+        }
+
+        std::map<std::string, std::string>& labels(std::size_t i) { return labelSets[i]; }
+
+        T& get(std::size_t i, prometheus::Family<T>* family)
+        {
+            auto& row = rows[i];
+            for (auto& [f, series] : row)
+                if (f == family)return *series;
+            T& series = family->Add(labelSets[i]);
+            row.emplace_back(family, &series);
+            return series;
+        }
+
+    private:
+        std::vector<std::map<std::string, std::string>> labelSets;
+        std::vector<std::vector<std::pair<prometheus::Family<T>*, T*>>> rows;
+    };
+
+    /* Counter 只能递增：把采集端给出的累计值同步为增量，-1（不可用）或回退时不更新 */
+    inline void setCounter(prometheus::Counter& counter, double total)
+    {
+        double delta = total - counter.Value();
+        if (total >= 0.0 && delta > 0.0)counter.Increment(delta);
+    }
 }
 
 #endif
\ No newline at end of file
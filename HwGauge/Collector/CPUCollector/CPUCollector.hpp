@@ -1,9 +1,14 @@
 #pragma once
 
-#ifdef HWGAUGE_USE_INTEL_PCM
+#if defined(HWGAUGE_USE_INTEL_PCM) || defined(__linux__)
 
 #include "Collector/Base/DeviceCollector.hpp"
+#ifdef HWGAUGE_USE_INTEL_PCM
 #include "PCM.hpp"
+#endif
+#ifdef __linux__
+#include "ProcCPU.hpp"
+#endif
 #include "CPUDatabase.hpp"
 #include "CPUCsvLogger.hpp"
 #include "CPUPrometheus.hpp"
@@ -30,9 +35,17 @@ namespace hwgauge
     using CPUHttpApiType = NullType;
 #endif
     // 定义别名
+#ifdef HWGAUGE_USE_INTEL_PCM
     using CPUCollector = DeviceCollector<
         CPULabel, CPUMetrics, PCM, CPUDatabaseType, CPUCsvLogger, CPUPrometheusType, CPUHttpApiType
     >;
+#endif
+#ifdef __linux__
+    // 不依赖 PCM 的数据源 (/proc/stat, cpufreq, powercap)，共用同一套输出
+    using ProcCPUCollector = DeviceCollector<
+        CPULabel, CPUMetrics, ProcCPU, CPUDatabaseType, CPUCsvLogger, CPUPrometheusType, CPUHttpApiType
+    >;
+#endif
     
     // 定义特定的打印函数
     template<>
@@ -51,17 +64,52 @@ namespace hwgauge
             << ", memoryReadBandwidth="  << m.memoryReadBandwidth
             << ", memoryWriteBandwidth="    << m.memoryWriteBandwidth
             << ", memoryPowerUsage=" << m.memoryPowerUsage
+            << ", ipc=" << m.ipc
+            << ", l3HitRatio=" << m.l3HitRatio
+            << ", l3Misses=" << m.l3Misses << "M/s"
+            << ", upiUtilization=" << m.upiUtilization
+            << ", ioBandwidth=" << m.ioBandwidth
+            << ", energy=" << m.energyJoules << "J"
+            << ", memoryEnergy=" << m.memoryEnergyJoules << "J"
             << " }\n";
     }
 
-    // 定义全局信息设置函数
+    // 定义上下文信息设置函数
     template<>
-    inline void setContextInfo(std::vector<CPULabel>& l, std::vector<CPUMetrics>& m)
+    inline void setContextInfo(std::vector<CPULabel>& l, std::vector<CPUMetrics>& m, TickContext& context)
     {
+        double cpuPower = 0.0, memoryPower = 0.0, cpuEnergy = 0.0, memoryEnergy = 0.0;
+        bool anyCpuPower = false, anyMemoryPower = false;
         for(size_t i=0; i<l.size(); i++) 
         {
-            sharedPower.cpu_power = sharedPower.cpu_power.value_or(0.0) + m[i].powerUsage;
-            sharedPower.memory_power = sharedPower.memory_power.value_or(0.0) + m[i].memoryPowerUsage;
+            // 没有对应 RAPL / powercap 域（AMD、鲲鹏常无 DRAM 域）或读取失败时为 -1，不计入合计
+            if (m[i].powerUsage >= 0) { cpuPower += m[i].powerUsage; anyCpuPower = true; }
+            if (m[i].memoryPowerUsage >= 0) { memoryPower += m[i].memoryPowerUsage; anyMemoryPower = true; }
+            if (m[i].energyJoules > 0)cpuEnergy += m[i].energyJoules;
+            if (m[i].memoryEnergyJoules > 0)memoryEnergy += m[i].memoryEnergyJoules;
+        }
+        if (l.empty())return;
+        if (anyCpuPower)context.addPower(PowerSource::Cpu, cpuPower);
+        if (anyMemoryPower)context.addPower(PowerSource::Memory, memoryPower);
+        context.setEnergy(PowerSource::Cpu, cpuEnergy);
+        context.setEnergy(PowerSource::Memory, memoryEnergy);
+    }
+
+    template<>
+    struct ContextDeps<CPULabel, CPUMetrics>
+    {
+        static constexpr unsigned provides = powerBit(PowerSource::Cpu) | powerBit(PowerSource::Memory);
+        static constexpr unsigned consumes = 0;
+    };
+
+    // 定义作业能耗统计数据：每个 socket 的 package 与内存分别统计
+    template<>
+    inline void jobSamples(const std::vector<CPULabel>& l, const std::vector<CPUMetrics>& m, std::vector<JobSample>& out)
+    {
+        for(size_t i=0; i<l.size(); i++)
+        {
+            out.push_back(JobSample{"cpu" + std::to_string(l[i].index), m[i].energyJoules, m[i].powerUsage, m[i].cpuUtilization});
+            out.push_back(JobSample{"memory" + std::to_string(l[i].index), m[i].memoryEnergyJoules, m[i].memoryPowerUsage, -1.0});
         }
     }
 }
@@ -0,0 +1,74 @@
+#pragma once
+
+#if defined(HWGAUGE_USE_INTEL_PCM) || defined(__linux__)
+
+#include "Collector/Base/DeviceCollector.hpp"
+#ifdef HWGAUGE_USE_INTEL_PCM
+#include "PCMCore.hpp"
+#endif
+#ifdef __linux__
+#include "ProcCPUCore.hpp"
+#endif
+#include "CPUCoreDatabase.hpp"
+#include "CPUCoreCsvLogger.hpp"
+#include "CPUCorePrometheus.hpp"
+
+#include <iostream>
+
+namespace hwgauge
+{
+#ifdef HWGAUGE_USE_POSTGRESQL
+    using CPUCoreDatabaseType = CPUCoreDatabase;
+#else
+    using CPUCoreDatabaseType = NullType;
+#endif
+
+#ifdef HWGAUGE_USE_PROMETHEUS
+    using CPUCorePrometheusType = CPUCorePrometheus;
+#else
+    using CPUCorePrometheusType = NullType;
+#endif
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+    using CPUCoreHttpApiType = HttpApi<CPUCoreLabel, CPUCoreMetrics>;
+#else
+    using CPUCoreHttpApiType = NullType;
+#endif
+    // 定义别名
+#ifdef HWGAUGE_USE_INTEL_PCM
+    using CPUCoreCollector = DeviceCollector<
+        CPUCoreLabel, CPUCoreMetrics, PCMCore, CPUCoreDatabaseType, CPUCoreCsvLogger, CPUCorePrometheusType, CPUCoreHttpApiType
+    >;
+#endif
+#ifdef __linux__
+    using ProcCPUCoreCollector = DeviceCollector<
+        CPUCoreLabel, CPUCoreMetrics, ProcCPUCore, CPUCoreDatabaseType, CPUCoreCsvLogger, CPUCorePrometheusType, CPUCoreHttpApiType
+    >;
+#endif
+    
+    // 定义特定的打印函数
+    template<>
+    inline void printMetric(const CPUCoreLabel& l, const CPUCoreMetrics& m)
+    {
+        std::cout
+            << "Core{ "
+            << "index="     << l.index
+            << ", socket=" << l.socket
+            << ", utilization=" << m.utilization
+            << ", frequency=" << m.frequency
+            << ", ipc=" << m.ipc
+            << ", l2HitRatio=" << m.l2HitRatio
+            << ", l3HitRatio=" << m.l3HitRatio
+            << ", c0Residency=" << m.c0Residency
+            << ", c1Residency=" << m.c1Residency
+            << ", c6Residency=" << m.c6Residency
+            << " }\n";
+    }
+
+    // 逐核数据不参与全局功耗统计
+    template<>
+    inline void setContextInfo(std::vector<CPUCoreLabel>&, std::vector<CPUCoreMetrics>&, TickContext&)
+    {}
+}
+
+#endif
@@ -0,0 +1,47 @@
+#if defined(HWGAUGE_USE_INTEL_PCM) || defined(__linux__)
+
+#include "CPUCoreCsvLogger.hpp"
+#include <sstream>
+#include <iomanip>
+
+namespace hwgauge
+{
+    CPUCoreCsvLogger::CPUCoreCsvLogger(const std::string& filepath) : CsvLogger(filepath) 
+    {
+        auto pos = m_filepath.rfind(".csv");
+        if (pos != std::string::npos) {
+            m_filepath.insert(pos, "_cpu_core");
+        }
+
+        m_ofs.open(m_filepath, std::ios::out | std::ios::app);
+        
+        if (!m_ofs.is_open()) {
+            spdlog::error("[CPUCoreCsvLogger] Failed to open file: {}", m_filepath);
+            throw FatalError("CPUCoreCsvLogger open failed: " + m_filepath);
+        }
+        spdlog::info("[CPUCoreCsvLogger] Initialized logger for: {}", m_filepath);
+    }
+
+    std::string CPUCoreCsvLogger::getHeader() const {
+        return "Core,Socket,Util(%),Freq(MHz),IPC,L2Hit,L3Hit,C0(%),C1(%),C6(%)";
+    }
+
+    std::string CPUCoreCsvLogger::formatRow(const CPUCoreLabel& l, const CPUCoreMetrics& m) const {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(2); // 统一设置浮点精度
+
+        ss << l.index << ","
+           << l.socket << ","
+           << m.utilization << ","
+           << m.frequency << ","
+           << m.ipc << ","
+           << m.l2HitRatio << ","
+           << m.l3HitRatio << ","
+           << m.c0Residency << ","
+           << m.c1Residency << ","
+           << m.c6Residency;
+        
+        return ss.str();
+    }
+}
+#endif
@@ -0,0 +1,20 @@
+#pragma once
+#if defined(HWGAUGE_USE_INTEL_PCM) || defined(__linux__)
+
+#include "Collector/Base/CsvLogger.hpp"
+#include "CPUCoreMetrics.hpp"
+
+namespace hwgauge
+{
+    class CPUCoreCsvLogger : public CsvLogger<CPUCoreLabel, CPUCoreMetrics>
+    {
+    public:
+        explicit CPUCoreCsvLogger(const std::string& filepath);
+
+    protected:
+        std::string getHeader() const override;
+        std::string formatRow(const CPUCoreLabel& l, const CPUCoreMetrics& m) const override;
+    };
+}
+
+#endif
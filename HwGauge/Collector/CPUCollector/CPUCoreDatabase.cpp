@@ -0,0 +1,160 @@
+#ifdef HWGAUGE_USE_POSTGRESQL
+
+#include "CPUCoreDatabase.hpp"
+
+#include "spdlog/spdlog.h"
+
+namespace hwgauge
+{
+    CPUCoreDatabase::CPUCoreDatabase(const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<CPUCoreLabel, CPUCoreMetrics>(config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    CPUCoreDatabase::CPUCoreDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<CPUCoreLabel, CPUCoreMetrics>(shared_conn, config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    void CPUCoreDatabase::setup(const std::string& table_name_prefix)
+    {
+        // 设置表名
+        metric_table_name = table_name_prefix + "_cpu_core_metric";
+        info_table_name = table_name_prefix + "_cpu_core_info";
+        // 创建表
+        if (!createMetricTable() || !createInfoTable())throw hwgauge::FatalError("[Database] Create Table Failed");
+        // 构建SQL模板
+        metric_copy_sql =
+            "COPY " + metric_table_name +
+            " (timestamp, core_index, utilization, frequency, ipc, "
+            "l2_hit_ratio, l3_hit_ratio, c0_residency, c1_residency, c6_residency, seq) "
+            "FROM STDIN;";
+
+        info_insert_sql =
+            "INSERT INTO " + info_table_name +
+            " (core_index, socket_index) "
+            "VALUES ($1, $2) "
+            "ON CONFLICT (core_index) DO UPDATE SET "
+            "socket_index = EXCLUDED.socket_index;";
+
+        spdlog::info("[CPUCoreDatabase] Initialize successfully");
+    }
+
+    CPUCoreDatabase::~CPUCoreDatabase(){}
+
+    bool CPUCoreDatabase::createMetricTable()
+    {
+        const std::string sql =
+            "CREATE TABLE IF NOT EXISTS " + metric_table_name + " ("
+            "timestamp TIMESTAMPTZ NOT NULL,"          // 时间戳
+            "core_index INTEGER NOT NULL,"            // OS core id
+            "utilization DOUBLE PRECISION,"           // 利用率(%)
+            "frequency DOUBLE PRECISION,"             // 频率(MHz)
+            "ipc DOUBLE PRECISION,"                   // 每周期指令数
+            "l2_hit_ratio DOUBLE PRECISION,"          // L2 命中率
+            "l3_hit_ratio DOUBLE PRECISION,"          // L3 命中率
+            "c0_residency DOUBLE PRECISION,"          // C0 状态占比(%)
+            "c1_residency DOUBLE PRECISION,"          // C1 状态占比(%)
+            "c6_residency DOUBLE PRECISION"           // C6 状态占比(%)
+            ");";
+
+        if (!execSQL(sql))
+        {
+            spdlog::error("[CPUCoreDatabase] Failed to create metric table");
+            return false;
+        }
+        if (!upgradeTimestampColumn(metric_table_name))
+        {
+            spdlog::error("[CPUCoreDatabase] Failed to convert timestamp column to TIMESTAMPTZ");
+            return false;
+        }
+        if (!addSeqColumn(metric_table_name))
+        {
+            spdlog::error("[CPUCoreDatabase] Failed to add seq column");
+            return false;
+        }
+        spdlog::info("[CPUCoreDatabase] Table {} created or already exists", metric_table_name);
+        return true;
+    }
+
+    bool CPUCoreDatabase::createInfoTable()
+    {
+        const std::string sql =
+            "CREATE TABLE IF NOT EXISTS " + info_table_name + " ("
+            "core_index INTEGER NOT NULL PRIMARY KEY," // OS core id
+            "socket_index INTEGER"                     // 所属 socket
+            ");";
+        if (!execSQL(sql))
+        {
+            spdlog::error("[CPUCoreDatabase] Failed to create info table");
+            return false;
+        }
+        spdlog::info("[CPUCoreDatabase] Table {} created or already exists", info_table_name);
+        return true;
+    }
+
+    void CPUCoreDatabase::writeMetric(TimePoint cur_time, std::uint64_t seq,
+                                const std::vector<CPUCoreLabel>& label_list,
+                                const std::vector<CPUCoreMetrics>& metric_list,
+                                bool)
+    {
+        if (!isConnected())throw hwgauge::FatalError("[CPUCoreDatabase] The database hasn't been connected before writing");
+
+        // 数百个核一次 COPY 完成，COPY 本身是原子的，不需要额外事务
+        copy_buf.clear();
+        for (size_t i = 0; i < label_list.size(); ++i)
+        {
+            const CPUCoreLabel& label = label_list[i];
+            const CPUCoreMetrics& metric = metric_list[i];
+
+            appendCopyField(copy_buf, cur_time);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, static_cast<long long>(label.index));
+            for (double v : { metric.utilization, metric.frequency, metric.ipc,
+                              metric.l2HitRatio, metric.l3HitRatio,
+                              metric.c0Residency, metric.c1Residency, metric.c6Residency })
+            {
+                copy_buf += '\t';
+                appendCopyField(copy_buf, v);
+            }
+            copy_buf += '\t';
+            appendCopyField(copy_buf, seqValue(seq));
+            copy_buf += '\n';
+        }
+
+        if (!copyIn(metric_copy_sql, copy_buf))return;
+        HWGAUGE_LOG_COUNT("CPUCoreDatabase records", label_list.size());
+    }
+    
+    void CPUCoreDatabase::writeInfo(const std::vector<CPUCoreLabel>& label_list,
+                                bool useTransaction)
+    {
+        if (!isConnected())throw hwgauge::FatalError("[CPUCoreDatabase] The database hasn't been connected before writing");
+        if (useTransaction && !startTransaction())return;
+        
+        int inserted = 0;
+        for (size_t i = 0; i < label_list.size(); ++i)
+        {
+            const CPUCoreLabel& label = label_list[i];
+
+            std::vector<std::string> buf(2);
+            const char* params[2] = {
+                to_sql_param_long(static_cast<long long>(label.index), buf[0]),
+                to_sql_param_long(static_cast<long long>(label.socket), buf[1]),
+            };
+
+            if (!execSQL(info_insert_sql, std::vector<const char*>(params, params + 2)))
+            {
+                if(useTransaction) rollbackTransaction();
+                return;
+            }
+            ++inserted;
+        }
+        if (useTransaction && !commitTransaction())return;
+        spdlog::info("[CPUCoreDatabase] Successfully inserted {}/{} records into {}", inserted, label_list.size(), info_table_name);
+    }
+}
+
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+
+#ifdef HWGAUGE_USE_POSTGRESQL
+
+#include "CPUCoreMetrics.hpp"
+#include "Collector/Common/Config.hpp"
+#include "Collector/Base/Database.hpp"
+
+namespace hwgauge
+{
+    /* 逐核CPU数据库操作类，指标数据使用 COPY 批量写入 */
+    class CPUCoreDatabase : public Database<CPUCoreLabel, CPUCoreMetrics>
+    {
+    public:
+        /* 构造函数 */
+        explicit CPUCoreDatabase(const DBConfig& config_, const std::string& table_name_prefix);
+
+        /* 构造函数：复用外部连接 */
+        CPUCoreDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix);
+        
+        /* 析构函数 */
+        ~CPUCoreDatabase();
+        
+        /* 写入逐核监控数据 */
+        void writeMetric(TimePoint cur_time, std::uint64_t seq,
+                        const std::vector<CPUCoreLabel>& label_list, 
+                        const std::vector<CPUCoreMetrics>& metric_list,
+                        bool useTransaction = true) override;
+        
+        /* 写入逐核静态数据 */
+        void writeInfo(const std::vector<CPUCoreLabel>& label_list,
+                      bool useTransaction = true) override;
+        
+    private:
+        /* 设置表名、建表并构建SQL模板 */
+        void setup(const std::string& table_name_prefix);
+
+        /* 创建指标数据表 */
+        bool createMetricTable() override;
+        /* 创建静态数据表 */
+        bool createInfoTable() override;
+
+        std::string metric_copy_sql;    // COPY 语句
+        std::string copy_buf;           // 复用的 COPY 数据缓冲
+    };
+}
+
+#endif
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Collector/Common/Fields.hpp"
+#include <string>
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+#include <nlohmann/json.hpp>
+#endif
+
+namespace hwgauge
+{
+    struct CPUCoreLabel
+    {
+        std::size_t index;      // OS core id
+        std::size_t socket;     // 所属 socket
+    };
+
+    struct CPUCoreMetrics
+    {
+        double utilization;     // core utilization percentage
+        double frequency;       // active average frequency in MHz
+        double ipc;             // instructions per cycle
+        double l2HitRatio;      // L2 cache hit ratio (0-1)
+        double l3HitRatio;      // L3 cache hit ratio (0-1)
+        double c0Residency;     // C0 state residency percentage
+        double c1Residency;     // C1 state residency percentage
+        double c6Residency;     // C6 state residency percentage
+    };
+
+    template<>
+    struct Fields<CPUCoreLabel>
+    {
+        template<typename T, typename F>
+        static void visit(T& l, F&& f)
+        {
+            f("index", l.index);
+            f("socket", l.socket);
+        }
+    };
+
+    template<>
+    struct Fields<CPUCoreMetrics>
+    {
+        template<typename T, typename F>
+        static void visit(T& m, F&& f)
+        {
+            f("utilization", m.utilization);
+            f("frequency", m.frequency);
+            f("ipc", m.ipc);
+            f("l2HitRatio", m.l2HitRatio);
+            f("l3HitRatio", m.l3HitRatio);
+            f("c0Residency", m.c0Residency);
+            f("c1Residency", m.c1Residency);
+            f("c6Residency", m.c6Residency);
+        }
+    };
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+    inline void to_json(nlohmann::json& j, const CPUCoreLabel& l) {
+        j = nlohmann::json{{"index", l.index}, {"socket", l.socket}};
+    }
+
+    inline void to_json(nlohmann::json& j, const CPUCoreMetrics& m) {
+        j = nlohmann::json{
+            {"utilization", m.utilization},
+            {"frequency", m.frequency},
+            {"ipc", m.ipc},
+            {"l2HitRatio", m.l2HitRatio},
+            {"l3HitRatio", m.l3HitRatio},
+            {"c0Residency", m.c0Residency},
+            {"c1Residency", m.c1Residency},
+            {"c6Residency", m.c6Residency}
+        };
+    }
+#endif
+}
@@ -0,0 +1,64 @@
+#if (defined(HWGAUGE_USE_INTEL_PCM) || defined(__linux__)) && defined(HWGAUGE_USE_PROMETHEUS)
+
+#include "CPUCorePrometheus.hpp"
+
+namespace hwgauge
+{
+    CPUCorePrometheus::CPUCorePrometheus(std::shared_ptr<prometheus::Registry> registry_)
+        : Prometheus<CPUCoreLabel, CPUCoreMetrics>(registry_)
+    {
+        // 创建指标族（Families）
+        static const std::array<std::pair<const char*, const char*>, kMetricCount> specs = {{
+            {"cpu_core_utilization_percent", "Per-core utilization percentage"},
+            {"cpu_core_frequency_mhz", "Per-core active average frequency in MHz"},
+            {"cpu_core_ipc", "Per-core instructions per cycle"},
+            {"cpu_core_l2_hit_ratio", "Per-core L2 cache hit ratio"},
+            {"cpu_core_l3_hit_ratio", "Per-core L3 cache hit ratio"},
+            {"cpu_core_c0_residency_percent", "Per-core C0 state residency percentage"},
+            {"cpu_core_c1_residency_percent", "Per-core C1 state residency percentage"},
+            {"cpu_core_c6_residency_percent", "Per-core C6 state residency percentage"},
+        }};
+
+        auto& registry_ref = *registry;
+        for (std::size_t k = 0; k < kMetricCount; ++k)
+        {
+            families[k] = &prometheus::BuildGauge()
+                .Name(specs[k].first)
+                .Help(specs[k].second)
+                .Register(registry_ref);
+        }
+    }
+
+    void CPUCorePrometheus::write(const std::vector<CPUCoreLabel>& label_list,const std::vector<CPUCoreMetrics>& metric_list)
+    {
+        // 核集合在采集器生命周期内固定（DeviceCollector 只在构造时读取一次 labels），首轮建立标签
+        if (coreLabels.size() != label_list.size())
+        {
+            coreLabels.clear();
+            for (const auto& label : label_list)
+            {
+                coreLabels.push_back({
+                    {"core", std::to_string(label.index)},
+                    {"socket", std::to_string(label.socket)}
+                });
+            }
+            gauges.assign(label_list.size(), {});
+        }
+
+        for (size_t i = 0; i < metric_list.size(); i++)
+        {
+            std::size_t k = 0;
+            auto& row = gauges[i];
+            Fields<CPUCoreMetrics>::visit(metric_list[i], [&](const char*, double value, auto...) {
+                if (value != -1.0)
+                {
+                    if (!row[k])row[k] = &families[k]->Add(coreLabels[i]);
+                    row[k]->Set(value);
+                }
+                ++k;
+            });
+        }
+    }
+}
+
+#endif
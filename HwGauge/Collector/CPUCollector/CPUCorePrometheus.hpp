@@ -0,0 +1,34 @@
+#pragma once
+
+#if (defined(HWGAUGE_USE_INTEL_PCM) || defined(__linux__)) && defined(HWGAUGE_USE_PROMETHEUS)
+
+#include "Collector/Base/Prometheus.hpp"
+#include "CPUCoreMetrics.hpp"
+
+#include <array>
+#include <map>
+
+namespace hwgauge
+{
+    class CPUCorePrometheus:public Prometheus<CPUCoreLabel,CPUCoreMetrics>
+    {
+    public:
+        static constexpr std::size_t kMetricCount = 8;
+
+        explicit CPUCorePrometheus(std::shared_ptr<prometheus::Registry> registry_);
+        
+        virtual ~CPUCorePrometheus() = default;
+
+        void write(const std::vector<CPUCoreLabel>& label_list,const std::vector<CPUCoreMetrics>& metric_list);
+    private:
+        // 按 Fields<CPUCoreMetrics> 的顺序排列
+        std::array<prometheus::Family<prometheus::Gauge>*, kMetricCount> families;
+
+        // 每个核的 Gauge 指针缓存，每轮只需 Set，不再查找标签；
+        // 数据源不支持的指标 (-1) 不创建
+        std::vector<std::array<prometheus::Gauge*, kMetricCount>> gauges;
+        std::vector<std::map<std::string, std::string>> coreLabels;
+    };
+}
+
+#endif
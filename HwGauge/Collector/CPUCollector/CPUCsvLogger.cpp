@@ -1,4 +1,4 @@
-#ifdef HWGAUGE_USE_INTEL_PCM
+#if defined(HWGAUGE_USE_INTEL_PCM) || defined(__linux__)
 
 #include "CPUCsvLogger.hpp"
 #include <sstream>
@@ -22,9 +22,35 @@ namespace hwgauge
         spdlog::info("[CPUCsvLogger] Initialized logger for: {}", m_filepath);
     }
 
-    std::string CPUCsvLogger::getHeader() const {
+    std::string CPUCsvLogger::header() {
         return "Index,Name,Util(%),Freq(MHz),Temp(C),Power(W),"
-               "C0(%),C6(%),MemRead(MB/s),MemWrite(MB/s),MemPower(W)";
+               "C0(%),C6(%),MemRead(MB/s),MemWrite(MB/s),MemPower(W),"
+               "IPC,L3Hit,L3Miss(M/s),UPI(%),IO(MB/s),Energy(J),MemEnergy(J)";
+    }
+
+    std::string CPUCsvLogger::getHeader() const {
+        return header();
+    }
+
+    void CPUCsvLogger::parseRow(CsvFieldReader& r, CPULabel& l, CPUMetrics& m) {
+        r.get(l.index);
+        r.get(l.name);
+        r.get(m.cpuUtilization);
+        r.get(m.cpuFrequency);
+        r.get(m.temperature);
+        r.get(m.powerUsage);
+        r.get(m.c0Residency);
+        r.get(m.c6Residency);
+        r.get(m.memoryReadBandwidth);
+        r.get(m.memoryWriteBandwidth);
+        r.get(m.memoryPowerUsage);
+        r.get(m.ipc);
+        r.get(m.l3HitRatio);
+        r.get(m.l3Misses);
+        r.get(m.upiUtilization);
+        r.get(m.ioBandwidth);
+        r.get(m.energyJoules);
+        r.get(m.memoryEnergyJoules);
     }
 
     std::string CPUCsvLogger::formatRow(const CPULabel& l, const CPUMetrics& m) const {
@@ -41,7 +67,14 @@ namespace hwgauge
            << m.c6Residency << ","
            << m.memoryReadBandwidth << ","
            << m.memoryWriteBandwidth << ","
-           << m.memoryPowerUsage;
+           << m.memoryPowerUsage << ","
+           << m.ipc << ","
+           << m.l3HitRatio << ","
+           << m.l3Misses << ","
+           << m.upiUtilization << ","
+           << m.ioBandwidth << ","
+           << m.energyJoules << ","
+           << m.memoryEnergyJoules;
         
         return ss.str();
     }
@@ -1,7 +1,8 @@
 #pragma once
-#ifdef HWGAUGE_USE_INTEL_PCM
+#if defined(HWGAUGE_USE_INTEL_PCM) || defined(__linux__)
 
 #include "Collector/Base/CsvLogger.hpp"
+#include "Collector/Common/CsvReader.hpp"
 #include "CPUMetrics.hpp"
 
 namespace hwgauge
@@ -12,6 +13,10 @@ namespace hwgauge
         //using CsvLogger<CPULabel, CPUMetrics>::CsvLogger;
         explicit CPUCsvLogger(const std::string& filepath);
 
+        // 表头与 formatRow 的逆过程，供回放 (--replay) 读取已记录的文件
+        static std::string header();
+        static void parseRow(CsvFieldReader& r, CPULabel& l, CPUMetrics& m);
+
     protected:
         std::string getHeader() const override;
         std::string formatRow(const CPULabel& l, const CPUMetrics& m) const override;
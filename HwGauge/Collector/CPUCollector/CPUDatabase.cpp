@@ -1,4 +1,4 @@
-#if defined(HWGAUGE_USE_POSTGRESQL) && defined(HWGAUGE_USE_INTEL_PCM)
+#ifdef HWGAUGE_USE_POSTGRESQL
 
 #include "CPUDatabase.hpp"
 
@@ -10,6 +10,17 @@ namespace hwgauge
 {
     CPUDatabase::CPUDatabase(const DBConfig& config_, const std::string& table_name_prefix)
         : Database<CPULabel, CPUMetrics>(config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    CPUDatabase::CPUDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<CPULabel, CPUMetrics>(shared_conn, config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    void CPUDatabase::setup(const std::string& table_name_prefix)
     {
         // 设置表名
         metric_table_name = table_name_prefix + "_cpu_metric";
@@ -21,8 +32,10 @@ namespace hwgauge
             "INSERT INTO " + metric_table_name +
             " (timestamp, cpu_index, cpu_utilization, cpu_frequency, "
             "c0_residency, c6_residency, power_usage, "
-            "memory_read_bandwidth, memory_write_bandwidth, memory_power_usage, temperature) "
-            "VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9, $10, $11);";
+            "memory_read_bandwidth, memory_write_bandwidth, memory_power_usage, temperature, "
+            "ipc, l3_hit_ratio, l3_misses, upi_utilization, io_bandwidth, "
+            "energy_joules, memory_energy_joules, seq) "
+            "VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9, $10, $11, $12, $13, $14, $15, $16, $17, $18, $19);";
 
         info_insert_sql =
             "INSERT INTO " + info_table_name +
@@ -40,7 +53,7 @@ namespace hwgauge
     {
         const std::string sql =
             "CREATE TABLE IF NOT EXISTS " + metric_table_name + " ("
-            "timestamp TIMESTAMP NOT NULL,"          // 时间戳
+            "timestamp TIMESTAMPTZ NOT NULL,"          // 时间戳
             "cpu_index INTEGER NOT NULL,"             // CPU / socket 索引
             "cpu_utilization DOUBLE PRECISION,"       // CPU 利用率(%)
             "cpu_frequency DOUBLE PRECISION,"         // CPU 频率(MHz)
@@ -50,7 +63,14 @@ namespace hwgauge
             "memory_read_bandwidth DOUBLE PRECISION," // 内存读带宽(MB/s)
             "memory_write_bandwidth DOUBLE PRECISION,"// 内存写带宽(MB/s)
             "memory_power_usage DOUBLE PRECISION,"    // 内存功耗(W)
-            "temperature DOUBLE PRECISION"            // 温度(C)
+            "temperature DOUBLE PRECISION,"           // 温度(C)
+            "ipc DOUBLE PRECISION,"                   // 每周期指令数
+            "l3_hit_ratio DOUBLE PRECISION,"          // L3 命中率
+            "l3_misses DOUBLE PRECISION,"             // L3 未命中(百万次/s)
+            "upi_utilization DOUBLE PRECISION,"       // 最繁忙 UPI 链路利用率(%)
+            "io_bandwidth DOUBLE PRECISION,"          // IO 流量(MB/s)
+            "energy_joules DOUBLE PRECISION,"         // 累计 package 能耗(J)
+            "memory_energy_joules DOUBLE PRECISION"   // 累计内存能耗(J)
             ");";
 
         if (!execSQL(sql))
@@ -58,6 +78,32 @@ namespace hwgauge
             spdlog::error("[CPUDatabase] Failed to create metric table");
             return false;
         }
+        if (!upgradeTimestampColumn(metric_table_name))
+        {
+            spdlog::error("[CPUDatabase] Failed to convert timestamp column to TIMESTAMPTZ");
+            return false;
+        }
+
+        // 兼容旧版本创建的表
+        const std::string upgrade =
+            "ALTER TABLE " + metric_table_name +
+            " ADD COLUMN IF NOT EXISTS ipc DOUBLE PRECISION,"
+            " ADD COLUMN IF NOT EXISTS l3_hit_ratio DOUBLE PRECISION,"
+            " ADD COLUMN IF NOT EXISTS l3_misses DOUBLE PRECISION,"
+            " ADD COLUMN IF NOT EXISTS upi_utilization DOUBLE PRECISION,"
+            " ADD COLUMN IF NOT EXISTS io_bandwidth DOUBLE PRECISION,"
+            " ADD COLUMN IF NOT EXISTS energy_joules DOUBLE PRECISION,"
+            " ADD COLUMN IF NOT EXISTS memory_energy_joules DOUBLE PRECISION;";
+        if (!execSQL(upgrade))
+        {
+            spdlog::error("[CPUDatabase] Failed to upgrade metric table");
+            return false;
+        }
+        if (!addSeqColumn(metric_table_name))
+        {
+            spdlog::error("[CPUDatabase] Failed to add seq column");
+            return false;
+        }
         spdlog::info("[CPUDatabase] Table {} created or already exists", metric_table_name);
         return true;
     }
@@ -78,7 +124,7 @@ namespace hwgauge
         return true;
     }
 
-    void CPUDatabase::writeMetric(const std::string& cur_time,
+    void CPUDatabase::writeMetric(TimePoint cur_time, std::uint64_t seq,
                                 const std::vector<CPULabel>& label_list,
                                 const std::vector<CPUMetrics>& metric_list,
                                 bool useTransaction)
@@ -87,27 +133,36 @@ namespace hwgauge
         if (useTransaction && !startTransaction())return;
         
         int inserted = 0;
+        // 时间戳以二进制 TIMESTAMPTZ 绑定，每轮只转换一次
+        const PgTimestamp time(cur_time);
         for (size_t i = 0; i < label_list.size(); ++i)
         {
             const CPULabel& label = label_list[i];
             const CPUMetrics& metric = metric_list[i];
 
-            std::vector<std::string> buf(11);
-            const char* params[11] = {
-                to_sql_param_string(cur_time, buf[0]),
-                to_sql_param_int(label.index, buf[1]),
-                to_sql_param_double(metric.cpuUtilization, buf[2]),
-                to_sql_param_double(metric.cpuFrequency, buf[3]),
-                to_sql_param_double(metric.c0Residency, buf[4]),
-                to_sql_param_double(metric.c6Residency, buf[5]),
-                to_sql_param_double(metric.powerUsage, buf[6]),
-                to_sql_param_double(metric.memoryReadBandwidth, buf[7]),
-                to_sql_param_double(metric.memoryWriteBandwidth, buf[8]),
-                to_sql_param_double(metric.memoryPowerUsage, buf[9]),
-                to_sql_param_double(metric.temperature, buf[10]),
+            std::vector<std::string> buf(18);
+            const char* params[18] = {
+                to_sql_param_int(label.index, buf[0]),
+                to_sql_param_double(metric.cpuUtilization, buf[1]),
+                to_sql_param_double(metric.cpuFrequency, buf[2]),
+                to_sql_param_double(metric.c0Residency, buf[3]),
+                to_sql_param_double(metric.c6Residency, buf[4]),
+                to_sql_param_double(metric.powerUsage, buf[5]),
+                to_sql_param_double(metric.memoryReadBandwidth, buf[6]),
+                to_sql_param_double(metric.memoryWriteBandwidth, buf[7]),
+                to_sql_param_double(metric.memoryPowerUsage, buf[8]),
+                to_sql_param_double(metric.temperature, buf[9]),
+                to_sql_param_double(metric.ipc, buf[10]),
+                to_sql_param_double(metric.l3HitRatio, buf[11]),
+                to_sql_param_double(metric.l3Misses, buf[12]),
+                to_sql_param_double(metric.upiUtilization, buf[13]),
+                to_sql_param_double(metric.ioBandwidth, buf[14]),
+                to_sql_param_double(metric.energyJoules, buf[15]),
+                to_sql_param_double(metric.memoryEnergyJoules, buf[16]),
+                to_sql_param_long(seqValue(seq), buf[17]),
             };
 
-            if (!execSQL(metric_insert_sql, std::vector<const char*>(params, params + 11)))
+            if (!execSQL(metric_insert_sql, time, std::vector<const char*>(params, params + 18)))
             {
                 if(useTransaction) rollbackTransaction();
                 return;
@@ -115,7 +170,7 @@ namespace hwgauge
             ++inserted;
         }
         if (useTransaction && !commitTransaction())return;
-        spdlog::info("[CPUDatabase] Successfully inserted {}/{} records into {}", inserted, label_list.size(), metric_table_name);
+        HWGAUGE_LOG_COUNT("CPUDatabase records", inserted);
     }
     
     void CPUDatabase::writeInfo(const std::vector<CPULabel>& label_list,
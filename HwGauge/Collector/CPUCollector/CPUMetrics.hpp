@@ -1,7 +1,6 @@
 #pragma once
 
-#ifdef HWGAUGE_USE_INTEL_PCM
-
+#include "Collector/Common/Fields.hpp"
 #include <string>
 
 #ifdef HWGAUGE_USE_LOCAL_HTTP
@@ -28,8 +27,55 @@ namespace hwgauge
 		double memoryPowerUsage;       // Memory power usage in watts
 
         double temperature;            // temperature
+
+        // 以下字段平台不支持时为 -1
+        double ipc;                    // Instructions per cycle
+        double l3HitRatio;             // L3 cache hit ratio (0-1)
+        double l3Misses;               // L3 cache misses in millions per second
+        double upiUtilization;         // Busiest UPI/QPI link utilization percentage
+        double ioBandwidth;            // IO (PCIe/DMA) traffic through the memory controller in MB/s
+
+        // 自 agent 启动以来的累计能耗（来自 RAPL 能耗计数器），单调不减
+        double energyJoules;           // Package energy in joules
+        double memoryEnergyJoules;     // DRAM energy in joules
 	};
 
+    template<>
+    struct Fields<CPULabel>
+    {
+        template<typename T, typename F>
+        static void visit(T& l, F&& f)
+        {
+            f("index", l.index);
+            f("name", l.name);
+        }
+    };
+
+    template<>
+    struct Fields<CPUMetrics>
+    {
+        template<typename T, typename F>
+        static void visit(T& m, F&& f)
+        {
+            f("cpuUtilization", m.cpuUtilization);
+            f("cpuFrequency", m.cpuFrequency);
+            f("c0Residency", m.c0Residency);
+            f("c6Residency", m.c6Residency);
+            f("powerUsage", m.powerUsage);
+            f("memoryReadBandwidth", m.memoryReadBandwidth);
+            f("memoryWriteBandwidth", m.memoryWriteBandwidth);
+            f("memoryPowerUsage", m.memoryPowerUsage);
+            f("temperature", m.temperature);
+            f("ipc", m.ipc);
+            f("l3HitRatio", m.l3HitRatio);
+            f("l3Misses", m.l3Misses);
+            f("upiUtilization", m.upiUtilization);
+            f("ioBandwidth", m.ioBandwidth);
+            f("energyJoules", m.energyJoules, FieldKind::Counter);
+            f("memoryEnergyJoules", m.memoryEnergyJoules, FieldKind::Counter);
+        }
+    };
+
 #ifdef HWGAUGE_USE_LOCAL_HTTP
     // 定义序列化规则（必须与结构体在同一命名空间）
     inline void to_json(nlohmann::json& j, const CPULabel& l) {
@@ -46,12 +92,17 @@ namespace hwgauge
             {"memoryReadBandwidth", m.memoryReadBandwidth},
             {"memoryWriteBandwidth", m.memoryWriteBandwidth},
             {"memoryPowerUsage", m.memoryPowerUsage},
-            {"temperature", m.temperature}
+            {"temperature", m.temperature},
+            {"ipc", m.ipc},
+            {"l3HitRatio", m.l3HitRatio},
+            {"l3Misses", m.l3Misses},
+            {"upiUtilization", m.upiUtilization},
+            {"ioBandwidth", m.ioBandwidth},
+            {"energyJoules", m.energyJoules},
+            {"memoryEnergyJoules", m.memoryEnergyJoules}
         };
     }
 #endif
 
 
-}
-
-#endif
\ No newline at end of file
+}
\ No newline at end of file
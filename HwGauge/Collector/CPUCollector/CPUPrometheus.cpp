@@ -1,4 +1,4 @@
-#if defined(HWGAUGE_USE_INTEL_PCM) && defined(HWGAUGE_USE_PROMETHEUS)
+#if (defined(HWGAUGE_USE_INTEL_PCM) || defined(__linux__)) && defined(HWGAUGE_USE_PROMETHEUS)
 
 #include "CPUPrometheus.hpp"
 
@@ -48,32 +48,82 @@ namespace hwgauge
             .Name("memory_power_usage_watts")
             .Help("Memory power usage in watts")
             .Register(registry_ref);
+
+        ipcFamily = &prometheus::BuildGauge()
+            .Name("cpu_ipc")
+            .Help("CPU instructions per cycle")
+            .Register(registry_ref);
+
+        l3HitRatioFamily = &prometheus::BuildGauge()
+            .Name("cpu_l3_hit_ratio")
+            .Help("CPU L3 cache hit ratio")
+            .Register(registry_ref);
+
+        l3MissesFamily = &prometheus::BuildGauge()
+            .Name("cpu_l3_misses_mps")
+            .Help("CPU L3 cache misses in millions per second")
+            .Register(registry_ref);
+
+        upiUtilizationFamily = &prometheus::BuildGauge()
+            .Name("cpu_upi_utilization_percent")
+            .Help("Busiest UPI/QPI link utilization percentage")
+            .Register(registry_ref);
+
+        ioBandwidthFamily = &prometheus::BuildGauge()
+            .Name("cpu_io_bandwidth_mbps")
+            .Help("IO (PCIe/DMA) traffic through the memory controller in MB/s")
+            .Register(registry_ref);
+
+        // 累计能耗使用 Counter，可直接 increase() 计算任意区间的能耗
+        energyFamily = &prometheus::BuildCounter()
+            .Name("cpu_energy_joules_total")
+            .Help("CPU package energy consumed since agent start in joules")
+            .Register(registry_ref);
+
+        memoryEnergyFamily = &prometheus::BuildCounter()
+            .Name("memory_energy_joules_total")
+            .Help("Memory (DRAM) energy consumed since agent start in joules")
+            .Register(registry_ref);
     }
 
     void CPUPrometheus::write(const std::vector<CPULabel>& label_list,const std::vector<CPUMetrics>& metric_list)
     {
+        // 构建标签：socket 集合在采集器生命周期内不变，只需在第一轮构建
+        if (gauges.resize(label_list.size()))
+        {
+            counters.resize(label_list.size());
+            for (size_t i = 0; i < label_list.size(); i++)
+            {
+                gauges.labels(i) = {
+                    {"index", std::to_string(label_list[i].index)},
+                    {"name", label_list[i].name}
+                };
+                counters.labels(i) = gauges.labels(i);
+            }
+        }
+
         // 更新每个设备的指标
         for (size_t i = 0; i < label_list.size(); i++)
         {
-            const auto& label = label_list[i];
             const auto& metric = metric_list[i];
             
-            // 构建标签
-            std::map<std::string, std::string> labels = 
-            {
-                {"index", std::to_string(label.index)},
-                {"name", label.name}
-            };
-            
-            // 更新各个指标 - 使用Add()获取或创建带有标签的指标
-            cpuUtilizationFamily->Add(labels).Set(metric.cpuUtilization);
-            cpuFrequencyFamily->Add(labels).Set(metric.cpuFrequency);
-            c0ResidencyFamily->Add(labels).Set(metric.c0Residency);
-            c6ResidencyFamily->Add(labels).Set(metric.c6Residency);
-            powerUsageFamily->Add(labels).Set(metric.powerUsage);
-            memoryReadBandwidthFamily->Add(labels).Set(metric.memoryReadBandwidth);
-            memoryWriteBandwidthFamily->Add(labels).Set(metric.memoryWriteBandwidth);
-            memoryPowerUsageFamily->Add(labels).Set(metric.memoryPowerUsage);
+            // 更新各个指标 - 序列在第一次用到时创建，之后直接 Set
+            gauges.get(i, cpuUtilizationFamily).Set(metric.cpuUtilization);
+            gauges.get(i, cpuFrequencyFamily).Set(metric.cpuFrequency);
+            gauges.get(i, powerUsageFamily).Set(metric.powerUsage);
+            gauges.get(i, memoryPowerUsageFamily).Set(metric.memoryPowerUsage);
+            // 平台或数据源不支持的指标不导出（非 PCM 数据源没有 C-state 与带宽）
+            if (metric.c0Residency != -1.0)gauges.get(i, c0ResidencyFamily).Set(metric.c0Residency);
+            if (metric.c6Residency != -1.0)gauges.get(i, c6ResidencyFamily).Set(metric.c6Residency);
+            if (metric.memoryReadBandwidth != -1.0)gauges.get(i, memoryReadBandwidthFamily).Set(metric.memoryReadBandwidth);
+            if (metric.memoryWriteBandwidth != -1.0)gauges.get(i, memoryWriteBandwidthFamily).Set(metric.memoryWriteBandwidth);
+            if (metric.ipc != -1.0)gauges.get(i, ipcFamily).Set(metric.ipc);
+            if (metric.l3HitRatio != -1.0)gauges.get(i, l3HitRatioFamily).Set(metric.l3HitRatio);
+            if (metric.l3Misses != -1.0)gauges.get(i, l3MissesFamily).Set(metric.l3Misses);
+            if (metric.upiUtilization != -1.0)gauges.get(i, upiUtilizationFamily).Set(metric.upiUtilization);
+            if (metric.ioBandwidth != -1.0)gauges.get(i, ioBandwidthFamily).Set(metric.ioBandwidth);
+            setCounter(counters.get(i, energyFamily), metric.energyJoules);
+            setCounter(counters.get(i, memoryEnergyFamily), metric.memoryEnergyJoules);
         }
     }
 }
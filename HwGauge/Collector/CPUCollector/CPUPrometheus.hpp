@@ -1,6 +1,6 @@
 #pragma once
 
-#if defined(HWGAUGE_USE_INTEL_PCM) && defined(HWGAUGE_USE_PROMETHEUS)
+#if (defined(HWGAUGE_USE_INTEL_PCM) || defined(__linux__)) && defined(HWGAUGE_USE_PROMETHEUS)
 
 #include "Collector/Base/Prometheus.hpp"
 #include "CPUMetrics.hpp"
@@ -25,6 +25,16 @@ namespace hwgauge
 		prometheus::Family<prometheus::Gauge>* memoryReadBandwidthFamily;
 		prometheus::Family<prometheus::Gauge>* memoryWriteBandwidthFamily;
 		prometheus::Family<prometheus::Gauge>* memoryPowerUsageFamily;
+		prometheus::Family<prometheus::Gauge>* ipcFamily;
+		prometheus::Family<prometheus::Gauge>* l3HitRatioFamily;
+		prometheus::Family<prometheus::Gauge>* l3MissesFamily;
+		prometheus::Family<prometheus::Gauge>* upiUtilizationFamily;
+		prometheus::Family<prometheus::Gauge>* ioBandwidthFamily;
+		prometheus::Family<prometheus::Counter>* energyFamily;
+		prometheus::Family<prometheus::Counter>* memoryEnergyFamily;
+
+		SeriesCache<prometheus::Gauge> gauges;
+		SeriesCache<prometheus::Counter> counters;
     };
 }
 
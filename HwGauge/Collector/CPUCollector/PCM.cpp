@@ -1,20 +1,17 @@
 #ifdef HWGAUGE_USE_INTEL_PCM
 #include "PCM.hpp"
 #include "Collector/Common/Exception.hpp"
+#include "Collector/Common/Log.hpp"
 
 #include "spdlog/spdlog.h"
 #include "cpucounters.h"
 #include <thread>
 #include <chrono>
-#include <iostream>
-#include <filesystem> // C++17
-#include <fstream>
 #include <string>
+#include <algorithm>
 
 namespace hwgauge
 {
-    namespace fs = std::filesystem;
-
     PCM::PCM() {
         initializePCM();
         initTempSensors();
@@ -27,11 +24,23 @@ namespace hwgauge
 
     PCM::PCM(PCM&& other) noexcept
         : initialized(other.initialized),
+        session(std::move(other.session)),
         pcmInstance(other.pcmInstance),
+        generation(other.generation),
         beforeState(std::move(other.beforeState)),
         afterState(std::move(other.afterState)),
+        upiAvailable(other.upiAvailable),
+        beforeSystem(std::move(other.beforeSystem)),
+        afterSystem(std::move(other.afterSystem)),
+        coreScratch(std::move(other.coreScratch)),
+        l3MissAvailable(other.l3MissAvailable),
+        l3HitAvailable(other.l3HitAvailable),
+        ioAvailable(other.ioAvailable),
         beforeTime(other.beforeTime),
-        socketPaths(std::move(other.socketPaths)) // <--- 必须加上这一行！
+        packageEnergy(std::move(other.packageEnergy)),
+        dramEnergy(std::move(other.dramEnergy)),
+        hwmon(std::move(other.hwmon)),
+        socketSensors(std::move(other.socketSensors))
     {
         other.initialized = false;
         other.pcmInstance = nullptr;
@@ -43,11 +52,23 @@ namespace hwgauge
                 cleanupPCM();
 
             initialized = other.initialized;
+            session = std::move(other.session);
             pcmInstance = other.pcmInstance;
+            generation = other.generation;
             beforeState = std::move(other.beforeState);
             afterState = std::move(other.afterState);
+            upiAvailable = other.upiAvailable;
+            beforeSystem = std::move(other.beforeSystem);
+            afterSystem = std::move(other.afterSystem);
+            coreScratch = std::move(other.coreScratch);
+            l3MissAvailable = other.l3MissAvailable;
+            l3HitAvailable = other.l3HitAvailable;
+            ioAvailable = other.ioAvailable;
             beforeTime = other.beforeTime;
-            socketPaths = std::move(other.socketPaths); // <--- 必须加上这一行！
+            packageEnergy = std::move(other.packageEnergy);
+            dramEnergy = std::move(other.dramEnergy);
+            hwmon = std::move(other.hwmon);
+            socketSensors = std::move(other.socketSensors);
 
             other.initialized = false;
             other.pcmInstance = nullptr;
@@ -57,8 +78,16 @@ namespace hwgauge
 
     /* ---------- helpers ---------- */
 
-    void PCM::snapshot(std::vector<pcm::SocketCounterState>& out)
+    void PCM::snapshot(std::vector<pcm::SocketCounterState>& out, pcm::SystemCounterState* system)
     {
+        std::lock_guard<std::mutex> lock(session->counterMutex());
+        // 需要 UPI 时一次读取系统 + socket + core 状态（vector 容量复用），否则只读 socket
+        if (system)
+        {
+            pcmInstance->getAllCounterStates(*system, out, coreScratch);
+            return;
+        }
+
         out.clear();
         out.reserve(pcmInstance->getNumSockets());
 
@@ -66,38 +95,38 @@ namespace hwgauge
             out.push_back(pcmInstance->getSocketCounterState(s));
     }
 
-    /* ---------- init ---------- */
-
-    void PCM::initializePCM()
+    void PCM::detectMetrics()
     {
-        pcmInstance = pcm::PCM::getInstance();
-        if (!pcmInstance)
-            throw hwgauge::FatalError("PCM: Failed to get PCM instance");
-
-        auto status = pcmInstance->program();
+        // 这些指标都来自默认编程下已有的计数器，不增加额外的 PMU 编程
+        upiAvailable = pcmInstance->incomingQPITrafficMetricsAvailable() && pcmInstance->getQPILinksPerSocket() > 0;
+        l3MissAvailable = pcmInstance->isL3CacheMissesAvailable();
+        l3HitAvailable = pcmInstance->isL3CacheHitRatioAvailable();
+        ioAvailable = pcmInstance->memoryIOTrafficMetricAvailable();
 
-        switch (status) {
-        case pcm::PCM::Success:
-            break;
-
-        case pcm::PCM::MSRAccessDenied:
-            throw hwgauge::FatalError(
-                "PCM: Access to CPU counters denied. Run with privileges.");
+        if (upiAvailable)
+        {
+            beforeSystem = std::make_unique<pcm::SystemCounterState>();
+            afterSystem = std::make_unique<pcm::SystemCounterState>();
+        }
+        spdlog::info("[PCM] Extended metrics: UPI={}, L3Miss={}, L3Hit={}, IO={}", upiAvailable, l3MissAvailable, l3HitAvailable, ioAvailable);
+    }
 
-        case pcm::PCM::PMUBusy:
-            pcmInstance->resetPMU();
-            if (pcmInstance->program() != pcm::PCM::Success)
-                throw hwgauge::FatalError("PCM: PMU busy and reset failed");
-            break;
+    /* ---------- init ---------- */
 
-        default:
-            throw hwgauge::FatalError("PCM init failed: " + std::to_string(int(status)));
-        }
+    void PCM::initializePCM()
+    {
+        session = PCMSession::acquire();
+        pcmInstance = session->get();
+        generation = session->generation();
 
         initialized = true;
+        detectMetrics();
+
+        packageEnergy.assign(pcmInstance->getNumSockets(), EnergyCounter{});
+        dramEnergy.assign(pcmInstance->getNumSockets(), EnergyCounter{});
 
         // Prime baseline snapshot
-        snapshot(beforeState);
+        snapshot(beforeState, beforeSystem.get());
         beforeTime = std::chrono::steady_clock::now();
 
         zeroBandwidthCounter=0;
@@ -105,9 +134,8 @@ namespace hwgauge
 
     void PCM::cleanupPCM()
     {
-        if (pcmInstance)
-            pcmInstance->cleanup();
-
+        // 最后一个使用者释放时由 PCMSession 负责 cleanup
+        session.reset();
         pcmInstance = nullptr;
         initialized = false;
     }
@@ -115,89 +143,51 @@ namespace hwgauge
     // 辅助函数：尝试重置 PCM
     void PCM::resetPCM()
     {
-        spdlog::warn("[PCM] Detected hung PMU counters (Bandwidth 0), attempting reset...");
-        if (pcmInstance) {
-            pcmInstance->cleanup();
-            // 稍微等待一下让硬件状态稳定
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
-            auto status = pcmInstance->program();
-            if (status != pcm::PCM::Success) {
-                spdlog::error("[PCM] Reset failed with status: {}", static_cast<int>(status));
-            } else {
-                // 重置成功后，必须重新校准 beforeState，否则下一次计算会因为计数器归零产生巨大的错误尖峰
-                snapshot(beforeState); 
-                beforeTime = std::chrono::steady_clock::now();
-                zeroBandwidthCounter = 0;
-                spdlog::info("[PCM] Reset successful.");
-            }
+        HWGAUGE_WARN_LIMITED("[PCM] Detected hung PMU counters (Bandwidth 0), attempting reset...");
+        if (session && session->reset())
+        {
+            // 重置成功后，必须重新校准 beforeState，否则下一次计算会因为计数器归零产生巨大的错误尖峰
+            snapshot(beforeState, beforeSystem.get()); 
+            beforeTime = std::chrono::steady_clock::now();
+            generation = session->generation();
+            zeroBandwidthCounter = 0;
+            spdlog::info("[PCM] Reset successful.");
         }
     }
 
     void PCM::initTempSensors()
     {
-        // 遍历所有 hwmon 目录
-        if (!fs::exists("/sys/class/hwmon")) {
-            spdlog::warn("[PCM] /sys/class/hwmon does not exist. Temperature unavailable.");
-            return;
-        }
+        hwmon.scan();
+        mapTempSensors();
+    }
 
-        for (const auto& entry : fs::directory_iterator("/sys/class/hwmon")) {
-            if (!entry.is_directory()) continue;
-            
-            // 遍历该 hwmon 目录下的所有 label 文件
-            for (const auto& f : fs::directory_iterator(entry.path())) {
-                std::string fname = f.path().filename().string();
-                
-                // 寻找 temp*_label 文件
-                if (fname.find("temp") == 0 && fname.find("_label") != std::string::npos) {
-                    
-                    // 读取 label 内容，期望找到 "Package id X"
-                    std::ifstream ifs(f.path());
-                    std::string labelContent;
-                    if (std::getline(ifs, labelContent)) {
-                        // 典型内容: "Package id 0"
-                        size_t pkgPos = labelContent.find("Package id");
-                        if (pkgPos != std::string::npos) {
-                            try {
-                                // 提取 ID 数字
-                                // "Package id " 长度是 11
-                                // 但为了稳健，我们找最后一个空格
-                                size_t lastSpace = labelContent.find_last_of(' ');
-                                std::string idStr = labelContent.substr(lastSpace + 1);
-                                uint32_t socketId = std::stoul(idStr);
-                                
-                                // 构造对应的 input 文件路径 (把 _label 换成 _input)
-                                // 例如: temp1_label -> temp1_input
-                                std::string inputPath = f.path().string();
-                                size_t labelIdx = inputPath.find("_label");
-                                if (labelIdx != std::string::npos) {
-                                    inputPath.replace(labelIdx, 6, "_input");
-                                    
-                                    socketPaths[socketId] = inputPath;
-                                    spdlog::info("[PCM] Mapped Socket {} temperature to {}", socketId, inputPath);
-                                }
-                            } catch (const std::exception& e) {
-                                spdlog::warn("[PCM] Failed to parse socket ID from label: '{}'", labelContent);
-                            }
-                        }
-                    }
-                }
-            }
+    void PCM::mapTempSensors()
+    {
+        socketSensors = mapPackageTemps(hwmon);
+        const auto& sensors = hwmon.sensors();
+        for (std::size_t s = 0; s < socketSensors.size(); ++s)
+        {
+            if (socketSensors[s] < 0)continue;
+            const auto& sensor = sensors[socketSensors[s]];
+            spdlog::info("[PCM] Mapped Socket {} temperature to {}/{}", s, sensor.device, sensor.sensor);
         }
+        if (socketSensors.empty())
+            spdlog::warn("[PCM] No coretemp package sensors found. Temperature unavailable.");
     }
 
     double PCM::readTemp(uint32_t socketId)
     {
-        if (socketPaths.count(socketId)) {
-            std::ifstream ifs(socketPaths[socketId]);
-            if (ifs.is_open()) {
-                long tempMilli = 0;
-                if (ifs >> tempMilli) {
-                    return static_cast<double>(tempMilli) / 1000.0;
-                }
-            }
+        if (socketId >= socketSensors.size() || socketSensors[socketId] < 0)
+            return -1.0; // 未找到传感器
+
+        double temp = hwmon.read(socketSensors[socketId]);
+        if (temp < 0.0 && hwmon.stale()) {
+            // hwmon 被重新编号，重新扫描后再读一次
+            initTempSensors();
+            if (socketId < socketSensors.size() && socketSensors[socketId] >= 0)
+                temp = hwmon.read(socketSensors[socketId]);
         }
-        return -1.0; // 读取失败或未找到文件
+        return temp;
     }
 
     /* ---------- labels ---------- */
@@ -220,32 +210,41 @@ namespace hwgauge
     }
 
     /* ---------- sampling ---------- */
-    std::vector<CPUMetrics> PCM::sample(std::vector<CPULabel>&labels)
+    void PCM::sample(std::vector<CPULabel>& labels, std::vector<CPUMetrics>& metrics)
     {
         if (!initialized || !pcmInstance)
             throw hwgauge::FatalError("PCM: Not initialized");
 
-        snapshot(afterState);
+        // 其他采集器重置过 PMU，本轮只重新采集基线
+        if (generation != session->generation())
+        {
+            snapshot(beforeState, beforeSystem.get());
+            beforeTime = std::chrono::steady_clock::now();
+            generation = session->generation();
+            throw hwgauge::RecoverableError("PCM: PMU was reprogrammed, skipping this sample");
+        }
+
+        snapshot(afterState, afterSystem.get());
         auto afterTime = std::chrono::steady_clock::now();
 
         double elapsed =
             std::chrono::duration_cast<std::chrono::duration<double>>(
                 afterTime - beforeTime).count();
 
-        std::vector<CPUMetrics> metrics;
         //auto numSockets = pcmInstance->getNumSockets();
         // 用于检测当前系统是否活跃
         bool isSystemActive = false; 
         // 用于检测是否所有 Socket 的带宽都为 0
         bool allBandwidthZero = true; 
 
-        for (const auto& label : labels)
+        for (std::size_t i = 0; i < labels.size(); ++i)
         {
-            auto s = label.index; 
+            auto s = labels[i].index; 
             const auto& before = beforeState[s];
             const auto& after = afterState[s];
 
-            CPUMetrics m{};
+            CPUMetrics& m = metrics[i];
+            m = CPUMetrics{};
 
             m.cpuUtilization = 100.0 * pcm::getExecUsage(before, after);
 
@@ -258,11 +257,15 @@ namespace hwgauge
             m.c6Residency =
                 100.0 * pcm::getPackageCStateResidency(6, before, after);
 
-            m.powerUsage =
-                pcm::getConsumedJoules(before, after) / elapsed;
+            // 能耗直接累加计数器差值，不经过功率换算，丢弃的采样也不会丢失能耗
+            double packageJoules = pcm::getConsumedJoules(before, after);
+            double dramJoules = pcm::getDRAMConsumedJoules(before, after);
 
-            m.memoryPowerUsage =
-                pcm::getDRAMConsumedJoules(before, after) / elapsed;
+            m.powerUsage = packageJoules / elapsed;
+            m.memoryPowerUsage = dramJoules / elapsed;
+
+            m.energyJoules = packageEnergy[s].add(packageJoules);
+            m.memoryEnergyJoules = dramEnergy[s].add(dramJoules);
 
             double readBytes = pcm::getBytesReadFromMC(before, after);
             double writeBytes = pcm::getBytesWrittenToMC(before, after);
@@ -272,9 +275,32 @@ namespace hwgauge
 
             m.temperature = readTemp(s);
 
-            //m.temperature = (double)pcmInstance->getTemperature(s);
+            m.ipc = pcm::getIPC(before, after);
+            m.l3HitRatio = l3HitAvailable ? pcm::getL3CacheHitRatio(before, after) : -1.0;
+            m.l3Misses = l3MissAvailable
+                ? static_cast<double>(pcm::getL3CacheMisses(before, after)) / 1e6 / elapsed  // -> M/s
+                : -1.0;
+            m.ioBandwidth = ioAvailable
+                ? static_cast<double>(pcm::getIORequestBytesFromMC(before, after)) / 1e6 / elapsed  // B/s -> MB/s
+                : -1.0;
+
+            m.upiUtilization = -1.0;
+            if (upiAvailable)
+            {
+                // 取该 socket 最繁忙的一条链路（收/发）
+                double busiest = 0.0;
+                const auto links = pcmInstance->getQPILinksPerSocket();
+                const bool outgoing = pcmInstance->outgoingQPITrafficMetricsAvailable();
+                for (pcm::uint32 link = 0; link < links; ++link)
+                {
+                    busiest = std::max(busiest, pcm::getIncomingQPILinkUtilization(static_cast<pcm::uint32>(s), link, *beforeSystem, *afterSystem));
+                    if (outgoing)
+                        busiest = std::max(busiest, pcm::getOutgoingQPILinkUtilization(static_cast<pcm::uint32>(s), link, *beforeSystem, *afterSystem));
+                }
+                m.upiUtilization = 100.0 * busiest;
+            }
 
-            metrics.push_back(m);
+            //m.temperature = (double)pcmInstance->getTemperature(s);
 
             // 如果 CPU 利用率 > 1%，认为系统是活的
             if (m.cpuUtilization > 1.0) isSystemActive = true; 
@@ -290,7 +316,7 @@ namespace hwgauge
             if (zeroBandwidthCounter >= 50)
             {
                 resetPCM();
-                return metrics; 
+                return; 
             }
         }
         else
@@ -300,9 +326,8 @@ namespace hwgauge
         }
 
         beforeState.swap(afterState);
+        beforeSystem.swap(afterSystem);
         beforeTime = afterTime;
-
-        return metrics;
     }
 
 } // namespace hwgauge
@@ -1,17 +1,20 @@
 #pragma once
 #ifdef HWGAUGE_USE_INTEL_PCM
 #include "CPUMetrics.hpp"
+#include "PCMSession.hpp"
+#include "Collector/Common/Energy.hpp"
+#include "Collector/Common/Hwmon.hpp"
 #include <string>
 #include <vector>
 #include <memory>
 #include <chrono>
-#include <map>
 
 namespace pcm
 {
     class PCM;
     class SystemCounterState;
     class SocketCounterState;
+    class CoreCounterState;
 }
 
 namespace hwgauge {
@@ -30,19 +33,37 @@ namespace hwgauge {
         std::string name() { return "cpu"; }
 
         std::vector<CPULabel>   labels();
-        std::vector<CPUMetrics> sample(std::vector<CPULabel>&labels);
+        void sample(std::vector<CPULabel>& labels, std::vector<CPUMetrics>& metrics);
 
     private:
         bool initialized{ false };
+        std::shared_ptr<PCMSession> session;
         pcm::PCM* pcmInstance{ nullptr };
+        std::uint64_t generation{ 0 };
 
         std::vector<pcm::SocketCounterState> beforeState;
         std::vector<pcm::SocketCounterState> afterState;
 
+        // UPI 利用率需要系统级计数器状态，与 socket 状态在同一次读取中获得
+        bool upiAvailable{ false };
+        std::unique_ptr<pcm::SystemCounterState> beforeSystem;
+        std::unique_ptr<pcm::SystemCounterState> afterSystem;
+        std::vector<pcm::CoreCounterState> coreScratch;
+
+        // 扩展指标是否可用（取决于 CPU 型号，初始化时检测一次）
+        bool l3MissAvailable{ false };
+        bool l3HitAvailable{ false };
+        bool ioAvailable{ false };
+
         std::chrono::steady_clock::time_point beforeTime;
 
-        // socket -> temp_input 路径
-        std::map<uint32_t, std::string> socketPaths;
+        // 每个 socket 的累计能耗（package / DRAM），按 socket 编号索引
+        std::vector<EnergyCounter> packageEnergy;
+        std::vector<EnergyCounter> dramEnergy;
+
+        // coretemp 传感器常驻打开；socket 编号 -> hwmon 传感器下标，-1 表示没有
+        Hwmon hwmon;
+        std::vector<long> socketSensors;
 
         void initializePCM();
         void cleanupPCM();
@@ -50,10 +71,12 @@ namespace hwgauge {
         int zeroBandwidthCounter;
         void resetPCM();
 
-        void snapshot(std::vector<pcm::SocketCounterState>& out);
+        void snapshot(std::vector<pcm::SocketCounterState>& out, pcm::SystemCounterState* system);
+        void detectMetrics();
 
         // ===== 新增：温度相关 =====
         void initTempSensors();
+        void mapTempSensors();
         double readTemp(uint32_t socketId);
     };
 
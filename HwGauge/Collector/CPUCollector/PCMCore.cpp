@@ -0,0 +1,77 @@
+#ifdef HWGAUGE_USE_INTEL_PCM
+#include "PCMCore.hpp"
+#include "Collector/Common/Exception.hpp"
+
+#include "spdlog/spdlog.h"
+#include "cpucounters.h"
+
+namespace hwgauge
+{
+    PCMCore::PCMCore()
+        : session(PCMSession::acquire()),
+          pcmInstance(session->get()),
+          generation(session->generation())
+    {
+        const auto numCores = pcmInstance->getNumCores();
+        for (pcm::uint32 c = 0; c < numCores; ++c)
+        {
+            if (pcmInstance->isCoreOnline(static_cast<pcm::int32>(c)))cores.push_back(c);
+        }
+        if (cores.empty())throw hwgauge::FatalError("PCM: No online cores");
+
+        beforeState.resize(numCores);
+        afterState.resize(numCores);
+        snapshot(beforeState);
+        spdlog::info("[PCMCore] Sampling {} online cores", cores.size());
+    }
+
+    PCMCore::~PCMCore() = default;
+
+    void PCMCore::snapshot(std::vector<pcm::CoreCounterState>& out)
+    {
+        std::lock_guard<std::mutex> lock(session->counterMutex());
+        for (auto c : cores)out[c] = pcmInstance->getCoreCounterState(c);
+    }
+
+    std::vector<CPUCoreLabel> PCMCore::labels()
+    {
+        std::vector<CPUCoreLabel> labels;
+        labels.reserve(cores.size());
+        for (auto c : cores)
+            labels.push_back(CPUCoreLabel{ c, static_cast<std::size_t>(pcmInstance->getSocketId(c)) });
+        return labels;
+    }
+
+    void PCMCore::sample(std::vector<CPUCoreLabel>& labels, std::vector<CPUCoreMetrics>& metrics)
+    {
+        // socket 级采集器重置过 PMU，本轮只重新采集基线
+        if (generation != session->generation())
+        {
+            snapshot(beforeState);
+            generation = session->generation();
+            throw hwgauge::RecoverableError("PCMCore: PMU was reprogrammed, skipping this sample");
+        }
+
+        snapshot(afterState);
+
+        for (std::size_t i = 0; i < labels.size(); ++i)
+        {
+            const auto& before = beforeState[labels[i].index];
+            const auto& after = afterState[labels[i].index];
+
+            CPUCoreMetrics& m = metrics[i];
+            m.utilization = 100.0 * pcm::getExecUsage(before, after);
+            m.frequency = pcm::getActiveAverageFrequency(before, after) / 1e6;  // Hz -> MHz
+            m.ipc = pcm::getIPC(before, after);
+            m.l2HitRatio = pcm::getL2CacheHitRatio(before, after);
+            m.l3HitRatio = pcm::getL3CacheHitRatio(before, after);
+            m.c0Residency = 100.0 * pcm::getCoreCStateResidency(0, before, after);
+            m.c1Residency = 100.0 * pcm::getCoreCStateResidency(1, before, after);
+            m.c6Residency = 100.0 * pcm::getCoreCStateResidency(6, before, after);
+        }
+
+        beforeState.swap(afterState);
+    }
+}
+
+#endif
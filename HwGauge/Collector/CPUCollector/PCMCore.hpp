@@ -0,0 +1,48 @@
+#pragma once
+#ifdef HWGAUGE_USE_INTEL_PCM
+#include "CPUCoreMetrics.hpp"
+#include "PCMSession.hpp"
+#include <string>
+#include <vector>
+#include <memory>
+#include <cstdint>
+
+namespace pcm
+{
+    class PCM;
+    class CoreCounterState;
+}
+
+namespace hwgauge {
+
+    /* 基于 PCM core 计数器的逐核采集，与 socket 级的 PCM 共用同一个 PCMSession */
+    class PCMCore {
+    public:
+        explicit PCMCore();
+        ~PCMCore();
+
+        PCMCore(const PCMCore&) = delete;
+        PCMCore& operator=(const PCMCore&) = delete;
+
+        std::string name() { return "cpu_core"; }
+
+        std::vector<CPUCoreLabel>   labels();
+        void sample(std::vector<CPUCoreLabel>& labels, std::vector<CPUCoreMetrics>& metrics);
+
+    private:
+        std::shared_ptr<PCMSession> session;
+        pcm::PCM* pcmInstance{ nullptr };
+        std::uint64_t generation{ 0 };
+
+        // 在线的 core id，与 labels 顺序一致
+        std::vector<std::uint32_t> cores;
+
+        // 按 core id 下标预分配，每轮原地覆盖后交换
+        std::vector<pcm::CoreCounterState> beforeState;
+        std::vector<pcm::CoreCounterState> afterState;
+
+        void snapshot(std::vector<pcm::CoreCounterState>& out);
+    };
+
+} // namespace hwgauge
+#endif
@@ -0,0 +1,85 @@
+#ifdef HWGAUGE_USE_INTEL_PCM
+#include "PCMSession.hpp"
+#include "Collector/Common/Exception.hpp"
+
+#include "spdlog/spdlog.h"
+#include "cpucounters.h"
+#include <chrono>
+#include <string>
+#include <thread>
+
+namespace hwgauge
+{
+    namespace
+    {
+        std::mutex sessionMutex;
+        std::weak_ptr<PCMSession> currentSession;
+    }
+
+    std::shared_ptr<PCMSession> PCMSession::acquire()
+    {
+        std::lock_guard<std::mutex> lock(sessionMutex);
+        auto session = currentSession.lock();
+        if (!session)
+        {
+            session.reset(new PCMSession());
+            currentSession = session;
+        }
+        return session;
+    }
+
+    PCMSession::PCMSession()
+    {
+        instance = pcm::PCM::getInstance();
+        if (!instance)
+            throw hwgauge::FatalError("PCM: Failed to get PCM instance");
+
+        auto status = instance->program();
+
+        // 计数器不可用时可以退回 /proc + perf_event 采集，不必退出
+        switch (status) {
+        case pcm::PCM::Success:
+            break;
+
+        case pcm::PCM::MSRAccessDenied:
+            throw hwgauge::RecoverableError(
+                "PCM: Access to CPU counters denied. Run with privileges.");
+
+        case pcm::PCM::PMUBusy:
+            instance->resetPMU();
+            if (instance->program() != pcm::PCM::Success)
+                throw hwgauge::RecoverableError("PCM: PMU busy and reset failed");
+            break;
+
+        default:
+            throw hwgauge::RecoverableError("PCM init failed: " + std::to_string(int(status)));
+        }
+        spdlog::info("[PCM] PMU programmed");
+    }
+
+    PCMSession::~PCMSession()
+    {
+        if (instance)
+            instance->cleanup();
+        instance = nullptr;
+    }
+
+    bool PCMSession::reset()
+    {
+        std::lock_guard<std::mutex> lock(sessionMutex);
+        std::lock_guard<std::mutex> countersLock(counters);
+        instance->cleanup();
+        // 稍微等待一下让硬件状态稳定
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        auto status = instance->program();
+        if (status != pcm::PCM::Success)
+        {
+            spdlog::error("[PCM] Reset failed with status: {}", static_cast<int>(status));
+            return false;
+        }
+        gen.fetch_add(1, std::memory_order_acq_rel);
+        return true;
+    }
+}
+
+#endif
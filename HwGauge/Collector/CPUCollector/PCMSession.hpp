@@ -0,0 +1,52 @@
+#pragma once
+#ifdef HWGAUGE_USE_INTEL_PCM
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace pcm
+{
+    class PCM;
+}
+
+namespace hwgauge
+{
+    /**
+     * 进程内共享的 PCM 会话
+     * pcm::PCM 是单例，多个采集器 (socket 级 / core 级) 共用同一次 program()，
+     * 最后一个使用者释放时才 cleanup()，避免互相重置 PMU。
+     */
+    class PCMSession
+    {
+    public:
+        // 获取共享会话，首次调用时完成 PMU 编程，失败抛出 FatalError
+        static std::shared_ptr<PCMSession> acquire();
+
+        ~PCMSession();
+
+        PCMSession(const PCMSession&) = delete;
+        PCMSession& operator=(const PCMSession&) = delete;
+
+        pcm::PCM* get() const { return instance; }
+
+        // 重新编程 PMU（计数器挂死时使用），成功后 generation 加一，
+        // 其他使用者据此重新采集基线
+        bool reset();
+        std::uint64_t generation() const { return gen.load(std::memory_order_acquire); }
+
+        // 读取计数器时持有：两阶段采集中 socket 级与 core 级采集器在不同线程同时读取，
+        // 读取与 reset() 的重新编程互斥
+        std::mutex& counterMutex() { return counters; }
+
+    private:
+        PCMSession();
+
+        pcm::PCM* instance{ nullptr };
+        std::mutex counters;
+        std::atomic<std::uint64_t> gen{ 0 };
+    };
+}
+
+#endif
@@ -0,0 +1,114 @@
+#ifdef __linux__
+#include "Powercap.hpp"
+
+#include "spdlog/spdlog.h"
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+
+namespace hwgauge
+{
+    namespace fs = std::filesystem;
+
+    namespace
+    {
+        std::string readName(const fs::path& zone)
+        {
+            std::ifstream ifs(zone / "name");
+            std::string name;
+            std::getline(ifs, name);
+            return name;
+        }
+
+        // "package-1" -> 1，其它名称返回 false
+        bool parsePackage(const std::string& name, std::size_t& socket)
+        {
+            static const std::string prefix = "package-";
+            if (name.compare(0, prefix.size(), prefix) != 0)return false;
+            char* end = nullptr;
+            socket = std::strtoul(name.c_str() + prefix.size(), &end, 10);
+            return end != name.c_str() + prefix.size();
+        }
+    }
+
+    Powercap::Powercap(const std::string& root)
+    {
+        std::error_code ec;
+        const fs::path base = fs::path(root) / "sys/class/powercap";
+        for (const auto& entry : fs::directory_iterator(base, ec))
+        {
+            // 顶层 zone (intel-rapl:N)；子 zone 在其目录下 (intel-rapl:N:M)
+            const fs::path dir = entry.path();
+            std::size_t socket;
+            if (!parsePackage(readName(dir), socket))continue;
+
+            std::vector<std::pair<fs::path, bool>> candidates = { { dir, false } };
+            for (const auto& sub : fs::directory_iterator(dir, ec))
+            {
+                if (sub.is_directory(ec) && readName(sub.path()) == "dram")
+                    candidates.emplace_back(sub.path(), true);
+            }
+            ec.clear();
+
+            for (const auto& [path, dram] : candidates)
+            {
+                Zone zone{ socket, dram, SysfsFile((path / "energy_uj").string()), 0, 0, false, {}, {}, -1.0, -1.0 };
+                if (!zone.energy.isOpen())
+                {
+                    // energy_uj 在较新内核上默认只有 root 可读
+                    spdlog::warn("[Powercap] Cannot open {}/energy_uj", path.string());
+                    continue;
+                }
+                SysfsFile range((path / "max_energy_range_uj").string());
+                long long r;
+                if (range.readInt(r) && r > 0)zone.range = static_cast<unsigned long long>(r);
+                zones.push_back(std::move(zone));
+                spdlog::info("[Powercap] Mapped socket {} {} energy to {}", socket, dram ? "DRAM" : "package", path.string());
+            }
+        }
+    }
+
+    void Powercap::update()
+    {
+        auto now = std::chrono::steady_clock::now();
+        for (auto& zone : zones)
+        {
+            long long raw;
+            if (!zone.energy.readInt(raw) || raw < 0)
+            {
+                zone.watts = -1.0;
+                continue;
+            }
+            auto cur = static_cast<unsigned long long>(raw);
+
+            if (zone.hasLast)
+            {
+                unsigned long long delta;
+                if (cur >= zone.last)delta = cur - zone.last;
+                else if (zone.range > zone.last)delta = zone.range - zone.last + cur;   // 回绕
+                else delta = 0;                                                         // 量程未知，重新取基线
+
+                double joules = static_cast<double>(delta) * 1e-6;
+                double dt = std::chrono::duration<double>(now - zone.lastTime).count();
+                zone.joules = zone.counter.add(joules);
+                zone.watts = dt > 0.0 ? joules / dt : -1.0;
+            }
+            else
+            {
+                zone.joules = zone.counter.add(0.0);
+            }
+            zone.hasLast = true;
+            zone.last = cur;
+            zone.lastTime = now;
+        }
+    }
+
+    double Powercap::value(std::size_t socket, bool dram, double Zone::* field) const
+    {
+        for (const auto& zone : zones)
+            if (zone.socket == socket && zone.dram == dram)return zone.*field;
+        return -1.0;
+    }
+}
+
+#endif
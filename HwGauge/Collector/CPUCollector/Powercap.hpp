@@ -0,0 +1,56 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "Collector/Common/SysfsFile.hpp"
+#include "Collector/Common/Energy.hpp"
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /**
+     * powercap (RAPL) 能耗计数器
+     * <root>/sys/class/powercap 下名为 package-N 的 zone 与其名为 dram 的子 zone，
+     * 分别对应 socket N 的 package / DRAM。energy_uj 到达 max_energy_range_uj 后回绕，
+     * 回绕时按量程补齐差值，而不是丢弃这一段。
+     */
+    class Powercap
+    {
+    public:
+        explicit Powercap(const std::string& root);
+
+        bool empty() const { return zones.empty(); }
+
+        // 读取所有计数器，计算区间平均功耗并累加能耗
+        void update();
+
+        // 不可用时返回 -1
+        double packagePower(std::size_t socket) const { return value(socket, false, &Zone::watts); }
+        double dramPower(std::size_t socket) const { return value(socket, true, &Zone::watts); }
+        double packageEnergy(std::size_t socket) const { return value(socket, false, &Zone::joules); }
+        double dramEnergy(std::size_t socket) const { return value(socket, true, &Zone::joules); }
+
+    private:
+        struct Zone
+        {
+            std::size_t socket;
+            bool dram;
+            SysfsFile energy;
+            unsigned long long range;   // max_energy_range_uj，0 表示未知
+            unsigned long long last;
+            bool hasLast;
+            std::chrono::steady_clock::time_point lastTime;
+            EnergyCounter counter;
+            double watts;
+            double joules;
+        };
+
+        double value(std::size_t socket, bool dram, double Zone::* field) const;
+
+        std::vector<Zone> zones;
+    };
+}
+
+#endif
@@ -0,0 +1,135 @@
+#ifdef __linux__
+#include "ProcCPU.hpp"
+
+#include "spdlog/spdlog.h"
+#include <fstream>
+
+namespace hwgauge
+{
+    namespace
+    {
+        // 读取 /proc/cpuinfo 中第一个 key 的值，找不到返回空
+        std::string cpuinfoValue(const std::string& root, const std::string& key)
+        {
+            std::ifstream ifs(root + "/proc/cpuinfo");
+            std::string line;
+            while (std::getline(ifs, line))
+            {
+                if (line.compare(0, key.size(), key) != 0)continue;
+                auto colon = line.find(':');
+                if (colon == std::string::npos)continue;
+                auto begin = line.find_first_not_of(" \t", colon + 1);
+                return begin == std::string::npos ? std::string() : line.substr(begin);
+            }
+            return {};
+        }
+    }
+
+    ProcCPU::ProcCPU(const CollectorConfig& cfg)
+        : root(cfg.hostRoot),
+          stat(cfg.hostRoot),
+          powercap(cfg.hostRoot),
+          hwmon(cfg.hostRoot + "/sys/class/hwmon")
+    {
+        modelName = cpuinfoValue(root, "model name");
+        if (modelName.empty())modelName = cpuinfoValue(root, "Hardware");   // 部分 ARM 平台
+        if (modelName.empty())modelName = "CPU";
+
+        hwmon.scan();
+        socketTemps = mapPackageTemps(hwmon);
+
+        const std::size_t sockets = stat.socketCount();
+        socketBusy.resize(sockets);
+        socketTotal.resize(sockets);
+        freqSum.resize(sockets);
+        freqCount.resize(sockets);
+
+        // 先读一轮作为基线
+        stat.update();
+        powercap.update();
+
+        if (powercap.empty())spdlog::warn("[ProcCPU] No readable powercap zones. Power and energy unavailable.");
+        spdlog::info("[ProcCPU] Initialize successfully: {} sockets, {} CPUs", sockets, stat.size());
+    }
+
+    bool ProcCPU::isIntel(const std::string& root)
+    {
+        return cpuinfoValue(root, "vendor_id") == "GenuineIntel";
+    }
+
+    std::vector<CPULabel> ProcCPU::labels()
+    {
+        std::vector<CPULabel> labels;
+        for (std::size_t s = 0; s < stat.socketCount(); ++s)
+            labels.push_back(CPULabel{ s, modelName });
+        return labels;
+    }
+
+    double ProcCPU::readTemp(std::size_t socket)
+    {
+        if (socket >= socketTemps.size() || socketTemps[socket] < 0)return -1.0;
+
+        double temp = hwmon.read(socketTemps[socket]);
+        if (temp < 0.0 && hwmon.stale())
+        {
+            // hwmon 被重新编号，重新扫描后再读一次
+            hwmon.scan();
+            socketTemps = mapPackageTemps(hwmon);
+            if (socket < socketTemps.size() && socketTemps[socket] >= 0)
+                temp = hwmon.read(socketTemps[socket]);
+        }
+        return temp;
+    }
+
+    void ProcCPU::sample(std::vector<CPULabel>& labels, std::vector<CPUMetrics>& metrics)
+    {
+        stat.update();
+        powercap.update();
+
+        // 逐 CPU 差值按 socket 汇总：利用率按 jiffies 加权，频率取平均
+        std::fill(socketBusy.begin(), socketBusy.end(), 0);
+        std::fill(socketTotal.begin(), socketTotal.end(), 0);
+        std::fill(freqSum.begin(), freqSum.end(), 0.0);
+        std::fill(freqCount.begin(), freqCount.end(), 0);
+
+        const auto& socketOf = stat.socketOf();
+        const auto& busy = stat.busyDelta();
+        const auto& total = stat.totalDelta();
+        const auto& freq = stat.frequency();
+        for (std::size_t k = 0; k < stat.size(); ++k)
+        {
+            const std::size_t s = socketOf[k];
+            socketBusy[s] += busy[k];
+            socketTotal[s] += total[k];
+            if (freq[k] >= 0.0)
+            {
+                freqSum[s] += freq[k];
+                ++freqCount[s];
+            }
+        }
+
+        for (std::size_t i = 0; i < labels.size(); ++i)
+        {
+            const std::size_t s = labels[i].index;
+            CPUMetrics& m = metrics[i];
+            m.cpuUtilization = socketTotal[s] ? 100.0 * static_cast<double>(socketBusy[s]) / static_cast<double>(socketTotal[s]) : -1.0;
+            m.cpuFrequency = freqCount[s] ? freqSum[s] / freqCount[s] : -1.0;
+            m.c0Residency = -1.0;
+            m.c6Residency = -1.0;
+            m.powerUsage = powercap.packagePower(s);
+            m.memoryReadBandwidth = -1.0;
+            m.memoryWriteBandwidth = -1.0;
+            m.memoryPowerUsage = powercap.dramPower(s);
+            m.temperature = readTemp(s);
+            m.ipc = -1.0;
+            m.l3HitRatio = -1.0;
+            m.l3Misses = -1.0;
+            m.upiUtilization = -1.0;
+            m.ioBandwidth = -1.0;
+            m.energyJoules = powercap.packageEnergy(s);
+            m.memoryEnergyJoules = powercap.dramEnergy(s);
+        }
+    }
+}
+
+#endif
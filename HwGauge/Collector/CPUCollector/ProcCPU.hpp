@@ -0,0 +1,55 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "CPUMetrics.hpp"
+#include "ProcCPUStat.hpp"
+#include "Powercap.hpp"
+#include "Collector/Common/Config.hpp"
+#include "Collector/Common/Hwmon.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /**
+     * 不依赖 PCM 的 socket 级 CPU 采集，用于 AMD / ARM 等 PCM 不支持的平台
+     * 利用率来自 /proc/stat，频率来自 cpufreq，package / DRAM 功耗与能耗来自 powercap，
+     * 温度来自 hwmon；PCM 特有的指标（C-state、带宽、IPC 等）为 -1。
+     */
+    class ProcCPU
+    {
+    public:
+        explicit ProcCPU(const CollectorConfig& cfg);
+
+        ProcCPU(const ProcCPU&) = delete;
+        ProcCPU& operator=(const ProcCPU&) = delete;
+
+        std::string name() { return "cpu"; }
+
+        std::vector<CPULabel>   labels();
+        void sample(std::vector<CPULabel>& labels, std::vector<CPUMetrics>& metrics);
+
+        // /proc/cpuinfo 的 vendor_id 是否为 GenuineIntel，用于自动选择 PCM
+        static bool isIntel(const std::string& root);
+
+    private:
+        double readTemp(std::size_t socket);
+
+        std::string root;
+        ProcCPUStat stat;
+        Powercap powercap;
+        Hwmon hwmon;
+        std::vector<long> socketTemps;      // socket -> hwmon 传感器下标
+
+        std::string modelName;
+
+        // 按 socket 汇总的复用缓冲
+        std::vector<std::uint64_t> socketBusy, socketTotal;
+        std::vector<double> freqSum;
+        std::vector<unsigned> freqCount;
+    };
+}
+
+#endif
@@ -0,0 +1,36 @@
+#ifdef __linux__
+#include "ProcCPUCore.hpp"
+
+#include "spdlog/spdlog.h"
+
+namespace hwgauge
+{
+    ProcCPUCore::ProcCPUCore(const CollectorConfig& cfg)
+        : stat(cfg.hostRoot)
+    {
+        stat.update();   // 基线
+        spdlog::info("[ProcCPUCore] Initialize successfully: {} CPUs", stat.size());
+    }
+
+    std::vector<CPUCoreLabel> ProcCPUCore::labels()
+    {
+        std::vector<CPUCoreLabel> labels;
+        labels.reserve(stat.size());
+        for (std::size_t k = 0; k < stat.size(); ++k)
+            labels.push_back(CPUCoreLabel{ stat.ids()[k], stat.socketOf()[k] });
+        return labels;
+    }
+
+    void ProcCPUCore::sample(std::vector<CPUCoreLabel>& labels, std::vector<CPUCoreMetrics>& metrics)
+    {
+        stat.update();
+
+        // 标签与 stat 的 CPU 顺序一致
+        const auto& util = stat.utilization();
+        const auto& freq = stat.frequency();
+        for (std::size_t k = 0; k < labels.size(); ++k)
+            metrics[k] = CPUCoreMetrics{ util[k], freq[k], -1.0, -1.0, -1.0, -1.0, -1.0, -1.0 };
+    }
+}
+
+#endif
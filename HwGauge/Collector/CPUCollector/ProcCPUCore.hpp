@@ -0,0 +1,32 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "CPUCoreMetrics.hpp"
+#include "ProcCPUStat.hpp"
+#include "Collector/Common/Config.hpp"
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /* 不依赖 PCM 的逐 CPU 采集：利用率与频率，其余字段为 -1 */
+    class ProcCPUCore
+    {
+    public:
+        explicit ProcCPUCore(const CollectorConfig& cfg);
+
+        ProcCPUCore(const ProcCPUCore&) = delete;
+        ProcCPUCore& operator=(const ProcCPUCore&) = delete;
+
+        std::string name() { return "cpu_core"; }
+
+        std::vector<CPUCoreLabel>   labels();
+        void sample(std::vector<CPUCoreLabel>& labels, std::vector<CPUCoreMetrics>& metrics);
+
+    private:
+        ProcCPUStat stat;
+    };
+}
+
+#endif
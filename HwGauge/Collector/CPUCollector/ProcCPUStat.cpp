@@ -0,0 +1,156 @@
+#ifdef __linux__
+#include "ProcCPUStat.hpp"
+#include "Collector/Common/Exception.hpp"
+
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace hwgauge
+{
+    namespace
+    {
+        // 跳过空格后解析一个无符号整数，失败时返回 nullptr
+        const char* parseU64(const char* p, const char* end, std::uint64_t& value)
+        {
+            while (p < end && *p == ' ')++p;
+            auto [ptr, ec] = std::from_chars(p, end, value);
+            return ec == std::errc() ? ptr : nullptr;
+        }
+
+        // "cpu12 a b c ..." 的 id 与 (忙碌, 总) jiffies，line 指向 "cpu" 之后
+        const char* parseCpuLine(const char* p, const char* end, std::uint64_t& id, std::uint64_t& busy, std::uint64_t& total)
+        {
+            auto [ptr, ec] = std::from_chars(p, end, id);
+            if (ec != std::errc())return nullptr;
+            p = ptr;
+
+            // user nice system idle iowait irq softirq steal（guest 已计入 user）
+            std::uint64_t v[8] = {};
+            for (int k = 0; k < 8 && p; ++k)
+            {
+                if (p >= end)break;   // 旧内核字段较少
+                p = parseU64(p, end, v[k]);
+            }
+            if (!p)return nullptr;
+            std::uint64_t idle = v[3] + v[4];
+            busy = v[0] + v[1] + v[2] + v[5] + v[6] + v[7];
+            total = busy + idle;
+            return p;
+        }
+    }
+
+    ProcCPUStat::ProcCPUStat(const std::string& root)
+    {
+        if (!statFile.open(root + "/proc/stat"))
+            throw RecoverableError("[ProcCPUStat] Cannot open " + root + "/proc/stat");
+
+        // 第一次解析只为确定 CPU 集合
+        if (!statFile.readText(buf))throw RecoverableError("[ProcCPUStat] Cannot read /proc/stat");
+        const char* p = buf.data();
+        const char* end = p + buf.size();
+        while (p < end)
+        {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (!eol)eol = end;
+            std::uint64_t id, busy, total;
+            if (eol - p > 3 && std::memcmp(p, "cpu", 3) == 0 && p[3] >= '0' && p[3] <= '9' &&
+                parseCpuLine(p + 3, eol, id, busy, total))
+                cpuIds.push_back(static_cast<std::size_t>(id));
+            p = eol + 1;
+        }
+        if (cpuIds.empty())throw RecoverableError("[ProcCPUStat] No CPUs found in /proc/stat");
+
+        const std::size_t n = cpuIds.size();
+        position.assign(*std::max_element(cpuIds.begin(), cpuIds.end()) + 1, -1);
+        cpuSocket.resize(n);
+        freqFiles.resize(n);
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            position[cpuIds[k]] = static_cast<long>(k);
+
+            const std::string dir = root + "/sys/devices/system/cpu/cpu" + std::to_string(cpuIds[k]);
+            SysfsFile package(dir + "/topology/physical_package_id");
+            long long socket = 0;
+            // ARM 上可能为 -1，统一归入 socket 0
+            if (!package.readInt(socket) || socket < 0)socket = 0;
+            cpuSocket[k] = static_cast<std::size_t>(socket);
+            sockets = std::max(sockets, cpuSocket[k] + 1);
+
+            freqFiles[k].open(dir + "/cpufreq/scaling_cur_freq");
+        }
+
+        for (auto* v : { &curBusy, &curTotal, &prevBusy, &prevTotal, &dBusy, &dTotal })v->assign(n, 0);
+        seen.assign(n, 0);
+        prevSeen.assign(n, 0);
+        util.assign(n, -1.0);
+        freq.assign(n, -1.0);
+
+        auto withFreq = std::count_if(freqFiles.begin(), freqFiles.end(), [](const SysfsFile& f) { return f.isOpen(); });
+        spdlog::info("[ProcCPUStat] {} CPUs in {} sockets, cpufreq available on {}", n, sockets, withFreq);
+    }
+
+    bool ProcCPUStat::parse()
+    {
+        if (!statFile.readText(buf))return false;
+
+        std::fill(seen.begin(), seen.end(), 0);
+        const char* p = buf.data();
+        const char* end = p + buf.size();
+        std::size_t expected = 0;
+        while (p < end)
+        {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            if (!eol)eol = end;
+            if (eol - p < 4 || std::memcmp(p, "cpu", 3) != 0)break;   // cpu 行之后是 intr 等，不需要
+            if (p[3] >= '0' && p[3] <= '9')
+            {
+                std::uint64_t id, busy, total;
+                if (parseCpuLine(p + 3, eol, id, busy, total))
+                {
+                    // 通常与构造时顺序一致，直接命中；否则查表
+                    long k = (expected < cpuIds.size() && cpuIds[expected] == id) ? static_cast<long>(expected)
+                           : (id < position.size() ? position[id] : -1);
+                    if (k >= 0)
+                    {
+                        curBusy[k] = busy;
+                        curTotal[k] = total;
+                        seen[k] = 1;
+                        expected = static_cast<std::size_t>(k) + 1;
+                    }
+                }
+            }
+            p = eol + 1;
+        }
+        return true;
+    }
+
+    bool ProcCPUStat::update()
+    {
+        if (!parse())return false;
+
+        const std::size_t n = cpuIds.size();
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            bool valid = seen[k] && prevSeen[k] && curTotal[k] > prevTotal[k] && curBusy[k] >= prevBusy[k];
+            dTotal[k] = valid ? curTotal[k] - prevTotal[k] : 0;
+            dBusy[k] = valid ? curBusy[k] - prevBusy[k] : 0;
+        }
+        for (std::size_t k = 0; k < n; ++k)
+            util[k] = dTotal[k] ? 100.0 * static_cast<double>(dBusy[k]) / static_cast<double>(dTotal[k]) : -1.0;
+
+        std::swap(curBusy, prevBusy);
+        std::swap(curTotal, prevTotal);
+        std::swap(seen, prevSeen);
+
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            long long khz;
+            freq[k] = freqFiles[k].readInt(khz) ? static_cast<double>(khz) / 1000.0 : -1.0;
+        }
+        return true;
+    }
+}
+
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "Collector/Common/SysfsFile.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /**
+     * 逐 CPU 利用率 (/proc/stat) 与频率 (cpufreq/scaling_cur_freq)
+     * CPU 集合在构造时确定，/proc/stat 与各 scaling_cur_freq 常驻打开；
+     * 每轮把计数器解析进连续数组，再整体计算差值，数百个 CPU 也只是几个线性循环。
+     * 运行中离线的 CPU 读数为 -1，新上线的 CPU 不计入。
+     */
+    class ProcCPUStat
+    {
+    public:
+        // root: /proc 与 /sys 所在的根目录，默认为空即 "/"
+        explicit ProcCPUStat(const std::string& root);
+
+        // 读取一轮，返回 false 表示 /proc/stat 读取失败
+        bool update();
+
+        std::size_t size() const { return cpuIds.size(); }
+        std::size_t socketCount() const { return sockets; }
+
+        // 以下数组按构造时的 CPU 顺序排列
+        const std::vector<std::size_t>& ids() const { return cpuIds; }
+        const std::vector<std::size_t>& socketOf() const { return cpuSocket; }
+        const std::vector<std::uint64_t>& busyDelta() const { return dBusy; }     // 两轮之间的忙碌 jiffies
+        const std::vector<std::uint64_t>& totalDelta() const { return dTotal; }   // 两轮之间的总 jiffies，0 表示不可用
+        const std::vector<double>& utilization() const { return util; }           // %，首轮为 -1
+        const std::vector<double>& frequency() const { return freq; }             // MHz，不可用为 -1
+
+    private:
+        bool parse();
+
+        SysfsFile statFile;
+        std::string buf;                     // 复用的 /proc/stat 读缓冲
+
+        std::vector<std::size_t> cpuIds;
+        std::vector<std::size_t> cpuSocket;
+        std::size_t sockets{ 0 };
+        std::vector<long> position;          // cpu id -> 数组下标，-1 表示不在集合中
+
+        std::vector<SysfsFile> freqFiles;
+
+        std::vector<std::uint64_t> curBusy, curTotal, prevBusy, prevTotal, dBusy, dTotal;
+        std::vector<char> seen, prevSeen;    // 本轮 / 上一轮是否读到该 CPU
+        std::vector<double> util, freq;
+    };
+}
+
+#endif
@@ -32,10 +32,14 @@ namespace hwgauge
         
         virtual ~ClusterCollector() = default;
 
-        void collect(const std::string& cur_time) override
+        void capture(const Tick&) override
         {
-            auto metric_list = sample(label_list);
+            metric_list.resize(label_list.size());
+            sample(label_list, metric_list);
+        }
 
+        void publish(const Tick&) override
+        {
             if(outTer) {
                 for(size_t i=0; i<label_list.size(); i++) 
                     printMetric(label_list[i], metric_list[i]);
@@ -44,11 +48,12 @@ namespace hwgauge
 
         std::string name() override { return impl->name(); }
         std::vector<ClusterLabel> labels() { return impl->labels(); }
-        std::vector<ClusterMetrics> sample(std::vector<ClusterLabel>& labels) { return impl->sample(labels); }
+        void sample(std::vector<ClusterLabel>& labels, std::vector<ClusterMetrics>& metrics) { impl->sample(labels, metrics); }
 
     private:
         std::unique_ptr<ClusterImpl> impl;
         std::vector<ClusterLabel> label_list;
+        std::vector<ClusterMetrics> metric_list;
 
         bool outTer;
     };
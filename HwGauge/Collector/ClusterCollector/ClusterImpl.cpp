@@ -2,6 +2,7 @@
 
 #include "ClusterImpl.hpp"
 #include "Collector/Common/Exception.hpp"
+#include "Collector/Common/Log.hpp"
 #include <spdlog/spdlog.h>
 #include <iostream>
 #include <chrono>
@@ -76,7 +77,7 @@ namespace hwgauge
         
         if (ctx_ == nullptr || ctx_->err) {
             std::string errStr = (ctx_) ? ctx_->errstr : "can't allocate context";
-            spdlog::warn("Redis connection failed to {}:{}. Error: {}", config_.host, portInt, errStr);
+            HWGAUGE_WARN_LIMITED("Redis connection failed to {}:{}. Error: {}", config_.host, portInt, errStr);
             
             if (ctx_) {
                 redisFree(ctx_);
@@ -163,7 +164,7 @@ namespace hwgauge
         redisReply* reply = (redisReply*)redisCommand(ctx_, "SET %s %s EX %d", key.c_str(), "1", config_.ttlSeconds);
 
         if (reply == nullptr) {
-            spdlog::warn("Heartbeat failed: IO Error. Connection marked down.");
+            HWGAUGE_WARN_LIMITED("Heartbeat failed: IO Error. Connection marked down.");
             isConnected_ = false; 
             if (ctx_) { redisFree(ctx_); ctx_ = nullptr; }
             return;
@@ -182,7 +183,7 @@ namespace hwgauge
     {
         // 假设外部 sample 已经加锁
         if (!ensureConnection()) {
-            spdlog::warn("countActiveNodes: Connection lost.");
+            HWGAUGE_WARN_LIMITED("countActiveNodes: Connection lost.");
             throw RecoverableError("Connection lost while counting nodes");
         }
 
@@ -232,12 +233,11 @@ namespace hwgauge
         return count;
     }
 
-    std::vector<ClusterMetrics> ClusterImpl::sample(std::vector<ClusterLabel>& labels)
+    void ClusterImpl::sample(std::vector<ClusterLabel>&, std::vector<ClusterMetrics>& metrics)
     {
         // 全局加锁
         std::lock_guard<std::recursive_mutex> lock(redisMutex_);
 
-        std::vector<ClusterMetrics> metricsList;
         ClusterMetrics m;
 
         // 1. 检查连接
@@ -253,7 +253,7 @@ namespace hwgauge
         {
             isConnected_ = false;
             if (ctx_) { redisFree(ctx_); ctx_ = nullptr; }
-            spdlog::warn("Sampling failed: PING IO error.");
+            HWGAUGE_WARN_LIMITED("Sampling failed: PING IO error.");
             m.redisLatencyMs = -1.0;
         }
         else if (reply->type == REDIS_REPLY_ERROR)
@@ -280,8 +280,7 @@ namespace hwgauge
             m.activeNodeCount = -1.0;
             spdlog::warn("Sampling aborted during node counting: {}", e.what());
         }
-        metricsList.push_back(m);
-        return metricsList;
+        for (auto& out : metrics)out = m;
     }
 
 }
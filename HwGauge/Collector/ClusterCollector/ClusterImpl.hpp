@@ -29,7 +29,7 @@ namespace hwgauge
         std::vector<ClusterLabel> labels();
         
         // 采样逻辑 (主线程调用)
-        std::vector<ClusterMetrics> sample(std::vector<ClusterLabel>& labels);
+        void sample(std::vector<ClusterLabel>& labels, std::vector<ClusterMetrics>& metrics);
 
         // 启动心跳线程 (参数已移除，使用内部 config)
         void startHeartbeat();
@@ -0,0 +1,189 @@
+#pragma once
+
+#include "Collector/Common/Exception.hpp"
+#include "Collector/Common/Fields.hpp"
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace hwgauge
+{
+    /* 紧凑二进制写入：整数使用 varint（有符号数先做 zigzag），浮点数按小端 8 字节 */
+    class BinaryWriter
+    {
+    public:
+        explicit BinaryWriter(std::string& out_) : out(out_) {}
+
+        template<typename T>
+        void put(T value)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                out.push_back(value ? 1 : 0);
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                double d = static_cast<double>(value);
+                std::uint64_t bits;
+                std::memcpy(&bits, &d, sizeof(bits));
+                for (int i = 0; i < 8; ++i)out.push_back(static_cast<char>((bits >> (8 * i)) & 0xFF));
+            }
+            else if constexpr (std::is_signed_v<T>)
+            {
+                std::int64_t v = static_cast<std::int64_t>(value);
+                putVarint((static_cast<std::uint64_t>(v) << 1) ^ static_cast<std::uint64_t>(v >> 63));
+            }
+            else
+            {
+                putVarint(static_cast<std::uint64_t>(value));
+            }
+        }
+
+        void put(const std::string& value)
+        {
+            putVarint(value.size());
+            out.append(value);
+        }
+
+        void putVarint(std::uint64_t v)
+        {
+            while (v >= 0x80)
+            {
+                out.push_back(static_cast<char>((v & 0x7F) | 0x80));
+                v >>= 7;
+            }
+            out.push_back(static_cast<char>(v));
+        }
+
+    private:
+        std::string& out;
+    };
+
+    /* 紧凑二进制读取，数据不完整时抛出 RecoverableError */
+    class BinaryReader
+    {
+    public:
+        BinaryReader(const char* data_, std::size_t size_) : data(data_), size(size_), pos(0) {}
+        explicit BinaryReader(const std::string& s) : BinaryReader(s.data(), s.size()) {}
+
+        template<typename T>
+        void get(T& value)
+        {
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                need(1);
+                value = data[pos++] != 0;
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                need(8);
+                std::uint64_t bits = 0;
+                for (int i = 0; i < 8; ++i)
+                    bits |= static_cast<std::uint64_t>(static_cast<unsigned char>(data[pos + i])) << (8 * i);
+                pos += 8;
+                double d;
+                std::memcpy(&d, &bits, sizeof(d));
+                value = static_cast<T>(d);
+            }
+            else if constexpr (std::is_signed_v<T>)
+            {
+                std::uint64_t u = getVarint();
+                value = static_cast<T>(static_cast<std::int64_t>((u >> 1) ^ (~(u & 1) + 1)));
+            }
+            else
+            {
+                value = static_cast<T>(getVarint());
+            }
+        }
+
+        void get(std::string& value)
+        {
+            std::uint64_t len = getVarint();
+            need(len);
+            value.assign(data + pos, static_cast<std::size_t>(len));
+            pos += static_cast<std::size_t>(len);
+        }
+
+        std::uint64_t getVarint()
+        {
+            std::uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7)
+            {
+                need(1);
+                auto byte = static_cast<unsigned char>(data[pos++]);
+                v |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+                if (!(byte & 0x80))return v;
+            }
+            throw RecoverableError("[Codec] Malformed varint");
+        }
+
+        bool eof() const { return pos >= size; }
+
+    private:
+        void need(std::uint64_t n) const
+        {
+            if (n > size - pos)throw RecoverableError("[Codec] Unexpected end of payload");
+        }
+
+        const char* data;
+        std::size_t size;
+        std::size_t pos;
+    };
+
+    /* 基于 Fields<T> 的通用编解码 */
+    template<typename T>
+    inline void encodeFields(BinaryWriter& w, const T& v)
+    {
+        Fields<T>::visit(v, [&w](const char*, const auto& field, auto...) { w.put(field); });
+    }
+
+    template<typename T>
+    inline void decodeFields(BinaryReader& r, T& v)
+    {
+        Fields<T>::visit(v, [&r](const char*, auto& field, auto...) { r.get(field); });
+    }
+
+    /* 一批 labels + metrics 的负载格式：版本号, 设备数, (label, metric)*
+       任一结构的字段变化时递增版本号，新旧版本不能混用 */
+    constexpr std::uint8_t kPayloadVersion = 4;
+
+    template<typename LabelT, typename MetricT>
+    inline void encodePayload(std::string& out,
+                              const std::vector<LabelT>& labels,
+                              const std::vector<MetricT>& metrics)
+    {
+        out.clear();
+        BinaryWriter w(out);
+        w.put(kPayloadVersion);
+        w.putVarint(labels.size());
+        for (std::size_t i = 0; i < labels.size(); ++i)
+        {
+            encodeFields(w, labels[i]);
+            encodeFields(w, metrics[i]);
+        }
+    }
+
+    template<typename LabelT, typename MetricT>
+    inline void decodePayload(const std::string& in,
+                              std::vector<LabelT>& labels,
+                              std::vector<MetricT>& metrics)
+    {
+        BinaryReader r(in);
+        std::uint8_t version = 0;
+        r.get(version);
+        if (version != kPayloadVersion)throw RecoverableError("[Codec] Unsupported payload version " + std::to_string(version));
+
+        std::uint64_t count = r.getVarint();
+        if (count > in.size())throw RecoverableError("[Codec] Invalid device count in payload");
+        labels.resize(static_cast<std::size_t>(count));
+        metrics.resize(static_cast<std::size_t>(count));
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            decodeFields(r, labels[i]);
+            decodeFields(r, metrics[i]);
+        }
+    }
+}
@@ -2,6 +2,8 @@
 
 #include <string>
 #include <optional>
+#include <memory>
+#include <vector>
 
 #ifdef HWGAUGE_USE_PROMETHEUS
 #include <prometheus/registry.h>
@@ -59,16 +61,64 @@ namespace hwgauge
         std::string password;
         int ttlSeconds;
     };
+
+    /*Redis Stream 配置结构体（复用 ClusterConfig 中的 Redis 地址）*/
+    struct StreamConfig
+    {
+        bool enable=false;
+        std::string key;          // Stream 键名
+        long long maxLen=100000;  // 近似上限 (XADD MAXLEN ~)
+
+        // 聚合器 (XREADGROUP)
+        std::string group;        // 消费组
+        std::string consumer;     // 消费者名称
+        int batchSize=512;        // 单次读取的最大条数
+        int blockMs=1000;         // 无数据时的阻塞等待时间
+        int claimIdleMs=60000;    // 其他消费者超过该时长未确认的记录由本消费者接管 (XAUTOCLAIM)
+    };
 #endif
 
+    /*机架级 relay 配置*/
+    struct RelayConfig
+    {
+        std::string listen;       // 作为 relay 监听的地址 (host:port)，为空时不启用
+        std::string upstream;     // 作为子节点推送的 relay 地址 (host:port)，为空时不启用
+        bool rollup=true;         // 是否按转发周期求平均，否则原样转发每一批
+    };
+
+    /*本地阈值告警配置*/
+    struct AlertConfig
+    {
+        std::vector<std::string> rules;   // "name: expression op threshold [for N|Ns] [clear value]"，为空时不启用
+        std::string file;         // 追加写入告警事件的文件，为空时不写
+        std::string command;      // 状态变化时执行的命令 (/bin/sh -c)，为空时不执行
+        std::string webhook;      // 状态变化时 POST JSON 的地址 http://host:port/path，为空时不发送
+    };
+
     /*Collector配置*/
     struct CollectorConfig
     {
         bool outTer=true;
         bool outFile=false;
         std::string filepath;
+        std::string nodeId;
+        // /proc 与 /sys 所在的根目录前缀，为空即 "/"（容器中挂载宿主机时为 /host 等）
+        std::string hostRoot;
+        // 批量数据下游 (Redis Stream 等)，为空时不编码
+        std::vector<std::shared_ptr<class BatchSink>> batchSinks;
+        // 作业能耗统计，为空时不记录
+        std::shared_ptr<class JobTracker> jobTracker;
+        // 把周期内的原始子样本 (GPU 功率/利用率采样缓冲区) 也发送给批量下游
+        bool rawSamples=false;
+        // GPU 进程统计时每块 GPU 导出的进程数上限（按显存占用排序）
+        std::size_t gpuProcessTopN=5;
+        // 派生指标定义 "name=expression"，为空时不启用
+        std::vector<std::string> derivedMetrics;
+        AlertConfig alertConfig;
+        RelayConfig relayConfig;
 #ifdef HWGAUGE_USE_CLUSTER
         ClusterConfig clusterConfig;
+        StreamConfig streamConfig;
 #endif
 #ifdef HWGAUGE_USE_PROMETHEUS
         bool pmEnable = false;
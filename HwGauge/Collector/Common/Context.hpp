@@ -1,32 +1,159 @@
 #pragma once
 
+#include "Collector/Common/FieldTable.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
 #include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
 
 namespace hwgauge
 {
-    /*共享的上下文结构*/
-    struct SharedPowerContext {
-        std::optional<double> cpu_power;
-        std::optional<double> memory_power;
-        std::optional<double> gpu_power;
-        std::optional<double> npu_power;
-
-        // 重置函数
-        inline void reSet() {
-            cpu_power.reset();
-            memory_power.reset();
-            gpu_power.reset();
-            npu_power.reset();
-        }
-
-        // 计算总和的辅助函数
-        inline double getTotalPower() const {
-            return cpu_power.value_or(0.0) + 
-                memory_power.value_or(0.0) +
-                gpu_power.value_or(0.0) + 
-                npu_power.value_or(0.0);
-        }
+    /* 汇总到整机的功率来源 */
+    enum class PowerSource : unsigned
+    {
+        Cpu,
+        Memory,
+        Gpu,
+        Npu,
+        Count
+    };
+
+    constexpr unsigned powerBit(PowerSource source) { return 1u << static_cast<unsigned>(source); }
+    constexpr unsigned kAllPowerSources = (1u << static_cast<unsigned>(PowerSource::Count)) - 1;
+    // 各采集器本轮的指标视图，派生指标读取
+    constexpr unsigned kMetricViews = 1u << 16;
+
+    /* 某个采集器本轮指标的只读视图：count 个 stride 字节的结构，数值字段按 fields 中的偏移读取 */
+    struct MetricView
+    {
+        std::string_view source;       // 采集器名称（cpu / gpu / sys ...）
+        const char* data = nullptr;
+        std::size_t count = 0;
+        std::size_t stride = 0;
+        const FieldTable* fields = nullptr;
+        const std::string* devices = nullptr;   // count 个设备标识（例如 gpu{index=0}），可为空
     };
 
-    inline SharedPowerContext sharedPower; // 定义全局共享上下文，注意要加inline以避免多重定义问题
-} 
\ No newline at end of file
+    /**
+     * 一轮采集的共享上下文，由调度方（Exposer、基准测试）持有，通过 Tick::context 传给采集器
+     * 每个来源一个独立的原子槽位，多个采集器在不同线程同时写入不需要加锁；另有各采集器本轮指标的视图。
+     * 读取方（SYS 汇总整机功率、派生指标）看到的是否完整取决于顺序：采集器通过 ContextDeps 声明提供 / 读取的来源，
+     * Exposer 据此把提供者的 publish 排在读取者之前，与加入顺序无关
+     */
+    class TickContext
+    {
+    public:
+        // 开始新的一轮：清除上一轮的功率；能耗保留最后一次的值，某个采集器本轮失败时总能耗仍保持单调
+        // 只能在没有采集器运行时调用
+        void begin(std::uint64_t seq)
+        {
+            for (auto& slot : slots)
+            {
+                slot.power.store(0.0, std::memory_order_relaxed);
+                slot.contributions.store(0, std::memory_order_relaxed);
+            }
+            viewCount.store(0, std::memory_order_relaxed);
+            current.store(seq, std::memory_order_release);
+        }
+
+        std::uint64_t seq() const { return current.load(std::memory_order_acquire); }
+
+        // 累加本轮功率，同一来源可由多个采集器提供
+        void addPower(PowerSource source, double watts)
+        {
+            auto& slot = at(source);
+            double old = slot.power.load(std::memory_order_relaxed);
+            while (!slot.power.compare_exchange_weak(old, old + watts, std::memory_order_relaxed)) {}
+            slot.contributions.fetch_add(1, std::memory_order_release);
+        }
+
+        void setEnergy(PowerSource source, double joules)
+        {
+            at(source).energy.store(joules, std::memory_order_release);
+        }
+
+        // 本轮没有采集器提供该来源时为空
+        std::optional<double> power(PowerSource source) const
+        {
+            auto& slot = at(source);
+            if (slot.contributions.load(std::memory_order_acquire) == 0)return std::nullopt;
+            return slot.power.load(std::memory_order_relaxed);
+        }
+
+        double energy(PowerSource source) const
+        {
+            return at(source).energy.load(std::memory_order_acquire);
+        }
+
+        double totalPower() const
+        {
+            double total = 0.0;
+            for (unsigned s = 0; s < kSlots; s++)total += power(static_cast<PowerSource>(s)).value_or(0.0);
+            return total;
+        }
+
+        double totalEnergy() const
+        {
+            double total = 0.0;
+            for (unsigned s = 0; s < kSlots; s++)total += energy(static_cast<PowerSource>(s));
+            return total;
+        }
+
+        // publish 时登记本轮指标，source、metrics 与 devices 需保持到本轮结束；超过 kMaxViews 个时忽略
+        template<typename M>
+        void addMetrics(std::string_view source, const std::vector<M>& metrics, const std::vector<std::string>* devices = nullptr)
+        {
+            std::size_t i = viewCount.fetch_add(1, std::memory_order_acq_rel);
+            if (i >= kMaxViews)return;
+            const std::string* ids = devices && devices->size() == metrics.size() ? devices->data() : nullptr;
+            views[i] = MetricView{ source, reinterpret_cast<const char*>(metrics.data()), metrics.size(), sizeof(M), &FieldTable::of<M>(), ids };
+        }
+
+        // 读取方按 kMetricViews 排在所有登记者之后，本轮没有登记（采集失败）时为空
+        const MetricView* metrics(std::string_view source) const
+        {
+            std::size_t n = std::min<std::size_t>(viewCount.load(std::memory_order_acquire), kMaxViews);
+            for (std::size_t i = 0; i < n; i++)
+                if (views[i].source == source)return &views[i];
+            return nullptr;
+        }
+
+        // 本轮已登记的数据源名称，逗号分隔，只用于诊断信息
+        std::string sourceNames() const
+        {
+            std::string names;
+            std::size_t n = std::min<std::size_t>(viewCount.load(std::memory_order_acquire), kMaxViews);
+            for (std::size_t i = 0; i < n; i++)
+            {
+                if (!names.empty())names += ", ";
+                names += views[i].source;
+            }
+            return names;
+        }
+
+    private:
+        static constexpr unsigned kSlots = static_cast<unsigned>(PowerSource::Count);
+        static constexpr std::size_t kMaxViews = 32;
+
+        // 每个槽位独占缓存行，不同来源的写入互不干扰
+        struct alignas(64) Slot
+        {
+            std::atomic<double> power{ 0.0 };
+            std::atomic<std::uint32_t> contributions{ 0 };
+            std::atomic<double> energy{ 0.0 };
+        };
+
+        Slot& at(PowerSource source) { return slots[static_cast<std::size_t>(source)]; }
+        const Slot& at(PowerSource source) const { return slots[static_cast<std::size_t>(source)]; }
+
+        Slot slots[kSlots];
+        std::atomic<std::uint64_t> current{ 0 };
+        MetricView views[kMaxViews];
+        std::atomic<std::size_t> viewCount{ 0 };
+    };
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "Collector/Common/Exception.hpp"
+
+#include <charconv>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace hwgauge
+{
+    /**
+     * 逐字段读取 CsvLogger 写出的一行，按 formatRow 的顺序调用 get。
+     * 带引号的字段去掉引号（"" 还原为 "），字段缺失、多余或数字格式错误时抛出 RecoverableError。
+     */
+    class CsvFieldReader
+    {
+    public:
+        explicit CsvFieldReader(std::string_view line_) : line(line_), pos(0)
+        {
+            if (!line.empty() && line.back() == '\r')line.remove_suffix(1);
+        }
+
+        template<typename T>
+        void get(T& value)
+        {
+            bool quoted = false;
+            std::string_view field = next(quoted);
+            if constexpr (std::is_same_v<T, std::string>)
+            {
+                value.assign(field.data(), field.size());
+                if (quoted)
+                {
+                    // 还原转义的引号
+                    for (std::size_t i = value.find("\"\""); i != std::string::npos; i = value.find("\"\"", i + 1))
+                        value.erase(i, 1);
+                }
+            }
+            else
+            {
+                const char* end = field.data() + field.size();
+                auto [ptr, ec] = std::from_chars(field.data(), end, value);
+                if (ec != std::errc() || ptr != end)
+                    throw RecoverableError("CSV field is not a number: " + std::string(field));
+            }
+        }
+
+        // 整行读完后调用，检查没有多余的字段
+        void finish() const
+        {
+            if (pos <= line.size())throw RecoverableError("CSV row has more fields than expected");
+        }
+
+    private:
+        std::string_view next(bool& quoted)
+        {
+            if (pos > line.size())throw RecoverableError("CSV row has fewer fields than expected");
+
+            quoted = pos < line.size() && line[pos] == '"';
+            std::string_view field;
+            if (quoted)
+            {
+                std::size_t close = pos + 1;
+                while (true)
+                {
+                    close = line.find('"', close);
+                    if (close == std::string_view::npos)throw RecoverableError("Unterminated quote in CSV row");
+                    if (close + 1 < line.size() && line[close + 1] == '"') { close += 2; continue; }
+                    break;
+                }
+                field = line.substr(pos + 1, close - pos - 1);
+                pos = close + 1;
+                if (pos < line.size() && line[pos] != ',')throw RecoverableError("Unexpected character after quoted CSV field");
+            }
+            else
+            {
+                std::size_t comma = line.find(',', pos);
+                if (comma == std::string_view::npos)comma = line.size();
+                field = line.substr(pos, comma - pos);
+                pos = comma;
+            }
+            // 跳过逗号；最后一个字段之后 pos 为 size + 1
+            pos++;
+            return field;
+        }
+
+        std::string_view line;
+        std::size_t pos;
+    };
+}
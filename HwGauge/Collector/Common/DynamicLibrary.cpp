@@ -0,0 +1,56 @@
+#include "DynamicLibrary.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <dlfcn.h>
+#endif
+
+namespace hwgauge
+{
+    DynamicLibrary::DynamicLibrary(const std::vector<std::string>& names)
+    {
+        for (const std::string& name : names)
+        {
+            if (name.empty())continue;
+#ifdef _WIN32
+            handle = reinterpret_cast<void*>(LoadLibraryA(name.c_str()));
+            if (!handle)lastError = name + ": error " + std::to_string(GetLastError());
+#else
+            // RTLD_LOCAL：厂商库的符号不进入全局命名空间，避免与其他依赖冲突
+            handle = dlopen(name.c_str(), RTLD_NOW | RTLD_LOCAL);
+            if (!handle)
+            {
+                const char* err = dlerror();
+                lastError = err ? err : name + ": unknown error";
+            }
+#endif
+            if (handle)
+            {
+                libraryName = name;
+                lastError.clear();
+                return;
+            }
+        }
+    }
+
+    DynamicLibrary::~DynamicLibrary()
+    {
+        if (!handle)return;
+#ifdef _WIN32
+        FreeLibrary(reinterpret_cast<HMODULE>(handle));
+#else
+        dlclose(handle);
+#endif
+    }
+
+    void* DynamicLibrary::symbol(const char* symbolName) const
+    {
+        if (!handle)return nullptr;
+#ifdef _WIN32
+        return reinterpret_cast<void*>(GetProcAddress(reinterpret_cast<HMODULE>(handle), symbolName));
+#else
+        return dlsym(handle, symbolName);
+#endif
+    }
+}
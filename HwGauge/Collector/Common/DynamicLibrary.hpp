@@ -0,0 +1,52 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /**
+     * 运行时加载的共享库 (dlopen / LoadLibrary)
+     * 厂商库 (NVML、DCMI) 不在链接期依赖，同一个可执行文件可以部署到任意节点，
+     * 库不存在时 loaded() 为 false，由调用方跳过对应采集器。
+     */
+    class DynamicLibrary
+    {
+    public:
+        // 按顺序尝试 names 中的库名或路径，使用第一个加载成功的
+        explicit DynamicLibrary(const std::vector<std::string>& names);
+        ~DynamicLibrary();
+
+        DynamicLibrary(const DynamicLibrary&) = delete;
+        DynamicLibrary& operator=(const DynamicLibrary&) = delete;
+
+        bool loaded() const { return handle != nullptr; }
+        // 加载成功的库名
+        const std::string& name() const { return libraryName; }
+        // 最后一次失败的原因 (dlerror)
+        const std::string& error() const { return lastError; }
+
+        // 查找符号，不存在时返回 nullptr
+        void* symbol(const char* symbolName) const;
+
+        // 把符号解析到函数指针 fn，不存在时 fn 为 nullptr 并返回 false
+        template<typename Fn>
+        bool resolve(Fn& fn, const char* symbolName) const
+        {
+            fn = reinterpret_cast<Fn>(symbol(symbolName));
+            return fn != nullptr;
+        }
+
+    private:
+        void* handle = nullptr;
+        std::string libraryName;
+        std::string lastError;
+    };
+
+    // 旧版本驱动缺少的可选函数替换为直接返回 Status 的桩函数，调用方按"不支持"处理
+    template<auto Status, typename R, typename... Args>
+    void bindMissing(R(*&fn)(Args...))
+    {
+        fn = [](Args...) -> R { return static_cast<R>(Status); };
+    }
+}
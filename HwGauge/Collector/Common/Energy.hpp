@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+
+namespace hwgauge
+{
+    /**
+     * 功率 -> 累计能耗（梯形积分）
+     * 用于没有硬件能耗计数器的设备，结果为自 agent 启动以来的焦耳数，单调不减。
+     * 功率为 -1（不可用）的采样被跳过，下一个有效采样与上一个有效采样之间仍按梯形补齐。
+     */
+    class EnergyIntegrator
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        // 累加一个功率采样（W），返回累计焦耳数；从未有过有效采样时返回 -1
+        double update(double watts, Clock::time_point now = Clock::now())
+        {
+            if (watts < 0.0)return joules();
+            if (hasLast)
+            {
+                double dt = std::chrono::duration<double>(now - lastTime).count();
+                if (dt > 0.0)total += 0.5 * (watts + lastWatts) * dt;
+            }
+            hasLast = true;
+            lastWatts = watts;
+            lastTime = now;
+            return total;
+        }
+
+        double joules() const { return hasLast ? total : -1.0; }
+
+    private:
+        bool hasLast = false;
+        double lastWatts = 0.0;
+        Clock::time_point lastTime{};
+        double total = 0.0;
+    };
+
+    /**
+     * 硬件累计能耗计数器 -> 自 agent 启动以来的焦耳数
+     * 首次读数作为基线；计数器回绕或被驱动重置（读数变小）时重新取基线，不产生负增量。
+     */
+    class EnergyCounter
+    {
+    public:
+        // 输入硬件原始累计值（J），返回累计焦耳数；raw 为 -1 时返回当前累计值
+        double update(double raw)
+        {
+            if (raw < 0.0)return joules();
+            if (hasLast && raw >= last)total += raw - last;
+            hasLast = true;
+            last = raw;
+            return total;
+        }
+
+        // 直接累加一段区间内的能耗（J），用于已经给出区间差值的接口
+        double add(double delta)
+        {
+            hasLast = true;
+            if (delta > 0.0)total += delta;
+            return total;
+        }
+
+        double joules() const { return hasLast ? total : -1.0; }
+
+    private:
+        bool hasLast = false;
+        double last = 0.0;
+        double total = 0.0;
+    };
+}
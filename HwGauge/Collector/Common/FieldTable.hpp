@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Collector/Common/Fields.hpp"
+
+#include <cstddef>
+#include <cstring>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace hwgauge
+{
+    /**
+     * 指标结构中数值字段的偏移表，由 Fields<T> 生成，每种类型一份
+     * 派生指标按名称解析一次得到 (偏移, 读取函数)，之后每轮直接按偏移读取
+     */
+    class FieldTable
+    {
+    public:
+        struct Field
+        {
+            std::string_view name;
+            std::size_t offset;
+            double (*read)(const char* p);
+        };
+
+        template<typename T>
+        static const FieldTable& of()
+        {
+            static const FieldTable table = build<T>();
+            return table;
+        }
+
+        const Field* find(std::string_view name) const
+        {
+            for (const auto& f : list)
+                if (f.name == name)return &f;
+            return nullptr;
+        }
+
+        const std::vector<Field>& fields() const { return list; }
+
+    private:
+        template<typename T>
+        static FieldTable build()
+        {
+            FieldTable table;
+            T sample{};
+            const char* base = reinterpret_cast<const char*>(&sample);
+            Fields<T>::visit(sample, [&](const char* name, auto& value, auto...) {
+                using V = std::decay_t<decltype(value)>;
+                // 字符串等非数值字段不能参与计算
+                if constexpr (std::is_arithmetic_v<V>)
+                {
+                    table.list.push_back(Field{ name, static_cast<std::size_t>(reinterpret_cast<const char*>(&value) - base),
+                        [](const char* p) {
+                            V v;
+                            std::memcpy(&v, p, sizeof(v));
+                            return static_cast<double>(v);
+                        } });
+                }
+            });
+            return table;
+        }
+
+        std::vector<Field> list;
+    };
+}
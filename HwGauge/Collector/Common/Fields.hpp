@@ -0,0 +1,29 @@
+#pragma once
+
+namespace hwgauge
+{
+    /**
+     * 结构体字段反射
+     * 每种 Label / Metrics 结构在其头文件中特化 Fields<T>，按固定顺序依次访问各字段：
+     *   template<typename T, typename F> static void visit(T& v, F&& f) { f("name", v.name); ... }
+     * T 可以是 const 或非 const 类型，编解码、汇总等通用逻辑都基于该顺序实现。
+     * 不是普通瞬时值的字段附加第三个参数 FieldKind，例如 f("health", m.health, FieldKind::Status)，
+     * 因此访问函数写作 [](const char* name, auto& field, auto... kind)，用 fieldKind(kind...) 取得类型。
+     */
+    template<typename T>
+    struct Fields;
+
+    /* 字段类型，决定 relay 按周期汇总时的合并方式 */
+    enum class FieldKind
+    {
+        Gauge,      // 瞬时值，求周期平均（默认）
+        Counter,    // 单调累计值（能耗计数器），取周期内最后一次的值
+        Min,        // 采样区间内的最小值，取周期内的最小值
+        Max,        // 采样区间内的最大值，取周期内的最大值
+        Percentile, // 采样区间内的高分位数 (p99)，取周期内的最大值：各区间 p99 的平均不是 p99，最大值是周期 p99 的近似上界
+        Status      // 状态码（健康状态等），取周期内最大即最严重的值，平均会得到不存在的状态码
+    };
+
+    constexpr FieldKind fieldKind() { return FieldKind::Gauge; }
+    constexpr FieldKind fieldKind(FieldKind kind) { return kind; }
+}
@@ -0,0 +1,207 @@
+#ifdef __linux__
+#include "Hwmon.hpp"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <charconv>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <tuple>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace hwgauge
+{
+    namespace fs = std::filesystem;
+
+    /* ---------- helpers ---------- */
+
+    namespace
+    {
+        // 读取短文本属性（name / *_label），去掉末尾换行
+        std::string readAttribute(const fs::path& path)
+        {
+            int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+            if (fd < 0)return {};
+            char buf[128];
+            ssize_t n = ::read(fd, buf, sizeof(buf));
+            ::close(fd);
+            if (n <= 0)return {};
+
+            std::string text(buf, static_cast<std::size_t>(n));
+            while (!text.empty() && (text.back() == '\n' || text.back() == ' '))text.pop_back();
+            return text;
+        }
+
+        // "temp12_input" -> kind=Temperature, index=12, sensor="temp12"
+        bool parseInput(const std::string& fname, HwmonKind& kind, long& index, std::string& sensor)
+        {
+            static const std::pair<const char*, HwmonKind> prefixes[] = {
+                {"temp", HwmonKind::Temperature},
+                {"fan", HwmonKind::Fan},
+                {"in", HwmonKind::Voltage},
+                {"curr", HwmonKind::Current},
+                {"power", HwmonKind::Power},
+            };
+            static const std::string suffix = "_input";
+
+            if (fname.size() <= suffix.size() || fname.compare(fname.size() - suffix.size(), suffix.size(), suffix) != 0)
+                return false;
+            sensor = fname.substr(0, fname.size() - suffix.size());
+
+            for (const auto& [prefix, k] : prefixes)
+            {
+                std::size_t len = std::char_traits<char>::length(prefix);
+                if (sensor.size() <= len || sensor.compare(0, len, prefix) != 0)continue;
+
+                const char* begin = sensor.data() + len;
+                const char* end = sensor.data() + sensor.size();
+                auto [ptr, ec] = std::from_chars(begin, end, index);
+                if (ec != std::errc() || ptr != end)return false;
+                kind = k;
+                return true;
+            }
+            return false;
+        }
+
+        double scaleOf(HwmonKind kind)
+        {
+            switch (kind)
+            {
+            case HwmonKind::Temperature: return 1e-3;
+            case HwmonKind::Fan:         return 1.0;
+            case HwmonKind::Voltage:     return 1e-3;
+            case HwmonKind::Current:     return 1e-3;
+            case HwmonKind::Power:       return 1e-6;
+            }
+            return 1.0;
+        }
+    }
+
+    const char* hwmonKindName(HwmonKind kind)
+    {
+        switch (kind)
+        {
+        case HwmonKind::Temperature: return "temp";
+        case HwmonKind::Fan:         return "fan";
+        case HwmonKind::Voltage:     return "in";
+        case HwmonKind::Current:     return "curr";
+        case HwmonKind::Power:       return "power";
+        }
+        return "unknown";
+    }
+
+    /* ---------- Hwmon ---------- */
+
+    Hwmon::Hwmon(std::string root)
+        : root_(std::move(root))
+    {}
+
+    void Hwmon::scan()
+    {
+        struct Found
+        {
+            HwmonSensor sensor;
+            long index;
+        };
+        std::vector<Found> found;
+
+        std::error_code ec;
+        for (const auto& entry : fs::directory_iterator(root_, ec))
+        {
+            const fs::path dir = entry.path();
+            std::string chip = readAttribute(dir / "name");
+            if (chip.empty())continue;
+
+            // hwmonN 的编号在驱动重新加载后会变化，设备名称不会
+            std::string device;
+            fs::path target = fs::read_symlink(dir / "device", ec);
+            device = ec ? chip : target.filename().string();
+            ec.clear();
+
+            for (const auto& f : fs::directory_iterator(dir, ec))
+            {
+                HwmonKind kind;
+                long index;
+                std::string sensor;
+                if (!parseInput(f.path().filename().string(), kind, index, sensor))continue;
+
+                Found item{ HwmonSensor{ chip, device, sensor, {}, kind, SysfsFile(f.path().string()) }, index };
+                if (!item.sensor.input.isOpen())continue;
+                item.sensor.label = readAttribute(dir / (sensor + "_label"));
+                if (item.sensor.label.empty())item.sensor.label = sensor;
+                found.push_back(std::move(item));
+            }
+            ec.clear();
+        }
+
+        // 目录遍历顺序不固定，按 (设备, 芯片, 类型, 编号) 排序保证传感器顺序稳定
+        std::sort(found.begin(), found.end(), [](const Found& a, const Found& b) {
+            return std::tie(a.sensor.device, a.sensor.chip, a.sensor.kind, a.index) <
+                   std::tie(b.sensor.device, b.sensor.chip, b.sensor.kind, b.index);
+        });
+
+        sensors_.clear();
+        sensors_.reserve(found.size());
+        for (auto& item : found)sensors_.push_back(std::move(item.sensor));
+
+        stale_ = false;
+        ++generation_;
+        spdlog::info("[Hwmon] Found {} sensors under {}", sensors_.size(), root_);
+    }
+
+    double Hwmon::read(std::size_t i)
+    {
+        if (i >= sensors_.size())return -1.0;
+
+        long long raw;
+        if (!sensors_[i].input.readInt(raw))
+        {
+            // ENODEV / ENXIO 等：设备已移除或 hwmon 被重新编号，需要重新扫描；
+            // EIO / ENODATA 等是传感器暂时无数据，只返回 -1
+            int err = errno;
+            if (err == ENODEV || err == ENXIO || err == ENOENT || err == EBADF)
+            {
+                if (!stale_)
+                    spdlog::warn("[Hwmon] Failed to read {}/{} ({}), rescan scheduled",
+                        sensors_[i].device, sensors_[i].sensor, std::strerror(err));
+                stale_ = true;
+            }
+            return -1.0;
+        }
+        return static_cast<double>(raw) * scaleOf(sensors_[i].kind);
+    }
+
+    std::vector<long> mapPackageTemps(const Hwmon& hwmon)
+    {
+        std::vector<long> result;
+        const auto& sensors = hwmon.sensors();
+        for (std::size_t i = 0; i < sensors.size(); ++i)
+        {
+            const auto& s = sensors[i];
+            if (s.kind != HwmonKind::Temperature || s.chip != "coretemp")continue;
+            if (s.label.compare(0, 11, "Package id ") != 0)continue;
+
+            char* end = nullptr;
+            unsigned long socketId = std::strtoul(s.label.c_str() + 11, &end, 10);
+            if (end == s.label.c_str() + 11)continue;
+            if (socketId >= result.size())result.resize(socketId + 1, -1);
+            result[socketId] = static_cast<long>(i);
+        }
+        if (!result.empty())return result;
+
+        // k10temp 没有 package 编号，传感器已按设备排序，每个设备取 Tctl 作为一个 socket
+        for (std::size_t i = 0; i < sensors.size(); ++i)
+        {
+            const auto& s = sensors[i];
+            if (s.kind == HwmonKind::Temperature && s.chip == "k10temp" && s.label == "Tctl")
+                result.push_back(static_cast<long>(i));
+        }
+        return result;
+    }
+}
+
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "SysfsFile.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    enum class HwmonKind
+    {
+        Temperature,    // temp*_input, 毫摄氏度 -> °C
+        Fan,            // fan*_input,  RPM
+        Voltage,        // in*_input,   毫伏 -> V
+        Current,        // curr*_input, 毫安 -> A
+        Power           // power*_input, 微瓦 -> W
+    };
+
+    const char* hwmonKindName(HwmonKind kind);
+
+    struct HwmonSensor
+    {
+        std::string chip;       // hwmon 的 name 属性，例如 coretemp / k10temp / nct6775
+        std::string device;     // 所属设备 (device 链接目标的名称)，hwmonN 重新编号后保持不变
+        std::string sensor;     // 属性前缀，例如 temp1 / fan2 / in0
+        std::string label;      // *_label 的内容，没有时与 sensor 相同
+        HwmonKind kind;
+        SysfsFile input;
+    };
+
+    /**
+     * hwmon 传感器枚举与读取
+     * scan() 枚举 <root>/hwmon* 下所有 temp/fan/in/curr/power 输入并常驻打开；
+     * 驱动重新加载或设备热插拔会导致 hwmonN 重新编号，旧 fd 读取失败（ENODEV 等），
+     * 此时 stale() 为 true，调用方重新 scan() 并依据 generation() 重建自己的索引。
+     */
+    class Hwmon
+    {
+    public:
+        explicit Hwmon(std::string root = "/sys/class/hwmon");
+
+        void scan();
+
+        const std::vector<HwmonSensor>& sensors() const { return sensors_; }
+
+        // 读取第 i 个传感器并换算为标准单位，失败返回 -1；设备已不存在时同时标记 stale
+        double read(std::size_t i);
+
+        bool stale() const { return stale_; }
+        std::uint64_t generation() const { return generation_; }
+
+    private:
+        std::string root_;
+        std::vector<HwmonSensor> sensors_;
+        bool stale_ = false;
+        std::uint64_t generation_ = 0;
+    };
+
+    /**
+     * socket 编号 -> 封装温度传感器下标，-1 表示没有
+     * Intel: coretemp 的 "Package id N"；AMD: 每个 k10temp 设备的 Tctl（按设备地址顺序对应 socket）
+     */
+    std::vector<long> mapPackageTemps(const Hwmon& hwmon);
+}
+
+#endif
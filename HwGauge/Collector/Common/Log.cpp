@@ -0,0 +1,186 @@
+#include "Log.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <memory>
+#include <vector>
+
+#include "spdlog/async.h"
+#include "spdlog/sinks/stdout_color_sinks.h"
+
+namespace hwgauge
+{
+    namespace
+    {
+        using Clock = std::chrono::steady_clock;
+
+        constexpr char kPattern[] = "[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [tid %t] %v";
+
+        // 各调用点被抑制的日志最迟在窗口结束后这么久输出
+        constexpr std::chrono::seconds kFlushCheck{ 60 };
+
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<LogLimiter*> limiters;
+            std::vector<std::unique_ptr<LogCounter>> counters;
+            Clock::time_point countersSince = Clock::now();
+            std::atomic<Clock::duration::rep> window{ std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(3600)).count() };
+            std::atomic<Clock::duration::rep> nextFlush{ 0 };
+        };
+
+        // 不析构：静态的 LogLimiter 与 atexit 中的刷新可能晚于其他静态对象的析构
+        Registry& registry()
+        {
+            static Registry* r = new Registry();
+            return *r;
+        }
+
+        Clock::duration window()
+        {
+            return Clock::duration(registry().window.load(std::memory_order_relaxed));
+        }
+
+        // "hour" / "2 hours" / "15 min" / "40 s"
+        std::string describe(Clock::duration d)
+        {
+            long long s = std::chrono::duration_cast<std::chrono::seconds>(d).count();
+            if (s == 3600)return "hour";
+            if (s > 3600 && s % 3600 == 0)return fmt::format("{} hours", s / 3600);
+            if (s >= 60)return fmt::format("{} min", s / 60);
+            return fmt::format("{} s", std::max(s, 1LL));
+        }
+
+        const char* basename(const char* path)
+        {
+            const char* name = path;
+            for (const char* p = path; *p; ++p)
+                if (*p == '/' || *p == '\\')name = p + 1;
+            return name;
+        }
+    }
+
+    void initLogging(const LogConfig& config)
+    {
+        spdlog::init_thread_pool(std::max<std::size_t>(config.queueSize, 64), 1);
+        auto sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
+        auto logger = std::make_shared<spdlog::async_logger>(
+            "hwgauge", std::move(sink), spdlog::thread_pool(), spdlog::async_overflow_policy::overrun_oldest);
+        spdlog::set_default_logger(std::move(logger));
+        spdlog::set_pattern(kPattern);
+        spdlog::set_level(config.level);
+        spdlog::flush_every(std::chrono::seconds(1));
+
+        Clock::duration w = std::max<Clock::duration>(config.repeatWindow, std::chrono::seconds(1));
+        registry().window.store(w.count(), std::memory_order_relaxed);
+
+        // exit() 退出（FatalError 等）时也把队列中的日志写出
+        static bool registered = (std::atexit([] { spdlog::shutdown(); }), true);
+        (void)registered;
+    }
+
+    void shutdownLogging()
+    {
+        flushLogStats(true);
+        spdlog::shutdown();
+    }
+
+    LogLimiter::LogLimiter(const char* file, int line, spdlog::level::level_enum level)
+        : file(basename(file)), line(line), level(level)
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.limiters.push_back(this);
+    }
+
+    bool LogLimiter::allow(std::string_view key)
+    {
+        auto now = Clock::now();
+        std::string summary;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = windows.find(key);
+            if (it == windows.end())it = windows.emplace(std::string(key), Window{}).first;
+            Window& w = it->second;
+            if (w.open && now - w.start < window())
+            {
+                ++w.suppressed;
+                return false;
+            }
+            if (w.suppressed > 0)
+                summary = fmt::format("{} (repeated {} times in last {}, {}:{})", w.lastMessage, w.suppressed, describe(now - w.start), file, line);
+            w.open = true;
+            w.start = now;
+            w.suppressed = 0;
+        }
+        if (!summary.empty())spdlog::log(level, summary);
+        return true;
+    }
+
+    void LogLimiter::emit(std::string_view key, std::string message)
+    {
+        spdlog::log(level, message);
+        std::lock_guard<std::mutex> lock(mutex);
+        auto it = windows.find(key);
+        if (it != windows.end())it->second.lastMessage = std::move(message);
+    }
+
+    void LogLimiter::flush(Clock::time_point now, bool force)
+    {
+        std::vector<std::string> summaries;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            for (auto& entry : windows)
+            {
+                Window& w = entry.second;
+                if (!w.open || (!force && now - w.start < window()))continue;
+                if (w.suppressed > 0)
+                    summaries.push_back(fmt::format("{} (repeated {} times in last {}, {}:{})", w.lastMessage, w.suppressed, describe(now - w.start), file, line));
+                // 下一次出现时立即输出
+                w.open = false;
+                w.suppressed = 0;
+            }
+        }
+        for (const auto& summary : summaries)spdlog::log(level, summary);
+    }
+
+    LogCounter& logCounter(const std::string& name)
+    {
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        for (auto& counter : r.counters)
+            if (counter->label() == name)return *counter;
+        r.counters.push_back(std::make_unique<LogCounter>(name));
+        return *r.counters.back();
+    }
+
+    void flushLogStats(bool force)
+    {
+        Registry& r = registry();
+        auto now = Clock::now();
+        if (!force && now.time_since_epoch().count() < r.nextFlush.load(std::memory_order_relaxed))return;
+        r.nextFlush.store((now + std::min<Clock::duration>(window(), kFlushCheck)).time_since_epoch().count(), std::memory_order_relaxed);
+
+        std::vector<LogLimiter*> limiters;
+        std::string totals;
+        Clock::duration elapsed{};
+        {
+            std::lock_guard<std::mutex> lock(r.mutex);
+            limiters = r.limiters;
+            elapsed = now - r.countersSince;
+            if (force || elapsed >= window())
+            {
+                for (auto& counter : r.counters)
+                {
+                    std::uint64_t n = counter->take();
+                    if (n == 0)continue;
+                    totals += fmt::format("{}{} {}", totals.empty() ? "" : ", ", counter->label(), n);
+                }
+                r.countersSince = now;
+            }
+        }
+
+        for (LogLimiter* limiter : limiters)limiter->flush(now, force);
+        if (!totals.empty())spdlog::info("[LogStats] In last {}: {}", describe(elapsed), totals);
+    }
+}
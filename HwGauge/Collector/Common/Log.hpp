@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "spdlog/spdlog.h"
+#include "spdlog/fmt/fmt.h"
+
+namespace hwgauge
+{
+    /*日志配置*/
+    struct LogConfig
+    {
+        std::size_t queueSize = 8192;                      // 异步队列长度，满时丢弃最旧的日志，采集线程不阻塞
+        std::chrono::seconds repeatWindow{ 3600 };         // 重复日志抑制与计数汇总的窗口
+        spdlog::level::level_enum level = spdlog::level::info;
+    };
+
+    /*把默认 logger 换成有界队列的异步 logger，格式与级别不变；进程退出时自动刷新*/
+    void initLogging(const LogConfig& config);
+
+    /*输出未到期的重复日志与计数汇总，并刷新异步队列；main 返回前调用*/
+    void shutdownLogging();
+
+    /**
+     * 单个调用点的重复日志抑制（由 HWGAUGE_LOG_LIMITED 创建）
+     * 窗口内只输出第一条，其余只计数；窗口结束时输出最后一条并附上 "repeated N times in last …"。
+     * 同一调用点可以按 key（采集器名、表名等）分别计数，一个对象的持续错误不会掩盖其他对象的错误。
+     * 可在多个采样线程中同时使用。
+     */
+    class LogLimiter
+    {
+    public:
+        LogLimiter(const char* file, int line, spdlog::level::level_enum level);
+
+        LogLimiter(const LogLimiter&) = delete;
+        LogLimiter& operator=(const LogLimiter&) = delete;
+
+        // 本次是否应当输出；false 时只计数，调用方不必格式化消息
+        bool allow(std::string_view key = {});
+        // 输出并记住消息，窗口结束时的汇总使用最后一条
+        void emit(std::string_view key, std::string message);
+        // 窗口已结束且有被抑制的日志时输出汇总
+        void flush(std::chrono::steady_clock::time_point now, bool force);
+
+    private:
+        struct Window
+        {
+            bool open = false;
+            std::chrono::steady_clock::time_point start;
+            std::uint64_t suppressed = 0;
+            std::string lastMessage;
+        };
+
+        std::mutex mutex;
+        const char* file;
+        int line;
+        spdlog::level::level_enum level;
+        // key 的数量由调用方保证有界（采集器、表等）
+        std::map<std::string, Window, std::less<>> windows;
+    };
+
+    /*成功类日志（写入 N 条记录等）改为计数，每个窗口输出一次合计*/
+    class LogCounter
+    {
+    public:
+        explicit LogCounter(std::string name) : name(std::move(name)) {}
+
+        void add(std::uint64_t n) { value.fetch_add(n, std::memory_order_relaxed); }
+        // 取出并清零
+        std::uint64_t take() { return value.exchange(0, std::memory_order_relaxed); }
+        const std::string& label() const { return name; }
+
+    private:
+        std::string name;
+        std::atomic<std::uint64_t> value{ 0 };
+    };
+
+    /*同名计数器共享同一个实例，返回的引用在进程内一直有效*/
+    LogCounter& logCounter(const std::string& name);
+
+    /*采集循环每轮调用：窗口到期时输出各调用点被抑制的日志与计数器合计，未到期时只比较一次时间*/
+    void flushLogStats(bool force = false);
+}
+
+// 按调用点抑制重复日志，参数与 spdlog::log 的格式串相同
+#define HWGAUGE_LOG_LIMITED(lvl, ...) HWGAUGE_LOG_LIMITED_BY(lvl, ::std::string_view(), __VA_ARGS__)
+
+// 按调用点 + key 抑制重复日志，不同 key 的日志分别输出与计数
+#define HWGAUGE_LOG_LIMITED_BY(lvl, key, ...) \
+    do { \
+        static ::hwgauge::LogLimiter hwgaugeLogLimiter_(__FILE__, __LINE__, lvl); \
+        if (spdlog::default_logger_raw()->should_log(lvl)) \
+        { \
+            const auto& hwgaugeLogKey_ = key; \
+            if (hwgaugeLogLimiter_.allow(hwgaugeLogKey_)) \
+                hwgaugeLogLimiter_.emit(hwgaugeLogKey_, fmt::format(__VA_ARGS__)); \
+        } \
+    } while (0)
+
+#define HWGAUGE_WARN_LIMITED(...) HWGAUGE_LOG_LIMITED(spdlog::level::warn, __VA_ARGS__)
+#define HWGAUGE_ERROR_LIMITED(...) HWGAUGE_LOG_LIMITED(spdlog::level::err, __VA_ARGS__)
+#define HWGAUGE_WARN_LIMITED_BY(key, ...) HWGAUGE_LOG_LIMITED_BY(spdlog::level::warn, key, __VA_ARGS__)
+#define HWGAUGE_ERROR_LIMITED_BY(key, ...) HWGAUGE_LOG_LIMITED_BY(spdlog::level::err, key, __VA_ARGS__)
+
+// 计数代替逐轮输出的成功日志
+#define HWGAUGE_LOG_COUNT(name, n) \
+    do { \
+        static ::hwgauge::LogCounter& hwgaugeLogCounter_ = ::hwgauge::logCounter(name); \
+        hwgaugeLogCounter_.add(static_cast<std::uint64_t>(n)); \
+    } while (0)
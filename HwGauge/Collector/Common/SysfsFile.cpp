@@ -0,0 +1,90 @@
+#ifdef __linux__
+#include "SysfsFile.hpp"
+
+#include <cerrno>
+#include <charconv>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace hwgauge
+{
+    SysfsFile& SysfsFile::operator=(SysfsFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            fd = other.fd;
+            other.fd = -1;
+        }
+        return *this;
+    }
+
+    bool SysfsFile::open(const std::string& path)
+    {
+        close();
+        fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        return fd >= 0;
+    }
+
+    void SysfsFile::close()
+    {
+        if (fd >= 0)::close(fd);
+        fd = -1;
+    }
+
+    bool SysfsFile::readInt(long long& value) const
+    {
+        if (fd < 0)return false;
+
+        // sysfs 属性在每次从偏移 0 读取时重新生成内容，不需要 lseek / 重新打开
+        char buf[32];
+        ssize_t n;
+        do {
+            n = ::pread(fd, buf, sizeof(buf) - 1, 0);
+        } while (n < 0 && errno == EINTR);
+        if (n < 0)return false;
+        if (n == 0)
+        {
+            errno = ENODATA;
+            return false;
+        }
+
+        const char* begin = buf;
+        const char* end = buf + n;
+        while (begin < end && (*begin == ' ' || *begin == '\t'))++begin;
+        auto [ptr, ec] = std::from_chars(begin, end, value);
+        if (ec != std::errc() || ptr == begin)
+        {
+            errno = EINVAL;
+            return false;
+        }
+        return true;
+    }
+
+    bool SysfsFile::readText(std::string& out) const
+    {
+        if (fd < 0)return false;
+
+        // 内容可能超过上一次的长度，按块读到 EOF
+        if (out.capacity() < 4096)out.reserve(4096);
+        out.resize(out.capacity());
+        std::size_t used = 0;
+        for (;;)
+        {
+            if (used == out.size())out.resize(out.size() * 2);
+            ssize_t n = ::pread(fd, &out[used], out.size() - used, static_cast<off_t>(used));
+            if (n < 0)
+            {
+                if (errno == EINTR)continue;
+                out.clear();
+                return false;
+            }
+            if (n == 0)break;
+            used += static_cast<std::size_t>(n);
+        }
+        out.resize(used);
+        return used > 0;
+    }
+}
+
+#endif
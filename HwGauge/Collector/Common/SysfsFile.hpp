@@ -0,0 +1,37 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <string>
+
+namespace hwgauge
+{
+    /* 常驻只读的 sysfs / procfs 文件：只打开一次，之后每次用 pread 从偏移 0 重新读取 */
+    class SysfsFile
+    {
+    public:
+        SysfsFile() = default;
+        explicit SysfsFile(const std::string& path) { open(path); }
+        ~SysfsFile() { close(); }
+
+        SysfsFile(const SysfsFile&) = delete;
+        SysfsFile& operator=(const SysfsFile&) = delete;
+        SysfsFile(SysfsFile&& other) noexcept : fd(other.fd) { other.fd = -1; }
+        SysfsFile& operator=(SysfsFile&& other) noexcept;
+
+        bool open(const std::string& path);
+        void close();
+        bool isOpen() const { return fd >= 0; }
+
+        // 读取一个整数（读入栈上缓冲区后直接解析，不经过 iostream），失败返回 false 并设置 errno
+        bool readInt(long long& value) const;
+
+        // 读取全部内容到 out（复用 out 的容量），用于 /proc/stat 等较大的文件
+        bool readText(std::string& out) const;
+
+    private:
+        int fd = -1;
+    };
+}
+
+#endif
@@ -0,0 +1,91 @@
+#include "ThreadPool.hpp"
+
+namespace hwgauge
+{
+    ThreadPool::ThreadPool(std::size_t threads)
+    {
+        for (std::size_t i = 1; i < threads; ++i)
+            workers.emplace_back([this] { workerLoop(); });
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers)worker.join();
+    }
+
+    void ThreadPool::runTasks()
+    {
+        for (;;)
+        {
+            std::size_t i = next.fetch_add(1, std::memory_order_relaxed);
+            if (i >= taskCount)break;
+            try
+            {
+                taskInvoke(taskContext, i);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error)error = std::current_exception();
+            }
+        }
+    }
+
+    void ThreadPool::workerLoop()
+    {
+        std::uint64_t seen = 0;
+        for (;;)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping)return;
+                seen = generation;
+            }
+
+            runTasks();
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--busy == 0)done.notify_one();
+        }
+    }
+
+    void ThreadPool::run(std::size_t count, void* context, Invoke invoke)
+    {
+        if (count == 0)return;
+        if (workers.empty() || count == 1)
+        {
+            for (std::size_t i = 0; i < count; ++i)invoke(context, i);
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            taskContext = context;
+            taskInvoke = invoke;
+            taskCount = count;
+            next.store(0, std::memory_order_relaxed);
+            error = nullptr;
+            busy = workers.size();
+            ++generation;
+        }
+        wake.notify_all();
+
+        runTasks();
+
+        std::exception_ptr failure;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            done.wait(lock, [&] { return busy == 0; });
+            taskContext = nullptr;
+            taskInvoke = nullptr;
+            failure = error;
+        }
+        if (failure)std::rethrow_exception(failure);
+    }
+}
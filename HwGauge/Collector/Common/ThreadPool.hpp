@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace hwgauge
+{
+    /**
+     * 固定大小的小线程池，用于同一轮内并行查询多个设备
+     * parallelFor 把 [0, count) 分给工作线程与调用线程，全部完成后返回；
+     * 任务中抛出的第一个异常在调用线程中重新抛出。同一时刻只允许一个 parallelFor。
+     */
+    class ThreadPool
+    {
+    public:
+        // threads: 总并行度（含调用线程），1 表示在调用线程中顺序执行
+        explicit ThreadPool(std::size_t threads);
+        ~ThreadPool();
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        // fn 以引用传入，不经过 std::function，每轮不分配
+        template<typename Fn>
+        void parallelFor(std::size_t count, Fn& fn)
+        {
+            run(count, &fn, [](void* context, std::size_t i) { (*static_cast<Fn*>(context))(i); });
+        }
+
+        std::size_t size() const { return workers.size() + 1; }
+
+    private:
+        using Invoke = void (*)(void* context, std::size_t i);
+
+        void run(std::size_t count, void* context, Invoke invoke);
+        void workerLoop();
+        void runTasks();
+
+        std::vector<std::thread> workers;
+
+        std::mutex mutex;
+        std::condition_variable wake;       // 新任务 / 退出
+        std::condition_variable done;       // 工作线程完成本轮
+        std::uint64_t generation{ 0 };
+        std::size_t busy{ 0 };
+        bool stopping{ false };
+
+        // 当前这一轮的任务
+        void* taskContext{ nullptr };
+        Invoke taskInvoke{ nullptr };
+        std::size_t taskCount{ 0 };
+        std::atomic<std::size_t> next{ 0 };
+        std::exception_ptr error;
+    };
+}
@@ -0,0 +1,67 @@
+#include "Time.hpp"
+
+#include <charconv>
+
+namespace hwgauge
+{
+    namespace
+    {
+        bool readInt(const char*& p, const char* end, std::size_t digits, int& value)
+        {
+            if (static_cast<std::size_t>(end - p) < digits)return false;
+            auto [ptr, ec] = std::from_chars(p, p + digits, value);
+            if (ec != std::errc() || ptr != p + digits)return false;
+            p = ptr;
+            return true;
+        }
+
+        bool expect(const char*& p, const char* end, char c)
+        {
+            if (p == end || *p != c)return false;
+            p++;
+            return true;
+        }
+    }
+
+    bool parseLocalTime(std::string_view text, TimePoint& time)
+    {
+        const char* p = text.data();
+        const char* end = p + text.size();
+        int year, month, day, hour, minute, second;
+        if (!readInt(p, end, 4, year) || !expect(p, end, '-') ||
+            !readInt(p, end, 2, month) || !expect(p, end, '-') ||
+            !readInt(p, end, 2, day) || !expect(p, end, ' ') ||
+            !readInt(p, end, 2, hour) || !expect(p, end, ':') ||
+            !readInt(p, end, 2, minute) || !expect(p, end, ':') ||
+            !readInt(p, end, 2, second))
+            return false;
+        if (month < 1 || month > 12 || day < 1 || day > 31)return false;
+
+        long long micros = 0;
+        if (p != end)
+        {
+            if (*p != '.')return false;
+            long long scale = 100000;
+            for (p++; p != end; p++, scale /= 10)
+            {
+                if (*p < '0' || *p > '9')return false;
+                micros += (*p - '0') * scale;
+            }
+        }
+
+        std::tm tm{};
+        tm.tm_year = year - 1900;
+        tm.tm_mon = month - 1;
+        tm.tm_mday = day;
+        tm.tm_hour = hour;
+        tm.tm_min = minute;
+        tm.tm_sec = second;
+        tm.tm_isdst = -1;
+        std::time_t t = std::mktime(&tm);
+        if (t == static_cast<std::time_t>(-1))return false;
+
+        time = std::chrono::system_clock::from_time_t(t) +
+            std::chrono::duration_cast<TimePoint::duration>(std::chrono::microseconds(micros));
+        return true;
+    }
+}
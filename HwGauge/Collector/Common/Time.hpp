@@ -0,0 +1,82 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <ctime>
+#include <string_view>
+
+namespace hwgauge
+{
+    using TimePoint = std::chrono::system_clock::time_point;
+
+    /**
+     * 把时间点格式化为文本，只在需要文本的下游（CSV、HTTP、COPY 文本格式）使用
+     *   Local: "YYYY-MM-DD HH:MM:SS.mmm"，采集端本地时间，与旧版本 CSV 一致
+     *   Utc:   "YYYY-MM-DD HH:MM:SS.uuuuuu+00"，带时区，不受夏令时影响
+     * 秒级部分按秒缓存，同一秒内只改写小数部分，不再调用 localtime / strftime
+     */
+    class TimestampFormatter
+    {
+    public:
+        enum Zone { Local, Utc };
+
+        explicit TimestampFormatter(Zone zone_ = Local) : zone(zone_) {}
+
+        // 返回的视图在下一次调用前有效
+        std::string_view format(TimePoint time)
+        {
+            using namespace std::chrono;
+            const long long scale = zone == Utc ? 1000000 : 1000;
+            long long ticks = zone == Utc
+                ? duration_cast<microseconds>(time.time_since_epoch()).count()
+                : duration_cast<milliseconds>(time.time_since_epoch()).count();
+            long long second = ticks / scale;
+            long long fraction = ticks % scale;
+            if (fraction < 0) { fraction += scale; second--; }
+
+            if (second != cachedSecond)
+            {
+                std::time_t t = static_cast<std::time_t>(second);
+                std::tm tm{};
+#ifdef _WIN32
+                if (zone == Utc)gmtime_s(&tm, &t); else localtime_s(&tm, &t);
+#else
+                if (zone == Utc)gmtime_r(&t, &tm); else localtime_r(&t, &tm);
+#endif
+                prefix = std::strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", &tm);
+                buf[prefix] = '.';
+                cachedSecond = second;
+            }
+
+            std::size_t digits = zone == Utc ? 6 : 3;
+            for (std::size_t i = digits; i > 0; i--, fraction /= 10)
+                buf[prefix + i] = static_cast<char>('0' + fraction % 10);
+            std::size_t n = prefix + 1 + digits;
+            if (zone == Utc) { buf[n++] = '+'; buf[n++] = '0'; buf[n++] = '0'; }
+            return std::string_view(buf, n);
+        }
+
+    private:
+        Zone zone;
+        long long cachedSecond = -1;
+        std::size_t prefix = 0;
+        char buf[40] = {};
+    };
+
+    /* 自 epoch 起的微秒，批量数据在网络上传输时使用 */
+    inline std::int64_t toEpochMicros(TimePoint time)
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(time.time_since_epoch()).count();
+    }
+
+    inline TimePoint fromEpochMicros(std::int64_t us)
+    {
+        return TimePoint(std::chrono::duration_cast<TimePoint::duration>(std::chrono::microseconds(us)));
+    }
+
+    /**
+     * 解析 "YYYY-MM-DD HH:MM:SS[.fff]"，按本机时区解释（旧版本 CSV 与批量数据的时间戳）
+     * 夏令时切换时重复的一小时无法区分，取 mktime 的结果
+     */
+    bool parseLocalTime(std::string_view text, TimePoint& time);
+}
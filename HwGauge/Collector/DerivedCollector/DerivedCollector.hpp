@@ -0,0 +1,56 @@
+#pragma once
+
+#include "Collector/Base/DeviceCollector.hpp"
+#include "DerivedImpl.hpp"
+#include "DerivedDatabase.hpp"
+#include "DerivedCsvLogger.hpp"
+#include "DerivedPrometheus.hpp"
+
+#include <iostream>
+
+namespace hwgauge
+{
+#ifdef HWGAUGE_USE_POSTGRESQL
+    using DerivedDatabaseType = DerivedDatabase;
+#else
+    using DerivedDatabaseType = NullType;
+#endif
+
+#ifdef HWGAUGE_USE_PROMETHEUS
+    using DerivedPrometheusType = DerivedPrometheus;
+#else
+    using DerivedPrometheusType = NullType;
+#endif
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+    using DerivedHttpApiType = HttpApi<DerivedLabel, DerivedMetrics>;
+#else
+    using DerivedHttpApiType = NullType;
+#endif
+    // 定义别名
+    using DerivedCollector = DeviceCollector<
+        DerivedLabel, DerivedMetrics, DerivedImpl, DerivedDatabaseType, DerivedCsvLogger, DerivedPrometheusType, DerivedHttpApiType
+    >;
+    
+    // 定义特定的打印函数
+    template<>
+    inline void printMetric(const DerivedLabel& l, const DerivedMetrics& m)
+    {
+        std::cout
+            << "Derived{ "
+            << l.name << "=" << m.value
+            << " }\n";
+    }
+
+    // 派生指标只读取其他采集器的结果，不参与全局功耗统计
+    template<>
+    inline void setContextInfo(std::vector<DerivedLabel>&, std::vector<DerivedMetrics>&, TickContext&)
+    {}
+
+    template<>
+    struct ContextDeps<DerivedLabel, DerivedMetrics>
+    {
+        static constexpr unsigned provides = 0;
+        static constexpr unsigned consumes = kMetricViews;
+    };
+}
@@ -0,0 +1,37 @@
+#include "DerivedCsvLogger.hpp"
+#include <sstream>
+#include <iomanip>
+
+namespace hwgauge
+{
+    DerivedCsvLogger::DerivedCsvLogger(const std::string& filepath) : CsvLogger(filepath) 
+    {
+        auto pos = m_filepath.rfind(".csv");
+        if (pos != std::string::npos) {
+            m_filepath.insert(pos, "_derived");
+        }
+
+        m_ofs.open(m_filepath, std::ios::out | std::ios::app);
+        
+        if (!m_ofs.is_open()) {
+            spdlog::error("[DerivedCsvLogger] Failed to open file: {}", m_filepath);
+            throw FatalError("DerivedCsvLogger open failed: " + m_filepath);
+        }
+        spdlog::info("[DerivedCsvLogger] Initialized logger for: {}", m_filepath);
+    }
+
+    std::string DerivedCsvLogger::getHeader() const {
+        return "Name,Expression,Value";
+    }
+
+    std::string DerivedCsvLogger::formatRow(const DerivedLabel& l, const DerivedMetrics& m) const {
+        std::stringstream ss;
+        ss << std::setprecision(6); // 比值可能很小，用有效数字而不是固定小数位
+
+        ss << l.name << ","
+           << "\"" << l.expression << "\","
+           << m.value;
+        
+        return ss.str();
+    }
+}
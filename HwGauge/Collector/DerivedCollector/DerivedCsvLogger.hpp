@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Collector/Base/CsvLogger.hpp"
+#include "DerivedMetrics.hpp"
+
+namespace hwgauge
+{
+    class DerivedCsvLogger : public CsvLogger<DerivedLabel, DerivedMetrics>
+    {
+    public:
+        explicit DerivedCsvLogger(const std::string& filepath);
+
+    protected:
+        std::string getHeader() const override;
+        std::string formatRow(const DerivedLabel& l, const DerivedMetrics& m) const override;
+    };
+}
@@ -0,0 +1,135 @@
+#ifdef HWGAUGE_USE_POSTGRESQL
+
+#include "DerivedDatabase.hpp"
+
+#include "spdlog/spdlog.h"
+
+namespace hwgauge
+{
+    DerivedDatabase::DerivedDatabase(const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<DerivedLabel, DerivedMetrics>(config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    DerivedDatabase::DerivedDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<DerivedLabel, DerivedMetrics>(shared_conn, config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    void DerivedDatabase::setup(const std::string& table_name_prefix)
+    {
+        // 设置表名
+        metric_table_name = table_name_prefix + "_derived_metric";
+        info_table_name = table_name_prefix + "_derived_info";
+        // 创建表
+        if (!createMetricTable() || !createInfoTable())throw hwgauge::FatalError("[Database] Create Table Failed");
+        // 构建SQL模板
+        metric_copy_sql =
+            "COPY " + metric_table_name +
+            " (timestamp, name, value, seq) "
+            "FROM STDIN;";
+
+        info_insert_sql =
+            "INSERT INTO " + info_table_name +
+            " (name, expression) "
+            "VALUES ($1, $2) "
+            "ON CONFLICT (name) DO UPDATE SET "
+            "expression = EXCLUDED.expression;";
+
+        spdlog::info("[DerivedDatabase] Initialize successfully");
+    }
+
+    DerivedDatabase::~DerivedDatabase(){}
+
+    bool DerivedDatabase::createMetricTable()
+    {
+        const std::string sql =
+            "CREATE TABLE IF NOT EXISTS " + metric_table_name + " ("
+            "timestamp TIMESTAMPTZ NOT NULL,"          // 时间戳
+            "name VARCHAR(64) NOT NULL,"              // 指标名称
+            "value DOUBLE PRECISION"                  // 结果，无法计算时为 NULL
+            ");";
+
+        if (!execSQL(sql))
+        {
+            spdlog::error("[DerivedDatabase] Failed to create metric table");
+            return false;
+        }
+        if (!addSeqColumn(metric_table_name))
+        {
+            spdlog::error("[DerivedDatabase] Failed to add seq column");
+            return false;
+        }
+        spdlog::info("[DerivedDatabase] Table {} created or already exists", metric_table_name);
+        return true;
+    }
+
+    bool DerivedDatabase::createInfoTable()
+    {
+        const std::string sql =
+            "CREATE TABLE IF NOT EXISTS " + info_table_name + " ("
+            "name VARCHAR(64) NOT NULL PRIMARY KEY," // 指标名称
+            "expression TEXT"                        // 当前使用的表达式
+            ");";
+        if (!execSQL(sql))
+        {
+            spdlog::error("[DerivedDatabase] Failed to create info table");
+            return false;
+        }
+        spdlog::info("[DerivedDatabase] Table {} created or already exists", info_table_name);
+        return true;
+    }
+
+    void DerivedDatabase::writeMetric(TimePoint cur_time, std::uint64_t seq,
+                                const std::vector<DerivedLabel>& label_list,
+                                const std::vector<DerivedMetrics>& metric_list,
+                                bool)
+    {
+        if (!isConnected())throw hwgauge::FatalError("[DerivedDatabase] The database hasn't been connected before writing");
+
+        copy_buf.clear();
+        for (size_t i = 0; i < label_list.size(); ++i)
+        {
+            appendCopyField(copy_buf, cur_time);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, label_list[i].name);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, metric_list[i].value);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, seqValue(seq));
+            copy_buf += '\n';
+        }
+
+        if (!copyIn(metric_copy_sql, copy_buf))return;
+        HWGAUGE_LOG_COUNT("DerivedDatabase records", label_list.size());
+    }
+    
+    void DerivedDatabase::writeInfo(const std::vector<DerivedLabel>& label_list,
+                                bool useTransaction)
+    {
+        if (!isConnected())throw hwgauge::FatalError("[DerivedDatabase] The database hasn't been connected before writing");
+        if (useTransaction && !startTransaction())return;
+        
+        int inserted = 0;
+        for (size_t i = 0; i < label_list.size(); ++i)
+        {
+            const char* params[2] = {
+                label_list[i].name.c_str(),
+                label_list[i].expression.c_str(),
+            };
+
+            if (!execSQL(info_insert_sql, std::vector<const char*>(params, params + 2)))
+            {
+                if(useTransaction) rollbackTransaction();
+                return;
+            }
+            ++inserted;
+        }
+        if (useTransaction && !commitTransaction())return;
+        spdlog::info("[DerivedDatabase] Successfully inserted {}/{} records into {}", inserted, label_list.size(), info_table_name);
+    }
+}
+
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+
+#ifdef HWGAUGE_USE_POSTGRESQL
+
+#include "DerivedMetrics.hpp"
+#include "Collector/Common/Config.hpp"
+#include "Collector/Base/Database.hpp"
+
+namespace hwgauge
+{
+    /* 派生指标数据库操作类，以指标名称为键，--derive 的顺序变化不影响历史数据 */
+    class DerivedDatabase : public Database<DerivedLabel, DerivedMetrics>
+    {
+    public:
+        /* 构造函数 */
+        explicit DerivedDatabase(const DBConfig& config_, const std::string& table_name_prefix);
+
+        /* 构造函数：复用外部连接 */
+        DerivedDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix);
+        
+        /* 析构函数 */
+        ~DerivedDatabase();
+        
+        /* 写入派生指标 */
+        void writeMetric(TimePoint cur_time, std::uint64_t seq,
+                        const std::vector<DerivedLabel>& label_list, 
+                        const std::vector<DerivedMetrics>& metric_list,
+                        bool useTransaction = true) override;
+        
+        /* 写入指标名称与表达式 */
+        void writeInfo(const std::vector<DerivedLabel>& label_list,
+                      bool useTransaction = true) override;
+        
+    private:
+        /* 设置表名、建表并构建SQL模板 */
+        void setup(const std::string& table_name_prefix);
+
+        /* 创建指标数据表 */
+        bool createMetricTable() override;
+        /* 创建静态数据表 */
+        bool createInfoTable() override;
+
+        std::string metric_copy_sql;    // COPY 语句
+        std::string copy_buf;           // 复用的 COPY 数据缓冲
+    };
+}
+
+#endif
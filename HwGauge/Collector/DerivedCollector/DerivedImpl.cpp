@@ -0,0 +1,55 @@
+#include "DerivedImpl.hpp"
+#include "Collector/Common/Exception.hpp"
+
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+
+namespace hwgauge
+{
+    DerivedImpl::DerivedImpl(const CollectorConfig& cfg)
+    {
+        for (const auto& definition : cfg.derivedMetrics)
+        {
+            auto eq = definition.find('=');
+            if (eq == std::string::npos)
+                throw FatalError("[DerivedImpl] Expected name=expression, got \"" + definition + "\"");
+
+            // 名称用作 CSV 行、数据库与 Prometheus 标签，只允许字母、数字和下划线
+            std::string name = definition.substr(0, eq);
+            name.erase(0, name.find_first_not_of(' '));
+            name.erase(name.find_last_not_of(' ') + 1);
+            bool valid = !name.empty() && std::all_of(name.begin(), name.end(),
+                [](char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; });
+            if (!valid)
+                throw FatalError("[DerivedImpl] Invalid metric name \"" + name + "\" (letters, digits and _ only)");
+            if (std::find(names.begin(), names.end(), name) != names.end())
+                throw FatalError("[DerivedImpl] Duplicate metric name \"" + name + "\"");
+
+            expressions.emplace_back(definition.substr(eq + 1));
+            names.push_back(std::move(name));
+        }
+        if (names.empty())throw RecoverableError("[DerivedImpl] No derived metrics configured");
+        spdlog::info("[DerivedImpl] Compiled {} derived metrics", names.size());
+    }
+
+    std::vector<DerivedLabel> DerivedImpl::labels()
+    {
+        std::vector<DerivedLabel> labels;
+        labels.reserve(names.size());
+        for (std::size_t i = 0; i < names.size(); ++i)
+            labels.push_back(DerivedLabel{ i, names[i], expressions[i].text() });
+        return labels;
+    }
+
+    void DerivedImpl::evaluate(const TickContext& context, std::vector<DerivedLabel>& labels, std::vector<DerivedMetrics>& metrics)
+    {
+        for (std::size_t i = 0; i < labels.size(); ++i)
+        {
+            double value = expressions[i].evaluate(context);
+            // 与其他采集器一致，无法计算时写 -1
+            metrics[i].value = std::isfinite(value) ? value : -1.0;
+        }
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "DerivedMetrics.hpp"
+#include "Expression.hpp"
+#include "Collector/Common/Config.hpp"
+#include "Collector/Common/Context.hpp"
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /**
+     * 派生指标：按 --derive name=expression 编译的表达式，每轮在其他采集器 publish 之后求值
+     * 不读取硬件，第一阶段为空
+     */
+    class DerivedImpl
+    {
+    public:
+        // 定义格式或表达式语法错误时抛出 FatalError
+        explicit DerivedImpl(const CollectorConfig& cfg);
+
+        DerivedImpl(const DerivedImpl&) = delete;
+        DerivedImpl& operator=(const DerivedImpl&) = delete;
+
+        std::string name() { return "derived"; }
+
+        std::vector<DerivedLabel> labels();
+        void sample(std::vector<DerivedLabel>&, std::vector<DerivedMetrics>&) {}
+        void evaluate(const TickContext& context, std::vector<DerivedLabel>& labels, std::vector<DerivedMetrics>& metrics);
+
+    private:
+        std::vector<std::string> names;
+        std::vector<Expression> expressions;
+    };
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Collector/Common/Fields.hpp"
+#include <string>
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+#include <nlohmann/json.hpp>
+#endif
+
+namespace hwgauge
+{
+    struct DerivedLabel
+    {
+        std::size_t index;      // 在 --derive 中的顺序
+        std::string name;       // 指标名称，例如 gpu_util_per_watt
+        std::string expression; // 表达式原文
+    };
+
+    struct DerivedMetrics
+    {
+        double value;           // 本轮结果，输入缺失或无法计算时为 -1
+    };
+
+    template<>
+    struct Fields<DerivedLabel>
+    {
+        template<typename T, typename F>
+        static void visit(T& l, F&& f)
+        {
+            f("index", l.index);
+            f("name", l.name);
+            f("expression", l.expression);
+        }
+    };
+
+    template<>
+    struct Fields<DerivedMetrics>
+    {
+        template<typename T, typename F>
+        static void visit(T& m, F&& f)
+        {
+            f("value", m.value);
+        }
+    };
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+    inline void to_json(nlohmann::json& j, const DerivedLabel& l) {
+        j = nlohmann::json{
+            {"index", l.index},
+            {"name", l.name},
+            {"expression", l.expression}
+        };
+    }
+
+    inline void to_json(nlohmann::json& j, const DerivedMetrics& m) {
+        j = nlohmann::json{{"value", m.value}};
+    }
+#endif
+}
@@ -0,0 +1,30 @@
+#ifdef HWGAUGE_USE_PROMETHEUS
+
+#include "DerivedPrometheus.hpp"
+
+namespace hwgauge
+{
+    DerivedPrometheus::DerivedPrometheus(std::shared_ptr<prometheus::Registry> registry_)
+        : Prometheus<DerivedLabel, DerivedMetrics>(registry_)
+    {
+        family = &prometheus::BuildGauge()
+            .Name("hwgauge_derived")
+            .Help("Derived metric computed each tick from --derive expressions")
+            .Register(*registry);
+    }
+
+    void DerivedPrometheus::write(const std::vector<DerivedLabel>& label_list,const std::vector<DerivedMetrics>& metric_list)
+    {
+        if (gauges.size() != label_list.size())
+        {
+            gauges.clear();
+            for (const auto& label : label_list)
+                gauges.push_back(&family->Add({ {"name", label.name} }));
+        }
+
+        for (size_t i = 0; i < metric_list.size(); i++)
+            gauges[i]->Set(metric_list[i].value);
+    }
+}
+
+#endif
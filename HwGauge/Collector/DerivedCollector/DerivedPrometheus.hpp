@@ -0,0 +1,26 @@
+#pragma once
+
+#ifdef HWGAUGE_USE_PROMETHEUS
+
+#include "Collector/Base/Prometheus.hpp"
+#include "DerivedMetrics.hpp"
+
+namespace hwgauge
+{
+    class DerivedPrometheus:public Prometheus<DerivedLabel,DerivedMetrics>
+    {
+    public:
+        explicit DerivedPrometheus(std::shared_ptr<prometheus::Registry> registry_);
+        
+        virtual ~DerivedPrometheus() = default;
+
+        void write(const std::vector<DerivedLabel>& label_list,const std::vector<DerivedMetrics>& metric_list);
+    private:
+        prometheus::Family<prometheus::Gauge>* family;
+
+        // 每个派生指标的 Gauge 指针缓存，定义在运行期间不变，每轮只需 Set
+        std::vector<prometheus::Gauge*> gauges;
+    };
+}
+
+#endif
@@ -0,0 +1,260 @@
+#include "Expression.hpp"
+#include "Collector/Common/Exception.hpp"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace hwgauge
+{
+    namespace
+    {
+        constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+        bool isIdentStart(char c) { return std::isalpha(static_cast<unsigned char>(c)) || c == '_'; }
+        bool isIdentChar(char c) { return std::isalnum(static_cast<unsigned char>(c)) || c == '_'; }
+    }
+
+    Expression::Expression(std::string text, bool perDevice)
+        : source(std::move(text)), bareAgg(perDevice ? Agg::Each : Agg::Sum)
+    {
+        parseExpr();
+        skipSpace();
+        if (pos != source.size())fail("unexpected '" + std::string(1, source[pos]) + "'");
+        stack.resize(static_cast<std::size_t>(maxDepth));
+
+        // 不同采集器的设备无法一一对应
+        for (const auto& ref : refs)
+        {
+            if (ref.agg != Agg::Each)continue;
+            if (perDeviceSource.empty())perDeviceSource = ref.source;
+            else if (ref.source != perDeviceSource)
+                throw FatalError("[Expression] References without a function must all come from one collector (" + perDeviceSource + " and " + ref.source
+                    + "), wrap the others in sum/avg/min/max/count in \"" + source + "\"");
+        }
+    }
+
+    void Expression::fail(const std::string& what) const
+    {
+        throw FatalError("[Expression] " + what + " at position " + std::to_string(pos + 1) + " in \"" + source + "\"");
+    }
+
+    void Expression::skipSpace()
+    {
+        while (pos < source.size() && std::isspace(static_cast<unsigned char>(source[pos])))pos++;
+    }
+
+    bool Expression::accept(char c)
+    {
+        skipSpace();
+        if (pos < source.size() && source[pos] == c)
+        {
+            pos++;
+            return true;
+        }
+        return false;
+    }
+
+    void Expression::emit(Op op, std::uint32_t arg)
+    {
+        code.push_back(Instr{ op, arg });
+        // 压栈指令 +1，二元运算 -1，取负不变
+        if (op == Op::Const || op == Op::Load)depth++;
+        else if (op != Op::Neg)depth--;
+        if (depth > maxDepth)maxDepth = depth;
+    }
+
+    void Expression::parseExpr()
+    {
+        parseTerm();
+        while (true)
+        {
+            if (accept('+')) { parseTerm(); emit(Op::Add); }
+            else if (accept('-')) { parseTerm(); emit(Op::Sub); }
+            else return;
+        }
+    }
+
+    void Expression::parseTerm()
+    {
+        parseUnary();
+        while (true)
+        {
+            if (accept('*')) { parseUnary(); emit(Op::Mul); }
+            else if (accept('/')) { parseUnary(); emit(Op::Div); }
+            else return;
+        }
+    }
+
+    void Expression::parseUnary()
+    {
+        if (accept('-'))
+        {
+            parseUnary();
+            emit(Op::Neg);
+            return;
+        }
+        parsePrimary();
+    }
+
+    void Expression::parsePrimary()
+    {
+        skipSpace();
+        if (pos == source.size())fail("unexpected end of expression");
+
+        char c = source[pos];
+        if (c == '(')
+        {
+            pos++;
+            parseExpr();
+            if (!accept(')'))fail("expected ')'");
+            return;
+        }
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.')
+        {
+            const char* begin = source.c_str() + pos;
+            char* end = nullptr;
+            double value = std::strtod(begin, &end);
+            if (end == begin)fail("invalid number");
+            pos += static_cast<std::size_t>(end - begin);
+            consts.push_back(value);
+            emit(Op::Const, static_cast<std::uint32_t>(consts.size() - 1));
+            return;
+        }
+        if (!isIdentStart(c))fail("unexpected '" + std::string(1, c) + "'");
+
+        // 函数名后紧跟 '('，否则是数据源名称
+        std::size_t start = pos;
+        std::string name = parseIdent();
+        if (accept('('))
+        {
+            Agg agg;
+            if (name == "sum")agg = Agg::Sum;
+            else if (name == "avg")agg = Agg::Avg;
+            else if (name == "min")agg = Agg::Min;
+            else if (name == "max")agg = Agg::Max;
+            else if (name == "count")agg = Agg::Count;
+            else
+            {
+                pos = start;
+                fail("unknown function '" + name + "' (expected sum, avg, min, max or count)");
+            }
+            parseRef(agg);
+            if (!accept(')'))fail("expected ')'");
+            return;
+        }
+        pos = start;
+        parseRef(bareAgg);
+    }
+
+    void Expression::parseRef(Agg agg)
+    {
+        skipSpace();
+        Ref ref;
+        ref.agg = agg;
+        if (pos == source.size() || !isIdentStart(source[pos]))fail("expected <collector>.<field>");
+        ref.source = parseIdent();
+        if (pos == source.size() || source[pos] != '.')fail("expected '.' after collector name '" + ref.source + "'");
+        pos++;
+        if (pos == source.size() || !isIdentStart(source[pos]))fail("expected field name after '" + ref.source + ".'");
+        ref.field = parseIdent();
+        refs.push_back(std::move(ref));
+        emit(Op::Load, static_cast<std::uint32_t>(refs.size() - 1));
+    }
+
+    std::string Expression::parseIdent()
+    {
+        std::size_t start = pos;
+        while (pos < source.size() && isIdentChar(source[pos]))pos++;
+        return source.substr(start, pos - start);
+    }
+
+    double Expression::load(Ref& ref, const TickContext& context, std::size_t device)
+    {
+        const MetricView* view = context.metrics(ref.source);
+        if (!view)
+        {
+            // 采集器未启用或名称拼错时每轮都缺失，每个引用只提示一次
+            if (!ref.missingLogged)
+            {
+                ref.missingLogged = true;
+                std::string names = context.sourceNames();
+                spdlog::warn("[Expression] No metrics from '{}' this round for \"{}\", the result is NaN while it is missing (available: {})",
+                    ref.source, source, names.empty() ? "none" : names);
+            }
+            return kNaN;
+        }
+
+        if (view->fields != ref.table)
+        {
+            ref.table = view->fields;
+            ref.resolved = ref.table->find(ref.field);
+            if (!ref.resolved)
+            {
+                std::string names;
+                for (const auto& f : ref.table->fields())
+                {
+                    if (!names.empty())names += ", ";
+                    names += f.name;
+                }
+                spdlog::error("[Expression] {} has no numeric field '{}' in \"{}\" (available: {})", ref.source, ref.field, source, names);
+            }
+        }
+        if (!ref.resolved)return kNaN;
+
+        if (ref.agg == Agg::Each)
+        {
+            if (device >= view->count)return kNaN;
+            double v = ref.resolved->read(view->data + device * view->stride + ref.resolved->offset);
+            return v >= 0 ? v : kNaN;
+        }
+
+        double sum = 0.0;
+        double lo = std::numeric_limits<double>::infinity();
+        double hi = -lo;
+        std::size_t n = 0;
+        const char* p = view->data + ref.resolved->offset;
+        for (std::size_t i = 0; i < view->count; i++, p += view->stride)
+        {
+            double v = ref.resolved->read(p);
+            if (!(v >= 0))continue;
+            sum += v;
+            lo = std::min(lo, v);
+            hi = std::max(hi, v);
+            n++;
+        }
+
+        if (ref.agg == Agg::Count)return static_cast<double>(n);
+        if (n == 0)return kNaN;
+        switch (ref.agg)
+        {
+        case Agg::Avg: return sum / static_cast<double>(n);
+        case Agg::Min: return lo;
+        case Agg::Max: return hi;
+        default: return sum;
+        }
+    }
+
+    double Expression::evaluate(const TickContext& context, std::size_t device)
+    {
+        double* sp = stack.data();
+        for (const auto& in : code)
+        {
+            switch (in.op)
+            {
+            case Op::Const: *sp++ = consts[in.arg]; break;
+            case Op::Load: *sp++ = load(refs[in.arg], context, device); break;
+            case Op::Add: sp--; sp[-1] += sp[0]; break;
+            case Op::Sub: sp--; sp[-1] -= sp[0]; break;
+            case Op::Mul: sp--; sp[-1] *= sp[0]; break;
+            case Op::Div: sp--; sp[-1] = sp[0] != 0.0 ? sp[-1] / sp[0] : kNaN; break;
+            case Op::Neg: sp[-1] = -sp[-1]; break;
+            }
+        }
+        return stack[0];
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "Collector/Common/Context.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /**
+     * 派生指标表达式，构造时编译为后缀字节码，每轮在预分配的栈上求值
+     *   expr    := term (('+' | '-') term)*
+     *   term    := unary (('*' | '/') unary)*
+     *   unary   := '-' unary | primary
+     *   primary := number | '(' expr ')' | ref | func '(' ref ')'
+     *   ref     := source '.' field          例如 gpu.powerUsage、sys.systemPowerWatts
+     *   func    := sum | avg | min | max | count
+     * 引用按设备汇总，不带函数时为 sum；负值（-1 表示不可用）与 NaN 不参与汇总。
+     * 按设备求值（告警规则）时不带函数的引用改为读取指定设备的值，这些引用必须来自同一个采集器。
+     * 数据源本轮缺失、没有可用的设备或除数为 0 时结果为 NaN；数据源缺失时每个引用记录一次警告。
+     */
+    class Expression
+    {
+    public:
+        // 语法错误抛出 FatalError，消息包含出错位置
+        explicit Expression(std::string text, bool perDevice = false);
+
+        // 读取本轮上下文中的指标视图求值，不分配内存；device 为按设备引用读取的设备下标
+        double evaluate(const TickContext& context, std::size_t device = 0);
+
+        const std::string& text() const { return source; }
+        // 按设备引用的采集器，没有按设备引用时为空
+        const std::string& deviceSource() const { return perDeviceSource; }
+
+    private:
+        enum class Op : std::uint8_t { Const, Load, Add, Sub, Mul, Div, Neg };
+        enum class Agg : std::uint8_t { Sum, Avg, Min, Max, Count, Each };   // Each: 按设备求值时不带函数的引用
+
+        struct Instr
+        {
+            Op op;
+            std::uint32_t arg;      // Const: consts 下标，Load: refs 下标
+        };
+
+        struct Ref
+        {
+            std::string source;
+            std::string field;
+            Agg agg;
+            // 按数据源的字段表解析一次，字段表变化（不同类型的同名数据源）时重新解析
+            const FieldTable* table = nullptr;
+            const FieldTable::Field* resolved = nullptr;
+            bool missingLogged = false;     // 数据源缺失只提示一次
+        };
+
+        // 递归下降解析，边解析边输出字节码
+        void parseExpr();
+        void parseTerm();
+        void parseUnary();
+        void parsePrimary();
+        void parseRef(Agg agg);
+        std::string parseIdent();
+        void skipSpace();
+        bool accept(char c);
+        void emit(Op op, std::uint32_t arg = 0);
+        [[noreturn]] void fail(const std::string& what) const;
+
+        double load(Ref& ref, const TickContext& context, std::size_t device);
+
+        std::string source;
+        Agg bareAgg;                    // 不带函数的引用
+        std::string perDeviceSource;
+        std::size_t pos = 0;            // 只在解析时使用
+        int depth = 0;
+        int maxDepth = 0;
+
+        std::vector<Instr> code;
+        std::vector<double> consts;
+        std::vector<Ref> refs;
+        std::vector<double> stack;
+    };
+}
@@ -49,16 +49,43 @@ namespace hwgauge
             << ", memFreq="<< m.memoryFrequency
             << ", power="  << m.powerUsage
             << ", temp="   << m.temperature<<"C"
+            << ", energy=" << m.energyJoules<<"J"
+            << ", powerMax=" << m.powerMax
+            << ", powerP99=" << m.powerP99
             << " }\n";
     }
 
-    // 定义全局信息设置函数
+    // 定义上下文信息设置函数
     template<>
-    inline void setContextInfo(std::vector<GPULabel>& l, std::vector<GPUMetrics>& m)
+    inline void setContextInfo(std::vector<GPULabel>& l, std::vector<GPUMetrics>& m, TickContext& context)
     {
+        double gpuPower = 0.0, gpuEnergy = 0.0;
+        bool anyPower = false;
         for(size_t i=0; i<l.size(); i++) 
         {
-            sharedPower.gpu_power = sharedPower.gpu_power.value_or(0.0) + m[i].powerUsage;
+            // NVML 读取失败时功率为 -1，不计入合计
+            if (m[i].powerUsage >= 0) { gpuPower += m[i].powerUsage; anyPower = true; }
+            if (m[i].energyJoules > 0)gpuEnergy += m[i].energyJoules;
+        }
+        if (l.empty())return;
+        if (anyPower)context.addPower(PowerSource::Gpu, gpuPower);
+        context.setEnergy(PowerSource::Gpu, gpuEnergy);
+    }
+
+    template<>
+    struct ContextDeps<GPULabel, GPUMetrics>
+    {
+        static constexpr unsigned provides = powerBit(PowerSource::Gpu);
+        static constexpr unsigned consumes = 0;
+    };
+
+    // 定义作业能耗统计数据
+    template<>
+    inline void jobSamples(const std::vector<GPULabel>& l, const std::vector<GPUMetrics>& m, std::vector<JobSample>& out)
+    {
+        for(size_t i=0; i<l.size(); i++)
+        {
+            out.push_back(JobSample{"gpu" + std::to_string(l[i].index), m[i].energyJoules, m[i].powerUsage, m[i].gpuUtilization});
         }
     }
 
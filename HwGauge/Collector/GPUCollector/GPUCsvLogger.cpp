@@ -22,9 +22,36 @@ namespace hwgauge
         spdlog::info("[GPUCsvLogger] Initialized logger for: {}", m_filepath);
     }
 
-    std::string GPUCsvLogger::getHeader()const
+    std::string GPUCsvLogger::header()
     {
-        return "Index,Name,GpuUtil(%),MemUtil(%),GpuFreq(MHz),MemFreq(MHz),Power(W),Temp(C)";
+        return "Index,Name,GpuUtil(%),MemUtil(%),GpuFreq(MHz),MemFreq(MHz),Power(W),Temp(C),Energy(J),"
+               "PowerMin(W),PowerMax(W),PowerMean(W),PowerP99(W),UtilMin(%),UtilMax(%),UtilMean(%),UtilP99(%)";
+    }
+
+    std::string GPUCsvLogger::getHeader() const
+    {
+        return header();
+    }
+
+    void GPUCsvLogger::parseRow(CsvFieldReader& r, GPULabel& l, GPUMetrics& m)
+    {
+        r.get(l.index);
+        r.get(l.name);
+        r.get(m.gpuUtilization);
+        r.get(m.memoryUtilization);
+        r.get(m.gpuFrequency);
+        r.get(m.memoryFrequency);
+        r.get(m.powerUsage);
+        r.get(m.temperature);
+        r.get(m.energyJoules);
+        r.get(m.powerMin);
+        r.get(m.powerMax);
+        r.get(m.powerMean);
+        r.get(m.powerP99);
+        r.get(m.utilizationMin);
+        r.get(m.utilizationMax);
+        r.get(m.utilizationMean);
+        r.get(m.utilizationP99);
     }
 
     std::string GPUCsvLogger::formatRow(const GPULabel& l, const GPUMetrics& m) const
@@ -37,7 +64,16 @@ namespace hwgauge
            << static_cast<int>(m.gpuFrequency) << ","  // 频率通常看整数即可
            << static_cast<int>(m.memoryFrequency) << ","
            << std::fixed << std::setprecision(2) << m.powerUsage << ","
-           << std::fixed << std::setprecision(1) << m.temperature;
+           << std::fixed << std::setprecision(1) << m.temperature << ","
+           << std::fixed << std::setprecision(2) << m.energyJoules << ","
+           << std::fixed << std::setprecision(2) << m.powerMin << ","
+           << std::fixed << std::setprecision(2) << m.powerMax << ","
+           << std::fixed << std::setprecision(2) << m.powerMean << ","
+           << std::fixed << std::setprecision(2) << m.powerP99 << ","
+           << std::fixed << std::setprecision(2) << m.utilizationMin << ","
+           << std::fixed << std::setprecision(2) << m.utilizationMax << ","
+           << std::fixed << std::setprecision(2) << m.utilizationMean << ","
+           << std::fixed << std::setprecision(2) << m.utilizationP99;
         return ss.str();
     }
 
@@ -3,6 +3,7 @@
 #ifdef HWGAUGE_USE_NVML
 
 #include "Collector/Base/CsvLogger.hpp"
+#include "Collector/Common/CsvReader.hpp"
 #include "GPUMetrics.hpp"
 
 namespace hwgauge
@@ -14,6 +15,10 @@ namespace hwgauge
         explicit GPUCsvLogger(const std::string& filepath);
         ~GPUCsvLogger() override = default;
 
+        // 表头与 formatRow 的逆过程，供回放 (--replay) 读取已记录的文件
+        static std::string header();
+        static void parseRow(CsvFieldReader& r, GPULabel& l, GPUMetrics& m);
+
     protected:
         // 声明虚函数，在 .cpp 中实现
         std::string getHeader() const override;
@@ -1,4 +1,4 @@
-#if defined(HWGAUGE_USE_POSTGRESQL) && defined(HWGAUGE_USE_NVML)
+#ifdef HWGAUGE_USE_POSTGRESQL
 
 #include "GPUDatabase.hpp"
 
@@ -10,6 +10,17 @@ namespace hwgauge
 {
     GPUDatabase::GPUDatabase(const DBConfig& config_, const std::string& table_name_prefix)
         : Database<GPULabel, GPUMetrics>(config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    GPUDatabase::GPUDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<GPULabel, GPUMetrics>(shared_conn, config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    void GPUDatabase::setup(const std::string& table_name_prefix)
     {
         // 设置表名
         metric_table_name = table_name_prefix + "_gpu_metric";
@@ -20,8 +31,10 @@ namespace hwgauge
         metric_insert_sql =
             "INSERT INTO " + metric_table_name +
             " (timestamp, gpu_index, gpu_utilization, memory_utilization, "
-            "gpu_frequency, memory_frequency, power_usage, temperature) "
-            "VALUES ($1, $2, $3, $4, $5, $6, $7, $8);";
+            "gpu_frequency, memory_frequency, power_usage, temperature, energy_joules, "
+            "power_min, power_max, power_mean, power_p99, "
+            "utilization_min, utilization_max, utilization_mean, utilization_p99, seq) "
+            "VALUES ($1, $2, $3, $4, $5, $6, $7, $8, $9, $10, $11, $12, $13, $14, $15, $16, $17, $18);";
 
         info_insert_sql =
             "INSERT INTO " + info_table_name +
@@ -39,20 +52,57 @@ namespace hwgauge
     {
         const std::string sql =
             "CREATE TABLE IF NOT EXISTS " + metric_table_name + " ("
-            "timestamp TIMESTAMP NOT NULL,"             // 时间戳
+            "timestamp TIMESTAMPTZ NOT NULL,"             // 时间戳
             "gpu_index INTEGER NOT NULL,"               // GPU索引
             "gpu_utilization DOUBLE PRECISION,"         // GPU利用率(%)
             "memory_utilization DOUBLE PRECISION,"      // 显存利用率(%)
             "gpu_frequency DOUBLE PRECISION,"           // GPU频率(MHz)
             "memory_frequency DOUBLE PRECISION,"        // 显存频率(MHz)
             "power_usage DOUBLE PRECISION,"             // 功耗(W)
-            "temperature DOUBLE PRECISION"              //温度(C)
+            "temperature DOUBLE PRECISION,"             //温度(C)
+            "energy_joules DOUBLE PRECISION,"           // 累计能耗(J)
+            "power_min DOUBLE PRECISION,"               // 周期内功耗最小值(W)
+            "power_max DOUBLE PRECISION,"               // 周期内功耗最大值(W)
+            "power_mean DOUBLE PRECISION,"              // 周期内功耗平均值(W)
+            "power_p99 DOUBLE PRECISION,"               // 周期内功耗 P99(W)
+            "utilization_min DOUBLE PRECISION,"         // 周期内GPU利用率最小值(%)
+            "utilization_max DOUBLE PRECISION,"         // 周期内GPU利用率最大值(%)
+            "utilization_mean DOUBLE PRECISION,"        // 周期内GPU利用率平均值(%)
+            "utilization_p99 DOUBLE PRECISION"          // 周期内GPU利用率 P99(%)
             ");";
         if (!execSQL(sql))
         {
             spdlog::error("[GPUDatabase] Failed to create metric table");
             return false;
         }
+        if (!upgradeTimestampColumn(metric_table_name))
+        {
+            spdlog::error("[GPUDatabase] Failed to convert timestamp column to TIMESTAMPTZ");
+            return false;
+        }
+
+        // 兼容旧版本创建的表
+        const std::string upgrade =
+            "ALTER TABLE " + metric_table_name +
+            " ADD COLUMN IF NOT EXISTS energy_joules DOUBLE PRECISION,"
+            " ADD COLUMN IF NOT EXISTS power_min DOUBLE PRECISION,"
+            " ADD COLUMN IF NOT EXISTS power_max DOUBLE PRECISION,"
+            " ADD COLUMN IF NOT EXISTS power_mean DOUBLE PRECISION,"
+            " ADD COLUMN IF NOT EXISTS power_p99 DOUBLE PRECISION,"
+            " ADD COLUMN IF NOT EXISTS utilization_min DOUBLE PRECISION,"
+            " ADD COLUMN IF NOT EXISTS utilization_max DOUBLE PRECISION,"
+            " ADD COLUMN IF NOT EXISTS utilization_mean DOUBLE PRECISION,"
+            " ADD COLUMN IF NOT EXISTS utilization_p99 DOUBLE PRECISION;";
+        if (!execSQL(upgrade))
+        {
+            spdlog::error("[GPUDatabase] Failed to upgrade metric table");
+            return false;
+        }
+        if (!addSeqColumn(metric_table_name))
+        {
+            spdlog::error("[GPUDatabase] Failed to add seq column");
+            return false;
+        }
         spdlog::info("[GPUDatabase] Table {} created or already exists", metric_table_name);
         return true;
     }
@@ -73,7 +123,7 @@ namespace hwgauge
         return true;
     }
 
-    void GPUDatabase::writeMetric(const std::string& cur_time,
+    void GPUDatabase::writeMetric(TimePoint cur_time, std::uint64_t seq,
                                 const std::vector<GPULabel>& label_list,
                                 const std::vector<GPUMetrics>& metric_list,
                                 bool useTransaction)
@@ -82,24 +132,35 @@ namespace hwgauge
         if (useTransaction && !startTransaction())return;
         
         int inserted = 0;
+        // 时间戳以二进制 TIMESTAMPTZ 绑定，每轮只转换一次
+        const PgTimestamp time(cur_time);
         for (size_t i = 0; i < label_list.size(); ++i)
         {
             const GPULabel& label = label_list[i];
             const GPUMetrics& metric = metric_list[i];
 
-            std::vector<std::string> buf(8);
-            const char* params[8] = {
-                to_sql_param_string(cur_time, buf[0]),
-                to_sql_param_int(label.index, buf[1]),
-                to_sql_param_double(metric.gpuUtilization, buf[2]),
-                to_sql_param_double(metric.memoryUtilization, buf[3]),
-                to_sql_param_double(metric.gpuFrequency, buf[4]),
-                to_sql_param_double(metric.memoryFrequency, buf[5]),
-                to_sql_param_double(metric.powerUsage, buf[6]),
-                to_sql_param_double(metric.temperature,buf[7]),
+            std::vector<std::string> buf(17);
+            const char* params[17] = {
+                to_sql_param_int(label.index, buf[0]),
+                to_sql_param_double(metric.gpuUtilization, buf[1]),
+                to_sql_param_double(metric.memoryUtilization, buf[2]),
+                to_sql_param_double(metric.gpuFrequency, buf[3]),
+                to_sql_param_double(metric.memoryFrequency, buf[4]),
+                to_sql_param_double(metric.powerUsage, buf[5]),
+                to_sql_param_double(metric.temperature,buf[6]),
+                to_sql_param_double(metric.energyJoules, buf[7]),
+                to_sql_param_double(metric.powerMin, buf[8]),
+                to_sql_param_double(metric.powerMax, buf[9]),
+                to_sql_param_double(metric.powerMean, buf[10]),
+                to_sql_param_double(metric.powerP99, buf[11]),
+                to_sql_param_double(metric.utilizationMin, buf[12]),
+                to_sql_param_double(metric.utilizationMax, buf[13]),
+                to_sql_param_double(metric.utilizationMean, buf[14]),
+                to_sql_param_double(metric.utilizationP99, buf[15]),
+                to_sql_param_long(seqValue(seq), buf[16]),
             };
 
-            if (!execSQL(metric_insert_sql, std::vector<const char*>(params, params +8)))
+            if (!execSQL(metric_insert_sql, time, std::vector<const char*>(params, params + 17)))
             {
                 if(useTransaction) rollbackTransaction();
                 return;
@@ -107,7 +168,7 @@ namespace hwgauge
             ++inserted;
         }
         if (useTransaction && !commitTransaction())return;
-        spdlog::info("[GPUDatabase] Successfully inserted {}/{} records into {}", inserted, label_list.size(), metric_table_name);
+        HWGAUGE_LOG_COUNT("GPUDatabase records", inserted);
     }
     
     void GPUDatabase::writeInfo(const std::vector<GPULabel>& label_list,
@@ -1,6 +1,6 @@
 #pragma once
 
-#if defined(HWGAUGE_USE_POSTGRESQL) && defined(HWGAUGE_USE_NVML)
+#ifdef HWGAUGE_USE_POSTGRESQL
 
 #include "GPUMetrics.hpp"
 #include "Collector/Common/Config.hpp"
@@ -14,12 +14,15 @@ namespace hwgauge
     public:
         /* 构造函数 */
         explicit GPUDatabase(const DBConfig& config_, const std::string& table_name_prefix);
+
+        /* 构造函数：复用外部连接 */
+        GPUDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix);
         
         /* 析构函数 */
         ~GPUDatabase();
         
         /* 写入GPU监控数据 */
-        void writeMetric(const std::string& cur_time,
+        void writeMetric(TimePoint cur_time, std::uint64_t seq,
                         const std::vector<GPULabel>& label_list, 
                         const std::vector<GPUMetrics>& metric_list,
                         bool useTransaction = true) override;
@@ -29,7 +32,9 @@ namespace hwgauge
                       bool useTransaction = true) override;
         
     private:
-        
+        /* 设置表名、建表并构建SQL模板 */
+        void setup(const std::string& table_name_prefix);
+
         /* 创建指标数据表 */
         bool createMetricTable() override;
         /* 创建静态数据表 */
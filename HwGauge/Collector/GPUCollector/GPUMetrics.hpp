@@ -1,7 +1,6 @@
 #pragma once
 
-#ifdef HWGAUGE_USE_NVML
-
+#include "Collector/Common/Fields.hpp"
 #include <string>
 
 #ifdef HWGAUGE_USE_LOCAL_HTTP
@@ -25,6 +24,88 @@ namespace hwgauge
         double powerUsage;
 
         double temperature;
+
+        double energyJoules;    // 自 agent 启动以来的累计能耗(J)
+
+        // 本周期内驱动采样缓冲区 (nvmlDeviceGetSamples) 的统计，不支持或周期内无样本时为 -1
+        double powerMin;
+        double powerMax;
+        double powerMean;
+        double powerP99;
+        double utilizationMin;
+        double utilizationMax;
+        double utilizationMean;
+        double utilizationP99;
+    };
+
+    /* 周期内的原始子样本，开启 --gpu-raw-samples 时作为 "gpu_samples" 批量数据发送 */
+    struct GPUSampleLabel
+    {
+        std::size_t index;
+        std::string kind;           // "power" / "utilization"
+        long long timestampUs;      // 驱动记录的采样时间 (自 epoch 起的微秒)
+    };
+
+    struct GPUSample
+    {
+        double value;               // W / %
+    };
+
+    template<>
+    struct Fields<GPULabel>
+    {
+        template<typename T, typename F>
+        static void visit(T& l, F&& f)
+        {
+            f("index", l.index);
+            f("name", l.name);
+        }
+    };
+
+    template<>
+    struct Fields<GPUMetrics>
+    {
+        template<typename T, typename F>
+        static void visit(T& m, F&& f)
+        {
+            f("gpuUtilization", m.gpuUtilization);
+            f("memoryUtilization", m.memoryUtilization);
+            f("gpuFrequency", m.gpuFrequency);
+            f("memoryFrequency", m.memoryFrequency);
+            f("powerUsage", m.powerUsage);
+            f("temperature", m.temperature);
+            f("energyJoules", m.energyJoules, FieldKind::Counter);
+            f("powerMin", m.powerMin, FieldKind::Min);
+            f("powerMax", m.powerMax, FieldKind::Max);
+            f("powerMean", m.powerMean);
+            f("powerP99", m.powerP99, FieldKind::Percentile);
+            f("utilizationMin", m.utilizationMin, FieldKind::Min);
+            f("utilizationMax", m.utilizationMax, FieldKind::Max);
+            f("utilizationMean", m.utilizationMean);
+            f("utilizationP99", m.utilizationP99, FieldKind::Percentile);
+        }
+    };
+
+    template<>
+    struct Fields<GPUSampleLabel>
+    {
+        template<typename T, typename F>
+        static void visit(T& l, F&& f)
+        {
+            f("index", l.index);
+            f("kind", l.kind);
+            f("timestampUs", l.timestampUs);
+        }
+    };
+
+    template<>
+    struct Fields<GPUSample>
+    {
+        template<typename T, typename F>
+        static void visit(T& m, F&& f)
+        {
+            f("value", m.value);
+        }
     };
 
 #ifdef HWGAUGE_USE_LOCAL_HTTP
@@ -39,10 +120,17 @@ namespace hwgauge
             {"gpuFrequency", m.gpuFrequency},
             {"memoryFrequency", m.memoryFrequency},
             {"powerUsage", m.powerUsage},
-            {"temperature", m.temperature}
+            {"temperature", m.temperature},
+            {"energyJoules", m.energyJoules},
+            {"powerMin", m.powerMin},
+            {"powerMax", m.powerMax},
+            {"powerMean", m.powerMean},
+            {"powerP99", m.powerP99},
+            {"utilizationMin", m.utilizationMin},
+            {"utilizationMax", m.utilizationMax},
+            {"utilizationMean", m.utilizationMean},
+            {"utilizationP99", m.utilizationP99}
         };
     }
 #endif
 }
-
-#endif
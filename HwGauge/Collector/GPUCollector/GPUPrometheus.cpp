@@ -35,29 +35,69 @@ namespace hwgauge
             .Name("gpu_power_usage_watts")
             .Help("GPU power usage in watts")
             .Register(registry_ref);
+
+        energyFamily = &prometheus::BuildCounter()
+            .Name("gpu_energy_joules_total")
+            .Help("GPU energy consumed since agent start in joules")
+            .Register(registry_ref);
+
+        powerIntervalFamily = &prometheus::BuildGauge()
+            .Name("gpu_power_interval_watts")
+            .Help("GPU power over the last interval from driver sample buffers (stat=min/max/mean/p99)")
+            .Register(registry_ref);
+
+        utilizationIntervalFamily = &prometheus::BuildGauge()
+            .Name("gpu_utilization_interval_percent")
+            .Help("GPU utilization over the last interval from driver sample buffers (stat=min/max/mean/p99)")
+            .Register(registry_ref);
     }
 
     void GPUPrometheus::write(const std::vector<GPULabel>& label_list,const std::vector<GPUMetrics>& metric_list)
     {
+        // 构建标签：设备集合在采集器生命周期内不变，只需在第一轮构建
+        // 周期统计的序列按 (设备, stat) 编号：i * kStatCount + s
+        static const char* const stats[kStatCount] = { "min", "max", "mean", "p99" };
+        if (gauges.resize(label_list.size()))
+        {
+            counters.resize(label_list.size());
+            statGauges.resize(label_list.size() * kStatCount);
+            for (size_t i = 0; i < label_list.size(); i++)
+            {
+                gauges.labels(i) = {
+                    {"index", std::to_string(label_list[i].index)},
+                    {"name", label_list[i].name}
+                };
+                counters.labels(i) = gauges.labels(i);
+                for (size_t s = 0; s < kStatCount; s++)
+                {
+                    auto& statLabels = statGauges.labels(i * kStatCount + s);
+                    statLabels = gauges.labels(i);
+                    statLabels["stat"] = stats[s];
+                }
+            }
+        }
+
         // 更新每个设备的指标
         for (size_t i = 0; i < label_list.size(); i++)
         {
-            const auto& label = label_list[i];
             const auto& metric = metric_list[i];
             
-            // 构建标签
-            std::map<std::string, std::string> labels = 
+            // 更新各个指标 - 序列在第一次用到时创建，之后直接 Set
+            gauges.get(i, gpuUtilizationFamily).Set(metric.gpuUtilization);
+            gauges.get(i, memoryUtilizationFamily).Set(metric.memoryUtilization);
+            gauges.get(i, gpuFrequencyFamily).Set(metric.gpuFrequency);
+            gauges.get(i, memoryFrequencyFamily).Set(metric.memoryFrequency);
+            gauges.get(i, powerUsageFamily).Set(metric.powerUsage);
+            setCounter(counters.get(i, energyFamily), metric.energyJoules);
+
+            // 驱动不提供采样缓冲区时不创建对应的序列
+            const double power[kStatCount] = { metric.powerMin, metric.powerMax, metric.powerMean, metric.powerP99 };
+            const double utilization[kStatCount] = { metric.utilizationMin, metric.utilizationMax, metric.utilizationMean, metric.utilizationP99 };
+            for (size_t s = 0; s < kStatCount; s++)
             {
-                {"index", std::to_string(label.index)},
-                {"name", label.name}
-            };
-            
-            // 更新各个指标 - 使用Add()获取或创建带有标签的指标
-            gpuUtilizationFamily->Add(labels).Set(metric.gpuUtilization);
-            memoryUtilizationFamily->Add(labels).Set(metric.memoryUtilization);
-            gpuFrequencyFamily->Add(labels).Set(metric.gpuFrequency);
-            memoryFrequencyFamily->Add(labels).Set(metric.memoryFrequency);
-            powerUsageFamily->Add(labels).Set(metric.powerUsage);
+                if (power[s] != -1.0)statGauges.get(i * kStatCount + s, powerIntervalFamily).Set(power[s]);
+                if (utilization[s] != -1.0)statGauges.get(i * kStatCount + s, utilizationIntervalFamily).Set(utilization[s]);
+            }
         }
     }
 }
@@ -22,6 +22,15 @@ namespace hwgauge
 		prometheus::Family<prometheus::Gauge>* gpuFrequencyFamily;
 		prometheus::Family<prometheus::Gauge>* memoryFrequencyFamily;
 		prometheus::Family<prometheus::Gauge>* powerUsageFamily;
+		prometheus::Family<prometheus::Counter>* energyFamily;
+		// 周期内采样缓冲区统计，stat 标签为 min / max / mean / p99
+		prometheus::Family<prometheus::Gauge>* powerIntervalFamily;
+		prometheus::Family<prometheus::Gauge>* utilizationIntervalFamily;
+
+		static constexpr std::size_t kStatCount = 4;
+		SeriesCache<prometheus::Gauge> gauges;
+		SeriesCache<prometheus::Counter> counters;
+		SeriesCache<prometheus::Gauge> statGauges;
     };
 }
 
@@ -0,0 +1,106 @@
+#ifdef HWGAUGE_USE_POSTGRESQL
+
+#include "GPUSampleDatabase.hpp"
+
+#include "spdlog/spdlog.h"
+
+namespace hwgauge
+{
+    GPUSampleDatabase::GPUSampleDatabase(const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<GPUSampleLabel, GPUSample>(config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    GPUSampleDatabase::GPUSampleDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<GPUSampleLabel, GPUSample>(shared_conn, config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    void GPUSampleDatabase::setup(const std::string& table_name_prefix)
+    {
+        // 设置表名
+        metric_table_name = table_name_prefix + "_gpu_sample";
+        // 创建表
+        if (!createMetricTable())throw hwgauge::FatalError("[Database] Create Table Failed");
+        // 构建SQL模板
+        metric_copy_sql =
+            "COPY " + metric_table_name +
+            " (timestamp, gpu_index, kind, sample_us, value, seq) "
+            "FROM STDIN;";
+
+        spdlog::info("[GPUSampleDatabase] Initialize successfully");
+    }
+
+    GPUSampleDatabase::~GPUSampleDatabase(){}
+
+    bool GPUSampleDatabase::createMetricTable()
+    {
+        const std::string sql =
+            "CREATE TABLE IF NOT EXISTS " + metric_table_name + " ("
+            "timestamp TIMESTAMPTZ NOT NULL,"          // 所属采集周期的时间戳
+            "gpu_index INTEGER NOT NULL,"             // GPU索引
+            "kind VARCHAR(16) NOT NULL,"              // power / utilization
+            "sample_us BIGINT NOT NULL,"              // 驱动记录的采样时间 (自 epoch 起的微秒)
+            "value DOUBLE PRECISION"                  // 功耗(W) / 利用率(%)
+            ");";
+
+        if (!execSQL(sql))
+        {
+            spdlog::error("[GPUSampleDatabase] Failed to create metric table");
+            return false;
+        }
+        if (!upgradeTimestampColumn(metric_table_name))
+        {
+            spdlog::error("[GPUSampleDatabase] Failed to convert timestamp column to TIMESTAMPTZ");
+            return false;
+        }
+        if (!addSeqColumn(metric_table_name))
+        {
+            spdlog::error("[GPUSampleDatabase] Failed to add seq column");
+            return false;
+        }
+        spdlog::info("[GPUSampleDatabase] Table {} created or already exists", metric_table_name);
+        return true;
+    }
+
+    bool GPUSampleDatabase::createInfoTable()
+    {
+        return true;
+    }
+
+    void GPUSampleDatabase::writeMetric(TimePoint cur_time, std::uint64_t seq,
+                                const std::vector<GPUSampleLabel>& label_list,
+                                const std::vector<GPUSample>& metric_list,
+                                bool)
+    {
+        if (!isConnected())throw hwgauge::FatalError("[GPUSampleDatabase] The database hasn't been connected before writing");
+
+        copy_buf.clear();
+        for (size_t i = 0; i < label_list.size(); ++i)
+        {
+            appendCopyField(copy_buf, cur_time);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, static_cast<long long>(label_list[i].index));
+            copy_buf += '\t';
+            appendCopyField(copy_buf, label_list[i].kind);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, label_list[i].timestampUs);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, metric_list[i].value);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, seqValue(seq));
+            copy_buf += '\n';
+        }
+
+        if (!copyIn(metric_copy_sql, copy_buf))return;
+        HWGAUGE_LOG_COUNT("GPUSampleDatabase records", label_list.size());
+    }
+
+    void GPUSampleDatabase::writeInfo(const std::vector<GPUSampleLabel>&, bool)
+    {
+    }
+}
+
+#endif
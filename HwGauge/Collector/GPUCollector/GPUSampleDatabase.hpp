@@ -0,0 +1,48 @@
+#pragma once
+
+#ifdef HWGAUGE_USE_POSTGRESQL
+
+#include "GPUMetrics.hpp"
+#include "Collector/Common/Config.hpp"
+#include "Collector/Base/Database.hpp"
+
+namespace hwgauge
+{
+    /* GPU 原始子样本 (gpu_samples) 数据库操作类，使用 COPY 批量写入；设备信息由 GPUDatabase 维护 */
+    class GPUSampleDatabase : public Database<GPUSampleLabel, GPUSample>
+    {
+    public:
+        /* 构造函数 */
+        explicit GPUSampleDatabase(const DBConfig& config_, const std::string& table_name_prefix);
+
+        /* 构造函数：复用外部连接 */
+        GPUSampleDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix);
+        
+        /* 析构函数 */
+        ~GPUSampleDatabase();
+        
+        /* 写入原始子样本 */
+        void writeMetric(TimePoint cur_time, std::uint64_t seq,
+                        const std::vector<GPUSampleLabel>& label_list, 
+                        const std::vector<GPUSample>& metric_list,
+                        bool useTransaction = true) override;
+        
+        /* 子样本没有静态信息 */
+        void writeInfo(const std::vector<GPUSampleLabel>& label_list,
+                      bool useTransaction = true) override;
+        
+    private:
+        /* 设置表名、建表并构建SQL模板 */
+        void setup(const std::string& table_name_prefix);
+
+        /* 创建指标数据表 */
+        bool createMetricTable() override;
+        /* 创建静态数据表 */
+        bool createInfoTable() override;
+
+        std::string metric_copy_sql;    // COPY 语句
+        std::string copy_buf;           // 复用的 COPY 数据缓冲
+    };
+}
+
+#endif
@@ -1,26 +1,136 @@
 #ifdef HWGAUGE_USE_NVML
 
+#include "Collector/Common/Codec.hpp"
 #include "Collector/Common/Exception.hpp"
 #include "NVML.hpp"
 
-#include <nvml.h>
+#include "Collector/GPUCollector/NVMLApi.hpp"
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include "spdlog/spdlog.h"
 
 namespace hwgauge {
-	NVML::NVML()
+	namespace
 	{
-		nvmlReturn_t status = nvmlInit();
+		// 并行采样的线程数上限（含采集线程），NVML 调用主要耗时在驱动 ioctl 上，几个线程足够
+		constexpr std::size_t kMaxSampleThreads = 4;
+
+		// Device::failing 中的各个失败项
+		enum FailBit : unsigned
+		{
+			FailUtilization = 1u << 0,
+			FailSmClock = 1u << 1,
+			FailMemClock = 1u << 2,
+			FailPower = 1u << 3,
+			FailTemperature = 1u << 4,
+			FailEnergy = 1u << 5,
+			FailFieldValues = 1u << 6,
+			FailPowerSamples = 1u << 7,
+			FailUtilizationSamples = 1u << 8,
+		};
+
+		// 同一失败项只在第一次出现时告警，恢复后再次失败会重新告警
+		bool check(nvmlReturn_t status, unsigned& failing, FailBit bit, std::size_t index, const char* what)
+		{
+			if (status == NVML_SUCCESS)
+			{
+				failing &= ~static_cast<unsigned>(bit);
+				return true;
+			}
+			if (!(failing & bit))
+			{
+				spdlog::warn("[NVML] GPU {} get {} failed: {}, {}", index, what, nvmlApi()->nvmlErrorString(status), static_cast<int>(status));
+				failing |= bit;
+			}
+			return false;
+		}
+
+		// 批量查询的字段：功率 (mW) 与累计能耗 (mJ)，旧版本 nvml.h 没有定义时退回单独查询
+		constexpr unsigned int kBatchFields[] = {
+#ifdef NVML_FI_DEV_POWER_INSTANT
+			NVML_FI_DEV_POWER_INSTANT,
+#endif
+#ifdef NVML_FI_DEV_TOTAL_ENERGY_CONSUMPTION
+			NVML_FI_DEV_TOTAL_ENERGY_CONSUMPTION,
+#endif
+			0u  // 占位，保证数组非空；不参与查询
+		};
+		constexpr unsigned int kBatchCount = sizeof(kBatchFields) / sizeof(kBatchFields[0]) - 1;
+
+		double toDouble(nvmlValueType_t type, const nvmlValue_t& value)
+		{
+			switch (type)
+			{
+			case NVML_VALUE_TYPE_DOUBLE: return value.dVal;
+			case NVML_VALUE_TYPE_UNSIGNED_INT: return static_cast<double>(value.uiVal);
+			case NVML_VALUE_TYPE_UNSIGNED_LONG: return static_cast<double>(value.ulVal);
+			case NVML_VALUE_TYPE_UNSIGNED_LONG_LONG: return static_cast<double>(value.ullVal);
+			case NVML_VALUE_TYPE_SIGNED_LONG_LONG: return static_cast<double>(value.sllVal);
+			default: return -1.0;
+			}
+		}
+
+		// 驱动缓冲区一般保存最近 1~2 秒的样本，首次不够时按驱动返回的数量扩容
+		constexpr unsigned int kSampleBuffer = 128;
+
+		unsigned long long nowMicros()
+		{
+			return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(
+				std::chrono::system_clock::now().time_since_epoch()).count());
+		}
+
+		struct IntervalStats
+		{
+			double min = -1.0;
+			double max = -1.0;
+			double mean = -1.0;
+			double p99 = -1.0;
+		};
+
+		// sorted 会被重排；没有样本时各项为 -1
+		IntervalStats summarize(std::vector<double>& sorted)
+		{
+			IntervalStats stats;
+			if (sorted.empty())return stats;
+
+			double sum = 0.0;
+			stats.min = stats.max = sorted.front();
+			for (double v : sorted)
+			{
+				sum += v;
+				stats.min = std::min(stats.min, v);
+				stats.max = std::max(stats.max, v);
+			}
+			stats.mean = sum / static_cast<double>(sorted.size());
+
+			// nearest-rank：第 ceil(0.99 * n) 个样本
+			std::size_t rank = (sorted.size() * 99 + 99) / 100;
+			auto nth = sorted.begin() + static_cast<std::ptrdiff_t>(rank - 1);
+			std::nth_element(sorted.begin(), nth, sorted.end());
+			stats.p99 = *nth;
+			return stats;
+		}
+	}
+
+	NVML::NVML(const CollectorConfig& cfg)
+		: keepRaw(cfg.rawSamples && !cfg.batchSinks.empty())
+	{
+		// 库缺失或没有 GPU 驱动的节点上跳过本采集器，而不是终止进程
+		if (!nvmlApi())throw hwgauge::RecoverableError("[NVML] NVML library not available");
+		nvmlReturn_t status = nvmlApi()->nvmlInit();
 		if (status != NVML_SUCCESS) {
-			throw hwgauge::FatalError("NVML initialization failed");
+			throw hwgauge::RecoverableError(std::string("[NVML] Initialization failed: ") + nvmlApi()->nvmlErrorString(status));
 		}
+		initialized = true;
 	}
 
 	NVML::~NVML() {
 		if (initialized) {
-			nvmlReturn_t status = nvmlShutdown();
+			pool.reset();
+			nvmlReturn_t status = nvmlApi()->nvmlShutdown();
 			if (status != NVML_SUCCESS) {
-				throw hwgauge::FatalError("NVML shutdown failed");
+				spdlog::warn("[NVML] Shutdown failed: {}", nvmlApi()->nvmlErrorString(status));
 			}
 		}
 	}
@@ -28,6 +138,9 @@ namespace hwgauge {
 	NVML::NVML(NVML&& other) noexcept
 	{
 		initialized = other.initialized;
+		devices = std::move(other.devices);
+		pool = std::move(other.pool);
+		keepRaw = other.keepRaw;
 		other.initialized = false;
 	}
 
@@ -35,12 +148,16 @@ namespace hwgauge {
 	{
 		if (this != &other)
 		{
+			pool.reset();
 			if (initialized)
 			{
-				nvmlShutdown();
+				nvmlApi()->nvmlShutdown();
 			}
 
 			initialized = other.initialized;
+			devices = std::move(other.devices);
+			pool = std::move(other.pool);
+			keepRaw = other.keepRaw;
 			other.initialized = false;
 		}
 
@@ -52,26 +169,39 @@ namespace hwgauge {
 		nvmlReturn_t status;
 
 		unsigned int devicesCount = 0;
-		status = nvmlDeviceGetCount(std::addressof(devicesCount));
+		status = nvmlApi()->nvmlDeviceGetCount(std::addressof(devicesCount));
 
 		if (status != NVML_SUCCESS) {
 			throw hwgauge::FatalError("NVML get devices count failed");
 		}
 
 		std::vector<GPULabel> labels;
-		for (std::size_t index = 0; index < devicesCount; index++) {
+		std::vector<Device> found(devicesCount);
+		for (unsigned int index = 0; index < devicesCount; index++) {
 			nvmlDevice_t handle;
-			status = nvmlDeviceGetHandleByIndex(index, std::addressof(handle));
+			status = nvmlApi()->nvmlDeviceGetHandleByIndex(index, std::addressof(handle));
 			if (status != NVML_SUCCESS) {
 				throw hwgauge::FatalError("NVML get devices handle failed");
 			}
 
 			std::array<char, NVML_DEVICE_NAME_BUFFER_SIZE> name = { 0 };
-			status = nvmlDeviceGetName(handle, name.data(), name.size() - 1);
+			status = nvmlApi()->nvmlDeviceGetName(handle, name.data(), name.size() - 1);
 			if (status != NVML_SUCCESS) {
 				throw hwgauge::FatalError("NVML get devices name failed");
 			}
 
+			found[index].handle = handle;
+			found[index].fieldValues = kBatchCount > 0;
+			// 只统计启动之后的样本
+			found[index].power.lastSeen = found[index].utilization.lastSeen = nowMicros();
+			// 一轮取回的样本不超过驱动缓冲区，预留后采样时不再分配（首个样本可能在若干轮后才出现）
+			for (SampleStream* stream : { &found[index].power, &found[index].utilization })
+			{
+				stream->values.reserve(kSampleBuffer);
+				stream->times.reserve(kSampleBuffer);
+				stream->sorted.reserve(kSampleBuffer);
+			}
+
 			GPULabel label = {
 				index,
 				std::string(name.data())
@@ -80,98 +210,234 @@ namespace hwgauge {
 			labels.emplace_back(std::move(label));
 		}
 
+		// 设备集合不会在运行中变化，重新枚举时沿用已有的能耗累计
+		for (std::size_t i = 0; i < std::min(found.size(), devices.size()); ++i)
+		{
+			found[i].hardwareEnergy = devices[i].hardwareEnergy;
+			found[i].counter = devices[i].counter;
+			found[i].integrator = devices[i].integrator;
+			found[i].power.lastSeen = devices[i].power.lastSeen;
+			found[i].utilization.lastSeen = devices[i].utilization.lastSeen;
+		}
+		devices = std::move(found);
+
+		std::size_t threads = std::min(devices.size(), kMaxSampleThreads);
+		if (threads > 1 && (!pool || pool->size() != threads))pool = std::make_unique<ThreadPool>(threads);
+
 		return labels;
 	}
 
-	std::vector<GPUMetrics> NVML::sample(std::vector<GPULabel>&labels)
+	void NVML::drainSamples(std::size_t index, Device& device, SampleStream& stream, bool power)
 	{
-		nvmlReturn_t status;
-		// status = nvmlDeviceGetCount(std::addressof(devicesCount));
-		// if (status != NVML_SUCCESS) {
-		// 	throw std::runtime_error("NVML get devices count failed");
-		// }
-		std::vector<GPUMetrics> metrics;
-		for (const auto& label : labels)
-		{
-			auto index = label.index;   // 关键：由 label 决定设备
-			nvmlDevice_t handle;
-			status = nvmlDeviceGetHandleByIndex(index, std::addressof(handle));
-			if (status != NVML_SUCCESS) {
-				throw hwgauge::RecoverableError("NVML get devices handle failed: {}");
-			}
+		stream.values.clear();
+		stream.times.clear();
+		if (!stream.supported)return;
 
-			// GPU / Memory Utilization
-			nvmlUtilization_t utilization;
-			double gpuUtilization,memoryUtilization;
-			status = nvmlDeviceGetUtilizationRates(handle, std::addressof(utilization));
-			if (status != NVML_SUCCESS)
+		// 每个采样线程复用自己的缓冲区
+		thread_local std::vector<nvmlSample_t> buffer(kSampleBuffer);
+
+		nvmlSamplingType_t type = power ? NVML_TOTAL_POWER_SAMPLES : NVML_GPU_UTILIZATION_SAMPLES;
+		nvmlValueType_t valueType;
+		unsigned int count = static_cast<unsigned int>(buffer.size());
+		nvmlReturn_t status = nvmlApi()->nvmlDeviceGetSamples(device.handle, type, stream.lastSeen, &valueType, &count, buffer.data());
+		if (status == NVML_ERROR_INSUFFICIENT_SIZE)
+		{
+			// samples 为空时驱动返回可用样本数
+			status = nvmlApi()->nvmlDeviceGetSamples(device.handle, type, stream.lastSeen, &valueType, &count, nullptr);
+			if (status == NVML_SUCCESS)
 			{
-				gpuUtilization=-1.0;
-				memoryUtilization=-1.0;
-				spdlog::warn("[NVML] Get utilizations rates failed: {}, {}",nvmlErrorString(status),static_cast<int>(status));
+				buffer.resize(std::max<std::size_t>(count, buffer.size()));
+				count = static_cast<unsigned int>(buffer.size());
+				status = nvmlApi()->nvmlDeviceGetSamples(device.handle, type, stream.lastSeen, &valueType, &count, buffer.data());
 			}
-			else
+		}
+
+		if (status == NVML_ERROR_NOT_FOUND)return;   // 上次之后没有新样本
+		if (status == NVML_ERROR_NOT_SUPPORTED || status == NVML_ERROR_FUNCTION_NOT_FOUND)
+		{
+			stream.supported = false;
+			spdlog::info("[NVML] GPU {} does not support {} samples", index, power ? "power" : "utilization");
+			return;
+		}
+		if (!check(status, device.failing, power ? FailPowerSamples : FailUtilizationSamples, index,
+			power ? "power samples" : "utilization samples"))return;
+
+		const double scale = power ? 1e-3 : 1.0;   // mW -> W
+		for (unsigned int i = 0; i < count && i < buffer.size(); ++i)
+		{
+			const nvmlSample_t& sample = buffer[i];
+			if (sample.timeStamp <= stream.lastSeen)continue;
+			stream.values.push_back(toDouble(valueType, sample.sampleValue) * scale);
+			stream.times.push_back(sample.timeStamp);
+		}
+		for (auto t : stream.times)stream.lastSeen = std::max(stream.lastSeen, t);
+	}
+
+	GPUMetrics NVML::sampleDevice(std::size_t index, Device& device)
+	{
+		nvmlReturn_t status;
+		nvmlDevice_t handle = device.handle;
+
+		double power_usage = -1.0;
+		double totalEnergy = -1.0;   // mJ
+		bool energyFromField = false;
+
+		// Power / Energy：一次调用取回全部字段
+		if (device.fieldValues)
+		{
+			std::array<nvmlFieldValue_t, kBatchCount> fields{};
+			for (unsigned int i = 0; i < kBatchCount; ++i)fields[i].fieldId = kBatchFields[i];
+
+			status = nvmlApi()->nvmlDeviceGetFieldValues(handle, static_cast<int>(kBatchCount), fields.data());
+			if (status == NVML_ERROR_NOT_SUPPORTED || status == NVML_ERROR_FUNCTION_NOT_FOUND)
 			{
-				gpuUtilization = utilization.gpu;
-				memoryUtilization = utilization.memory;
+				device.fieldValues = false;
+				spdlog::info("[NVML] GPU {} does not support field value queries, using per-metric calls", index);
 			}
-			
-			// GPU Frequency
-			unsigned int smClock;
-			double gpuFrequency;
-			status = nvmlDeviceGetClockInfo(handle, NVML_CLOCK_SM, std::addressof(smClock));
-			if (status != NVML_SUCCESS)
+			else if (check(status, device.failing, FailFieldValues, index, "field values"))
 			{
-				gpuFrequency=-1.0;
-				spdlog::warn("[NVML] Get SM clock info failed: {}, {}",nvmlErrorString(status),static_cast<int>(status));
+				for (const auto& field : fields)
+				{
+					if (field.nvmlReturn != NVML_SUCCESS)continue;
+					double value = toDouble(field.valueType, field.value);
+#ifdef NVML_FI_DEV_POWER_INSTANT
+					if (field.fieldId == NVML_FI_DEV_POWER_INSTANT)power_usage = value / 1e3;  // mW -> W
+#endif
+#ifdef NVML_FI_DEV_TOTAL_ENERGY_CONSUMPTION
+					if (field.fieldId == NVML_FI_DEV_TOTAL_ENERGY_CONSUMPTION)
+					{
+						totalEnergy = value;
+						energyFromField = true;
+					}
+#endif
+				}
 			}
-			else gpuFrequency = smClock;
+		}
 
-			// Memory Frequency
-			unsigned int memClock;
-			double memFrequency;
-			status = nvmlDeviceGetClockInfo(handle, NVML_CLOCK_MEM, std::addressof(memClock));
-			if (status != NVML_SUCCESS)
-			{
-				memFrequency=-1.0;
-				spdlog::warn("[NVML] Get memory clock info failed: {}, {}",nvmlErrorString(status),static_cast<int>(status));
-			}
-			else memFrequency = memClock;
+		// GPU / Memory Utilization
+		nvmlUtilization_t utilization;
+		double gpuUtilization = -1.0, memoryUtilization = -1.0;
+		status = nvmlApi()->nvmlDeviceGetUtilizationRates(handle, std::addressof(utilization));
+		if (check(status, device.failing, FailUtilization, index, "utilization rates"))
+		{
+			gpuUtilization = utilization.gpu;
+			memoryUtilization = utilization.memory;
+		}
+
+		// GPU Frequency
+		unsigned int smClock;
+		double gpuFrequency = -1.0;
+		status = nvmlApi()->nvmlDeviceGetClockInfo(handle, NVML_CLOCK_SM, std::addressof(smClock));
+		if (check(status, device.failing, FailSmClock, index, "SM clock info"))gpuFrequency = smClock;
+
+		// Memory Frequency
+		unsigned int memClock;
+		double memFrequency = -1.0;
+		status = nvmlApi()->nvmlDeviceGetClockInfo(handle, NVML_CLOCK_MEM, std::addressof(memClock));
+		if (check(status, device.failing, FailMemClock, index, "memory clock info"))memFrequency = memClock;
 
-			// Power Usage
+		// Power Usage（批量查询不可用或该字段失败时）
+		if (power_usage < 0.0)
+		{
 			unsigned int power;
-			double power_usage;
-			status = nvmlDeviceGetPowerUsage(handle, std::addressof(power));
-			if (status != NVML_SUCCESS)
+			status = nvmlApi()->nvmlDeviceGetPowerUsage(handle, std::addressof(power));
+			if (check(status, device.failing, FailPower, index, "power usage"))power_usage = power / 1e3;  // mW -> W
+		}
+
+		// GPU Temperature
+		unsigned int temperature; // NVML 返回的温度是无符号整数，单位是摄氏度
+		double tempDouble = -1.0;
+		// 第二个参数 NVML_TEMPERATURE_GPU 代表读取核心温度
+		status = nvmlApi()->nvmlDeviceGetTemperature(handle, NVML_TEMPERATURE_GPU, &temperature);
+		if (check(status, device.failing, FailTemperature, index, "temperature"))tempDouble = static_cast<double>(temperature);
+
+		// Energy (Volta 及以上支持驱动累计计数器，单位 mJ)
+		double energyJoules = -1.0;
+		if (device.hardwareEnergy && !energyFromField)
+		{
+			unsigned long long energyMilli;
+			status = nvmlApi()->nvmlDeviceGetTotalEnergyConsumption(handle, std::addressof(energyMilli));
+			if (status == NVML_SUCCESS)totalEnergy = static_cast<double>(energyMilli);
+			else if (status == NVML_ERROR_NOT_SUPPORTED || status == NVML_ERROR_FUNCTION_NOT_FOUND)
 			{
-				power_usage=-1.0;
-				spdlog::warn("[NVML] Get power usage failed: {}, {}",nvmlErrorString(status),static_cast<int>(status));
+				device.hardwareEnergy = false;
+				spdlog::info("[NVML] GPU {} has no energy counter, integrating power instead", index);
 			}
-			else power_usage = power / 1e3;  // mW -> W
-
-			// GPU Temperature
-			unsigned int temperature; // NVML 返回的温度是无符号整数，单位是摄氏度
-			double tempDouble;
-			// 第二个参数 NVML_TEMPERATURE_GPU 代表读取核心温度
-			status = nvmlDeviceGetTemperature(handle, NVML_TEMPERATURE_GPU, &temperature);
-			if (status != NVML_SUCCESS)
-			{
-				tempDouble = -1.0; 
-				spdlog::warn("[NVML] Get temperature failed: {}, {}", nvmlErrorString(status), static_cast<int>(status));
+			else check(status, device.failing, FailEnergy, index, "total energy consumption");
+		}
+		if (device.hardwareEnergy)
+			energyJoules = device.counter.update(totalEnergy < 0.0 ? -1.0 : totalEnergy / 1e3);  // mJ -> J
+		else
+			energyJoules = device.integrator.update(power_usage);
+
+		// 周期内的功率 / 利用率样本，捕捉单次读数看不到的毫秒级尖峰
+		drainSamples(index, device, device.power, true);
+		drainSamples(index, device, device.utilization, false);
+		device.power.sorted.assign(device.power.values.begin(), device.power.values.end());
+		device.utilization.sorted.assign(device.utilization.values.begin(), device.utilization.values.end());
+		IntervalStats powerStats = summarize(device.power.sorted);
+		IntervalStats utilizationStats = summarize(device.utilization.sorted);
+
+		return GPUMetrics{
+			gpuUtilization,
+			memoryUtilization,
+			gpuFrequency,
+			memFrequency,
+			power_usage,
+			tempDouble,
+			energyJoules,
+			powerStats.min,
+			powerStats.max,
+			powerStats.mean,
+			powerStats.p99,
+			utilizationStats.min,
+			utilizationStats.max,
+			utilizationStats.mean,
+			utilizationStats.p99
+		};
+	}
+
+	void NVML::sample(std::vector<GPULabel>& labels, std::vector<GPUMetrics>& metrics)
+	{
+		auto begin = std::chrono::steady_clock::now();
+
+		auto task = [&](std::size_t i) {
+			auto index = labels[i].index;   // 关键：由 label 决定设备
+			if (index >= devices.size() || devices[index].handle == nullptr) {
+				throw hwgauge::RecoverableError("NVML device handle not resolved");
 			}
-			else tempDouble = static_cast<double>(temperature);
+			metrics[i] = sampleDevice(index, devices[index]);
+		};
+
+		if (pool)pool->parallelFor(labels.size(), task);
+		else for (std::size_t i = 0; i < labels.size(); ++i)task(i);
+
+		spdlog::debug("[NVML] Sampled {} GPUs in {} us", labels.size(),
+			std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count());
+	}
 
-			metrics.emplace_back(GPUMetrics{
-					gpuUtilization,
-					memoryUtilization,
-					gpuFrequency,
-					memFrequency,
-					power_usage,
-					tempDouble
-				});
+	bool NVML::rawSamples(std::string& payload)
+	{
+		if (!keepRaw)return false;
+
+		rawLabels.clear();
+		rawValues.clear();
+		auto append = [this](std::size_t index, const char* kind, const SampleStream& stream) {
+			for (std::size_t i = 0; i < stream.values.size(); ++i)
+			{
+				rawLabels.push_back(GPUSampleLabel{ index, kind, static_cast<long long>(stream.times[i]) });
+				rawValues.push_back(GPUSample{ stream.values[i] });
+			}
+		};
+		for (std::size_t index = 0; index < devices.size(); ++index)
+		{
+			append(index, "power", devices[index].power);
+			append(index, "utilization", devices[index].utilization);
 		}
+		if (rawLabels.empty())return false;
 
-		return metrics;
+		encodePayload(payload, rawLabels, rawValues);
+		return true;
 	}
 }
-#endif
\ No newline at end of file
+#endif
@@ -3,13 +3,19 @@
 #ifdef HWGAUGE_USE_NVML
 
 #include "GPUMetrics.hpp"
+#include "Collector/Common/Config.hpp"
+#include "Collector/Common/Energy.hpp"
+#include "Collector/Common/ThreadPool.hpp"
+#include <memory>
 #include <string>
 #include <vector>
 
+struct nvmlDevice_st;
+
 namespace hwgauge {
 	class NVML {
 	public:
-		explicit NVML();
+		explicit NVML(const CollectorConfig& cfg);
 		~NVML();
 
 		NVML(const NVML&) = delete;
@@ -20,10 +26,51 @@ namespace hwgauge {
 
 		std::string name() { return "gpu"; }
 		std::vector<GPULabel> labels();
-		std::vector<GPUMetrics> sample(std::vector<GPULabel>&labels);
+		void sample(std::vector<GPULabel>& labels, std::vector<GPUMetrics>& metrics);
+
+		// 编码本轮的原始子样本 (GPUSampleLabel / GPUSample)，未开启或没有样本时返回 false
+		bool rawSamples(std::string& payload);
 
 	private:
 		bool initialized = false;
+
+		// 驱动采样缓冲区中的一类样本 (功率 / 利用率)，每轮取回上次时间戳之后的部分
+		struct SampleStream
+		{
+			bool supported = true;
+			unsigned long long lastSeen = 0;          // 已取回的最新样本时间戳 (us)
+			std::vector<double> values;               // 本轮样本，按时间顺序
+			std::vector<unsigned long long> times;
+			std::vector<double> sorted;               // 计算分位数用的副本
+		};
+
+		// 设备句柄与逐设备状态在 labels() 中建立，sample() 中不再查询句柄
+		struct Device
+		{
+			nvmlDevice_st* handle = nullptr;
+			bool fieldValues = true;     // 驱动支持 nvmlDeviceGetFieldValues
+			unsigned failing = 0;        // 已告警的失败项（位掩码），恢复后清除，避免每轮刷屏
+
+			// 累计能耗：优先使用驱动的能耗计数器，不支持时对功率积分
+			bool hardwareEnergy = true;
+			EnergyCounter counter;
+			EnergyIntegrator integrator;
+
+			SampleStream power;
+			SampleStream utilization;
+		};
+		std::vector<Device> devices;
+		bool keepRaw = false;
+
+		std::vector<GPUSampleLabel> rawLabels;
+		std::vector<GPUSample> rawValues;
+
+		// 多卡时并行采样，每个任务只访问自己的 Device 与输出槽
+		std::unique_ptr<ThreadPool> pool;
+
+		static GPUMetrics sampleDevice(std::size_t index, Device& device);
+		// 取回上次时间戳之后的功率 (power=true) 或 GPU 利用率样本
+		static void drainSamples(std::size_t index, Device& device, SampleStream& stream, bool power);
 	};
 }
-#endif
\ No newline at end of file
+#endif
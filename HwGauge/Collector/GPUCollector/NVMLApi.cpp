@@ -0,0 +1,79 @@
+#ifdef HWGAUGE_USE_NVML
+
+#include "NVMLApi.hpp"
+#include "Collector/Common/DynamicLibrary.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "spdlog/spdlog.h"
+
+// 两层展开：nvml.h 把 nvmlInit 定义为 nvmlInit_v2 等宏时取得真实的符号名
+#define HWGAUGE_NVML_STRINGIFY_(x) #x
+#define HWGAUGE_NVML_STRINGIFY(x) HWGAUGE_NVML_STRINGIFY_(x)
+
+namespace hwgauge
+{
+    namespace
+    {
+        std::vector<std::string> candidates()
+        {
+            std::vector<std::string> names;
+            if (const char* env = std::getenv("HWGAUGE_NVML_LIBRARY"))names.emplace_back(env);
+#ifdef HWGAUGE_NVML_LIBRARY
+            names.emplace_back(HWGAUGE_NVML_LIBRARY);
+#endif
+#ifdef _WIN32
+            names.emplace_back("nvml.dll");
+#else
+            names.emplace_back("libnvidia-ml.so.1");
+            names.emplace_back("libnvidia-ml.so");
+#endif
+            return names;
+        }
+
+        NVMLApi* load()
+        {
+            // 函数表与库句柄不释放：采集器可能在静态析构阶段才调用 nvmlShutdown
+            auto api = std::make_unique<NVMLApi>();
+            api->library = std::make_unique<DynamicLibrary>(candidates());
+            const DynamicLibrary& library = *api->library;
+            if (!library.loaded())
+            {
+                spdlog::info("[NVMLApi] NVML library not found, GPU collectors disabled ({})", library.error());
+                return nullptr;
+            }
+
+            bool complete = true;
+#define HWGAUGE_NVML_REQUIRE(fn) \
+            if (!library.resolve(api->fn, HWGAUGE_NVML_STRINGIFY(fn))) \
+            { \
+                spdlog::warn("[NVMLApi] {} has no symbol {}", library.name(), HWGAUGE_NVML_STRINGIFY(fn)); \
+                complete = false; \
+            }
+            HWGAUGE_NVML_REQUIRED(HWGAUGE_NVML_REQUIRE)
+#undef HWGAUGE_NVML_REQUIRE
+            if (!complete)return nullptr;
+
+#define HWGAUGE_NVML_OPTION(fn) \
+            if (!library.resolve(api->fn, HWGAUGE_NVML_STRINGIFY(fn))) \
+            { \
+                spdlog::info("[NVMLApi] {} has no symbol {}", library.name(), HWGAUGE_NVML_STRINGIFY(fn)); \
+                bindMissing<NVML_ERROR_FUNCTION_NOT_FOUND>(api->fn); \
+            }
+            HWGAUGE_NVML_OPTIONAL(HWGAUGE_NVML_OPTION)
+#undef HWGAUGE_NVML_OPTION
+
+            spdlog::info("[NVMLApi] Loaded {}", library.name());
+            return api.release();
+        }
+    }
+
+    const NVMLApi* nvmlApi()
+    {
+        static const NVMLApi* api = load();
+        return api;
+    }
+}
+
+#endif
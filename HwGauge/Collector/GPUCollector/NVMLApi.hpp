@@ -0,0 +1,56 @@
+#pragma once
+
+#ifdef HWGAUGE_USE_NVML
+
+#include <nvml.h>
+#include <memory>
+
+namespace hwgauge
+{
+    class DynamicLibrary;
+
+    // 必需的函数：缺少任意一个即视为 NVML 不可用
+#define HWGAUGE_NVML_REQUIRED(X) \
+    X(nvmlInit) \
+    X(nvmlShutdown) \
+    X(nvmlErrorString) \
+    X(nvmlDeviceGetCount) \
+    X(nvmlDeviceGetHandleByIndex)
+
+    // 可选的函数：旧驱动缺少时返回 NVML_ERROR_FUNCTION_NOT_FOUND
+#define HWGAUGE_NVML_OPTIONAL(X) \
+    X(nvmlDeviceGetName) \
+    X(nvmlDeviceGetUtilizationRates) \
+    X(nvmlDeviceGetClockInfo) \
+    X(nvmlDeviceGetPowerUsage) \
+    X(nvmlDeviceGetTemperature) \
+    X(nvmlDeviceGetTotalEnergyConsumption) \
+    X(nvmlDeviceGetFieldValues) \
+    X(nvmlDeviceGetSamples) \
+    X(nvmlDeviceGetComputeRunningProcesses) \
+    X(nvmlDeviceGetProcessUtilization)
+
+    /**
+     * 运行时从 libnvidia-ml 解析的函数表
+     * 成员名与 nvml.h 中的函数同名（nvml.h 把 nvmlInit 等定义为带版本后缀的宏时，成员名与符号名一起展开），
+     * 调用方式为 nvmlApi()->nvmlDeviceGetCount(...)。
+     */
+    struct NVMLApi
+    {
+#define HWGAUGE_NVML_MEMBER(fn) decltype(&::fn) fn = nullptr;
+        HWGAUGE_NVML_REQUIRED(HWGAUGE_NVML_MEMBER)
+        HWGAUGE_NVML_OPTIONAL(HWGAUGE_NVML_MEMBER)
+#undef HWGAUGE_NVML_MEMBER
+
+        std::unique_ptr<DynamicLibrary> library;
+    };
+
+    /**
+     * 首次调用时加载 NVML 并解析函数表，之后直接返回缓存（线程安全）
+     * 库不存在或缺少必需函数时返回 nullptr，GPU 采集器应被跳过。
+     * 查找顺序：环境变量 HWGAUGE_NVML_LIBRARY、编译时指定的路径 (模拟库)、系统中的 libnvidia-ml.so.1
+     */
+    const NVMLApi* nvmlApi();
+}
+
+#endif
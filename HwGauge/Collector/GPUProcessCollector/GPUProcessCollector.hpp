@@ -0,0 +1,61 @@
+#pragma once
+
+#ifdef HWGAUGE_USE_NVML
+
+#include "Collector/Base/DeviceCollector.hpp"
+#include "NVMLProcess.hpp"
+#include "GPUProcessDatabase.hpp"
+#include "GPUProcessCsvLogger.hpp"
+#include "GPUProcessPrometheus.hpp"
+
+#include <iostream>
+
+namespace hwgauge
+{
+#ifdef HWGAUGE_USE_POSTGRESQL
+    using GPUProcessDatabaseType = GPUProcessDatabase;
+#else
+    using GPUProcessDatabaseType = NullType;
+#endif
+
+#ifdef HWGAUGE_USE_PROMETHEUS
+    using GPUProcessPrometheusType = GPUProcessPrometheus;
+#else
+    using GPUProcessPrometheusType = NullType;
+#endif
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+    using GPUProcessHttpApiType = HttpApi<GPUProcessLabel, GPUProcessMetrics>;
+#else
+    using GPUProcessHttpApiType = NullType;
+#endif
+    // 定义别名
+    using GPUProcessCollector = DeviceCollector<
+        GPUProcessLabel, GPUProcessMetrics, NVMLProcess, GPUProcessDatabaseType, GPUProcessCsvLogger, GPUProcessPrometheusType, GPUProcessHttpApiType
+    >;
+    
+    // 定义特定的打印函数，空位置不打印
+    template<>
+    inline void printMetric(const GPUProcessLabel& l, const GPUProcessMetrics& m)
+    {
+        if (m.pid < 0)return;
+        std::cout
+            << "GPUProcess{ "
+            << "gpu="     << l.gpu
+            << ", rank=" << l.rank
+            << ", pid=" << m.pid
+            << ", name=" << m.name
+            << ", container=" << m.container
+            << ", memory=" << m.usedMemory << "MiB"
+            << ", smUtil=" << m.smUtilization
+            << ", memUtil=" << m.memoryUtilization
+            << " }\n";
+    }
+
+    // 进程数据不参与全局功耗统计
+    template<>
+    inline void setContextInfo(std::vector<GPUProcessLabel>&, std::vector<GPUProcessMetrics>&, TickContext&)
+    {}
+}
+
+#endif
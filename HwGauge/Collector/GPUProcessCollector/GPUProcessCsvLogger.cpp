@@ -0,0 +1,43 @@
+#ifdef HWGAUGE_USE_NVML
+
+#include "GPUProcessCsvLogger.hpp"
+#include <sstream>
+#include <iomanip>
+
+namespace hwgauge
+{
+    GPUProcessCsvLogger::GPUProcessCsvLogger(const std::string& filepath) : CsvLogger(filepath) 
+    {
+        auto pos = m_filepath.rfind(".csv");
+        if (pos != std::string::npos) {
+            m_filepath.insert(pos, "_gpu_process");
+        }
+
+        m_ofs.open(m_filepath, std::ios::out | std::ios::app);
+        
+        if (!m_ofs.is_open()) {
+            spdlog::error("[GPUProcessCsvLogger] Failed to open file: {}", m_filepath);
+            throw FatalError("GPUProcessCsvLogger open failed: " + m_filepath);
+        }
+        spdlog::info("[GPUProcessCsvLogger] Initialized logger for: {}", m_filepath);
+    }
+
+    std::string GPUProcessCsvLogger::getHeader() const {
+        return "GPU,Rank,PID,Name,Container,Cgroup,Memory(MiB),SmUtil(%),MemUtil(%)";
+    }
+
+    std::string GPUProcessCsvLogger::formatRow(const GPUProcessLabel& l, const GPUProcessMetrics& m) const {
+        std::stringstream ss;
+        ss << l.gpu << ","
+           << l.rank << ","
+           << m.pid << ","
+           << "\"" << m.name << "\","
+           << m.container << ","
+           << "\"" << m.cgroup << "\","
+           << std::fixed << std::setprecision(1) << m.usedMemory << ","
+           << std::fixed << std::setprecision(1) << m.smUtilization << ","
+           << std::fixed << std::setprecision(1) << m.memoryUtilization;
+        return ss.str();
+    }
+}
+#endif
@@ -0,0 +1,20 @@
+#pragma once
+#ifdef HWGAUGE_USE_NVML
+
+#include "Collector/Base/CsvLogger.hpp"
+#include "GPUProcessMetrics.hpp"
+
+namespace hwgauge
+{
+    class GPUProcessCsvLogger : public CsvLogger<GPUProcessLabel, GPUProcessMetrics>
+    {
+    public:
+        explicit GPUProcessCsvLogger(const std::string& filepath);
+
+    protected:
+        std::string getHeader() const override;
+        std::string formatRow(const GPUProcessLabel& l, const GPUProcessMetrics& m) const override;
+    };
+}
+
+#endif
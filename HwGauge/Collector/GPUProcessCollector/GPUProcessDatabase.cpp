@@ -0,0 +1,129 @@
+#ifdef HWGAUGE_USE_POSTGRESQL
+
+#include "GPUProcessDatabase.hpp"
+
+#include "spdlog/spdlog.h"
+
+namespace hwgauge
+{
+    GPUProcessDatabase::GPUProcessDatabase(const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<GPUProcessLabel, GPUProcessMetrics>(config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    GPUProcessDatabase::GPUProcessDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<GPUProcessLabel, GPUProcessMetrics>(shared_conn, config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    void GPUProcessDatabase::setup(const std::string& table_name_prefix)
+    {
+        // 设置表名
+        metric_table_name = table_name_prefix + "_gpu_process_metric";
+        // 创建表
+        if (!createMetricTable())throw hwgauge::FatalError("[Database] Create Table Failed");
+        // 构建SQL模板
+        metric_copy_sql =
+            "COPY " + metric_table_name +
+            " (timestamp, gpu_index, rank, pid, process_name, container_id, cgroup, "
+            "memory_used_mib, sm_utilization, memory_utilization, seq) "
+            "FROM STDIN;";
+
+        spdlog::info("[GPUProcessDatabase] Initialize successfully");
+    }
+
+    GPUProcessDatabase::~GPUProcessDatabase(){}
+
+    bool GPUProcessDatabase::createMetricTable()
+    {
+        const std::string sql =
+            "CREATE TABLE IF NOT EXISTS " + metric_table_name + " ("
+            "timestamp TIMESTAMPTZ NOT NULL,"          // 时间戳
+            "gpu_index INTEGER NOT NULL,"             // GPU索引
+            "rank INTEGER NOT NULL,"                  // 按显存占用的排名
+            "pid BIGINT NOT NULL,"                    // 进程号
+            "process_name TEXT,"                      // 进程名 (comm)
+            "container_id VARCHAR(64),"               // 容器 ID，非容器进程为空
+            "cgroup TEXT,"                            // cgroup 路径
+            "memory_used_mib DOUBLE PRECISION,"       // 显存占用(MiB)
+            "sm_utilization DOUBLE PRECISION,"        // SM 利用率(%)
+            "memory_utilization DOUBLE PRECISION"     // 显存带宽利用率(%)
+            ");";
+
+        if (!execSQL(sql))
+        {
+            spdlog::error("[GPUProcessDatabase] Failed to create metric table");
+            return false;
+        }
+        if (!upgradeTimestampColumn(metric_table_name))
+        {
+            spdlog::error("[GPUProcessDatabase] Failed to convert timestamp column to TIMESTAMPTZ");
+            return false;
+        }
+        if (!addSeqColumn(metric_table_name))
+        {
+            spdlog::error("[GPUProcessDatabase] Failed to add seq column");
+            return false;
+        }
+        spdlog::info("[GPUProcessDatabase] Table {} created or already exists", metric_table_name);
+        return true;
+    }
+
+    bool GPUProcessDatabase::createInfoTable()
+    {
+        return true;
+    }
+
+    void GPUProcessDatabase::writeMetric(TimePoint cur_time, std::uint64_t seq,
+                                const std::vector<GPUProcessLabel>& label_list,
+                                const std::vector<GPUProcessMetrics>& metric_list,
+                                bool)
+    {
+        if (!isConnected())throw hwgauge::FatalError("[GPUProcessDatabase] The database hasn't been connected before writing");
+
+        copy_buf.clear();
+        size_t rows = 0;
+        for (size_t i = 0; i < label_list.size(); ++i)
+        {
+            const auto& l = label_list[i];
+            const auto& m = metric_list[i];
+            if (m.pid < 0)continue;
+
+            appendCopyField(copy_buf, cur_time);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, static_cast<long long>(l.gpu));
+            copy_buf += '\t';
+            appendCopyField(copy_buf, static_cast<long long>(l.rank));
+            copy_buf += '\t';
+            appendCopyField(copy_buf, m.pid);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, m.name);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, m.container);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, m.cgroup);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, m.usedMemory);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, m.smUtilization);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, m.memoryUtilization);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, seqValue(seq));
+            copy_buf += '\n';
+            ++rows;
+        }
+        if (rows == 0)return;
+
+        if (!copyIn(metric_copy_sql, copy_buf))return;
+        HWGAUGE_LOG_COUNT("GPUProcessDatabase records", rows);
+    }
+
+    void GPUProcessDatabase::writeInfo(const std::vector<GPUProcessLabel>&, bool)
+    {
+    }
+}
+
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+
+#ifdef HWGAUGE_USE_POSTGRESQL
+
+#include "GPUProcessMetrics.hpp"
+#include "Collector/Common/Config.hpp"
+#include "Collector/Base/Database.hpp"
+
+namespace hwgauge
+{
+    /* GPU 进程数据库操作类，只写入有进程的位置，使用 COPY 批量写入 */
+    class GPUProcessDatabase : public Database<GPUProcessLabel, GPUProcessMetrics>
+    {
+    public:
+        /* 构造函数 */
+        explicit GPUProcessDatabase(const DBConfig& config_, const std::string& table_name_prefix);
+
+        /* 构造函数：复用外部连接 */
+        GPUProcessDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix);
+        
+        /* 析构函数 */
+        ~GPUProcessDatabase();
+        
+        /* 写入进程数据 */
+        void writeMetric(TimePoint cur_time, std::uint64_t seq,
+                        const std::vector<GPUProcessLabel>& label_list, 
+                        const std::vector<GPUProcessMetrics>& metric_list,
+                        bool useTransaction = true) override;
+        
+        /* 进程位置没有静态信息（设备信息由 GPUDatabase 维护） */
+        void writeInfo(const std::vector<GPUProcessLabel>& label_list,
+                      bool useTransaction = true) override;
+        
+    private:
+        /* 设置表名、建表并构建SQL模板 */
+        void setup(const std::string& table_name_prefix);
+
+        /* 创建指标数据表 */
+        bool createMetricTable() override;
+        /* 创建静态数据表 */
+        bool createInfoTable() override;
+
+        std::string metric_copy_sql;    // COPY 语句
+        std::string copy_buf;           // 复用的 COPY 数据缓冲
+    };
+}
+
+#endif
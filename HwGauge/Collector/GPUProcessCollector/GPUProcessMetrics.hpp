@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Collector/Common/Fields.hpp"
+#include <string>
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+#include <nlohmann/json.hpp>
+#endif
+
+namespace hwgauge
+{
+    // 每块 GPU 固定 N 个位置（按显存占用排序），行数不随进程变化
+    struct GPUProcessLabel
+    {
+        std::size_t index;      // 行号 = gpu * N + rank
+        std::size_t gpu;        // GPU 索引
+        std::size_t rank;       // 在该 GPU 上的排名，0 为显存占用最多
+    };
+
+    // pid 为 -1 表示该位置当前没有进程；不可用的数值为 -1
+    struct GPUProcessMetrics
+    {
+        long long pid;
+        std::string name;               // /proc/<pid>/comm
+        std::string container;          // 容器 ID (前 12 位)，非容器进程为空
+        std::string cgroup;             // cgroup 路径
+        double usedMemory;              // 显存占用 (MiB)
+        double smUtilization;           // 周期内 SM 利用率 (%)
+        double memoryUtilization;       // 周期内显存带宽利用率 (%)
+    };
+
+    template<>
+    struct Fields<GPUProcessLabel>
+    {
+        template<typename T, typename F>
+        static void visit(T& l, F&& f)
+        {
+            f("index", l.index);
+            f("gpu", l.gpu);
+            f("rank", l.rank);
+        }
+    };
+
+    template<>
+    struct Fields<GPUProcessMetrics>
+    {
+        template<typename T, typename F>
+        static void visit(T& m, F&& f)
+        {
+            f("pid", m.pid);
+            f("name", m.name);
+            f("container", m.container);
+            f("cgroup", m.cgroup);
+            f("usedMemory", m.usedMemory);
+            f("smUtilization", m.smUtilization);
+            f("memoryUtilization", m.memoryUtilization);
+        }
+    };
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+    inline void to_json(nlohmann::json& j, const GPUProcessLabel& l) {
+        j = nlohmann::json{{"index", l.index}, {"gpu", l.gpu}, {"rank", l.rank}};
+    }
+
+    inline void to_json(nlohmann::json& j, const GPUProcessMetrics& m) {
+        j = nlohmann::json{
+            {"pid", m.pid},
+            {"name", m.name},
+            {"container", m.container},
+            {"cgroup", m.cgroup},
+            {"usedMemory", m.usedMemory},
+            {"smUtilization", m.smUtilization},
+            {"memoryUtilization", m.memoryUtilization}
+        };
+    }
+#endif
+}
@@ -0,0 +1,85 @@
+#if defined(HWGAUGE_USE_NVML) && defined(HWGAUGE_USE_PROMETHEUS)
+
+#include "GPUProcessPrometheus.hpp"
+
+namespace hwgauge
+{
+    GPUProcessPrometheus::GPUProcessPrometheus(std::shared_ptr<prometheus::Registry> registry_)
+        : Prometheus<GPUProcessLabel, GPUProcessMetrics>(registry_)
+    {
+        // 创建指标族（Families）
+        static const std::array<std::pair<const char*, const char*>, kMetricCount> specs = {{
+            {"gpu_process_memory_used_bytes", "GPU memory used by the process in bytes"},
+            {"gpu_process_sm_utilization_percent", "SM utilization of the process over the last interval"},
+            {"gpu_process_memory_utilization_percent", "Memory bandwidth utilization of the process over the last interval"},
+        }};
+
+        auto& registry_ref = *registry;
+        for (std::size_t k = 0; k < kMetricCount; ++k)
+        {
+            families[k] = &prometheus::BuildGauge()
+                .Name(specs[k].first)
+                .Help(specs[k].second)
+                .Register(registry_ref);
+        }
+    }
+
+    void GPUProcessPrometheus::remove(Series& s)
+    {
+        for (std::size_t k = 0; k < kMetricCount; ++k)
+        {
+            if (s.gauges[k])families[k]->Remove(s.gauges[k]);
+            s.gauges[k] = nullptr;
+        }
+    }
+
+    void GPUProcessPrometheus::write(const std::vector<GPUProcessLabel>& label_list,const std::vector<GPUProcessMetrics>& metric_list)
+    {
+        for (auto& [key, s] : series)s.seen = false;
+
+        for (size_t i = 0; i < label_list.size(); i++)
+        {
+            const auto& label = label_list[i];
+            const auto& metric = metric_list[i];
+            if (metric.pid < 0)continue;
+
+            auto [it, inserted] = series.try_emplace(std::make_pair(label.gpu, metric.pid));
+            Series& s = it->second;
+            s.seen = true;
+
+            const double values[kMetricCount] = {
+                metric.usedMemory < 0.0 ? -1.0 : metric.usedMemory * 1024.0 * 1024.0,
+                metric.smUtilization,
+                metric.memoryUtilization
+            };
+            for (std::size_t k = 0; k < kMetricCount; ++k)
+            {
+                if (values[k] == -1.0)continue;
+                if (!s.gauges[k])
+                {
+                    s.gauges[k] = &families[k]->Add({
+                        {"gpu", std::to_string(label.gpu)},
+                        {"pid", std::to_string(metric.pid)},
+                        {"process", metric.name},
+                        {"container", metric.container}
+                    });
+                }
+                s.gauges[k]->Set(values[k]);
+            }
+        }
+
+        // 已退出或跌出前 N 名的进程
+        for (auto it = series.begin(); it != series.end();)
+        {
+            if (it->second.seen)
+            {
+                ++it;
+                continue;
+            }
+            remove(it->second);
+            it = series.erase(it);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,44 @@
+#pragma once
+
+#if defined(HWGAUGE_USE_NVML) && defined(HWGAUGE_USE_PROMETHEUS)
+
+#include "Collector/Base/Prometheus.hpp"
+#include "GPUProcessMetrics.hpp"
+
+#include <array>
+#include <map>
+#include <utility>
+
+namespace hwgauge
+{
+    /**
+     * 每个 (GPU, PID) 一组序列，标签包含进程名与容器 ID；
+     * 进程退出或跌出前 N 名时删除对应序列，序列数不超过 GPU 数 × N
+     */
+    class GPUProcessPrometheus:public Prometheus<GPUProcessLabel,GPUProcessMetrics>
+    {
+    public:
+        static constexpr std::size_t kMetricCount = 3;
+
+        explicit GPUProcessPrometheus(std::shared_ptr<prometheus::Registry> registry_);
+        
+        virtual ~GPUProcessPrometheus() = default;
+
+        void write(const std::vector<GPUProcessLabel>& label_list,const std::vector<GPUProcessMetrics>& metric_list);
+    private:
+        struct Series
+        {
+            std::array<prometheus::Gauge*, kMetricCount> gauges{};
+            bool seen = false;
+        };
+
+        void remove(Series& series);
+
+        // 显存占用 (bytes) / SM 利用率 / 显存带宽利用率
+        std::array<prometheus::Family<prometheus::Gauge>*, kMetricCount> families;
+
+        std::map<std::pair<std::size_t, long long>, Series> series;   // (gpu, pid)
+    };
+}
+
+#endif
@@ -0,0 +1,288 @@
+#ifdef HWGAUGE_USE_NVML
+
+#include "NVMLProcess.hpp"
+#include "Collector/Common/Exception.hpp"
+#ifdef __linux__
+#include "Collector/Common/SysfsFile.hpp"
+#endif
+
+#include "Collector/GPUCollector/NVMLApi.hpp"
+#include <algorithm>
+#include <cctype>
+#include "spdlog/spdlog.h"
+
+namespace hwgauge
+{
+    namespace
+    {
+        enum FailBit : unsigned
+        {
+            FailProcesses = 1u << 0,
+            FailUtilization = 1u << 1,
+        };
+
+        // 同一失败项只在第一次出现时告警
+        bool check(nvmlReturn_t status, unsigned& failing, FailBit bit, std::size_t gpu, const char* what)
+        {
+            if (status == NVML_SUCCESS)
+            {
+                failing &= ~static_cast<unsigned>(bit);
+                return true;
+            }
+            if (!(failing & bit))
+            {
+                spdlog::warn("[NVMLProcess] GPU {} get {} failed: {}, {}", gpu, what, nvmlApi()->nvmlErrorString(status), static_cast<int>(status));
+                failing |= bit;
+            }
+            return false;
+        }
+
+        // 本轮单块 GPU 上的一个进程
+        struct Entry
+        {
+            unsigned int pid;
+            double usedMemory;      // MiB
+            double smSum;
+            double memSum;
+            unsigned samples;
+        };
+
+        constexpr double kMiB = 1024.0 * 1024.0;
+    }
+
+    struct NVMLProcess::Buffers
+    {
+        std::vector<nvmlProcessInfo_t> processes;
+        std::vector<nvmlProcessUtilizationSample_t> utilization;
+        std::vector<Entry> entries;
+#ifdef __linux__
+        std::string text;
+#endif
+    };
+
+    void parseProcessCgroup(const std::string& text, std::string& cgroup, std::string& container)
+    {
+        cgroup.clear();
+        container.clear();
+
+        std::string fallback;
+        std::size_t begin = 0;
+        while (begin < text.size())
+        {
+            std::size_t end = text.find('\n', begin);
+            if (end == std::string::npos)end = text.size();
+            // hierarchy-ID:controller-list:cgroup-path
+            std::size_t first = text.find(':', begin);
+            std::size_t second = first < end ? text.find(':', first + 1) : std::string::npos;
+            if (second < end)
+            {
+                std::string path = text.substr(second + 1, end - second - 1);
+                std::string controllers = text.substr(first + 1, second - first - 1);
+                bool unified = second == first + 1 && text.compare(begin, first - begin, "0") == 0;
+                if (unified || controllers == "name=systemd")cgroup = path;
+                else if (fallback.empty())fallback = path;
+
+                // 容器 ID 是路径中 64 位十六进制串，例如 docker-<id>.scope / cri-containerd-<id>.scope / crio-<id>
+                if (container.empty())
+                {
+                    std::size_t run = 0;
+                    for (std::size_t i = 0; i <= path.size(); ++i)
+                    {
+                        if (i < path.size() && std::isxdigit(static_cast<unsigned char>(path[i])))
+                        {
+                            ++run;
+                            continue;
+                        }
+                        if (run == 64)
+                        {
+                            container = path.substr(i - 64, 12);
+                            break;
+                        }
+                        run = 0;
+                    }
+                }
+            }
+            begin = end + 1;
+        }
+        if (cgroup.empty())cgroup = std::move(fallback);
+    }
+
+    NVMLProcess::NVMLProcess(const CollectorConfig& cfg)
+        : topN(cfg.gpuProcessTopN), procRoot(cfg.hostRoot + "/proc"), buffers(std::make_unique<Buffers>())
+    {
+        if (topN == 0)throw RecoverableError("[NVMLProcess] Top-N must be at least 1");
+
+        if (!nvmlApi())throw RecoverableError("[NVMLProcess] NVML library not available");
+        nvmlReturn_t status = nvmlApi()->nvmlInit();
+        if (status != NVML_SUCCESS) {
+            throw RecoverableError(std::string("[NVMLProcess] Initialization failed: ") + nvmlApi()->nvmlErrorString(status));
+        }
+        initialized = true;
+    }
+
+    NVMLProcess::~NVMLProcess()
+    {
+        if (initialized)nvmlApi()->nvmlShutdown();
+    }
+
+    std::vector<GPUProcessLabel> NVMLProcess::labels()
+    {
+        unsigned int devicesCount = 0;
+        nvmlReturn_t status = nvmlApi()->nvmlDeviceGetCount(std::addressof(devicesCount));
+        if (status != NVML_SUCCESS) {
+            throw hwgauge::FatalError("NVML get devices count failed");
+        }
+
+        devices.assign(devicesCount, {});
+        std::vector<GPUProcessLabel> labels;
+        labels.reserve(devicesCount * topN);
+        for (unsigned int gpu = 0; gpu < devicesCount; gpu++)
+        {
+            nvmlDevice_t handle;
+            status = nvmlApi()->nvmlDeviceGetHandleByIndex(gpu, std::addressof(handle));
+            if (status != NVML_SUCCESS) {
+                throw hwgauge::FatalError("NVML get devices handle failed");
+            }
+            devices[gpu].handle = handle;
+
+            for (std::size_t rank = 0; rank < topN; ++rank)
+                labels.push_back(GPUProcessLabel{ labels.size(), gpu, rank });
+        }
+        spdlog::info("[NVMLProcess] Tracking top {} processes on {} GPUs", topN, devicesCount);
+        return labels;
+    }
+
+    const NVMLProcess::ProcessInfo& NVMLProcess::lookup(unsigned int pid)
+    {
+        auto [it, inserted] = processes.try_emplace(pid);
+        ProcessInfo& info = it->second;
+        info.seen = true;
+        if (!inserted)return info;
+
+#ifdef __linux__
+        // 新出现的进程只读取一次 comm 与 cgroup；容器中运行时需要 hostPID 或 --host-root 指向宿主机
+        std::string base = procRoot + "/" + std::to_string(pid);
+        SysfsFile comm(base + "/comm");
+        if (comm.readText(buffers->text))
+        {
+            info.name = buffers->text;
+            while (!info.name.empty() && info.name.back() == '\n')info.name.pop_back();
+        }
+        SysfsFile cgroup(base + "/cgroup");
+        if (cgroup.readText(buffers->text))parseProcessCgroup(buffers->text, info.cgroup, info.container);
+#endif
+        return info;
+    }
+
+    void NVMLProcess::sample(std::vector<GPUProcessLabel>&, std::vector<GPUProcessMetrics>& metrics)
+    {
+        // 空槽位 pid 为 -1；字符串只清空，保留容量供下一轮复用
+        for (auto& m : metrics)
+        {
+            m.pid = -1;
+            m.name.clear();
+            m.container.clear();
+            m.cgroup.clear();
+            m.usedMemory = m.smUtilization = m.memoryUtilization = -1.0;
+        }
+        for (auto& [pid, info] : processes)info.seen = false;
+
+        auto& processBuf = buffers->processes;
+        auto& utilBuf = buffers->utilization;
+        auto& entries = buffers->entries;
+        if (processBuf.empty())processBuf.resize(32);
+        if (utilBuf.empty())utilBuf.resize(64);
+
+        for (std::size_t gpu = 0; gpu < devices.size(); ++gpu)
+        {
+            Device& device = devices[gpu];
+            entries.clear();
+
+            // 计算进程与显存占用；缓冲区不足时按驱动返回的数量扩容后重试一次
+            unsigned int count = static_cast<unsigned int>(processBuf.size());
+            nvmlReturn_t status = nvmlApi()->nvmlDeviceGetComputeRunningProcesses(device.handle, &count, processBuf.data());
+            if (status == NVML_ERROR_INSUFFICIENT_SIZE)
+            {
+                processBuf.resize(static_cast<std::size_t>(count) + 8);
+                count = static_cast<unsigned int>(processBuf.size());
+                status = nvmlApi()->nvmlDeviceGetComputeRunningProcesses(device.handle, &count, processBuf.data());
+            }
+            if (!check(status, device.failing, FailProcesses, gpu, "compute processes"))continue;
+
+            for (unsigned int i = 0; i < count; ++i)
+            {
+                const auto& p = processBuf[i];
+                double used = p.usedGpuMemory == static_cast<unsigned long long>(NVML_VALUE_NOT_AVAILABLE)
+                    ? -1.0 : static_cast<double>(p.usedGpuMemory) / kMiB;
+                entries.push_back(Entry{ p.pid, used, 0.0, 0.0, 0 });
+            }
+            if (entries.empty())continue;
+
+            // 上次时间戳之后的进程利用率样本，同一进程的多个样本取平均
+            if (device.utilization)
+            {
+                count = static_cast<unsigned int>(utilBuf.size());
+                status = nvmlApi()->nvmlDeviceGetProcessUtilization(device.handle, utilBuf.data(), &count, device.lastSeen);
+                if (status == NVML_ERROR_INSUFFICIENT_SIZE)
+                {
+                    utilBuf.resize(static_cast<std::size_t>(count) + 16);
+                    count = static_cast<unsigned int>(utilBuf.size());
+                    status = nvmlApi()->nvmlDeviceGetProcessUtilization(device.handle, utilBuf.data(), &count, device.lastSeen);
+                }
+
+                if (status == NVML_ERROR_NOT_SUPPORTED || status == NVML_ERROR_FUNCTION_NOT_FOUND)
+                {
+                    device.utilization = false;
+                    spdlog::info("[NVMLProcess] GPU {} does not support per-process utilization", gpu);
+                }
+                else if (status != NVML_ERROR_NOT_FOUND &&
+                    check(status, device.failing, FailUtilization, gpu, "process utilization"))
+                {
+                    for (unsigned int i = 0; i < count; ++i)
+                    {
+                        const auto& s = utilBuf[i];
+                        device.lastSeen = std::max(device.lastSeen, s.timeStamp);
+                        auto it = std::find_if(entries.begin(), entries.end(), [&](const Entry& e) { return e.pid == s.pid; });
+                        if (it == entries.end())continue;
+                        it->smSum += s.smUtil;
+                        it->memSum += s.memUtil;
+                        ++it->samples;
+                    }
+                }
+            }
+
+            // 按显存占用取前 N 个，显存相同时按 SM 利用率
+            std::size_t n = std::min(topN, entries.size());
+            std::partial_sort(entries.begin(), entries.begin() + static_cast<std::ptrdiff_t>(n), entries.end(),
+                [](const Entry& a, const Entry& b) {
+                    if (a.usedMemory != b.usedMemory)return a.usedMemory > b.usedMemory;
+                    double sa = a.samples ? a.smSum / a.samples : -1.0;
+                    double sb = b.samples ? b.smSum / b.samples : -1.0;
+                    return sa > sb;
+                });
+
+            for (std::size_t rank = 0; rank < n; ++rank)
+            {
+                const Entry& e = entries[rank];
+                const ProcessInfo& info = lookup(e.pid);
+                auto& m = metrics[gpu * topN + rank];
+                m.pid = e.pid;
+                m.name = info.name;
+                m.container = info.container;
+                m.cgroup = info.cgroup;
+                m.usedMemory = e.usedMemory;
+                m.smUtilization = e.samples ? e.smSum / e.samples : -1.0;
+                m.memoryUtilization = e.samples ? e.memSum / e.samples : -1.0;
+            }
+        }
+
+        // 本轮不在任何 GPU 前 N 名中的进程不再缓存（PID 可能被复用）
+        for (auto it = processes.begin(); it != processes.end();)
+        {
+            if (it->second.seen)++it;
+            else it = processes.erase(it);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,69 @@
+#pragma once
+
+#ifdef HWGAUGE_USE_NVML
+
+#include "GPUProcessMetrics.hpp"
+#include "Collector/Common/Config.hpp"
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct nvmlDevice_st;
+
+namespace hwgauge
+{
+    /**
+     * GPU 进程统计
+     * 每轮对每块 GPU 调用 nvmlDeviceGetComputeRunningProcesses 与 nvmlDeviceGetProcessUtilization
+     * （取上次时间戳之后的样本求平均），按显存占用取前 N 个进程，并关联 /proc/<pid>/cgroup 得到容器 ID。
+     * NVML 缓冲区与进程信息缓存在各轮之间复用。
+     */
+    class NVMLProcess
+    {
+    public:
+        explicit NVMLProcess(const CollectorConfig& cfg);
+        ~NVMLProcess();
+
+        NVMLProcess(const NVMLProcess&) = delete;
+        NVMLProcess& operator=(const NVMLProcess&) = delete;
+
+        std::string name() { return "gpu_process"; }
+        std::vector<GPUProcessLabel> labels();
+        void sample(std::vector<GPUProcessLabel>& labels, std::vector<GPUProcessMetrics>& metrics);
+
+    private:
+        struct Device
+        {
+            nvmlDevice_st* handle = nullptr;
+            bool utilization = true;             // 支持 nvmlDeviceGetProcessUtilization
+            unsigned long long lastSeen = 0;     // 已取回的最新利用率样本时间戳 (us)
+            unsigned failing = 0;                // 已告警的失败项，恢复后清除
+        };
+
+        // 进程静态信息，进程离开所有 GPU 后淘汰
+        struct ProcessInfo
+        {
+            std::string name;
+            std::string container;
+            std::string cgroup;
+            bool seen = false;
+        };
+
+        struct Buffers;     // NVML 结构体缓冲区，定义在 .cpp 中
+
+        const ProcessInfo& lookup(unsigned int pid);
+
+        bool initialized = false;
+        std::size_t topN;
+        std::string procRoot;
+        std::vector<Device> devices;
+        std::unique_ptr<Buffers> buffers;
+        std::unordered_map<unsigned int, ProcessInfo> processes;
+    };
+
+    // 从 /proc/<pid>/cgroup 的内容中取 cgroup 路径与容器 ID (docker / containerd / cri-o / podman)
+    void parseProcessCgroup(const std::string& text, std::string& cgroup, std::string& container);
+}
+
+#endif
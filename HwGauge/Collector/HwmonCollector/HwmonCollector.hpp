@@ -0,0 +1,55 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "Collector/Base/DeviceCollector.hpp"
+#include "HwmonImpl.hpp"
+#include "HwmonDatabase.hpp"
+#include "HwmonCsvLogger.hpp"
+#include "HwmonPrometheus.hpp"
+
+#include <iostream>
+
+namespace hwgauge
+{
+#ifdef HWGAUGE_USE_POSTGRESQL
+    using HwmonDatabaseType = HwmonDatabase;
+#else
+    using HwmonDatabaseType = NullType;
+#endif
+
+#ifdef HWGAUGE_USE_PROMETHEUS
+    using HwmonPrometheusType = HwmonPrometheus;
+#else
+    using HwmonPrometheusType = NullType;
+#endif
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+    using HwmonHttpApiType = HttpApi<HwmonLabel, HwmonMetrics>;
+#else
+    using HwmonHttpApiType = NullType;
+#endif
+    // 定义别名
+    using HwmonCollector = DeviceCollector<
+        HwmonLabel, HwmonMetrics, HwmonImpl, HwmonDatabaseType, HwmonCsvLogger, HwmonPrometheusType, HwmonHttpApiType
+    >;
+    
+    // 定义特定的打印函数
+    template<>
+    inline void printMetric(const HwmonLabel& l, const HwmonMetrics& m)
+    {
+        std::cout
+            << "Hwmon{ "
+            << l.device << "/" << l.sensor
+            << " (" << l.chip << ", " << l.label << ")"
+            << ", " << l.kind << "=" << m.value
+            << " }\n";
+    }
+
+    // 传感器读数不参与全局功耗统计
+    template<>
+    inline void setContextInfo(std::vector<HwmonLabel>&, std::vector<HwmonMetrics>&, TickContext&)
+    {}
+}
+
+#endif
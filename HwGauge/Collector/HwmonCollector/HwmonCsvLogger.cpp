@@ -0,0 +1,44 @@
+#ifdef __linux__
+
+#include "HwmonCsvLogger.hpp"
+#include <sstream>
+#include <iomanip>
+
+namespace hwgauge
+{
+    HwmonCsvLogger::HwmonCsvLogger(const std::string& filepath) : CsvLogger(filepath) 
+    {
+        auto pos = m_filepath.rfind(".csv");
+        if (pos != std::string::npos) {
+            m_filepath.insert(pos, "_hwmon");
+        }
+
+        m_ofs.open(m_filepath, std::ios::out | std::ios::app);
+        
+        if (!m_ofs.is_open()) {
+            spdlog::error("[HwmonCsvLogger] Failed to open file: {}", m_filepath);
+            throw FatalError("HwmonCsvLogger open failed: " + m_filepath);
+        }
+        spdlog::info("[HwmonCsvLogger] Initialized logger for: {}", m_filepath);
+    }
+
+    std::string HwmonCsvLogger::getHeader() const {
+        return "Index,Chip,Device,Sensor,Label,Kind,Value";
+    }
+
+    std::string HwmonCsvLogger::formatRow(const HwmonLabel& l, const HwmonMetrics& m) const {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(3); // 电压需要毫伏精度
+
+        ss << l.index << ","
+           << l.chip << ","
+           << l.device << ","
+           << l.sensor << ","
+           << "\"" << l.label << "\","
+           << l.kind << ","
+           << m.value;
+        
+        return ss.str();
+    }
+}
+#endif
@@ -0,0 +1,20 @@
+#pragma once
+#ifdef __linux__
+
+#include "Collector/Base/CsvLogger.hpp"
+#include "HwmonMetrics.hpp"
+
+namespace hwgauge
+{
+    class HwmonCsvLogger : public CsvLogger<HwmonLabel, HwmonMetrics>
+    {
+    public:
+        explicit HwmonCsvLogger(const std::string& filepath);
+
+    protected:
+        std::string getHeader() const override;
+        std::string formatRow(const HwmonLabel& l, const HwmonMetrics& m) const override;
+    };
+}
+
+#endif
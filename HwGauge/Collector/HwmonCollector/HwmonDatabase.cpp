@@ -0,0 +1,155 @@
+#if defined(__linux__) && defined(HWGAUGE_USE_POSTGRESQL)
+
+#include "HwmonDatabase.hpp"
+
+#include "spdlog/spdlog.h"
+
+namespace hwgauge
+{
+    HwmonDatabase::HwmonDatabase(const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<HwmonLabel, HwmonMetrics>(config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    HwmonDatabase::HwmonDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<HwmonLabel, HwmonMetrics>(shared_conn, config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    void HwmonDatabase::setup(const std::string& table_name_prefix)
+    {
+        // 设置表名
+        metric_table_name = table_name_prefix + "_hwmon_metric";
+        info_table_name = table_name_prefix + "_hwmon_info";
+        // 创建表
+        if (!createMetricTable() || !createInfoTable())throw hwgauge::FatalError("[Database] Create Table Failed");
+        // 构建SQL模板
+        metric_copy_sql =
+            "COPY " + metric_table_name +
+            " (timestamp, sensor_index, value, seq) "
+            "FROM STDIN;";
+
+        info_insert_sql =
+            "INSERT INTO " + info_table_name +
+            " (sensor_index, chip, device, sensor, label, kind) "
+            "VALUES ($1, $2, $3, $4, $5, $6) "
+            "ON CONFLICT (sensor_index) DO UPDATE SET "
+            "chip = EXCLUDED.chip, "
+            "device = EXCLUDED.device, "
+            "sensor = EXCLUDED.sensor, "
+            "label = EXCLUDED.label, "
+            "kind = EXCLUDED.kind;";
+
+        spdlog::info("[HwmonDatabase] Initialize successfully");
+    }
+
+    HwmonDatabase::~HwmonDatabase(){}
+
+    bool HwmonDatabase::createMetricTable()
+    {
+        const std::string sql =
+            "CREATE TABLE IF NOT EXISTS " + metric_table_name + " ("
+            "timestamp TIMESTAMPTZ NOT NULL,"          // 时间戳
+            "sensor_index INTEGER NOT NULL,"          // 传感器序号
+            "value DOUBLE PRECISION"                  // 读数（°C / RPM / V / A / W）
+            ");";
+
+        if (!execSQL(sql))
+        {
+            spdlog::error("[HwmonDatabase] Failed to create metric table");
+            return false;
+        }
+        if (!upgradeTimestampColumn(metric_table_name))
+        {
+            spdlog::error("[HwmonDatabase] Failed to convert timestamp column to TIMESTAMPTZ");
+            return false;
+        }
+        if (!addSeqColumn(metric_table_name))
+        {
+            spdlog::error("[HwmonDatabase] Failed to add seq column");
+            return false;
+        }
+        spdlog::info("[HwmonDatabase] Table {} created or already exists", metric_table_name);
+        return true;
+    }
+
+    bool HwmonDatabase::createInfoTable()
+    {
+        const std::string sql =
+            "CREATE TABLE IF NOT EXISTS " + info_table_name + " ("
+            "sensor_index INTEGER NOT NULL PRIMARY KEY," // 传感器序号
+            "chip VARCHAR(64),"                          // 驱动名称
+            "device VARCHAR(128),"                       // 所属设备
+            "sensor VARCHAR(32),"                        // 属性前缀 (temp1 / fan2 ...)
+            "label VARCHAR(128),"                        // 驱动提供的描述
+            "kind VARCHAR(16)"                           // temp / fan / in / curr / power
+            ");";
+        if (!execSQL(sql))
+        {
+            spdlog::error("[HwmonDatabase] Failed to create info table");
+            return false;
+        }
+        spdlog::info("[HwmonDatabase] Table {} created or already exists", info_table_name);
+        return true;
+    }
+
+    void HwmonDatabase::writeMetric(TimePoint cur_time, std::uint64_t seq,
+                                const std::vector<HwmonLabel>& label_list,
+                                const std::vector<HwmonMetrics>& metric_list,
+                                bool)
+    {
+        if (!isConnected())throw hwgauge::FatalError("[HwmonDatabase] The database hasn't been connected before writing");
+
+        copy_buf.clear();
+        for (size_t i = 0; i < label_list.size(); ++i)
+        {
+            appendCopyField(copy_buf, cur_time);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, static_cast<long long>(label_list[i].index));
+            copy_buf += '\t';
+            appendCopyField(copy_buf, metric_list[i].value);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, seqValue(seq));
+            copy_buf += '\n';
+        }
+
+        if (!copyIn(metric_copy_sql, copy_buf))return;
+        HWGAUGE_LOG_COUNT("HwmonDatabase records", label_list.size());
+    }
+    
+    void HwmonDatabase::writeInfo(const std::vector<HwmonLabel>& label_list,
+                                bool useTransaction)
+    {
+        if (!isConnected())throw hwgauge::FatalError("[HwmonDatabase] The database hasn't been connected before writing");
+        if (useTransaction && !startTransaction())return;
+        
+        int inserted = 0;
+        for (size_t i = 0; i < label_list.size(); ++i)
+        {
+            const HwmonLabel& label = label_list[i];
+
+            std::string index_buf;
+            const char* params[6] = {
+                to_sql_param_long(static_cast<long long>(label.index), index_buf),
+                label.chip.c_str(),
+                label.device.c_str(),
+                label.sensor.c_str(),
+                label.label.c_str(),
+                label.kind.c_str(),
+            };
+
+            if (!execSQL(info_insert_sql, std::vector<const char*>(params, params + 6)))
+            {
+                if(useTransaction) rollbackTransaction();
+                return;
+            }
+            ++inserted;
+        }
+        if (useTransaction && !commitTransaction())return;
+        spdlog::info("[HwmonDatabase] Successfully inserted {}/{} records into {}", inserted, label_list.size(), info_table_name);
+    }
+}
+
+#endif
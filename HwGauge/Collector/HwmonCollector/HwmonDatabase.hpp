@@ -0,0 +1,48 @@
+#pragma once
+
+#if defined(__linux__) && defined(HWGAUGE_USE_POSTGRESQL)
+
+#include "HwmonMetrics.hpp"
+#include "Collector/Common/Config.hpp"
+#include "Collector/Base/Database.hpp"
+
+namespace hwgauge
+{
+    /* hwmon 传感器数据库操作类，指标数据使用 COPY 批量写入 */
+    class HwmonDatabase : public Database<HwmonLabel, HwmonMetrics>
+    {
+    public:
+        /* 构造函数 */
+        explicit HwmonDatabase(const DBConfig& config_, const std::string& table_name_prefix);
+
+        /* 构造函数：复用外部连接 */
+        HwmonDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix);
+        
+        /* 析构函数 */
+        ~HwmonDatabase();
+        
+        /* 写入传感器读数 */
+        void writeMetric(TimePoint cur_time, std::uint64_t seq,
+                        const std::vector<HwmonLabel>& label_list, 
+                        const std::vector<HwmonMetrics>& metric_list,
+                        bool useTransaction = true) override;
+        
+        /* 写入传感器静态信息 */
+        void writeInfo(const std::vector<HwmonLabel>& label_list,
+                      bool useTransaction = true) override;
+        
+    private:
+        /* 设置表名、建表并构建SQL模板 */
+        void setup(const std::string& table_name_prefix);
+
+        /* 创建指标数据表 */
+        bool createMetricTable() override;
+        /* 创建静态数据表 */
+        bool createInfoTable() override;
+
+        std::string metric_copy_sql;    // COPY 语句
+        std::string copy_buf;           // 复用的 COPY 数据缓冲
+    };
+}
+
+#endif
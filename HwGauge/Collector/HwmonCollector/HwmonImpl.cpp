@@ -0,0 +1,65 @@
+#ifdef __linux__
+#include "HwmonImpl.hpp"
+#include "Collector/Common/Exception.hpp"
+
+#include "spdlog/spdlog.h"
+#include <map>
+#include <utility>
+
+namespace hwgauge
+{
+    HwmonImpl::HwmonImpl(const CollectorConfig& cfg)
+        : hwmon(cfg.hostRoot + "/sys/class/hwmon")
+    {
+        hwmon.scan();
+        if (hwmon.sensors().empty())
+            throw RecoverableError("[HwmonImpl] No hwmon sensors found");
+    }
+
+    std::vector<HwmonLabel> HwmonImpl::labels()
+    {
+        const auto& sensors = hwmon.sensors();
+        std::vector<HwmonLabel> labels;
+        labels.reserve(sensors.size());
+        for (std::size_t i = 0; i < sensors.size(); ++i)
+        {
+            const auto& s = sensors[i];
+            labels.push_back(HwmonLabel{ i, s.chip, s.device, s.sensor, s.label, hwmonKindName(s.kind) });
+        }
+
+        slots.resize(labels.size());
+        for (std::size_t i = 0; i < slots.size(); ++i)slots[i] = static_cast<long>(i);
+        mappedGeneration = hwmon.generation();
+        return labels;
+    }
+
+    void HwmonImpl::remap(const std::vector<HwmonLabel>& labels)
+    {
+        std::map<std::pair<std::string, std::string>, long> index;
+        const auto& sensors = hwmon.sensors();
+        for (std::size_t i = 0; i < sensors.size(); ++i)
+            index.emplace(std::make_pair(sensors[i].device, sensors[i].sensor), static_cast<long>(i));
+
+        std::size_t missing = 0;
+        slots.assign(labels.size(), -1);
+        for (std::size_t i = 0; i < labels.size(); ++i)
+        {
+            auto it = index.find({ labels[i].device, labels[i].sensor });
+            if (it != index.end())slots[i] = it->second;
+            else ++missing;
+        }
+        mappedGeneration = hwmon.generation();
+        spdlog::info("[HwmonImpl] Remapped {} sensors after rescan ({} missing)", labels.size() - missing, missing);
+    }
+
+    void HwmonImpl::sample(std::vector<HwmonLabel>& labels, std::vector<HwmonMetrics>& metrics)
+    {
+        if (hwmon.stale())hwmon.scan();
+        if (hwmon.generation() != mappedGeneration)remap(labels);
+
+        for (std::size_t i = 0; i < labels.size(); ++i)
+            metrics[i].value = slots[i] >= 0 ? hwmon.read(static_cast<std::size_t>(slots[i])) : -1.0;
+    }
+}
+
+#endif
@@ -0,0 +1,38 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "HwmonMetrics.hpp"
+#include "Collector/Common/Config.hpp"
+#include "Collector/Common/Hwmon.hpp"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /* 所有 hwmon 传感器（温度、风扇、电压、电流、功率），输入文件常驻打开 */
+    class HwmonImpl
+    {
+    public:
+        explicit HwmonImpl(const CollectorConfig& cfg);
+
+        HwmonImpl(const HwmonImpl&) = delete;
+        HwmonImpl& operator=(const HwmonImpl&) = delete;
+
+        std::string name() { return "hwmon"; }
+
+        std::vector<HwmonLabel>   labels();
+        void sample(std::vector<HwmonLabel>& labels, std::vector<HwmonMetrics>& metrics);
+
+    private:
+        // 重新扫描后按 (device, sensor) 把标签重新对应到传感器
+        void remap(const std::vector<HwmonLabel>& labels);
+
+        Hwmon hwmon;
+        std::vector<long> slots;            // 标签序号 -> 传感器下标，-1 表示传感器已消失
+        std::uint64_t mappedGeneration{ 0 };
+    };
+}
+
+#endif
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Collector/Common/Fields.hpp"
+#include <string>
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+#include <nlohmann/json.hpp>
+#endif
+
+namespace hwgauge
+{
+    struct HwmonLabel
+    {
+        std::size_t index;      // 传感器序号（扫描排序后的位置）
+        std::string chip;       // 驱动名称，例如 coretemp / nct6775 / amdgpu
+        std::string device;     // 所属设备，例如 coretemp.0 / 0000:03:00.0
+        std::string sensor;     // 属性前缀，例如 temp1 / fan2 / in0
+        std::string label;      // 驱动提供的描述，例如 "Core 3" / "CPU_FAN"
+        std::string kind;       // temp / fan / in / curr / power
+    };
+
+    struct HwmonMetrics
+    {
+        double value;           // 标准单位：°C / RPM / V / A / W
+    };
+
+    template<>
+    struct Fields<HwmonLabel>
+    {
+        template<typename T, typename F>
+        static void visit(T& l, F&& f)
+        {
+            f("index", l.index);
+            f("chip", l.chip);
+            f("device", l.device);
+            f("sensor", l.sensor);
+            f("label", l.label);
+            f("kind", l.kind);
+        }
+    };
+
+    template<>
+    struct Fields<HwmonMetrics>
+    {
+        template<typename T, typename F>
+        static void visit(T& m, F&& f)
+        {
+            f("value", m.value);
+        }
+    };
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+    inline void to_json(nlohmann::json& j, const HwmonLabel& l) {
+        j = nlohmann::json{
+            {"index", l.index},
+            {"chip", l.chip},
+            {"device", l.device},
+            {"sensor", l.sensor},
+            {"label", l.label},
+            {"kind", l.kind}
+        };
+    }
+
+    inline void to_json(nlohmann::json& j, const HwmonMetrics& m) {
+        j = nlohmann::json{{"value", m.value}};
+    }
+#endif
+}
@@ -0,0 +1,59 @@
+#if defined(__linux__) && defined(HWGAUGE_USE_PROMETHEUS)
+
+#include "HwmonPrometheus.hpp"
+
+#include <tuple>
+
+namespace hwgauge
+{
+    HwmonPrometheus::HwmonPrometheus(std::shared_ptr<prometheus::Registry> registry_)
+        : Prometheus<HwmonLabel, HwmonMetrics>(registry_)
+    {
+        // 创建指标族（Families）
+        static const std::tuple<const char*, const char*, const char*> specs[] = {
+            {"temp", "hwmon_temperature_celsius", "Hardware monitor temperature in Celsius"},
+            {"fan", "hwmon_fan_rpm", "Hardware monitor fan speed in RPM"},
+            {"in", "hwmon_voltage_volts", "Hardware monitor voltage in Volts"},
+            {"curr", "hwmon_current_amperes", "Hardware monitor current in Amperes"},
+            {"power", "hwmon_power_watts", "Hardware monitor power in Watts"},
+        };
+
+        auto& registry_ref = *registry;
+        for (const auto& [kind, name, help] : specs)
+        {
+            families[kind] = &prometheus::BuildGauge()
+                .Name(name)
+                .Help(help)
+                .Register(registry_ref);
+        }
+    }
+
+    void HwmonPrometheus::rebuild(const std::vector<HwmonLabel>& label_list)
+    {
+        gauges.assign(label_list.size(), nullptr);
+        for (size_t i = 0; i < label_list.size(); i++)
+        {
+            const auto& label = label_list[i];
+            auto family = families.find(label.kind);
+            if (family == families.end())continue;
+
+            gauges[i] = &family->second->Add({
+                {"chip", label.chip},
+                {"device", label.device},
+                {"sensor", label.sensor},
+                {"label", label.label}
+            });
+        }
+    }
+
+    void HwmonPrometheus::write(const std::vector<HwmonLabel>& label_list,const std::vector<HwmonMetrics>& metric_list)
+    {
+        // 标签在采集器生命周期内不变，只需在第一轮构建
+        if (gauges.size() != label_list.size())rebuild(label_list);
+
+        for (size_t i = 0; i < metric_list.size(); i++)
+            if (gauges[i])gauges[i]->Set(metric_list[i].value);
+    }
+}
+
+#endif
@@ -0,0 +1,31 @@
+#pragma once
+
+#if defined(__linux__) && defined(HWGAUGE_USE_PROMETHEUS)
+
+#include "Collector/Base/Prometheus.hpp"
+#include "HwmonMetrics.hpp"
+
+#include <map>
+
+namespace hwgauge
+{
+    class HwmonPrometheus:public Prometheus<HwmonLabel,HwmonMetrics>
+    {
+    public:
+        explicit HwmonPrometheus(std::shared_ptr<prometheus::Registry> registry_);
+        
+        virtual ~HwmonPrometheus() = default;
+
+        void write(const std::vector<HwmonLabel>& label_list,const std::vector<HwmonMetrics>& metric_list);
+    private:
+        void rebuild(const std::vector<HwmonLabel>& label_list);
+
+        // 每种传感器一个指标族，key 为 HwmonLabel::kind
+        std::map<std::string, prometheus::Family<prometheus::Gauge>*> families;
+
+        // 每个传感器的 Gauge 指针缓存，传感器集合不变时每轮只需 Set
+        std::vector<prometheus::Gauge*> gauges;
+    };
+}
+
+#endif
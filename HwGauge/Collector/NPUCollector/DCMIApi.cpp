@@ -0,0 +1,73 @@
+#ifdef HWGAUGE_USE_NPU
+
+#include "DCMIApi.hpp"
+#include "Collector/Common/DynamicLibrary.hpp"
+
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "spdlog/spdlog.h"
+
+namespace hwgauge
+{
+    namespace
+    {
+        std::vector<std::string> candidates()
+        {
+            std::vector<std::string> names;
+            if (const char* env = std::getenv("HWGAUGE_DCMI_LIBRARY"))names.emplace_back(env);
+#ifdef HWGAUGE_DCMI_LIBRARY
+            names.emplace_back(HWGAUGE_DCMI_LIBRARY);
+#endif
+            names.emplace_back("libdcmi.so");
+            // 驱动目录通常不在 ld.so 的搜索路径中
+            names.emplace_back("/usr/local/Ascend/driver/lib64/driver/libdcmi.so");
+            names.emplace_back("/usr/local/Ascend/driver/lib64/libdcmi.so");
+            return names;
+        }
+
+        DCMIApi* load()
+        {
+            // 函数表与库句柄不释放，与 NVML 相同
+            auto api = std::make_unique<DCMIApi>();
+            api->library = std::make_unique<DynamicLibrary>(candidates());
+            const DynamicLibrary& library = *api->library;
+            if (!library.loaded())
+            {
+                spdlog::info("[DCMIApi] DCMI library not found, NPU collector disabled ({})", library.error());
+                return nullptr;
+            }
+
+            bool complete = true;
+#define HWGAUGE_DCMI_REQUIRE(fn) \
+            if (!library.resolve(api->fn, #fn)) \
+            { \
+                spdlog::warn("[DCMIApi] {} has no symbol {}", library.name(), #fn); \
+                complete = false; \
+            }
+            HWGAUGE_DCMI_REQUIRED(HWGAUGE_DCMI_REQUIRE)
+#undef HWGAUGE_DCMI_REQUIRE
+            if (!complete)return nullptr;
+
+#define HWGAUGE_DCMI_OPTION(fn) \
+            if (!library.resolve(api->fn, #fn)) \
+            { \
+                spdlog::info("[DCMIApi] {} has no symbol {}", library.name(), #fn); \
+                bindMissing<kDcmiSymbolMissing>(api->fn); \
+            }
+            HWGAUGE_DCMI_OPTIONAL(HWGAUGE_DCMI_OPTION)
+#undef HWGAUGE_DCMI_OPTION
+
+            spdlog::info("[DCMIApi] Loaded {}", library.name());
+            return api.release();
+        }
+    }
+
+    const DCMIApi* dcmiApi()
+    {
+        static const DCMIApi* api = load();
+        return api;
+    }
+}
+
+#endif
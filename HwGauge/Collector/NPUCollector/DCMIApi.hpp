@@ -0,0 +1,53 @@
+#pragma once
+
+#ifdef HWGAUGE_USE_NPU
+
+#include <dcmi_interface_api.h>
+#include <memory>
+
+namespace hwgauge
+{
+    class DynamicLibrary;
+
+    // 必需的函数：缺少任意一个即视为 DCMI 不可用
+#define HWGAUGE_DCMI_REQUIRED(X) \
+    X(dcmi_init) \
+    X(dcmi_get_card_list) \
+    X(dcmi_get_device_id_in_card)
+
+    // 可选的函数：旧驱动缺少时返回 kDcmiSymbolMissing
+#define HWGAUGE_DCMI_OPTIONAL(X) \
+    X(dcmi_get_device_chip_info) \
+    X(dcmi_get_device_aicore_info) \
+    X(dcmi_get_device_aicpu_info) \
+    X(dcmi_get_device_frequency) \
+    X(dcmi_get_device_utilization_rate) \
+    X(dcmi_get_device_hbm_info) \
+    X(dcmi_get_device_power_info) \
+    X(dcmi_get_device_health) \
+    X(dcmi_get_device_temperature) \
+    X(dcmi_get_device_voltage)
+
+    // 与 DCMI_ERR_CODE_NOT_SUPPORT 相同
+    constexpr int kDcmiSymbolMissing = -8255;
+
+    /*运行时从 libdcmi 解析的函数表，成员名与 dcmi_interface_api.h 中的函数同名*/
+    struct DCMIApi
+    {
+#define HWGAUGE_DCMI_MEMBER(fn) decltype(&::fn) fn = nullptr;
+        HWGAUGE_DCMI_REQUIRED(HWGAUGE_DCMI_MEMBER)
+        HWGAUGE_DCMI_OPTIONAL(HWGAUGE_DCMI_MEMBER)
+#undef HWGAUGE_DCMI_MEMBER
+
+        std::unique_ptr<DynamicLibrary> library;
+    };
+
+    /**
+     * 首次调用时加载 DCMI 并解析函数表，之后直接返回缓存（线程安全）
+     * 库不存在或缺少必需函数时返回 nullptr，NPU 采集器应被跳过。
+     * 查找顺序：环境变量 HWGAUGE_DCMI_LIBRARY、动态链接器搜索路径、昇腾驱动的默认安装目录
+     */
+    const DCMIApi* dcmiApi();
+}
+
+#endif
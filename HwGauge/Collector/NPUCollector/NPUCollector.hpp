@@ -62,6 +62,7 @@ namespace hwgauge
             << ", freqMem="  << m.freq_mem
 
             << ", chip_power="   << m.chip_power
+            << ", energy="       << m.energy_joules << "J"
 
             << ", temp="       << m.temperature
             << ", voltage="    << m.voltage
@@ -69,13 +70,38 @@ namespace hwgauge
             << " }\n";
     }
 
-    // 定义全局信息设置函数
+    // 定义上下文信息设置函数
     template<>
-    inline void setContextInfo(std::vector<NPULabel>& l, std::vector<NPUMetrics>& m)
+    inline void setContextInfo(std::vector<NPULabel>& l, std::vector<NPUMetrics>& m, TickContext& context)
     {
+        double npuPower = 0.0, npuEnergy = 0.0;
+        bool anyPower = false;
         for(size_t i=0; i<l.size(); i++) 
         {
-            sharedPower.npu_power = sharedPower.npu_power.value_or(0.0) + m[i].chip_power;
+            // 读取失败的设备功率为 -1，不计入合计
+            if (m[i].chip_power >= 0) { npuPower += m[i].chip_power; anyPower = true; }
+            if (m[i].energy_joules > 0)npuEnergy += m[i].energy_joules;
+        }
+        if (anyPower)context.addPower(PowerSource::Npu, npuPower);
+        context.setEnergy(PowerSource::Npu, npuEnergy);
+    }
+
+    template<>
+    struct ContextDeps<NPULabel, NPUMetrics>
+    {
+        static constexpr unsigned provides = powerBit(PowerSource::Npu);
+        static constexpr unsigned consumes = 0;
+    };
+
+    // 定义作业能耗统计数据，利用率取 AICore
+    template<>
+    inline void jobSamples(const std::vector<NPULabel>& l, const std::vector<NPUMetrics>& m, std::vector<JobSample>& out)
+    {
+        for(size_t i=0; i<l.size(); i++)
+        {
+            out.push_back(JobSample{
+                "npu" + std::to_string(l[i].card_id) + "-" + std::to_string(l[i].device_id),
+                m[i].energy_joules, m[i].chip_power, static_cast<double>(m[i].util_aicore)});
         }
     }
 }
@@ -22,12 +22,40 @@ namespace hwgauge {
         spdlog::info("[NPUCsvLogger] Initialized logger for: {}", m_filepath);
     }
 
-    std::string NPUCsvLogger::getHeader() const {
+    std::string NPUCsvLogger::header() {
         return "CardID,DevID,Type,Name,"
                "FreqAICore(MHz),FreqAICPU(MHz),FreqCtrl(MHz),"
                "UtilAICore(%),UtilAICPU(%),UtilCtrl(%),UtilVec(%),"
                "MemTotal(MB),MemUsed(MB),UtilMem(%),UtilMemBW(%),FreqMem(MHz),"
-               "Power(W),Temp(C),Volt(V),Health";
+               "Power(W),Energy(J),Temp(C),Volt(V),Health";
+    }
+
+    std::string NPUCsvLogger::getHeader() const {
+        return header();
+    }
+
+    void NPUCsvLogger::parseRow(CsvFieldReader& r, NPULabel& l, NPUMetrics& m) {
+        r.get(l.card_id);
+        r.get(l.device_id);
+        r.get(l.chip_type);
+        r.get(l.chip_name);
+        r.get(m.freq_aicore);
+        r.get(m.freq_aicpu);
+        r.get(m.freq_ctrlcpu);
+        r.get(m.util_aicore);
+        r.get(m.util_aicpu);
+        r.get(m.util_ctrlcpu);
+        r.get(m.util_vec);
+        r.get(m.mem_total_mb);
+        r.get(m.mem_usage_mb);
+        r.get(m.util_mem);
+        r.get(m.util_membw);
+        r.get(m.freq_mem);
+        r.get(m.chip_power);
+        r.get(m.energy_joules);
+        r.get(m.temperature);
+        r.get(m.voltage);
+        r.get(m.health);
     }
 
     std::string NPUCsvLogger::formatRow(const NPULabel& l, const NPUMetrics& m) const {
@@ -59,6 +87,7 @@ namespace hwgauge {
            
            // 功耗环境 (浮点数)
            << m.chip_power << ","
+           << m.energy_joules << ","
            << m.temperature << ","  // int
            << m.voltage << ","      // double
            << m.health;             // unsigned int (hex might be better? keeping decimal for csv)
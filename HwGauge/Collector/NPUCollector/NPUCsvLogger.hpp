@@ -2,12 +2,17 @@
 #ifdef HWGAUGE_USE_NPU
 
 #include "Collector/Base/CsvLogger.hpp"
+#include "Collector/Common/CsvReader.hpp"
 #include "NPUMetrics.hpp"
 
 namespace hwgauge {
     class NPUCsvLogger : public CsvLogger<NPULabel, NPUMetrics> {
     public:
         explicit NPUCsvLogger(const std::string& filepath);
+
+        // 表头与 formatRow 的逆过程，供回放 (--replay) 读取已记录的文件
+        static std::string header();
+        static void parseRow(CsvFieldReader& r, NPULabel& l, NPUMetrics& m);
     protected:
         std::string getHeader() const override;
         std::string formatRow(const NPULabel& l, const NPUMetrics& m) const override;
@@ -1,4 +1,4 @@
-#if defined(HWGAUGE_USE_POSTGRESQL) && defined(HWGAUGE_USE_NPU)
+#ifdef HWGAUGE_USE_POSTGRESQL
 
 #include "NPUDatabase.hpp"
 
@@ -10,6 +10,17 @@ namespace hwgauge
 {
     NPUDatabase::NPUDatabase(const DBConfig& config_, const std::string& table_name_prefix)
         : Database<NPULabel, NPUMetrics>(config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    NPUDatabase::NPUDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<NPULabel, NPUMetrics>(shared_conn, config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    void NPUDatabase::setup(const std::string& table_name_prefix)
     {
         // 设置表名
         metric_table_name = table_name_prefix + "_npu_metric";
@@ -24,8 +35,8 @@ namespace hwgauge
             "util_aicore, util_aicpu, util_ctrlcpu, util_vec, "
             "mem_total_mb, mem_usage_mb, util_mem, util_membw, freq_mem, "
             "chip_power, "
-            "health, temperature, voltage) "
-            "VALUES ($1,$2,$3,$4,$5,$6,$7,$8,$9,$10,$11,$12,$13,$14,$15,$16,$17,$18,$19);";
+            "health, temperature, voltage, energy_joules, seq) "
+            "VALUES ($1,$2,$3,$4,$5,$6,$7,$8,$9,$10,$11,$12,$13,$14,$15,$16,$17,$18,$19,$20,$21);";
 
         info_insert_sql =
             "INSERT INTO " + info_table_name +
@@ -44,7 +55,7 @@ namespace hwgauge
     {
          const std::string sql =
             "CREATE TABLE IF NOT EXISTS " + metric_table_name + " ("
-            "timestamp TIMESTAMP NOT NULL,"
+            "timestamp TIMESTAMPTZ NOT NULL,"
             "card_id INTEGER NOT NULL,"
             "device_id INTEGER NOT NULL,"
             "freq_aicore INTEGER,"      // AICore频率 (MHz)
@@ -62,13 +73,34 @@ namespace hwgauge
             "chip_power DOUBLE PRECISION,"  // 芯片功耗 (W)
             "health INTEGER,"           // 健康状态 (0:OK,1:WARN,2:ERROR,3:CRITICAL,0xFFFFFFFF:NOT_EXIST)
             "temperature INTEGER,"      // 温度 (C)
-            "voltage DOUBLE PRECISION"  // 电压 (V)
+            "voltage DOUBLE PRECISION," // 电压 (V)
+            "energy_joules DOUBLE PRECISION" // 累计能耗 (J)
             ");";
         if (!execSQL(sql))
         {
             spdlog::error("[NPUDatabase] Failed to create metric table");
             return false;
         }
+        if (!upgradeTimestampColumn(metric_table_name))
+        {
+            spdlog::error("[NPUDatabase] Failed to convert timestamp column to TIMESTAMPTZ");
+            return false;
+        }
+
+        // 兼容旧版本创建的表
+        const std::string upgrade =
+            "ALTER TABLE " + metric_table_name +
+            " ADD COLUMN IF NOT EXISTS energy_joules DOUBLE PRECISION;";
+        if (!execSQL(upgrade))
+        {
+            spdlog::error("[NPUDatabase] Failed to upgrade metric table");
+            return false;
+        }
+        if (!addSeqColumn(metric_table_name))
+        {
+            spdlog::error("[NPUDatabase] Failed to add seq column");
+            return false;
+        }
         spdlog::info("[NPUDatabase] Table {} created or already exists", metric_table_name);
         return true;
     }
@@ -92,7 +124,7 @@ namespace hwgauge
         return true;
     }
 
-    void NPUDatabase::writeMetric(const std::string& cur_time,
+    void NPUDatabase::writeMetric(TimePoint cur_time, std::uint64_t seq,
                                 const std::vector<NPULabel>& label_list,
                                 const std::vector<NPUMetrics>& metric_list,
                                 bool useTransaction)
@@ -101,40 +133,43 @@ namespace hwgauge
         if (useTransaction && !startTransaction())return;
         
         int inserted = 0;
+        // 时间戳以二进制 TIMESTAMPTZ 绑定，每轮只转换一次
+        const PgTimestamp time(cur_time);
         for (size_t i = 0; i < label_list.size(); ++i)
         {
             const NPULabel& label = label_list[i];
             const NPUMetrics& metric = metric_list[i];
 
-            std::vector<std::string> buf(19);
-            const char* params[19] = {
-                to_sql_param_string(cur_time, buf[0]),
-                to_sql_param_int(label.card_id, buf[1]),
-                to_sql_param_int(label.device_id, buf[2]),
+            std::vector<std::string> buf(20);
+            const char* params[20] = {
+                to_sql_param_int(label.card_id, buf[0]),
+                to_sql_param_int(label.device_id, buf[1]),
                 // 频率
-                to_sql_param_int(metric.freq_aicore, buf[3]),
-                to_sql_param_int(metric.freq_aicpu, buf[4]),
-                to_sql_param_int(metric.freq_ctrlcpu, buf[5]),  // 新增
+                to_sql_param_int(metric.freq_aicore, buf[2]),
+                to_sql_param_int(metric.freq_aicpu, buf[3]),
+                to_sql_param_int(metric.freq_ctrlcpu, buf[4]),  // 新增
                 // 算力负载
-                to_sql_param_int(metric.util_aicore, buf[6]),
-                to_sql_param_int(metric.util_aicpu, buf[7]),
-                to_sql_param_int(metric.util_ctrlcpu, buf[8]),  // 新增
-                to_sql_param_int(metric.util_vec, buf[9]),
+                to_sql_param_int(metric.util_aicore, buf[5]),
+                to_sql_param_int(metric.util_aicpu, buf[6]),
+                to_sql_param_int(metric.util_ctrlcpu, buf[7]),  // 新增
+                to_sql_param_int(metric.util_vec, buf[8]),
                 // 存储资源
-                to_sql_param_long(metric.mem_total_mb, buf[10]),
-                to_sql_param_long(metric.mem_usage_mb, buf[11]),
-                to_sql_param_int(metric.util_mem, buf[12]),
-                to_sql_param_int(metric.util_membw, buf[13]),
-                to_sql_param_int(metric.freq_mem, buf[14]),  // 新增
+                to_sql_param_long(metric.mem_total_mb, buf[9]),
+                to_sql_param_long(metric.mem_usage_mb, buf[10]),
+                to_sql_param_int(metric.util_mem, buf[11]),
+                to_sql_param_int(metric.util_membw, buf[12]),
+                to_sql_param_int(metric.freq_mem, buf[13]),  // 新增
                 // 功耗
-                to_sql_param_double(metric.chip_power, buf[15]),
+                to_sql_param_double(metric.chip_power, buf[14]),
                 // 环境
-                to_sql_param_int(metric.health, buf[16]),
-                to_sql_param_int(metric.temperature, buf[17]),
-                to_sql_param_double(metric.voltage, buf[18])
+                to_sql_param_int(metric.health, buf[15]),
+                to_sql_param_int(metric.temperature, buf[16]),
+                to_sql_param_double(metric.voltage, buf[17]),
+                to_sql_param_double(metric.energy_joules, buf[18]),
+                to_sql_param_long(seqValue(seq), buf[19]),
             };
 
-            if (!execSQL(metric_insert_sql, std::vector<const char*>(params, params + 19)))
+            if (!execSQL(metric_insert_sql, time, std::vector<const char*>(params, params + 20)))
             {
                 if(useTransaction) rollbackTransaction();
                 return;
@@ -142,7 +177,7 @@ namespace hwgauge
             ++inserted;
         }
         if (useTransaction && !commitTransaction())return;
-        spdlog::info("[NPUDatabase] Successfully inserted {}/{} records into {}", inserted, label_list.size(), metric_table_name);
+        HWGAUGE_LOG_COUNT("NPUDatabase records", inserted);
     }
     
     void NPUDatabase::writeInfo(const std::vector<NPULabel>& label_list,
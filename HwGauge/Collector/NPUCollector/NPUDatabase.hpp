@@ -1,5 +1,5 @@
 #pragma once
-#if defined(HWGAUGE_USE_POSTGRESQL) && defined(HWGAUGE_USE_NPU)
+#ifdef HWGAUGE_USE_POSTGRESQL
 
 #include "NPUMetrics.hpp"
 #include "Collector/Common/Config.hpp"
@@ -13,12 +13,15 @@ namespace hwgauge
     public:
         /* 构造函数 */
         explicit NPUDatabase(const DBConfig& config_, const std::string& table_name_prefix);
+
+        /* 构造函数：复用外部连接 */
+        NPUDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix);
         
         /* 析构函数 */
         ~NPUDatabase();
         
         /* 写入NPU监控数据 */
-        void writeMetric(const std::string& cur_time,
+        void writeMetric(TimePoint cur_time, std::uint64_t seq,
                         const std::vector<NPULabel>& label_list, 
                         const std::vector<NPUMetrics>& metric_list,
                         bool useTransaction = true) override;
@@ -28,7 +31,9 @@ namespace hwgauge
                       bool useTransaction = true) override;
         
     private:
-        
+        /* 设置表名、建表并构建SQL模板 */
+        void setup(const std::string& table_name_prefix);
+
         /* 创建指标数据表 */
         bool createMetricTable() override;
         /* 创建静态数据表 */
@@ -1,8 +1,9 @@
 #ifdef HWGAUGE_USE_NPU
 
-#include <assert.h>
-#include <iostream>
-#include <dcmi_interface_api.h>
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include "DCMIApi.hpp"
 #include "spdlog/spdlog.h"
 
 #include "Collector/Common/Exception.hpp"
@@ -12,10 +13,55 @@
 
 namespace hwgauge
 {
+    namespace
+    {
+        // 并行采样的线程数上限（含采集线程），DCMI 调用主要耗时在驱动 ioctl 上，不同设备之间可以并发
+        constexpr std::size_t kMaxSampleThreads = 8;
+
+        // 慢变字段的刷新间隔（轮）
+        constexpr unsigned kSlowRefreshTicks = 12;
+
+        // Device::failing 中的各个失败项
+        enum FailBit : unsigned
+        {
+            FailAICoreFreq = 1u << 0,
+            FailAICPUFreq = 1u << 1,
+            FailCtrlCPUFreq = 1u << 2,
+            FailAICoreUtil = 1u << 3,
+            FailAICPUUtil = 1u << 4,
+            FailCtrlCPUUtil = 1u << 5,
+            FailVectorUtil = 1u << 6,
+            FailMemory = 1u << 7,
+            FailMemoryInvalid = 1u << 8,
+            FailPower = 1u << 9,
+            FailHealth = 1u << 10,
+            FailTemperature = 1u << 11,
+            FailVoltage = 1u << 12,
+        };
+
+        // 同一失败项只在第一次出现时告警，恢复后再次失败会重新告警
+        bool check(int ret, unsigned& failing, FailBit bit, int card, int device, const char* what)
+        {
+            if (ret == NPU_OK)
+            {
+                failing &= ~static_cast<unsigned>(bit);
+                return true;
+            }
+            if (!(failing & bit))
+            {
+                spdlog::warn("[NPUImpl] Get {} failed (ret={}, card={}, device={})", what, ret, card, device);
+                failing |= bit;
+            }
+            return false;
+        }
+    }
+
     NPUImpl::NPUImpl()
     {
-        int ret = dcmi_init();
-        if(ret!=NPU_OK)throw hwgauge::FatalError("[NPUImpl] dcmi_init failed");
+        // 库缺失或没有昇腾驱动的节点上跳过本采集器，而不是终止进程
+        if(!dcmiApi())throw hwgauge::RecoverableError("[NPUImpl] DCMI library not available");
+        int ret = dcmiApi()->dcmi_init();
+        if(ret!=NPU_OK)throw hwgauge::RecoverableError("[NPUImpl] dcmi_init failed (ret=" + std::to_string(ret) + ")");
     }
 
     std::string NPUImpl::name() const
@@ -29,18 +75,20 @@ namespace hwgauge
         int ret;
         int card_count = 0;
         int card_list[MAX_CARD_NUM] = {0};
-        ret=dcmi_get_card_list(&card_count, card_list, MAX_CARD_NUM);
-        if(ret!=NPU_OK)throw hwgauge::FatalError("[NPUImpl] dcmi_get_card_list failed");
-        if(card_count==0)throw hwgauge::FatalError("[NPUImpl] The card of num is zero");
+        ret=dcmiApi()->dcmi_get_card_list(&card_count, card_list, MAX_CARD_NUM);
+        // 装有 DCMI 库但没有 NPU 卡的节点同样跳过本采集器
+        if(ret!=NPU_OK)throw hwgauge::RecoverableError("[NPUImpl] dcmi_get_card_list failed (ret=" + std::to_string(ret) + ")");
+        if(card_count==0)throw hwgauge::RecoverableError("[NPUImpl] No NPU card found");
 
-        //遍历每个卡和设备
+        //遍历每个卡和设备，芯片信息只在这里读取一次
         std::vector<NPULabel> labels;
+        std::vector<Device> found;
         NPULabel label;
         for (int i = 0; i < card_count; i++)
         {
             int card = card_list[i];
             int device_count = 0, mcu_id = 0, cpu_id = 0;
-            ret=dcmi_get_device_id_in_card(card, &device_count, &mcu_id, &cpu_id);
+            ret=dcmiApi()->dcmi_get_device_id_in_card(card, &device_count, &mcu_id, &cpu_id);
             if(ret!=NPU_OK)
             {
                 spdlog::warn("[NPUImpl] dcmi_get_device_id_in_card failed (ret={}, card={})",ret,card);
@@ -51,8 +99,8 @@ namespace hwgauge
             {
                 label.card_id = card;
                 label.device_id = dev;
-                struct dcmi_chip_info chip_info = {0};
-                ret = dcmi_get_device_chip_info(card, dev, &chip_info);
+                struct dcmi_chip_info chip_info = {};
+                ret = dcmiApi()->dcmi_get_device_chip_info(card, dev, &chip_info);
                 if (ret == NPU_OK)
                 {
                     label.chip_type.assign(
@@ -71,159 +119,150 @@ namespace hwgauge
                     spdlog::warn("[NPUImpl] Get npu info failed (ret={}, card={}, device={})",ret,card,dev);
                 }
                 labels.push_back(label);
+
+                Device state;
+                state.card = card;
+                state.device = dev;
+                found.push_back(state);
             }
         }
+
+        // 重新枚举时沿用同一设备的能耗累计
+        for (Device& d : found)
+        {
+            auto it = std::find_if(devices.begin(), devices.end(),
+                [&](const Device& old) { return old.card == d.card && old.device == d.device; });
+            if (it != devices.end())d.energy = it->energy;
+        }
+        devices = std::move(found);
+
+        std::size_t threads = std::min(devices.size(), kMaxSampleThreads);
+        if (threads > 1 && (!pool || pool->size() != threads))pool = std::make_unique<ThreadPool>(threads);
         return labels;
     }
-        
-    std::vector<NPUMetrics> NPUImpl::sample(std::vector<NPULabel>&labels)
+
+    void NPUImpl::sample(std::vector<NPULabel>& labels, std::vector<NPUMetrics>& metrics)
     {
-        std::vector<NPUMetrics> metrics;
-        NPUMetrics metric;
-        //为每个设备采集数据
-        for (const auto& label : labels)
-        {
-            collect_single_device_metric(label.card_id, label.device_id, metric);
-            metrics.push_back(metric);
-        }
-        return metrics;
+        if (labels.size() != devices.size())throw RecoverableError("[NPUImpl] Labels do not match the enumerated devices");
+        auto begin = std::chrono::steady_clock::now();
+
+        //为每个设备采集数据，单个设备的失败只影响该设备的对应指标
+        auto task = [&](std::size_t i) {
+            Device& device = devices[i];
+            collect_single_device_metric(device, metrics[i]);
+            metrics[i].energy_joules = device.energy.update(metrics[i].chip_power);
+        };
+
+        if (pool)pool->parallelFor(labels.size(), task);
+        else for (std::size_t i = 0; i < labels.size(); ++i)task(i);
+
+        spdlog::debug("[NPUImpl] Sampled {} NPUs in {} us", labels.size(),
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - begin).count());
     }
 
-    void NPUImpl::collect_single_device_metric(int card, int device, NPUMetrics& metric)
+    void NPUImpl::collect_single_device_metric(Device& state, NPUMetrics& metric)
     {
+        const DCMIApi& dcmi = *dcmiApi();
+        const int card = state.card;
+        const int device = state.device;
+        unsigned& failing = state.failing;
         int ret;
+
+        // 慢变字段：首轮与每 kSlowRefreshTicks 轮刷新，上次读取失败时下一轮重试
+        bool refreshSlow = state.ticks % kSlowRefreshTicks == 0 ||
+            (failing & (FailAICPUFreq | FailCtrlCPUFreq | FailHealth)) != 0;
+        ++state.ticks;
+
         /*频率*/
         //AICore
-        struct dcmi_aicore_info aicore = {0};
-        ret=dcmi_get_device_aicore_info(card, device, &aicore);
-        if (ret== NPU_OK)metric.freq_aicore = aicore.cur_freq;
-        else
-        {
-            metric.freq_aicore = -1;
-            spdlog::warn("[NPUImpl] Get AICore Frequency failed (ret={}, card={}, device={})",ret,card,device);
-        }
-        //AICPU
-        struct dcmi_aicpu_info aicpu = {0};
-        ret=dcmi_get_device_aicpu_info(card, device, &aicpu);
-        if (ret == NPU_OK)metric.freq_aicpu = aicpu.cur_freq;
-        else
-        {
-            metric.freq_aicpu = -1;
-            spdlog::warn("[NPUImpl] Get AICPU Frequency failed (ret={}, card={}, device={})",ret,card,device);
-        }
-        //CtrlCPU
-        unsigned int freq_ctrlcpu=0;
-        ret= dcmi_get_device_frequency(card,device,(enum dcmi_freq_type)2, &freq_ctrlcpu);
-        if (ret== NPU_OK)metric.freq_ctrlcpu = freq_ctrlcpu;
-        else
+        struct dcmi_aicore_info aicore = {};
+        ret=dcmi.dcmi_get_device_aicore_info(card, device, &aicore);
+        metric.freq_aicore = check(ret, failing, FailAICoreFreq, card, device, "AICore frequency") ? static_cast<int>(aicore.cur_freq) : -1;
+        if (refreshSlow)
         {
-            metric.freq_ctrlcpu = -1;
-            spdlog::warn("[NPUImpl] Get CtrlCPU Frequency rate failed (ret={}, card={}, device={})",ret,card,device);
+            //AICPU
+            struct dcmi_aicpu_info aicpu = {};
+            ret=dcmi.dcmi_get_device_aicpu_info(card, device, &aicpu);
+            state.freqAicpu = check(ret, failing, FailAICPUFreq, card, device, "AICPU frequency") ? static_cast<int>(aicpu.cur_freq) : -1;
+            //CtrlCPU
+            unsigned int freq_ctrlcpu=0;
+            ret= dcmi.dcmi_get_device_frequency(card,device,(enum dcmi_freq_type)2, &freq_ctrlcpu);
+            state.freqCtrlcpu = check(ret, failing, FailCtrlCPUFreq, card, device, "CtrlCPU frequency") ? static_cast<int>(freq_ctrlcpu) : -1;
         }
-
+        metric.freq_aicpu = state.freqAicpu;
+        metric.freq_ctrlcpu = state.freqCtrlcpu;
 
         /*利用率*/
-        unsigned int util_aicore = 0;
+        unsigned int util = 0;
         //AICore
-        ret=dcmi_get_device_utilization_rate(card, device, 2, &util_aicore);
-        if (ret== NPU_OK)metric.util_aicore = util_aicore;
-        else
-        {
-            metric.util_aicore = -1;
-            spdlog::warn("[NPUImpl] Get AICore utilization rate failed (ret={}, card={}, device={})",ret,card,device);
-        }
+        ret=dcmi.dcmi_get_device_utilization_rate(card, device, 2, &util);
+        metric.util_aicore = check(ret, failing, FailAICoreUtil, card, device, "AICore utilization rate") ? static_cast<int>(util) : -1;
         //AICPU
-        unsigned int util_aicpu = 0;
-        ret=dcmi_get_device_utilization_rate(card, device, 3, &util_aicpu);
-        if (ret== NPU_OK)metric.util_aicpu = util_aicpu;
-        else
-        {
-            metric.util_aicpu = -1;
-            spdlog::warn("[NPUImpl] Get AICPU utilization rate failed (ret={}, card={}, device={})",ret,card,device);
-        }
+        ret=dcmi.dcmi_get_device_utilization_rate(card, device, 3, &util);
+        metric.util_aicpu = check(ret, failing, FailAICPUUtil, card, device, "AICPU utilization rate") ? static_cast<int>(util) : -1;
         //CtrlCPU
-        unsigned int util_ctrlcpu=0;
-        ret=dcmi_get_device_utilization_rate(card, device, 4, &util_ctrlcpu);
-        if (ret== NPU_OK)metric.util_ctrlcpu = util_ctrlcpu;
-        else
-        {
-            metric.util_ctrlcpu = -1;
-            spdlog::warn("[NPUImpl] Get CtrlCPU utilization rate failed (ret={}, card={}, device={})",ret,card,device);
-        }
+        ret=dcmi.dcmi_get_device_utilization_rate(card, device, 4, &util);
+        metric.util_ctrlcpu = check(ret, failing, FailCtrlCPUUtil, card, device, "CtrlCPU utilization rate") ? static_cast<int>(util) : -1;
         //vector core
-        unsigned int util_vec=0;
-        ret=dcmi_get_device_utilization_rate(card, device, 12, &util_vec);
-        if (ret== NPU_OK)metric.util_vec = util_vec;
-        else
-        {
-            metric.util_vec = -1;
-            spdlog::warn("[NPUImpl] Get vector core utilization rate failed (ret={}, card={}, device={})",ret,card,device);
-        }
+        ret=dcmi.dcmi_get_device_utilization_rate(card, device, 12, &util);
+        metric.util_vec = check(ret, failing, FailVectorUtil, card, device, "vector core utilization rate") ? static_cast<int>(util) : -1;
 
         /*显存*/
-        struct dcmi_hbm_info hbm_info = {0};
-        ret = dcmi_get_device_hbm_info(card, device, &hbm_info);
-        if (ret == NPU_OK)
-        {
-            metric.mem_total_mb = (unsigned long)hbm_info.memory_size; // MB
-            metric.mem_usage_mb = (unsigned long)hbm_info.memory_usage;
-            if(metric.mem_total_mb<metric.mem_usage_mb)throw RecoverableError("[NPUImpl] The memory total mb is larger than used mb");
-            metric.util_mem=((double)metric.mem_usage_mb/metric.mem_total_mb)*100.0;
-            metric.util_membw = hbm_info.bandwith_util_rate;
-            metric.freq_mem=hbm_info.freq;
-        }
-        else
+        metric.mem_total_mb = -1;
+        metric.mem_usage_mb = -1;
+        metric.util_mem = -1;
+        metric.util_membw = -1;
+        metric.freq_mem = -1;
+        struct dcmi_hbm_info hbm_info = {};
+        ret = dcmi.dcmi_get_device_hbm_info(card, device, &hbm_info);
+        if (check(ret, failing, FailMemory, card, device, "on-chip memory"))
         {
-            metric.mem_total_mb = -1;
-            metric.mem_usage_mb = -1;
-            metric.util_mem=-1;
-            metric.util_membw = -1;
-            metric.freq_mem=-1;
-            spdlog::warn("[NPUImpl] Get On-chip memory failed (ret={}, card={}, device={})",ret,card,device);
+            // 读数异常（已用超过总量）只丢弃本设备的显存指标
+            bool valid = hbm_info.memory_size > 0 && hbm_info.memory_usage <= hbm_info.memory_size;
+            if (!valid && !(failing & FailMemoryInvalid))
+            {
+                spdlog::warn("[NPUImpl] Invalid on-chip memory reading, used {} MB of {} MB (card={}, device={})",
+                    hbm_info.memory_usage, hbm_info.memory_size, card, device);
+            }
+            if (valid)failing &= ~static_cast<unsigned>(FailMemoryInvalid);
+            else failing |= FailMemoryInvalid;
+
+            if (valid)
+            {
+                metric.mem_total_mb = static_cast<long long>(hbm_info.memory_size); // MB
+                metric.mem_usage_mb = static_cast<long long>(hbm_info.memory_usage);
+                metric.util_mem = ((double)metric.mem_usage_mb / metric.mem_total_mb) * 100.0;
+                metric.util_membw = hbm_info.bandwith_util_rate;
+                metric.freq_mem = hbm_info.freq;
+            }
         }
 
         /*功耗*/
         int power = 0;
-        ret=dcmi_get_device_power_info(card, device, &power);
-        if (ret == NPU_OK)metric.chip_power = (double)power/10.0;
-        else
-        {
-            metric.chip_power = -1;
-            spdlog::warn("[NPUImpl] Get chip power failed (ret={}, card={}, device={})",ret,card,device);
-        }
+        ret=dcmi.dcmi_get_device_power_info(card, device, &power);
+        metric.chip_power = check(ret, failing, FailPower, card, device, "chip power") ? (double)power/10.0 : -1;
 
         /*环境*/
         //健康状态
-        unsigned int health = 0;
-        ret=dcmi_get_device_health(card, device, &health);
-        if (ret == NPU_OK)metric.health = health;
-        else
+        if (refreshSlow)
         {
-            metric.health = 0xFFFFFFFF;
-            spdlog::warn("[NPUImpl] Get health failed (ret={}, card={}, device={})",ret,card,device);
+            unsigned int health = 0;
+            ret=dcmi.dcmi_get_device_health(card, device, &health);
+            state.health = check(ret, failing, FailHealth, card, device, "health") ? health : 0xFFFFFFFF;
         }
-        
+        metric.health = state.health;
+
         //温度
         int temperature = 0;
-        ret=dcmi_get_device_temperature(card, device, &temperature);
-        if (ret == NPU_OK)metric.temperature = temperature;
-        else
-        {
-            metric.temperature = -1;
-            spdlog::warn("[NPUImpl] Get temperature failed (ret={}, card={}, device={})",ret,card,device);
-        }
-        
+        ret=dcmi.dcmi_get_device_temperature(card, device, &temperature);
+        metric.temperature = check(ret, failing, FailTemperature, card, device, "temperature") ? temperature : -1;
+
         //电压
         unsigned int voltage = 0;
-        ret=dcmi_get_device_voltage(card, device, &voltage);
-        if (ret == NPU_OK)metric.voltage = (double)voltage/100.0;
-        else
-        {
-            metric.voltage = -1;
-            spdlog::warn("[NPUImpl] Get voltage failed (ret={}, card={}, device={})",ret,card,device);
-        }
+        ret=dcmi.dcmi_get_device_voltage(card, device, &voltage);
+        metric.voltage = check(ret, failing, FailVoltage, card, device, "voltage") ? (double)voltage/100.0 : -1;
     }
 
 }
 
-#endif
\ No newline at end of file
+#endif
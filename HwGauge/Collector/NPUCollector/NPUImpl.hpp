@@ -2,8 +2,11 @@
 
 #ifdef HWGAUGE_USE_NPU
 
+#include <memory>
 #include <vector>
 #include "NPUMetrics.hpp"
+#include "Collector/Common/Energy.hpp"
+#include "Collector/Common/ThreadPool.hpp"
 
 namespace hwgauge
 {
@@ -13,19 +16,40 @@ namespace hwgauge
     public:
         /*构造函数：初始化DCMI*/
         NPUImpl();
-        
+
         /*返回收集器名称*/
         std::string name() const;
-        
+
         /*返回所有设备的标签*/
         std::vector<NPULabel> labels();
 
         /*采集标签label的指标数据*/
-        std::vector<NPUMetrics> sample(std::vector<NPULabel>&labels);
-        
+        void sample(std::vector<NPULabel>& labels, std::vector<NPUMetrics>& metrics);
+
     private:
-        /*采集单个设备的指标数据*/
-        void collect_single_device_metric(int card, int device, NPUMetrics& metric);
+        // 逐设备状态在 labels() 中建立，与 labels 顺序一致
+        struct Device
+        {
+            int card = 0;
+            int device = 0;
+            unsigned failing = 0;          // 已告警的失败项（位掩码），恢复后清除，避免每轮刷屏
+
+            // 慢变字段（健康状态、AICPU / CtrlCPU 频率）：每 kSlowRefreshTicks 轮刷新一次，其余轮次沿用缓存
+            unsigned ticks = 0;
+            unsigned int health = 0xFFFFFFFF;
+            int freqAicpu = -1;
+            int freqCtrlcpu = -1;
+
+            // DCMI 没有能耗计数器，对功率积分
+            EnergyIntegrator energy;
+        };
+        std::vector<Device> devices;
+
+        // 多卡时并行采样，每个任务只访问自己的 Device 与输出槽
+        std::unique_ptr<ThreadPool> pool;
+
+        /*采集单个设备的指标数据，失败项为 -1，不抛出异常*/
+        static void collect_single_device_metric(Device& device, NPUMetrics& metric);
     };
 }
 
@@ -1,7 +1,6 @@
 #pragma once
 
-#ifdef HWGAUGE_USE_NPU
-
+#include "Collector/Common/Fields.hpp"
 #include <string>
 
 #ifdef HWGAUGE_USE_LOCAL_HTTP
@@ -40,6 +39,8 @@ namespace hwgauge
 
         // --- 功耗（W）---
         double chip_power;
+        // 自 agent 启动以来的累计能耗（J），由功率梯形积分得到
+        double energy_joules;
 
         // --- 环境 ---
         //健康状态 (0: OK, 1: WARN, 2: ERROR, 3: CRITICAL, 0xFFFFFFFF: NOT_EXIST)
@@ -50,6 +51,45 @@ namespace hwgauge
         double voltage;
     };
 
+    template<>
+    struct Fields<NPULabel>
+    {
+        template<typename T, typename F>
+        static void visit(T& l, F&& f)
+        {
+            f("card_id", l.card_id);
+            f("device_id", l.device_id);
+            f("chip_type", l.chip_type);
+            f("chip_name", l.chip_name);
+        }
+    };
+
+    template<>
+    struct Fields<NPUMetrics>
+    {
+        template<typename T, typename F>
+        static void visit(T& m, F&& f)
+        {
+            f("freq_aicore", m.freq_aicore);
+            f("freq_aicpu", m.freq_aicpu);
+            f("freq_ctrlcpu", m.freq_ctrlcpu);
+            f("util_aicore", m.util_aicore);
+            f("util_aicpu", m.util_aicpu);
+            f("util_ctrlcpu", m.util_ctrlcpu);
+            f("util_vec", m.util_vec);
+            f("mem_total_mb", m.mem_total_mb);
+            f("mem_usage_mb", m.mem_usage_mb);
+            f("util_mem", m.util_mem);
+            f("util_membw", m.util_membw);
+            f("freq_mem", m.freq_mem);
+            f("chip_power", m.chip_power);
+            f("energy_joules", m.energy_joules, FieldKind::Counter);
+            f("health", m.health, FieldKind::Status);
+            f("temperature", m.temperature);
+            f("voltage", m.voltage);
+        }
+    };
+
 #ifdef HWGAUGE_USE_LOCAL_HTTP
     inline void to_json(nlohmann::json& j, const NPULabel& l) {
         j = nlohmann::json{
@@ -75,6 +115,7 @@ namespace hwgauge
             {"util_membw", m.util_membw},
             {"freq_mem", m.freq_mem},
             {"chip_power", m.chip_power},
+            {"energy_joules", m.energy_joules},
             {"health", m.health},
             {"temperature", m.temperature},
             {"voltage", m.voltage}
@@ -82,5 +123,3 @@ namespace hwgauge
     }
 #endif
 }
-
-#endif
\ No newline at end of file
@@ -79,6 +79,11 @@ namespace hwgauge
             .Help("NPU chip power consumption in watts")
             .Register(registry_ref);
 
+        energy_counter_ = &prometheus::BuildCounter()
+            .Name("npu_energy_joules_total")
+            .Help("NPU chip energy consumed since agent start in joules")
+            .Register(registry_ref);
+
         // 5. 环境指标
         health_gauge_ = &prometheus::BuildGauge()
             .Name("npu_health") 
@@ -98,44 +103,51 @@ namespace hwgauge
 
     void NPUPrometheus::write(const std::vector<NPULabel>& label_list,const std::vector<NPUMetrics>& metric_list)
     {
+        // 构建标签：设备集合在采集器生命周期内不变，只需在第一轮构建
+        if (gauges.resize(label_list.size()))
+        {
+            counters.resize(label_list.size());
+            for (size_t i = 0; i < label_list.size(); i++)
+            {
+                gauges.labels(i) = {
+                    {"card_id", std::to_string(label_list[i].card_id)},
+                    {"device_id", std::to_string(label_list[i].device_id)}
+                };
+                counters.labels(i) = gauges.labels(i);
+            }
+        }
+
         // 更新每个设备的指标
         for (size_t i = 0; i < label_list.size(); i++)
         {
-            const auto& label = label_list[i];
             const auto& metric = metric_list[i];
             
-            // 构建标签
-            std::map<std::string, std::string> labels = 
-            {
-                {"card_id", std::to_string(label.card_id)},
-                {"device_id", std::to_string(label.device_id)}
-            };
-            
             // 1. 更新频率指标
-            aicore_freq_gauge_->Add(labels).Set(metric.freq_aicore);
-            aicpu_freq_gauge_->Add(labels).Set(metric.freq_aicpu);
-            ctrlcpu_freq_gauge_->Add(labels).Set(metric.freq_ctrlcpu);  // 新增
+            gauges.get(i, aicore_freq_gauge_).Set(metric.freq_aicore);
+            gauges.get(i, aicpu_freq_gauge_).Set(metric.freq_aicpu);
+            gauges.get(i, ctrlcpu_freq_gauge_).Set(metric.freq_ctrlcpu);  // 新增
             
             // 2. 更新算力负载指标
-            aicore_util_gauge_->Add(labels).Set(metric.util_aicore);
-            aicpu_util_gauge_->Add(labels).Set(metric.util_aicpu);
-            ctrlcpu_util_gauge_->Add(labels).Set(metric.util_ctrlcpu);  // 新增
-            vec_util_gauge_->Add(labels).Set(metric.util_vec);
+            gauges.get(i, aicore_util_gauge_).Set(metric.util_aicore);
+            gauges.get(i, aicpu_util_gauge_).Set(metric.util_aicpu);
+            gauges.get(i, ctrlcpu_util_gauge_).Set(metric.util_ctrlcpu);  // 新增
+            gauges.get(i, vec_util_gauge_).Set(metric.util_vec);
             
             // 3. 更新存储资源指标
-            mem_total_gauge_->Add(labels).Set(metric.mem_total_mb);
-            mem_usage_gauge_->Add(labels).Set(metric.mem_usage_mb);
-            mem_util_gauge_->Add(labels).Set(metric.util_mem);
-            membw_util_gauge_->Add(labels).Set(metric.util_membw);
-            mem_freq_gauge_->Add(labels).Set(metric.freq_mem);  // 新增
+            gauges.get(i, mem_total_gauge_).Set(metric.mem_total_mb);
+            gauges.get(i, mem_usage_gauge_).Set(metric.mem_usage_mb);
+            gauges.get(i, mem_util_gauge_).Set(metric.util_mem);
+            gauges.get(i, membw_util_gauge_).Set(metric.util_membw);
+            gauges.get(i, mem_freq_gauge_).Set(metric.freq_mem);  // 新增
             
             // 4. 更新功耗指标
-            chip_power_gauge_->Add(labels).Set(metric.chip_power);
+            gauges.get(i, chip_power_gauge_).Set(metric.chip_power);
+            setCounter(counters.get(i, energy_counter_), metric.energy_joules);
             
             // 5. 更新环境指标
-            health_gauge_->Add(labels).Set(metric.health);
-            temperature_gauge_->Add(labels).Set(metric.temperature);
-            voltage_gauge_->Add(labels).Set(metric.voltage);
+            gauges.get(i, health_gauge_).Set(metric.health);
+            gauges.get(i, temperature_gauge_).Set(metric.temperature);
+            gauges.get(i, voltage_gauge_).Set(metric.voltage);
         }
     }
 }
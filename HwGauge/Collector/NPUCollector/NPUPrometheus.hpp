@@ -36,11 +36,15 @@ namespace hwgauge
         
         // 4. 功耗指标
         prometheus::Family<prometheus::Gauge>* chip_power_gauge_;
+        prometheus::Family<prometheus::Counter>* energy_counter_;
         
         // 5. 环境指标
         prometheus::Family<prometheus::Gauge>* health_gauge_;
         prometheus::Family<prometheus::Gauge>* temperature_gauge_;
         prometheus::Family<prometheus::Gauge>* voltage_gauge_;
+
+        SeriesCache<prometheus::Gauge> gauges;
+        SeriesCache<prometheus::Counter> counters;
     };
 }
 
@@ -0,0 +1,61 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "Collector/Base/DeviceCollector.hpp"
+#include "PerfEvents.hpp"
+#include "PerfDatabase.hpp"
+#include "PerfCsvLogger.hpp"
+#include "PerfPrometheus.hpp"
+
+#include <iostream>
+
+namespace hwgauge
+{
+#ifdef HWGAUGE_USE_POSTGRESQL
+    using PerfDatabaseType = PerfDatabase;
+#else
+    using PerfDatabaseType = NullType;
+#endif
+
+#ifdef HWGAUGE_USE_PROMETHEUS
+    using PerfPrometheusType = PerfPrometheus;
+#else
+    using PerfPrometheusType = NullType;
+#endif
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+    using PerfHttpApiType = HttpApi<PerfLabel, PerfMetrics>;
+#else
+    using PerfHttpApiType = NullType;
+#endif
+    // 定义别名
+    using PerfCollector = DeviceCollector<
+        PerfLabel, PerfMetrics, PerfEvents, PerfDatabaseType, PerfCsvLogger, PerfPrometheusType, PerfHttpApiType
+    >;
+    
+    // 定义特定的打印函数
+    template<>
+    inline void printMetric(const PerfLabel& l, const PerfMetrics& m)
+    {
+        std::cout
+            << "Perf{ "
+            << "cpu="     << l.index
+            << ", socket=" << l.socket
+            << ", ipc=" << m.ipc
+            << ", instructions=" << m.instructions << "M/s"
+            << ", cacheMissRatio=" << m.cacheMissRatio
+            << ", cacheMisses=" << m.cacheMisses << "M/s"
+            << ", branchMisses=" << m.branchMisses << "M/s"
+            << ", contextSwitches=" << m.contextSwitches << "/s"
+            << ", pageFaults=" << m.pageFaults << "/s"
+            << " }\n";
+    }
+
+    // 计数器数据不参与全局功耗统计
+    template<>
+    inline void setContextInfo(std::vector<PerfLabel>&, std::vector<PerfMetrics>&, TickContext&)
+    {}
+}
+
+#endif
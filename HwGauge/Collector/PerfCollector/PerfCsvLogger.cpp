@@ -0,0 +1,46 @@
+#ifdef __linux__
+
+#include "PerfCsvLogger.hpp"
+#include <sstream>
+#include <iomanip>
+
+namespace hwgauge
+{
+    PerfCsvLogger::PerfCsvLogger(const std::string& filepath) : CsvLogger(filepath) 
+    {
+        auto pos = m_filepath.rfind(".csv");
+        if (pos != std::string::npos) {
+            m_filepath.insert(pos, "_perf");
+        }
+
+        m_ofs.open(m_filepath, std::ios::out | std::ios::app);
+        
+        if (!m_ofs.is_open()) {
+            spdlog::error("[PerfCsvLogger] Failed to open file: {}", m_filepath);
+            throw FatalError("PerfCsvLogger open failed: " + m_filepath);
+        }
+        spdlog::info("[PerfCsvLogger] Initialized logger for: {}", m_filepath);
+    }
+
+    std::string PerfCsvLogger::getHeader() const {
+        return "CPU,Socket,IPC,Instr(M/s),CacheMissRatio,CacheMiss(M/s),BranchMiss(M/s),CtxSwitch(/s),PageFault(/s)";
+    }
+
+    std::string PerfCsvLogger::formatRow(const PerfLabel& l, const PerfMetrics& m) const {
+        std::stringstream ss;
+        ss << std::fixed << std::setprecision(3); // 比率需要更高精度
+
+        ss << l.index << ","
+           << l.socket << ","
+           << m.ipc << ","
+           << m.instructions << ","
+           << m.cacheMissRatio << ","
+           << m.cacheMisses << ","
+           << m.branchMisses << ","
+           << m.contextSwitches << ","
+           << m.pageFaults;
+        
+        return ss.str();
+    }
+}
+#endif
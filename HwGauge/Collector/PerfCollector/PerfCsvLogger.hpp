@@ -0,0 +1,20 @@
+#pragma once
+#ifdef __linux__
+
+#include "Collector/Base/CsvLogger.hpp"
+#include "PerfMetrics.hpp"
+
+namespace hwgauge
+{
+    class PerfCsvLogger : public CsvLogger<PerfLabel, PerfMetrics>
+    {
+    public:
+        explicit PerfCsvLogger(const std::string& filepath);
+
+    protected:
+        std::string getHeader() const override;
+        std::string formatRow(const PerfLabel& l, const PerfMetrics& m) const override;
+    };
+}
+
+#endif
@@ -0,0 +1,156 @@
+#if defined(__linux__) && defined(HWGAUGE_USE_POSTGRESQL)
+
+#include "PerfDatabase.hpp"
+
+#include "spdlog/spdlog.h"
+
+namespace hwgauge
+{
+    PerfDatabase::PerfDatabase(const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<PerfLabel, PerfMetrics>(config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    PerfDatabase::PerfDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<PerfLabel, PerfMetrics>(shared_conn, config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    void PerfDatabase::setup(const std::string& table_name_prefix)
+    {
+        // 设置表名
+        metric_table_name = table_name_prefix + "_perf_metric";
+        info_table_name = table_name_prefix + "_perf_info";
+        // 创建表
+        if (!createMetricTable() || !createInfoTable())throw hwgauge::FatalError("[Database] Create Table Failed");
+        // 构建SQL模板
+        metric_copy_sql =
+            "COPY " + metric_table_name +
+            " (timestamp, cpu_index, ipc, instructions_mps, cache_miss_ratio, "
+            "cache_misses_mps, branch_misses_mps, context_switches, page_faults, seq) "
+            "FROM STDIN;";
+
+        info_insert_sql =
+            "INSERT INTO " + info_table_name +
+            " (cpu_index, socket_index) "
+            "VALUES ($1, $2) "
+            "ON CONFLICT (cpu_index) DO UPDATE SET "
+            "socket_index = EXCLUDED.socket_index;";
+
+        spdlog::info("[PerfDatabase] Initialize successfully");
+    }
+
+    PerfDatabase::~PerfDatabase(){}
+
+    bool PerfDatabase::createMetricTable()
+    {
+        const std::string sql =
+            "CREATE TABLE IF NOT EXISTS " + metric_table_name + " ("
+            "timestamp TIMESTAMPTZ NOT NULL,"          // 时间戳
+            "cpu_index INTEGER NOT NULL,"             // OS cpu id
+            "ipc DOUBLE PRECISION,"                   // 每周期指令数
+            "instructions_mps DOUBLE PRECISION,"      // 指令数(百万/秒)
+            "cache_miss_ratio DOUBLE PRECISION,"      // LLC 未命中率
+            "cache_misses_mps DOUBLE PRECISION,"      // LLC 未命中(百万/秒)
+            "branch_misses_mps DOUBLE PRECISION,"     // 分支预测失败(百万/秒)
+            "context_switches DOUBLE PRECISION,"      // 上下文切换(次/秒)
+            "page_faults DOUBLE PRECISION"            // 缺页(次/秒)
+            ");";
+
+        if (!execSQL(sql))
+        {
+            spdlog::error("[PerfDatabase] Failed to create metric table");
+            return false;
+        }
+        if (!upgradeTimestampColumn(metric_table_name))
+        {
+            spdlog::error("[PerfDatabase] Failed to convert timestamp column to TIMESTAMPTZ");
+            return false;
+        }
+        if (!addSeqColumn(metric_table_name))
+        {
+            spdlog::error("[PerfDatabase] Failed to add seq column");
+            return false;
+        }
+        spdlog::info("[PerfDatabase] Table {} created or already exists", metric_table_name);
+        return true;
+    }
+
+    bool PerfDatabase::createInfoTable()
+    {
+        const std::string sql =
+            "CREATE TABLE IF NOT EXISTS " + info_table_name + " ("
+            "cpu_index INTEGER NOT NULL PRIMARY KEY,"  // OS cpu id
+            "socket_index INTEGER"                     // 所属 socket
+            ");";
+        if (!execSQL(sql))
+        {
+            spdlog::error("[PerfDatabase] Failed to create info table");
+            return false;
+        }
+        spdlog::info("[PerfDatabase] Table {} created or already exists", info_table_name);
+        return true;
+    }
+
+    void PerfDatabase::writeMetric(TimePoint cur_time, std::uint64_t seq,
+                                const std::vector<PerfLabel>& label_list,
+                                const std::vector<PerfMetrics>& metric_list,
+                                bool)
+    {
+        if (!isConnected())throw hwgauge::FatalError("[PerfDatabase] The database hasn't been connected before writing");
+
+        copy_buf.clear();
+        for (size_t i = 0; i < label_list.size(); ++i)
+        {
+            const PerfMetrics& metric = metric_list[i];
+
+            appendCopyField(copy_buf, cur_time);
+            copy_buf += '\t';
+            appendCopyField(copy_buf, static_cast<long long>(label_list[i].index));
+            for (double v : { metric.ipc, metric.instructions, metric.cacheMissRatio, metric.cacheMisses,
+                              metric.branchMisses, metric.contextSwitches, metric.pageFaults })
+            {
+                copy_buf += '\t';
+                appendCopyField(copy_buf, v);
+            }
+            copy_buf += '\t';
+            appendCopyField(copy_buf, seqValue(seq));
+            copy_buf += '\n';
+        }
+
+        if (!copyIn(metric_copy_sql, copy_buf))return;
+        HWGAUGE_LOG_COUNT("PerfDatabase records", label_list.size());
+    }
+    
+    void PerfDatabase::writeInfo(const std::vector<PerfLabel>& label_list,
+                                bool useTransaction)
+    {
+        if (!isConnected())throw hwgauge::FatalError("[PerfDatabase] The database hasn't been connected before writing");
+        if (useTransaction && !startTransaction())return;
+        
+        int inserted = 0;
+        for (size_t i = 0; i < label_list.size(); ++i)
+        {
+            const PerfLabel& label = label_list[i];
+
+            std::vector<std::string> buf(2);
+            const char* params[2] = {
+                to_sql_param_long(static_cast<long long>(label.index), buf[0]),
+                to_sql_param_long(static_cast<long long>(label.socket), buf[1]),
+            };
+
+            if (!execSQL(info_insert_sql, std::vector<const char*>(params, params + 2)))
+            {
+                if(useTransaction) rollbackTransaction();
+                return;
+            }
+            ++inserted;
+        }
+        if (useTransaction && !commitTransaction())return;
+        spdlog::info("[PerfDatabase] Successfully inserted {}/{} records into {}", inserted, label_list.size(), info_table_name);
+    }
+}
+
+#endif
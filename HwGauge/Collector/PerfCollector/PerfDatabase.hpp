@@ -0,0 +1,48 @@
+#pragma once
+
+#if defined(__linux__) && defined(HWGAUGE_USE_POSTGRESQL)
+
+#include "PerfMetrics.hpp"
+#include "Collector/Common/Config.hpp"
+#include "Collector/Base/Database.hpp"
+
+namespace hwgauge
+{
+    /* perf_event 计数器数据库操作类，指标数据使用 COPY 批量写入 */
+    class PerfDatabase : public Database<PerfLabel, PerfMetrics>
+    {
+    public:
+        /* 构造函数 */
+        explicit PerfDatabase(const DBConfig& config_, const std::string& table_name_prefix);
+
+        /* 构造函数：复用外部连接 */
+        PerfDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix);
+        
+        /* 析构函数 */
+        ~PerfDatabase();
+        
+        /* 写入逐 CPU 计数器数据 */
+        void writeMetric(TimePoint cur_time, std::uint64_t seq,
+                        const std::vector<PerfLabel>& label_list, 
+                        const std::vector<PerfMetrics>& metric_list,
+                        bool useTransaction = true) override;
+        
+        /* 写入逐 CPU 静态数据 */
+        void writeInfo(const std::vector<PerfLabel>& label_list,
+                      bool useTransaction = true) override;
+        
+    private:
+        /* 设置表名、建表并构建SQL模板 */
+        void setup(const std::string& table_name_prefix);
+
+        /* 创建指标数据表 */
+        bool createMetricTable() override;
+        /* 创建静态数据表 */
+        bool createInfoTable() override;
+
+        std::string metric_copy_sql;    // COPY 语句
+        std::string copy_buf;           // 复用的 COPY 数据缓冲
+    };
+}
+
+#endif
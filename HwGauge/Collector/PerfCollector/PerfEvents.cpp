@@ -0,0 +1,152 @@
+#ifdef __linux__
+#include "PerfEvents.hpp"
+#include "Collector/Common/Exception.hpp"
+#include "Collector/Common/SysfsFile.hpp"
+
+#include "spdlog/spdlog.h"
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <linux/perf_event.h>
+
+namespace hwgauge
+{
+    namespace
+    {
+        enum HardwareSlot { Cycles, Instructions, CacheReferences, CacheMisses, BranchMisses, HardwareCount };
+        enum SoftwareSlot { TaskClock, ContextSwitches, PageFaults, SoftwareCount };
+
+        const PerfEventSpec kHardwareEvents[HardwareCount] = {
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_REFERENCES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES },
+            { PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES },
+        };
+
+        const PerfEventSpec kSoftwareEvents[SoftwareCount] = {
+            { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_TASK_CLOCK },
+            { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_CONTEXT_SWITCHES },
+            { PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS },
+        };
+
+        // 解析 "0-3,8,10-11" 形式的 CPU 列表
+        std::vector<std::size_t> parseCpuList(const std::string& text)
+        {
+            std::vector<std::size_t> result;
+            const char* p = text.c_str();
+            while (*p)
+            {
+                char* end;
+                unsigned long first = std::strtoul(p, &end, 10);
+                if (end == p)break;
+                unsigned long last = first;
+                p = end;
+                if (*p == '-')
+                {
+                    last = std::strtoul(p + 1, &end, 10);
+                    p = end;
+                }
+                for (unsigned long c = first; c <= last; ++c)result.push_back(c);
+                if (*p == ',')++p;
+                else break;
+            }
+            return result;
+        }
+
+        // 比率的分母为 0 或任一计数不可用时返回 -1
+        double ratio(double num, double den)
+        {
+            return (num >= 0.0 && den > 0.0) ? num / den : -1.0;
+        }
+
+        double rate(double count, double seconds, double unit = 1.0)
+        {
+            return (count >= 0.0 && seconds > 0.0) ? count / seconds / unit : -1.0;
+        }
+    }
+
+    PerfEvents::PerfEvents(const CollectorConfig& cfg)
+    {
+        const std::string cpuDir = cfg.hostRoot + "/sys/devices/system/cpu";
+        std::ifstream ifs(cpuDir + "/online");
+        std::string online;
+        std::getline(ifs, online);
+        cpus = parseCpuList(online);
+        if (cpus.empty())throw RecoverableError("[PerfEvents] Cannot read online CPU list from " + cpuDir + "/online");
+
+        sockets.resize(cpus.size());
+        for (std::size_t k = 0; k < cpus.size(); ++k)
+        {
+            SysfsFile package(cpuDir + "/cpu" + std::to_string(cpus[k]) + "/topology/physical_package_id");
+            long long socket = 0;
+            if (!package.readInt(socket) || socket < 0)socket = 0;
+            sockets[k] = static_cast<std::size_t>(socket);
+        }
+
+        // 第一个 CPU 上硬件事件打不开时认为整机不可用，不再逐个尝试
+        hardware.resize(cpus.size());
+        for (std::size_t k = 0; k < cpus.size(); ++k)
+        {
+            if (hardware[k].open(static_cast<int>(cpus[k]), kHardwareEvents, HardwareCount))continue;
+            spdlog::warn("[PerfEvents] Hardware events unavailable on cpu{} ({}), using software events only",
+                cpus[k], std::strerror(errno));
+            hardware.clear();
+            break;
+        }
+
+        software.resize(cpus.size());
+        for (std::size_t k = 0; k < cpus.size(); ++k)
+        {
+            if (software[k].open(static_cast<int>(cpus[k]), kSoftwareEvents, SoftwareCount))continue;
+            int err = errno;
+            throw RecoverableError(std::string("[PerfEvents] perf_event_open failed on cpu") + std::to_string(cpus[k]) + ": " +
+                std::strerror(err) + (err == EACCES ? " (check /proc/sys/kernel/perf_event_paranoid)" : ""));
+        }
+
+        // 基线
+        for (auto& group : hardware)group.read();
+        for (auto& group : software)group.read();
+        spdlog::info("[PerfEvents] Initialize successfully: {} CPUs, hardware events {}", cpus.size(), hardware.empty() ? "off" : "on");
+    }
+
+    std::vector<PerfLabel> PerfEvents::labels()
+    {
+        std::vector<PerfLabel> labels;
+        labels.reserve(cpus.size());
+        for (std::size_t k = 0; k < cpus.size(); ++k)
+            labels.push_back(PerfLabel{ cpus[k], sockets[k] });
+        return labels;
+    }
+
+    void PerfEvents::sample(std::vector<PerfLabel>& labels, std::vector<PerfMetrics>& metrics)
+    {
+        for (std::size_t k = 0; k < labels.size(); ++k)
+        {
+            PerfMetrics& m = metrics[k];
+            m = PerfMetrics{ -1.0, -1.0, -1.0, -1.0, -1.0, -1.0, -1.0 };
+
+            if (!hardware.empty() && hardware[k].read())
+            {
+                const PerfGroup& g = hardware[k];
+                const double seconds = g.seconds();
+                m.ipc = ratio(g.delta(Instructions), g.delta(Cycles));
+                m.instructions = rate(g.delta(Instructions), seconds, 1e6);
+                m.cacheMissRatio = ratio(g.delta(CacheMisses), g.delta(CacheReferences));
+                m.cacheMisses = rate(g.delta(CacheMisses), seconds, 1e6);
+                m.branchMisses = rate(g.delta(BranchMisses), seconds, 1e6);
+            }
+
+            if (software[k].read())
+            {
+                const PerfGroup& g = software[k];
+                const double seconds = g.seconds();
+                m.contextSwitches = rate(g.delta(ContextSwitches), seconds);
+                m.pageFaults = rate(g.delta(PageFaults), seconds);
+            }
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,40 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "PerfMetrics.hpp"
+#include "PerfGroup.hpp"
+#include "Collector/Common/Config.hpp"
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /**
+     * 基于 perf_event_open 的逐 CPU 计数器采集，用于 PCM 无法运行（MSR 不可访问、PMU 被占用）的主机
+     * 每个 CPU 一个硬件事件组 (cycles, instructions, cache references/misses, branch misses)
+     * 和一个软件事件组 (task-clock, context switches, page faults)；
+     * 硬件事件不可用时（虚拟机等）只保留软件事件组。
+     */
+    class PerfEvents
+    {
+    public:
+        explicit PerfEvents(const CollectorConfig& cfg);
+
+        PerfEvents(const PerfEvents&) = delete;
+        PerfEvents& operator=(const PerfEvents&) = delete;
+
+        std::string name() { return "perf"; }
+
+        std::vector<PerfLabel>   labels();
+        void sample(std::vector<PerfLabel>& labels, std::vector<PerfMetrics>& metrics);
+
+    private:
+        std::vector<std::size_t> cpus;
+        std::vector<std::size_t> sockets;
+        std::vector<PerfGroup> hardware;    // 与 cpus 对齐，硬件事件不可用时为空
+        std::vector<PerfGroup> software;
+    };
+}
+
+#endif
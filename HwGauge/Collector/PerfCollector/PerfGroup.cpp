@@ -0,0 +1,139 @@
+#ifdef __linux__
+#include "PerfGroup.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace hwgauge
+{
+    namespace
+    {
+        int perfEventOpen(perf_event_attr& attr, int cpu, int groupFd)
+        {
+            // pid = -1, cpu = N：统计该 CPU 上的所有进程
+            return static_cast<int>(::syscall(__NR_perf_event_open, &attr, -1, cpu, groupFd, PERF_FLAG_FD_CLOEXEC));
+        }
+    }
+
+    PerfGroup::PerfGroup(PerfGroup&& other) noexcept
+        : fds(std::move(other.fds)),
+          position(std::move(other.position)),
+          buf(std::move(other.buf)),
+          prev(std::move(other.prev)),
+          deltas(std::move(other.deltas)),
+          elapsed(other.elapsed),
+          hasPrev(other.hasPrev)
+    {
+        other.fds.clear();
+    }
+
+    PerfGroup& PerfGroup::operator=(PerfGroup&& other) noexcept
+    {
+        if (this != &other)
+        {
+            close();
+            fds = std::move(other.fds);
+            position = std::move(other.position);
+            buf = std::move(other.buf);
+            prev = std::move(other.prev);
+            deltas = std::move(other.deltas);
+            elapsed = other.elapsed;
+            hasPrev = other.hasPrev;
+            other.fds.clear();
+        }
+        return *this;
+    }
+
+    bool PerfGroup::open(int cpu, const PerfEventSpec* specs, std::size_t count)
+    {
+        close();
+        position.assign(count, -1);
+
+        for (std::size_t slot = 0; slot < count; ++slot)
+        {
+            perf_event_attr attr;
+            std::memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = specs[slot].type;
+            attr.config = specs[slot].config;
+            attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+            attr.disabled = fds.empty() ? 1 : 0;   // 只有 leader 控制启停
+
+            int fd = perfEventOpen(attr, cpu, fds.empty() ? -1 : fds.front());
+            if (fd < 0)
+            {
+                if (fds.empty())
+                {
+                    int err = errno;
+                    close();
+                    errno = err;
+                    return false;
+                }
+                continue;
+            }
+            position[slot] = static_cast<int>(fds.size());
+            fds.push_back(fd);
+        }
+
+        buf.assign(3 + fds.size(), 0);
+        prev.assign(buf.size(), 0);
+        deltas.assign(fds.size(), 0.0);
+        hasPrev = false;
+
+        ::ioctl(fds.front(), PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+        ::ioctl(fds.front(), PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        return true;
+    }
+
+    void PerfGroup::close()
+    {
+        // 先关成员再关 leader
+        for (auto it = fds.rbegin(); it != fds.rend(); ++it)::close(*it);
+        fds.clear();
+        hasPrev = false;
+    }
+
+    bool PerfGroup::read()
+    {
+        if (fds.empty())return false;
+
+        const std::size_t bytes = buf.size() * sizeof(std::uint64_t);
+        ssize_t n;
+        do {
+            n = ::read(fds.front(), buf.data(), bytes);
+        } while (n < 0 && errno == EINTR);
+        if (n != static_cast<ssize_t>(bytes) || buf[0] != fds.size())
+        {
+            hasPrev = false;
+            return false;
+        }
+
+        bool ok = hasPrev;
+        if (ok)
+        {
+            const std::uint64_t enabled = buf[1] - prev[1];
+            const std::uint64_t running = buf[2] - prev[2];
+            elapsed = static_cast<double>(enabled) * 1e-9;
+            // 区间内组未被调度时没有数据
+            ok = running > 0;
+            const double scale = ok ? static_cast<double>(enabled) / static_cast<double>(running) : 0.0;
+            for (std::size_t i = 0; i < deltas.size(); ++i)
+                deltas[i] = static_cast<double>(buf[3 + i] - prev[3 + i]) * scale;
+        }
+        std::swap(buf, prev);
+        hasPrev = true;
+        return ok;
+    }
+
+    double PerfGroup::delta(std::size_t slot) const
+    {
+        if (slot >= position.size() || position[slot] < 0)return -1.0;
+        return deltas[position[slot]];
+    }
+}
+
+#endif
@@ -0,0 +1,57 @@
+#pragma once
+
+#ifdef __linux__
+
+#include <cstdint>
+#include <vector>
+
+namespace hwgauge
+{
+    struct PerfEventSpec
+    {
+        std::uint32_t type;     // PERF_TYPE_HARDWARE / PERF_TYPE_SOFTWARE
+        std::uint64_t config;   // PERF_COUNT_*
+    };
+
+    /**
+     * 单个 CPU 上的一组 perf 事件
+     * 第一个事件为 group leader，读取时使用 PERF_FORMAT_GROUP 一次 read 得到全部计数，
+     * 缓冲区在 open 时分配，之后每轮复用。组被复用 (multiplexing) 时按
+     * time_enabled / time_running 的区间比例缩放。
+     */
+    class PerfGroup
+    {
+    public:
+        PerfGroup() = default;
+        ~PerfGroup() { close(); }
+
+        PerfGroup(const PerfGroup&) = delete;
+        PerfGroup& operator=(const PerfGroup&) = delete;
+        PerfGroup(PerfGroup&& other) noexcept;
+        PerfGroup& operator=(PerfGroup&& other) noexcept;
+
+        // leader 打开失败返回 false（errno 保留）；其余事件打开失败时跳过，对应 slot 不可用
+        bool open(int cpu, const PerfEventSpec* specs, std::size_t count);
+        void close();
+        bool isOpen() const { return !fds.empty(); }
+
+        // 读取一轮并计算与上一轮的差值，首轮或读取失败返回 false
+        bool read();
+
+        // 第 slot 个事件在区间内的计数（已缩放），事件不可用返回 -1
+        double delta(std::size_t slot) const;
+        // 区间时长 (s)，按 time_enabled 计算
+        double seconds() const { return elapsed; }
+
+    private:
+        std::vector<int> fds;
+        std::vector<int> position;          // slot -> 在组内的读取位置，-1 表示未打开
+        std::vector<std::uint64_t> buf;     // nr, time_enabled, time_running, value[nr]
+        std::vector<std::uint64_t> prev;
+        std::vector<double> deltas;         // 按组内位置
+        double elapsed{ 0.0 };
+        bool hasPrev{ false };
+    };
+}
+
+#endif
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Collector/Common/Fields.hpp"
+#include <string>
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+#include <nlohmann/json.hpp>
+#endif
+
+namespace hwgauge
+{
+    struct PerfLabel
+    {
+        std::size_t index;      // OS cpu id
+        std::size_t socket;     // 所属 socket
+    };
+
+    // 硬件事件不可用（虚拟机、perf_event_paranoid 限制）时对应字段为 -1
+    struct PerfMetrics
+    {
+        double ipc;                     // instructions per cycle
+        double instructions;            // retired instructions in millions per second
+        double cacheMissRatio;          // LLC misses / references (0-1)
+        double cacheMisses;             // LLC misses in millions per second
+        double branchMisses;            // branch mispredictions in millions per second
+        double contextSwitches;         // context switches per second (software event)
+        double pageFaults;              // page faults per second (software event)
+    };
+
+    template<>
+    struct Fields<PerfLabel>
+    {
+        template<typename T, typename F>
+        static void visit(T& l, F&& f)
+        {
+            f("index", l.index);
+            f("socket", l.socket);
+        }
+    };
+
+    template<>
+    struct Fields<PerfMetrics>
+    {
+        template<typename T, typename F>
+        static void visit(T& m, F&& f)
+        {
+            f("ipc", m.ipc);
+            f("instructions", m.instructions);
+            f("cacheMissRatio", m.cacheMissRatio);
+            f("cacheMisses", m.cacheMisses);
+            f("branchMisses", m.branchMisses);
+            f("contextSwitches", m.contextSwitches);
+            f("pageFaults", m.pageFaults);
+        }
+    };
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+    inline void to_json(nlohmann::json& j, const PerfLabel& l) {
+        j = nlohmann::json{{"index", l.index}, {"socket", l.socket}};
+    }
+
+    inline void to_json(nlohmann::json& j, const PerfMetrics& m) {
+        j = nlohmann::json{
+            {"ipc", m.ipc},
+            {"instructions", m.instructions},
+            {"cacheMissRatio", m.cacheMissRatio},
+            {"cacheMisses", m.cacheMisses},
+            {"branchMisses", m.branchMisses},
+            {"contextSwitches", m.contextSwitches},
+            {"pageFaults", m.pageFaults}
+        };
+    }
+#endif
+}
@@ -0,0 +1,66 @@
+#if defined(__linux__) && defined(HWGAUGE_USE_PROMETHEUS)
+
+#include "PerfPrometheus.hpp"
+
+namespace hwgauge
+{
+    PerfPrometheus::PerfPrometheus(std::shared_ptr<prometheus::Registry> registry_)
+        : Prometheus<PerfLabel, PerfMetrics>(registry_)
+    {
+        // 创建指标族（Families）
+        static const std::array<std::pair<const char*, const char*>, kMetricCount> specs = {{
+            {"perf_ipc", "Per-CPU instructions per cycle (perf_event)"},
+            {"perf_instructions_mps", "Per-CPU retired instructions in millions per second"},
+            {"perf_cache_miss_ratio", "Per-CPU LLC miss ratio (misses / references)"},
+            {"perf_cache_misses_mps", "Per-CPU LLC misses in millions per second"},
+            {"perf_branch_misses_mps", "Per-CPU branch mispredictions in millions per second"},
+            {"perf_context_switches_per_second", "Per-CPU context switches per second"},
+            {"perf_page_faults_per_second", "Per-CPU page faults per second"},
+        }};
+
+        auto& registry_ref = *registry;
+        for (std::size_t k = 0; k < kMetricCount; ++k)
+        {
+            families[k] = &prometheus::BuildGauge()
+                .Name(specs[k].first)
+                .Help(specs[k].second)
+                .Register(registry_ref);
+        }
+    }
+
+    void PerfPrometheus::rebuild(const std::vector<PerfLabel>& label_list)
+    {
+        gauges.assign(label_list.size(), {});
+        cpuLabels.resize(label_list.size());
+        for (size_t i = 0; i < label_list.size(); i++)
+        {
+            cpuLabels[i] =
+            {
+                {"cpu", std::to_string(label_list[i].index)},
+                {"socket", std::to_string(label_list[i].socket)}
+            };
+        }
+    }
+
+    void PerfPrometheus::write(const std::vector<PerfLabel>& label_list,const std::vector<PerfMetrics>& metric_list)
+    {
+        // CPU 集合在采集器生命周期内不变，只需在第一轮构建
+        if (gauges.size() != label_list.size())rebuild(label_list);
+
+        for (size_t i = 0; i < metric_list.size(); i++)
+        {
+            std::size_t k = 0;
+            auto& row = gauges[i];
+            Fields<PerfMetrics>::visit(metric_list[i], [&](const char*, double value, auto...) {
+                if (value != -1.0)
+                {
+                    if (!row[k])row[k] = &families[k]->Add(cpuLabels[i]);
+                    row[k]->Set(value);
+                }
+                ++k;
+            });
+        }
+    }
+}
+
+#endif
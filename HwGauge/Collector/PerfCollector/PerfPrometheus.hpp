@@ -0,0 +1,35 @@
+#pragma once
+
+#if defined(__linux__) && defined(HWGAUGE_USE_PROMETHEUS)
+
+#include "Collector/Base/Prometheus.hpp"
+#include "PerfMetrics.hpp"
+
+#include <array>
+#include <map>
+
+namespace hwgauge
+{
+    class PerfPrometheus:public Prometheus<PerfLabel,PerfMetrics>
+    {
+    public:
+        static constexpr std::size_t kMetricCount = 7;
+
+        explicit PerfPrometheus(std::shared_ptr<prometheus::Registry> registry_);
+        
+        virtual ~PerfPrometheus() = default;
+
+        void write(const std::vector<PerfLabel>& label_list,const std::vector<PerfMetrics>& metric_list);
+    private:
+        void rebuild(const std::vector<PerfLabel>& label_list);
+
+        // 按 Fields<PerfMetrics> 的顺序排列
+        std::array<prometheus::Family<prometheus::Gauge>*, kMetricCount> families;
+
+        // 每个 CPU 的 Gauge 指针缓存；不可用的事件 (-1) 不创建
+        std::vector<std::array<prometheus::Gauge*, kMetricCount>> gauges;
+        std::vector<std::map<std::string, std::string>> cpuLabels;
+    };
+}
+
+#endif
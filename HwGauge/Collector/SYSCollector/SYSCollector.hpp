@@ -43,17 +43,38 @@ namespace hwgauge
             << "Mem: " << m.memUsedGB << "/" << m.memTotalGB << "GB (" << m.memUtilizationPercent << "%), "
             << "Disk: R=" << m.diskReadMBps << " W=" << m.diskWriteMBps << " MB/s (MaxUtil: " << m.maxDiskUtilPercent << "%), "
             << "Net: In=" << m.netDownloadMBps << " Out=" << m.netUploadMBps << " MB/s, "
-            << "systemPower: " << m.systemPowerWatts << " totalPower: " << m.totalPowerWatts << " W"
+            << "systemPower: " << m.systemPowerWatts << " totalPower: " << m.totalPowerWatts << " W, "
+            << "systemEnergy: " << m.systemEnergyJoules << " totalEnergy: " << m.totalEnergyJoules << " J"
             << " }\n";
     }
 
-    // 定义全局信息接口
+    // 定义上下文信息接口：汇总本轮各组件的功率与累计能耗
     template<>
-    inline void setContextInfo(std::vector<SYSLabel>& l, std::vector<SYSMetrics>& m)
+    inline void setContextInfo(std::vector<SYSLabel>& l, std::vector<SYSMetrics>& m, TickContext& context)
     {
+        const double totalPower = context.totalPower();
+        const double totalEnergy = context.totalEnergy();
         for(size_t i=0; i<l.size(); i++) 
         {
-            m[i].totalPowerWatts=sharedPower.getTotalPower();
+            m[i].totalPowerWatts=totalPower;
+            m[i].totalEnergyJoules=totalEnergy;
+        }
+    }
+
+    template<>
+    struct ContextDeps<SYSLabel, SYSMetrics>
+    {
+        static constexpr unsigned provides = 0;
+        static constexpr unsigned consumes = kAllPowerSources;
+    };
+
+    // 定义作业能耗统计数据：整机（IPMI）
+    template<>
+    inline void jobSamples(const std::vector<SYSLabel>& l, const std::vector<SYSMetrics>& m, std::vector<JobSample>& out)
+    {
+        for(size_t i=0; i<l.size(); i++)
+        {
+            out.push_back(JobSample{"system", m[i].systemEnergyJoules, m[i].systemPowerWatts, -1.0});
         }
     }
 }
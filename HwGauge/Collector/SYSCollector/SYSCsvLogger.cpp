@@ -22,12 +22,32 @@ namespace hwgauge {
         spdlog::info("[SYSCsvLogger] Initialized logger for: {}", m_filepath);
     }
 
-    std::string SYSCsvLogger::getHeader() const {
+    std::string SYSCsvLogger::header() {
         return "MachineName,"
                "MemTotal(GB),MemUsed(GB),MemUtil(%),"
                "DiskRead(MB/s),DiskWrite(MB/s),MaxDiskUtil(%),"
                "NetDown(MB/s),NetUp(MB/s),"
-               "SysPower(W),TotalPower(W)";
+               "SysPower(W),TotalPower(W),SysEnergy(J),TotalEnergy(J)";
+    }
+
+    std::string SYSCsvLogger::getHeader() const {
+        return header();
+    }
+
+    void SYSCsvLogger::parseRow(CsvFieldReader& r, SYSLabel& l, SYSMetrics& m) {
+        r.get(l.name);
+        r.get(m.memTotalGB);
+        r.get(m.memUsedGB);
+        r.get(m.memUtilizationPercent);
+        r.get(m.diskReadMBps);
+        r.get(m.diskWriteMBps);
+        r.get(m.maxDiskUtilPercent);
+        r.get(m.netDownloadMBps);
+        r.get(m.netUploadMBps);
+        r.get(m.systemPowerWatts);
+        r.get(m.totalPowerWatts);
+        r.get(m.systemEnergyJoules);
+        r.get(m.totalEnergyJoules);
     }
 
     std::string SYSCsvLogger::formatRow(const SYSLabel& l, const SYSMetrics& m) const {
@@ -44,7 +64,9 @@ namespace hwgauge {
            << m.netDownloadMBps << ","
            << m.netUploadMBps << ","
            << m.systemPowerWatts << ","
-           << m.totalPowerWatts;
+           << m.totalPowerWatts << ","
+           << m.systemEnergyJoules << ","
+           << m.totalEnergyJoules;
 
         return ss.str();
     }
@@ -2,12 +2,17 @@
 #ifdef __linux__
 
 #include "Collector/Base/CsvLogger.hpp"
+#include "Collector/Common/CsvReader.hpp"
 #include "SYSMetrics.hpp"
 
 namespace hwgauge {
     class SYSCsvLogger : public CsvLogger<SYSLabel, SYSMetrics> {
     public:
         explicit SYSCsvLogger(const std::string& filepath);
+
+        // 表头与 formatRow 的逆过程，供回放 (--replay) 读取已记录的文件
+        static std::string header();
+        static void parseRow(CsvFieldReader& r, SYSLabel& l, SYSMetrics& m);
     protected:
         std::string getHeader() const override;
         std::string formatRow(const SYSLabel& l, const SYSMetrics& m) const override;
@@ -10,6 +10,17 @@ namespace hwgauge
 {
     SYSDatabase::SYSDatabase(const DBConfig& config_, const std::string& table_name_prefix)
         : Database<SYSLabel, SYSMetrics>(config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    SYSDatabase::SYSDatabase(PGconn* shared_conn, const DBConfig& config_, const std::string& table_name_prefix)
+        : Database<SYSLabel, SYSMetrics>(shared_conn, config_)
+    {
+        setup(table_name_prefix);
+    }
+
+    void SYSDatabase::setup(const std::string& table_name_prefix)
     {
         // 设置表名
         metric_table_name = table_name_prefix + "_sys_metric";
@@ -21,8 +32,9 @@ namespace hwgauge
             "INSERT INTO "+ metric_table_name +
             "(timestamp, mem_total_gb, mem_used_gb, mem_util_percent, "
             "disk_read_mbps, disk_write_mbps, max_disk_util_percent, "
-            "net_download_mbps, net_upload_mbps, system_power_watts, total_power_watts) " 
-            "VALUES ($1,$2,$3,$4,$5,$6,$7,$8,$9,$10,$11);";
+            "net_download_mbps, net_upload_mbps, system_power_watts, total_power_watts, "
+            "system_energy_joules, total_energy_joules, seq) "
+            "VALUES ($1,$2,$3,$4,$5,$6,$7,$8,$9,$10,$11,$12,$13,$14);";
 
         spdlog::info("[SYSDatabase] Initialize successfully");
     }
@@ -33,7 +45,7 @@ namespace hwgauge
     {
         const std::string sql =
             "CREATE TABLE IF NOT EXISTS " + metric_table_name + " ("
-            "timestamp TIMESTAMP NOT NULL,"
+            "timestamp TIMESTAMPTZ NOT NULL,"
             "mem_total_gb DOUBLE PRECISION,"
             "mem_used_gb DOUBLE PRECISION,"
             "mem_util_percent DOUBLE PRECISION,"
@@ -44,6 +56,8 @@ namespace hwgauge
             "net_upload_mbps DOUBLE PRECISION,"
             "system_power_watts DOUBLE PRECISION,"
             "total_power_watts DOUBLE PRECISION,"
+            "system_energy_joules DOUBLE PRECISION,"
+            "total_energy_joules DOUBLE PRECISION,"
             "PRIMARY KEY (timestamp)"
             ");";
         if (!execSQL(sql))
@@ -51,6 +65,27 @@ namespace hwgauge
             spdlog::error("[SYSDatabase] Failed to create metric table");
             return false;
         }
+        if (!upgradeTimestampColumn(metric_table_name))
+        {
+            spdlog::error("[SYSDatabase] Failed to convert timestamp column to TIMESTAMPTZ");
+            return false;
+        }
+
+        // 兼容旧版本创建的表
+        const std::string upgrade =
+            "ALTER TABLE " + metric_table_name +
+            " ADD COLUMN IF NOT EXISTS system_energy_joules DOUBLE PRECISION,"
+            " ADD COLUMN IF NOT EXISTS total_energy_joules DOUBLE PRECISION;";
+        if (!execSQL(upgrade))
+        {
+            spdlog::error("[SYSDatabase] Failed to upgrade metric table");
+            return false;
+        }
+        if (!addSeqColumn(metric_table_name))
+        {
+            spdlog::error("[SYSDatabase] Failed to add seq column");
+            return false;
+        }
         spdlog::info("[SYSDatabase] Table {} created or already exists", metric_table_name);
         return true;
     }
@@ -61,7 +96,7 @@ namespace hwgauge
         return true;
     }
 
-    void SYSDatabase::writeMetric(const std::string& cur_time,
+    void SYSDatabase::writeMetric(TimePoint cur_time, std::uint64_t seq,
                                 const std::vector<SYSLabel>& label_list,
                                 const std::vector<SYSMetrics>& metric_list,
                                 bool useTransaction)
@@ -70,27 +105,31 @@ namespace hwgauge
         if (useTransaction && !startTransaction())return;
         
         int inserted = 0;
+        // 时间戳以二进制 TIMESTAMPTZ 绑定，每轮只转换一次
+        const PgTimestamp time(cur_time);
         for (size_t i = 0; i < label_list.size(); ++i)
         {
             const SYSLabel& label = label_list[i];
             const SYSMetrics& metric = metric_list[i];
 
-            std::vector<std::string> buf(11);
-            const char* params[11] = {
-                to_sql_param_string(cur_time, buf[0]),
-                to_sql_param_double(metric.memTotalGB, buf[1]),
-                to_sql_param_double(metric.memUsedGB, buf[2]),
-                to_sql_param_double(metric.memUtilizationPercent, buf[3]),
-                to_sql_param_double(metric.diskReadMBps, buf[4]),
-                to_sql_param_double(metric.diskWriteMBps, buf[5]),
-                to_sql_param_double(metric.maxDiskUtilPercent, buf[6]),
-                to_sql_param_double(metric.netDownloadMBps, buf[7]),
-                to_sql_param_double(metric.netUploadMBps, buf[8]),
-                to_sql_param_double(metric.systemPowerWatts, buf[9]),
-                to_sql_param_double(metric.totalPowerWatts, buf[10]),
+            std::vector<std::string> buf(13);
+            const char* params[13] = {
+                to_sql_param_double(metric.memTotalGB, buf[0]),
+                to_sql_param_double(metric.memUsedGB, buf[1]),
+                to_sql_param_double(metric.memUtilizationPercent, buf[2]),
+                to_sql_param_double(metric.diskReadMBps, buf[3]),
+                to_sql_param_double(metric.diskWriteMBps, buf[4]),
+                to_sql_param_double(metric.maxDiskUtilPercent, buf[5]),
+                to_sql_param_double(metric.netDownloadMBps, buf[6]),
+                to_sql_param_double(metric.netUploadMBps, buf[7]),
+                to_sql_param_double(metric.systemPowerWatts, buf[8]),
+                to_sql_param_double(metric.totalPowerWatts, buf[9]),
+                to_sql_param_double(metric.systemEnergyJoules, buf[10]),
+                to_sql_param_double(metric.totalEnergyJoules, buf[11]),
+                to_sql_param_long(seqValue(seq), buf[12]),
             };
 
-            if (!execSQL(metric_insert_sql, std::vector<const char*>(params, params + 11)))
+            if (!execSQL(metric_insert_sql, time, std::vector<const char*>(params, params + 13)))
             {
                 if(useTransaction) rollbackTransaction();
                 return;
@@ -98,7 +137,7 @@ namespace hwgauge
             ++inserted;
         }
         if (useTransaction && !commitTransaction())return;
-        spdlog::info("[SYSDatabase] Successfully inserted {}/{} records into {}", inserted, label_list.size(), metric_table_name);
+        HWGAUGE_LOG_COUNT("SYSDatabase records", inserted);
     }
     
     void SYSDatabase::writeInfo(const std::vector<SYSLabel>& label_list,
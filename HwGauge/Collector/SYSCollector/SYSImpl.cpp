@@ -1,12 +1,17 @@
 #ifdef __linux__
 
 #include "Collector/Common/Exception.hpp"
+#include "Collector/Common/Log.hpp"
 #include "SYSImpl.hpp"
 
 #include "spdlog/spdlog.h"
 #include <sstream>
 #include <iostream>
+#include <algorithm>
+#include <charconv>
+#include <cctype>
 #include <cstdio>
+#include <cstring>
 #include <memory>
 #include <array>
 #include <sys/time.h> 
@@ -16,19 +21,66 @@
 
 namespace hwgauge
 {
-    SYSImpl::SYSImpl(): cachedPowerWatts_(-1.0), stopThread_(false)
+    namespace
+    {
+        // 跳过空白后解析一个无符号整数，失败时返回 nullptr
+        const char* parseU64(const char* p, const char* end, unsigned long long& value)
+        {
+            while (p < end && (*p == ' ' || *p == '\t'))++p;
+            auto [ptr, ec] = std::from_chars(p, end, value);
+            return ec == std::errc() ? ptr : nullptr;
+        }
+
+        // 跳过空白后取出一个以空白结束的字段
+        const char* parseToken(const char* p, const char* end, std::string_view& token)
+        {
+            while (p < end && (*p == ' ' || *p == '\t'))++p;
+            const char* begin = p;
+            while (p < end && *p != ' ' && *p != '\t')++p;
+            token = std::string_view(begin, static_cast<std::size_t>(p - begin));
+            return p;
+        }
+
+        // 按名称查找上一轮的状态，新设备追加到末尾（只在设备出现时分配）
+        template<typename State>
+        State& findState(std::vector<State>& states, std::string_view name, bool& found)
+        {
+            for (auto& state : states)
+            {
+                if (state.name == name)
+                {
+                    found = true;
+                    return state;
+                }
+            }
+            found = false;
+            states.emplace_back();
+            states.back().name.assign(name.data(), name.size());
+            return states.back();
+        }
+
+        // 移除本轮已消失的设备，并清除标记
+        template<typename State>
+        void sweepStates(std::vector<State>& states)
+        {
+            states.erase(std::remove_if(states.begin(), states.end(), [](const State& state) { return !state.seen; }), states.end());
+            for (auto& state : states)state.seen = false;
+        }
+    }
+
+    SYSImpl::SYSImpl(): cachedPowerWatts_(-1.0), cachedEnergyJoules_(-1.0), stopThread_(false)
     {
         // 初始化时间
         lastTime = std::chrono::steady_clock::now();
 
         // --- 优化 : 预先打开文件 ---
         // /proc 文件一旦打开，其实是指向了内核的一个 handle。
-        // 即使内容变了，只要不关闭，用 seekg(0) 就能重读最新数据。
+        // 即使内容变了，只要不关闭，从偏移 0 重新 pread 就能读到最新数据。
         fileMem_.open("/proc/meminfo");
         fileDisk_.open("/proc/diskstats");
         fileNet_.open("/proc/net/dev");
 
-        if (!fileMem_ || !fileDisk_ || !fileNet_)throw hwgauge::FatalError("[SYSImpl] Failed to keep open /proc files.");
+        if (!fileMem_.isOpen() || !fileDisk_.isOpen() || !fileNet_.isOpen())throw hwgauge::FatalError("[SYSImpl] Failed to keep open /proc files.");
 
         // --- 核心：初始化探测命令 ---
         initPowerCmd();
@@ -37,7 +89,8 @@ namespace hwgauge
         // 我们手动构造一个 label 跑一次流程，填充 lastDiskStates 和 lastNetStates
         // 这里的日志可能会在启动时打印一次，是可以接受的
         std::vector<SYSLabel> dummy = labels();
-        sample(dummy); 
+        std::vector<SYSMetrics> baseline(dummy.size());
+        sample(dummy, baseline); 
 
         // 启动后台线程
         powerThread_ = std::thread(&SYSImpl::powerWorker, this);
@@ -45,10 +98,9 @@ namespace hwgauge
 
     SYSImpl::~SYSImpl()
     {
-        // 关闭文件流
-        if (fileMem_.is_open()) fileMem_.close();
-        if (fileDisk_.is_open()) fileDisk_.close();
-        if (fileNet_.is_open()) fileNet_.close();
+        // 先停止功耗线程，文件由 SysfsFile 自行关闭
+        stopThread_ = true;
+        if (powerThread_.joinable()) powerThread_.join();
     }
 
     std::vector<SYSLabel> SYSImpl::labels()
@@ -56,10 +108,8 @@ namespace hwgauge
         return { {"LocalHost"} };
     }
 
-    std::vector<SYSMetrics> SYSImpl::sample(std::vector<SYSLabel>& labels)
+    void SYSImpl::sample(std::vector<SYSLabel>& labels, std::vector<SYSMetrics>& metrics)
     {
-        std::vector<SYSMetrics> results;
-
         // 计算时间差
         auto now = std::chrono::steady_clock::now();
         std::chrono::duration<double> elapsed = now - lastTime;
@@ -68,16 +118,15 @@ namespace hwgauge
         lastTime = now;
 
         // 循环 Labels (保持语义正确)
-        for (const auto& label : labels)
+        for (std::size_t i = 0; i < labels.size(); ++i)
         {
-            SYSMetrics m; // 构造函数已默认初始化为 -1
+            SYSMetrics& m = metrics[i];
+            m = SYSMetrics(); // 构造函数已默认初始化为 -1
             readMemory(m);
             readDisk(m, dt);
             readNetwork(m, dt);
             readPower(m);
-            results.push_back(m);
         }
-        return results;
     }
 
     // --- 功耗命令探测函数 ---
@@ -155,23 +204,24 @@ namespace hwgauge
     }
 
     // --- 判断是否为物理磁盘---
-    bool SYSImpl::isPhysicalDisk(const std::string& name)
+    bool SYSImpl::isPhysicalDisk(std::string_view name)
     {
+        if (name.empty()) return false;
         // 1. 过滤 loop (回环), ram (内存盘), sr (光驱)
-        if (name.find("loop") == 0 || name.find("ram") == 0 || name.find("sr") == 0) return false;
+        if (name.rfind("loop", 0) == 0 || name.rfind("ram", 0) == 0 || name.rfind("sr", 0) == 0) return false;
         // 2. 过滤虚拟设备 (dm-*)，视情况而定，LVM 通常看 dm，这里为了简单只看物理硬件
-        if (name.find("dm-") == 0) return false;
+        if (name.rfind("dm-", 0) == 0) return false;
         // 3. 区分 SATA/SAS 盘 (sda, sdb...) vs 分区 (sda1, sdb2...)
-        if (name.find("sd") == 0 || name.find("vd") == 0)
+        if (name.rfind("sd", 0) == 0 || name.rfind("vd", 0) == 0)
         {
             // 如果最后一位是数字，通常是分区 (sda1)，如果不是数字，是盘 (sda)
             char last = name.back();
-            if (isdigit(last)) return false; 
+            if (std::isdigit(static_cast<unsigned char>(last))) return false; 
         }
         // 4. 区分 NVMe 盘 (nvme0n1) vs 分区 (nvme0n1p1)
-        if (name.find("nvme") == 0) {
+        if (name.rfind("nvme", 0) == 0) {
             // 如果包含 'p' 且 p 后面跟数字，通常是分区
-            if (name.find('p') != std::string::npos) return false; 
+            if (name.find('p') != std::string_view::npos) return false; 
         }
         return true;
     }
@@ -179,20 +229,28 @@ namespace hwgauge
     // --- 内存读取 (/proc/meminfo) ---
     void SYSImpl::readMemory(SYSMetrics& m)
     {
-        if (!fileMem_.is_open())throw FatalError("[SYSImpl] Cannot open /proc/meminfo");
-        // 重置文件流状态和指针
-        fileMem_.clear();
-        fileMem_.seekg(0);
-
-        std::string line, key;
-        long long value;
         long long total = -1, available = -1;
-
-        while (std::getline(fileMem_, line)) {
-            std::istringstream iss(line);
-            iss >> key >> value;
-            if (key == "MemTotal:") total = value;
-            else if (key == "MemAvailable:") available = value;
+        if (fileMem_.readText(buf_))
+        {
+            const char* p = buf_.data();
+            const char* end = p + buf_.size();
+            while (p < end && (total < 0 || available < 0))
+            {
+                const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+                if (!eol) eol = end;
+                const char* colon = static_cast<const char*>(std::memchr(p, ':', static_cast<std::size_t>(eol - p)));
+                if (colon)
+                {
+                    std::string_view key(p, static_cast<std::size_t>(colon - p));
+                    unsigned long long value = 0;
+                    if (parseU64(colon + 1, eol, value))
+                    {
+                        if (key == "MemTotal") total = static_cast<long long>(value);
+                        else if (key == "MemAvailable") available = static_cast<long long>(value);
+                    }
+                }
+                p = eol + 1;
+            }
         }
         
         // /proc/meminfo 单位是 kB
@@ -205,7 +263,7 @@ namespace hwgauge
         }
         else
         {
-            spdlog::warn("[SYSImpl] Memory collection failed");
+            HWGAUGE_WARN_LIMITED("[SYSImpl] Memory collection failed");
             m.memTotalGB = -1.0;
             m.memUsedGB = -1.0;
             m.memUtilizationPercent = -1.0;
@@ -215,61 +273,62 @@ namespace hwgauge
     // --- 磁盘读取 (/proc/diskstats) ---
     void SYSImpl::readDisk(SYSMetrics& m, double dt)
     {
-         if (!fileDisk_.is_open())throw FatalError("[SYSImpl] Cannot open /proc/diskstats");
-        fileDisk_.clear();
-        fileDisk_.seekg(0);
+        if (!fileDisk_.readText(buf_)) return;
 
-        std::string line;
         double totalReadBytes = 0;
         double totalWriteBytes = 0;
         double maxUtil = 0;
 
-        // 当前时刻的临时 map
-        std::map<std::string, DiskState> currentStates;
-
-        while (std::getline(fileDisk_, line))
+        const char* p = buf_.data();
+        const char* end = p + buf_.size();
+        while (p < end)
         {
-            std::istringstream iss(line);
-            int major, minor;
-            std::string devName;
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+            if (!eol) eol = end;
+            const char* line = p;
+            p = eol + 1;
+
             // diskstats 格式复杂，通常第3列是设备名，后面跟着一堆统计
-            iss >> major >> minor >> devName;
+            unsigned long long major, minor;
+            std::string_view devName;
+            line = parseU64(line, eol, major);
+            if (line) line = parseU64(line, eol, minor);
+            if (!line) continue;
+            line = parseToken(line, eol, devName);
 
             // 过滤非物理设备
             if (!isPhysicalDisk(devName)) continue;
-            
-            unsigned long long r_ios, r_merges, r_sectors, r_ticks;
-            unsigned long long w_ios, w_merges, w_sectors, w_ticks;
-            unsigned long long io_in_progress, time_io, time_io_weighted;
 
-            // 读取后续字段 (Kernel 4.18+)
-            iss >> r_ios >> r_merges >> r_sectors >> r_ticks 
-                >> w_ios >> w_merges >> w_sectors >> w_ticks 
-                >> io_in_progress >> time_io >> time_io_weighted;
+            // r_ios r_merges r_sectors r_ticks w_ios w_merges w_sectors w_ticks io_in_progress time_io
+            unsigned long long v[10] = {};
+            for (int k = 0; k < 10 && line; ++k) line = parseU64(line, eol, v[k]);
+            if (!line) continue;
 
-            DiskState ds = { r_sectors, w_sectors, time_io };
-            currentStates[devName] = ds;
+            bool found = false;
+            DiskState& state = findState(lastDiskStates, devName, found);
+            state.seen = true;
 
             // 如果上一次有记录，计算差值
-            if (lastDiskStates.count(devName)) {
-                auto& old = lastDiskStates[devName];
-                
+            if (found) {
                 // 吞吐量 (扇区 * 512字节)
-                double r_diff = (double)(ds.sectorsRead - old.sectorsRead) * 512.0;
-                double w_diff = (double)(ds.sectorsWritten - old.sectorsWritten) * 512.0;
+                double r_diff = (double)(v[2] - state.sectorsRead) * 512.0;
+                double w_diff = (double)(v[6] - state.sectorsWritten) * 512.0;
                 
                 totalReadBytes += r_diff;
                 totalWriteBytes += w_diff;
 
                 // 利用率 (time_io 是毫秒)
-                double util_diff = (double)(ds.timeDoingIO - old.timeDoingIO);
+                double util_diff = (double)(v[9] - state.timeDoingIO);
                 // 比如经过 1秒(1000ms)，IO耗时 500ms，则利用率为 50%
                 double util = (util_diff / (dt * 1000.0)) * 100.0;
                 if (util > maxUtil) maxUtil = util;
             }
+            state.sectorsRead = v[2];
+            state.sectorsWritten = v[6];
+            state.timeDoingIO = v[9];
         }
 
-        lastDiskStates = currentStates; // 更新状态
+        sweepStates(lastDiskStates); // 更新状态
 
         m.diskReadMBps = totalReadBytes / 1024.0 / 1024.0 / dt;
         m.diskWriteMBps = totalWriteBytes / 1024.0 / 1024.0 / dt;
@@ -279,51 +338,49 @@ namespace hwgauge
     // --- 网络读取 (/proc/net/dev) ---
     void SYSImpl::readNetwork(SYSMetrics& m, double dt)
     {
-        if (!fileNet_.is_open())throw FatalError("[SYSImpl] Cannot open /proc/net/dev");
-        fileNet_.clear();
-        fileNet_.seekg(0);
+        if (!fileNet_.readText(buf_)) return;
 
-        std::string line;
         double totalRx = 0;
         double totalTx = 0;
-        std::map<std::string, NetState> currentStates;
 
-        // 跳过前两行表头
-        std::getline(fileNet_, line);
-        std::getline(fileNet_, line);
+        // 前两行表头没有 ':'，下面会自然跳过
+        const char* p = buf_.data();
+        const char* end = p + buf_.size();
+        while (p < end) {
+            const char* eol = static_cast<const char*>(std::memchr(p, '\n', static_cast<std::size_t>(end - p)));
+            if (!eol) eol = end;
+            const char* line = p;
+            p = eol + 1;
 
-        while (std::getline(fileNet_, line)) {
             // 处理格式: "  eth0: 1234 56 ..."
-            size_t colonPos = line.find(':');
-            if (colonPos == std::string::npos) continue;
+            const char* colon = static_cast<const char*>(std::memchr(line, ':', static_cast<std::size_t>(eol - line)));
+            if (!colon) continue;
 
-            std::string devName = line.substr(0, colonPos);
             // 去除空格
-            devName.erase(0, devName.find_first_not_of(" "));
+            while (line < colon && *line == ' ') ++line;
+            std::string_view devName(line, static_cast<std::size_t>(colon - line));
 
             // 过滤回环 lo
             if (devName == "lo") continue;
 
-            std::string statsPart = line.substr(colonPos + 1);
-            std::istringstream iss(statsPart);
-            
-            unsigned long long rxBytes, rxPackets, rxErrs, rxDrop, rxFifo, rxFrame, rxCom, rxMulti;
-            unsigned long long txBytes, txPackets, txErrs, txDrop, txFifo, txColl, txCarrier, txCom;
-
-            iss >> rxBytes >> rxPackets >> rxErrs >> rxDrop >> rxFifo >> rxFrame >> rxCom >> rxMulti
-                >> txBytes >> txPackets >> txErrs >> txDrop >> txFifo >> txColl >> txCarrier >> txCom;
-
-            NetState ns = { rxBytes, txBytes };
-            currentStates[devName] = ns;
-
-            if (lastNetStates.count(devName)) {
-                auto& old = lastNetStates[devName];
-                totalRx += (double)(ns.bytesRx - old.bytesRx);
-                totalTx += (double)(ns.bytesTx - old.bytesTx);
+            // rx: bytes packets errs drop fifo frame compressed multicast, tx: bytes ...
+            unsigned long long v[9] = {};
+            const char* q = colon + 1;
+            for (int k = 0; k < 9 && q; ++k) q = parseU64(q, eol, v[k]);
+            if (!q) continue;
+
+            bool found = false;
+            NetState& state = findState(lastNetStates, devName, found);
+            state.seen = true;
+            if (found) {
+                totalRx += (double)(v[0] - state.bytesRx);
+                totalTx += (double)(v[8] - state.bytesTx);
             }
+            state.bytesRx = v[0];
+            state.bytesTx = v[8];
         }
 
-        lastNetStates = currentStates;
+        sweepStates(lastNetStates);
 
         m.netDownloadMBps = totalRx / 1024.0 / 1024.0 / dt;
         m.netUploadMBps = totalTx / 1024.0 / 1024.0 / dt;
@@ -335,6 +392,7 @@ namespace hwgauge
         // 主线程只做一件事：读原子变量
         // 无论系统负载多高，这里永不卡顿
         m.systemPowerWatts = cachedPowerWatts_.load();
+        m.systemEnergyJoules = cachedEnergyJoules_.load();
     }
 
     // --- 后台线程函数 (即使卡顿也没关系) ---
@@ -352,6 +410,8 @@ namespace hwgauge
             // 2. 如果采集成功，更新缓存
             if (watts > 0) {
                 cachedPowerWatts_.store(watts);
+                // 能耗在这里积分：与主循环的采样周期、是否丢样无关
+                cachedEnergyJoules_.store(energyIntegrator_.update(watts));
             }
             // 3. 休眠等待下一次采集
             // 使用小步休眠，以便能及时响应 stopThread_
@@ -366,13 +426,14 @@ namespace hwgauge
     // --- 功耗读取函数 ---
     double SYSImpl::fetchPowerFromHardware()
     {
-        //if (powerCmd_.empty())throw FatalError("[SYSImpl] No supported power monitoring method found.");
+        // 没有可用的功率命令时已在探测阶段告警，不再每轮启动子进程
+        if (powerCmd_.empty())return -1.0;
         try
         {
             std::unique_ptr<FILE, decltype(&pclose)> pipe(popen(powerCmd_.c_str(), "r"), pclose);
             if (!pipe)
             {
-                spdlog::warn("[SYSImpl] Failed to get machine power");
+                HWGAUGE_WARN_LIMITED("[SYSImpl] Failed to get machine power");
                 return -1.0;
             }
             std::array<char, 256> buffer;
@@ -429,7 +490,7 @@ namespace hwgauge
         } catch (...) {
             // 忽略读取过程中的异常
         }
-        spdlog::warn("[SYSImpl] Failed to get machine power");
+        HWGAUGE_WARN_LIMITED("[SYSImpl] Failed to parse machine power from \"{}\"", powerCmd_);
         return -1.0;
     }
 }
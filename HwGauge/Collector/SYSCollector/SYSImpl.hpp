@@ -3,10 +3,12 @@
 #ifdef __linux__
 
 #include "SYSMetrics.hpp"
+#include "Collector/Common/Energy.hpp"
+#include "Collector/Common/SysfsFile.hpp"
 #include <vector>
 #include <chrono>
-#include <map>
-#include <fstream>
+#include <string>
+#include <string_view>
 #include <atomic>
 #include <thread>
 #include <mutex>
@@ -16,15 +18,19 @@ namespace hwgauge
     // 辅助结构：用于保存上一次的计数器状态
     struct DiskState
     {
+        std::string name;
         unsigned long long sectorsRead;
         unsigned long long sectorsWritten;
         unsigned long long timeDoingIO; // milliseconds
+        bool seen;                      // 本轮是否仍然存在
     };
 
     struct NetState
     {
+        std::string name;
         unsigned long long bytesRx;
         unsigned long long bytesTx;
+        bool seen;
     };
 
     enum class PowerParseType
@@ -51,20 +57,21 @@ namespace hwgauge
         std::vector<SYSLabel> labels();
         
         // 采样并计算速率
-        std::vector<SYSMetrics> sample(std::vector<SYSLabel>& labels);
+        void sample(std::vector<SYSLabel>& labels, std::vector<SYSMetrics>& metrics);
 
     private:
         // 上一个时钟周期
         std::chrono::steady_clock::time_point lastTime;
 
-        // 常驻文件流 (优化文件 I/O) 
-        std::ifstream fileMem_;
-        std::ifstream fileDisk_;
-        std::ifstream fileNet_;
+        // 常驻文件，每轮用 pread 重读到复用的缓冲区，不经过 iostream
+        SysfsFile fileMem_;
+        SysfsFile fileDisk_;
+        SysfsFile fileNet_;
+        std::string buf_;
         
-        // 缓存上一次的磁盘和网络计数器，用于做减法计算速率
-        std::map<std::string, DiskState> lastDiskStates;
-        std::map<std::string, NetState> lastNetStates;
+        // 缓存上一次的磁盘和网络计数器，用于做减法计算速率；设备集合不变时原地更新，不再分配
+        std::vector<DiskState> lastDiskStates;
+        std::vector<NetState> lastNetStates;
 
         // --- 整机功耗获取指令类型 ---
         PowerParseType powerParseType_;
@@ -75,6 +82,8 @@ namespace hwgauge
 
         // --- 异步功耗相关 ---
         std::atomic<double> cachedPowerWatts_; // 最新的功耗值 (主线程读这个)
+        std::atomic<double> cachedEnergyJoules_; // 累计整机能耗 (J)
+        EnergyIntegrator energyIntegrator_;    // 只在功耗线程中使用，按 IPMI 读数的实际时间积分
         std::atomic<bool> stopThread_;         // 线程停止标志
         std::thread powerThread_;              // 专用的功耗采集线程
         // 获取功耗线程函数
@@ -83,7 +92,7 @@ namespace hwgauge
         double fetchPowerFromHardware();
 
         // 辅助函数：判断是否为物理磁盘（避免统计 sda1 这种分区导致吞吐量双倍）---
-        bool isPhysicalDisk(const std::string& name);
+        bool isPhysicalDisk(std::string_view name);
 
         // 内部读取函数
         void readMemory(SYSMetrics& m);
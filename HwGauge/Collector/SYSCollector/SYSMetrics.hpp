@@ -2,6 +2,7 @@
 
 #ifdef __linux__
 
+#include "Collector/Common/Fields.hpp"
 #include <string>
 
 #ifdef HWGAUGE_USE_LOCAL_HTTP
@@ -35,14 +36,50 @@ namespace hwgauge
         double systemPowerWatts;  // 整机功耗 (W)
         double totalPowerWatts; // CPU、内存、GPU等所有组件的功耗之和
 
+        // 能耗 (自 agent 启动以来的累计值，J)
+        double systemEnergyJoules; // 整机能耗，对 IPMI 功率读数积分
+        double totalEnergyJoules;  // 各组件累计能耗之和
+
         SYSMetrics() 
             : memTotalGB(-1.0), memUsedGB(-1.0), memUtilizationPercent(-1.0),
               diskReadMBps(-1.0), diskWriteMBps(-1.0), maxDiskUtilPercent(-1.0),
               netDownloadMBps(-1.0), netUploadMBps(-1.0),
-              systemPowerWatts(-1.0), totalPowerWatts(-1.0)
+              systemPowerWatts(-1.0), totalPowerWatts(-1.0),
+              systemEnergyJoules(-1.0), totalEnergyJoules(-1.0)
         {}
     };
 
+    template<>
+    struct Fields<SYSLabel>
+    {
+        template<typename T, typename F>
+        static void visit(T& l, F&& f)
+        {
+            f("name", l.name);
+        }
+    };
+
+    template<>
+    struct Fields<SYSMetrics>
+    {
+        template<typename T, typename F>
+        static void visit(T& m, F&& f)
+        {
+            f("memTotalGB", m.memTotalGB);
+            f("memUsedGB", m.memUsedGB);
+            f("memUtilizationPercent", m.memUtilizationPercent);
+            f("diskReadMBps", m.diskReadMBps);
+            f("diskWriteMBps", m.diskWriteMBps);
+            f("maxDiskUtilPercent", m.maxDiskUtilPercent);
+            f("netDownloadMBps", m.netDownloadMBps);
+            f("netUploadMBps", m.netUploadMBps);
+            f("systemPowerWatts", m.systemPowerWatts);
+            f("totalPowerWatts", m.totalPowerWatts);
+            f("systemEnergyJoules", m.systemEnergyJoules, FieldKind::Counter);
+            f("totalEnergyJoules", m.totalEnergyJoules, FieldKind::Counter);
+        }
+    };
+
 #ifdef HWGAUGE_USE_LOCAL_HTTP
     inline void to_json(nlohmann::json& j, const SYSLabel& l) {
         j = nlohmann::json{{"name", l.name}};
@@ -59,7 +96,9 @@ namespace hwgauge
             {"netDownloadMBps", m.netDownloadMBps},
             {"netUploadMBps", m.netUploadMBps},
             {"systemPowerWatts", m.systemPowerWatts},
-            {"totalPowerWatts", m.totalPowerWatts}
+            {"totalPowerWatts", m.totalPowerWatts},
+            {"systemEnergyJoules", m.systemEnergyJoules},
+            {"totalEnergyJoules", m.totalEnergyJoules}
         };
     }
 #endif
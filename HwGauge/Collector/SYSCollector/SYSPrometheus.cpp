@@ -63,40 +63,58 @@ namespace hwgauge
             .Name("system_total_power_watts")   
             .Help("Total power consumption of all components (CPU, memory, GPU, etc.) in watts")
             .Register(registry_ref);
+
+        // 能耗指标（累计值）
+        systemEnergyFamily = &prometheus::BuildCounter()
+            .Name("system_energy_joules_total")
+            .Help("System energy consumed since agent start in joules")
+            .Register(registry_ref);
+
+        totalEnergyFamily = &prometheus::BuildCounter()
+            .Name("system_total_energy_joules_total")
+            .Help("Energy consumed by all components (CPU, memory, GPU, etc.) since agent start in joules")
+            .Register(registry_ref);
     }
 
     void SYSPrometheus::write(const std::vector<SYSLabel>& label_list, const std::vector<SYSMetrics>& metric_list)
     {
+        // 构建标签：系统监控通常只有一个全局标签，但保持扩展性
+        if (gauges.resize(label_list.size()))
+        {
+            counters.resize(label_list.size());
+            for (size_t i = 0; i < label_list.size(); i++)
+            {
+                gauges.labels(i) = { {"name", label_list[i].name} };
+                counters.labels(i) = gauges.labels(i);
+            }
+        }
+
         // 更新每个标签对应的指标
         for (size_t i = 0; i < label_list.size(); i++)
         {
-            const auto& label = label_list[i];
             const auto& metric = metric_list[i];
             
-            // 构建标签
-            std::map<std::string, std::string> labels = 
-            {
-                {"name", label.name}
-                // 系统监控通常只有一个全局标签，但保持扩展性
-            };
-            
             // 更新内存指标
-            memTotalFamily->Add(labels).Set(metric.memTotalGB);
-            memUsedFamily->Add(labels).Set(metric.memUsedGB);
-            memUtilizationFamily->Add(labels).Set(metric.memUtilizationPercent);
+            gauges.get(i, memTotalFamily).Set(metric.memTotalGB);
+            gauges.get(i, memUsedFamily).Set(metric.memUsedGB);
+            gauges.get(i, memUtilizationFamily).Set(metric.memUtilizationPercent);
             
             // 更新磁盘指标
-            diskReadFamily->Add(labels).Set(metric.diskReadMBps);
-            diskWriteFamily->Add(labels).Set(metric.diskWriteMBps);
-            diskUtilizationFamily->Add(labels).Set(metric.maxDiskUtilPercent);
+            gauges.get(i, diskReadFamily).Set(metric.diskReadMBps);
+            gauges.get(i, diskWriteFamily).Set(metric.diskWriteMBps);
+            gauges.get(i, diskUtilizationFamily).Set(metric.maxDiskUtilPercent);
             
             // 更新网络指标
-            netDownloadFamily->Add(labels).Set(metric.netDownloadMBps);
-            netUploadFamily->Add(labels).Set(metric.netUploadMBps);
+            gauges.get(i, netDownloadFamily).Set(metric.netDownloadMBps);
+            gauges.get(i, netUploadFamily).Set(metric.netUploadMBps);
             
             // 更新功耗指标
-            systemPowerFamily->Add(labels).Set(metric.systemPowerWatts);
-            totalPowerFamily->Add(labels).Set(metric.totalPowerWatts);
+            gauges.get(i, systemPowerFamily).Set(metric.systemPowerWatts);
+            gauges.get(i, totalPowerFamily).Set(metric.totalPowerWatts);
+
+            // 更新能耗指标
+            setCounter(counters.get(i, systemEnergyFamily), metric.systemEnergyJoules);
+            setCounter(counters.get(i, totalEnergyFamily), metric.totalEnergyJoules);
         }
     }
 }
@@ -34,6 +34,13 @@ namespace hwgauge
         // 功耗指标
         prometheus::Family<prometheus::Gauge>* systemPowerFamily;
         prometheus::Family<prometheus::Gauge>* totalPowerFamily;
+
+        // 能耗
+        prometheus::Family<prometheus::Counter>* systemEnergyFamily;
+        prometheus::Family<prometheus::Counter>* totalEnergyFamily;
+
+        SeriesCache<prometheus::Gauge> gauges;
+        SeriesCache<prometheus::Counter> counters;
     };
 }
 
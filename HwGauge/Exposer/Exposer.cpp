@@ -1,86 +1,409 @@
 #include "Exposer.hpp"
 #include "spdlog/spdlog.h"
-#include "Collector/Common/Context.hpp"
+#include "Collector/Common/Log.hpp"
+#include "StopSignal.hpp"
 
+#include <algorithm>  // std::min, std::max
 #include <chrono>     // std::chrono::system_clock
-#include <ctime>      // std::time_t, std::localtime, std::tm
-#include <sstream>    // std::ostringstream
-#include <iomanip>    // std::put_time
 #include <string>     // std::string
+#include <thread>     // std::this_thread::sleep_until
+
+#ifdef __linux__
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#endif
 
 namespace hwgauge
 {
-	/* 获取当前时间戳 */
-	inline std::string getNowTime()
+	Exposer::Exposer(std::chrono::duration<double> interval, OverrunPolicy policy) :
+		interval(interval), policy(policy), period(interval)
 	{
-		using namespace std::chrono;
+		tick.context = &context;
+#ifdef __linux__
+		wakeFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+#endif
+	}
 
-		auto now = system_clock::now();
+	Exposer::~Exposer()
+	{
+#ifdef __linux__
+		if (wakeFd >= 0)close(wakeFd);
+#endif
+	}
 
-		// 秒级部分（给 put_time 用）
-		std::time_t now_time = system_clock::to_time_t(now);
-		std::tm now_tm = *std::localtime(&now_time);
+#ifdef HWGAUGE_USE_PROMETHEUS
+	void Exposer::exportStats(const std::shared_ptr<prometheus::Registry>& registry)
+	{
+		missedCounter = &prometheus::BuildCounter()
+			.Name("hwgauge_missed_ticks_total")
+			.Help("Collection ticks skipped because a round took longer than the interval")
+			.Register(*registry)
+			.Add({});
+		periodGauge = &prometheus::BuildGauge()
+			.Name("hwgauge_tick_interval_seconds")
+			.Help("Current collection interval; differs from --interval only with --overrun stretch")
+			.Register(*registry)
+			.Add({});
+		periodGauge->Set(period.count());
+		skewFamily = &prometheus::BuildGauge()
+			.Name("hwgauge_capture_skew_seconds")
+			.Help("Delay between the shared tick instant and the moment a collector started reading hardware")
+			.Register(*registry);
+		durationFamily = &prometheus::BuildGauge()
+			.Name("hwgauge_capture_duration_seconds")
+			.Help("Time a collector spent reading hardware in the last tick")
+			.Register(*registry);
+	}
+#endif
 
-		// 毫秒部分
-		auto ms = duration_cast<milliseconds>(now.time_since_epoch()) % 1000;
+	void Exposer::run()
+	{
+		running.store(true, std::memory_order_release);
+#ifdef __linux__
+		if (runEventLoop())return;
+#endif
+		runSleepLoop();
+	}
 
-		std::ostringstream ss;
-		ss << std::put_time(&now_tm, "%Y-%m-%d %H:%M:%S")
-		<< '.' << std::setw(3) << std::setfill('0') << ms.count();
+	void Exposer::stop() {
+		running.store(false, std::memory_order_release);
+#ifdef __linux__
+		std::uint64_t one = 1;
+		if (wakeFd >= 0)(void)write(wakeFd, &one, sizeof(one));
+#endif
+	}
 
-		return ss.str();
+	void Exposer::addMissed(std::uint64_t n)
+	{
+		missed.fetch_add(n, std::memory_order_relaxed);
+#ifdef HWGAUGE_USE_PROMETHEUS
+		if (missedCounter)missedCounter->Increment(static_cast<double>(n));
+#endif
+		HWGAUGE_WARN_LIMITED("[Exposer] Collection took longer than the {} s interval, {} tick(s) skipped", interval.count(), n);
+		HWGAUGE_LOG_COUNT("Exposer missed ticks", n);
 	}
-	
-	void Exposer::run()
+
+	void Exposer::onTick(std::uint64_t due)
+	{
+		std::uint64_t runs = policy == OverrunPolicy::CatchUp ? std::min(due, kMaxCatchUp) : 1;
+		// 跳过的是较早的槽位，但仍占用序号
+		if (due > runs)
+		{
+			addMissed(due - runs);
+			tick.seq += due - runs;
+		}
+		for (std::uint64_t i = 0; i < runs && running.load(std::memory_order_acquire); i++)
+		{
+			tick.seq++;
+			collect();
+		}
+	}
+
+	bool Exposer::adapt(std::chrono::duration<double> took)
+	{
+		// 超过当前间隔时立即放大到耗时的 1.25 倍，之后每轮回落差值的 1/4，接近设定值时直接恢复
+		auto target = std::max(interval, took * 1.25);
+		auto next = target > period ? target : period + (target - period) * 0.25;
+		if (next - interval < interval * 0.01)next = interval;
+		if (next == period)return false;
+
+		if (period == interval)
+			HWGAUGE_WARN_LIMITED("[Exposer] Collection took {:.3f} s, stretching the interval to {:.3f} s", took.count(), next.count());
+		else if (next == interval)
+			spdlog::info("[Exposer] Collection interval back to {} s", interval.count());
+		period = next;
+#ifdef HWGAUGE_USE_PROMETHEUS
+		if (periodGauge)periodGauge->Set(period.count());
+#endif
+		return true;
+	}
+
+#ifdef __linux__
+	/* timerfd 按 CLOCK_MONOTONIC 绝对时间周期触发，与停止信号、stop() 的 eventfd 一起在同一个 epoll_wait 中等待 */
+	bool Exposer::runEventLoop()
+	{
+		int timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+		int epollFd = epoll_create1(EPOLL_CLOEXEC);
+		if (timerFd < 0 || epollFd < 0 || wakeFd < 0)
+		{
+			spdlog::warn("[Exposer] timerfd/epoll unavailable ({}), falling back to sleep_until", std::strerror(errno));
+			if (timerFd >= 0)close(timerFd);
+			if (epollFd >= 0)close(epollFd);
+			return false;
+		}
+
+		auto toTimespec = [](std::chrono::duration<double> d) {
+			auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+			timespec ts;
+			ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+			ts.tv_nsec = static_cast<long>(ns % 1000000000);
+			return ts;
+		};
+
+		// 首次到期设为当前时刻，立即采集第一轮，之后每隔 interval 到期，槽位与启动时刻对齐
+		itimerspec spec{};
+		spec.it_interval = toTimespec(period);
+		clock_gettime(CLOCK_MONOTONIC, &spec.it_value);
+		timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+
+		int signalFd = stopSignalFd();
+		for (int fd : { timerFd, wakeFd, signalFd })
+		{
+			if (fd < 0)continue;
+			epoll_event ev{};
+			ev.events = EPOLLIN;
+			ev.data.fd = fd;
+			epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &ev);
+		}
+
+		epoll_event events[3];
+		while (running.load(std::memory_order_acquire))
+		{
+			int n = epoll_wait(epollFd, events, 3, -1);
+			if (n < 0)
+			{
+				if (errno == EINTR)continue;
+				spdlog::critical("[Exposer] epoll_wait failed: {}", std::strerror(errno));
+				break;
+			}
+
+			std::uint64_t due = 0;
+			for (int i = 0; i < n; i++)
+			{
+				int fd = events[i].data.fd;
+				std::uint64_t value = 0;
+				if (fd == timerFd)
+				{
+					// 到期次数大于 1 说明上一轮采集超过了间隔
+					if (read(timerFd, &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value)))due = value;
+				}
+				else if (fd == wakeFd)
+				{
+					(void)read(wakeFd, &value, sizeof(value));
+				}
+				else if (fd == signalFd)
+				{
+					int signal = readStopSignal();
+					if (signal != 0)
+					{
+						spdlog::info("Received {}, stopping exposer", signal == SIGTERM ? "SIGTERM" : "SIGINT");
+						running.store(false, std::memory_order_release);
+					}
+				}
+			}
+			if (due == 0 || !running.load(std::memory_order_acquire))continue;
+
+			timespec start;
+			clock_gettime(CLOCK_MONOTONIC, &start);
+			auto begin = std::chrono::steady_clock::now();
+			onTick(due);
+			if (policy == OverrunPolicy::Stretch && adapt(std::chrono::steady_clock::now() - begin))
+			{
+				// 新的间隔从本轮开始时刻计算
+				spec.it_interval = toTimespec(period);
+				spec.it_value.tv_sec = start.tv_sec + spec.it_interval.tv_sec;
+				spec.it_value.tv_nsec = start.tv_nsec + spec.it_interval.tv_nsec;
+				if (spec.it_value.tv_nsec >= 1000000000) { spec.it_value.tv_sec++; spec.it_value.tv_nsec -= 1000000000; }
+				timerfd_settime(timerFd, TFD_TIMER_ABSTIME, &spec, nullptr);
+			}
+		}
+
+		close(timerFd);
+		close(epollFd);
+		return true;
+	}
+#endif
+
+	void Exposer::runSleepLoop()
 	{
-		running.store(true, std::memory_order_release);
 		using clock = std::chrono::steady_clock;
 
 		auto next_tick = clock::now();
 
-		while (running.load(std::memory_order_acquire)) {
-			collect();
+		while (running.load(std::memory_order_acquire) && !stopRequested()) {
+			auto step = std::chrono::duration_cast<clock::duration>(period);
+			auto start = clock::now();
 
-			next_tick += std::chrono::duration_cast<clock::duration>(interval);
-			auto now = clock::now();
+			// 与 timerfd 一致：计算已到期的槽位数，下一次在之后的第一个槽位
+			std::uint64_t due = 1;
+			if (start > next_tick)due += static_cast<std::uint64_t>((start - next_tick) / step);
+			next_tick += step * static_cast<clock::rep>(due);
+			onTick(due);
 
-			if (now < next_tick)
+			if (policy == OverrunPolicy::Stretch && adapt(clock::now() - start))
+			{
+				next_tick = start + std::chrono::duration_cast<clock::duration>(period);
+			}
+
+			if (clock::now() < next_tick)
 			{
 				std::this_thread::sleep_until(next_tick);
 			}
 		}
 	}
 
-	void Exposer::stop() {
-		running.store(false, std::memory_order_release);
+	void Exposer::collect()
+	{
+		if (names.size() != collectors.size())
+		{
+			names.clear();
+			for (auto& collector : collectors)names.push_back(collector->name());
+			captures.assign(collectors.size(), CaptureState{});
+#ifdef HWGAUGE_USE_PROMETHEUS
+			for (std::size_t i = 0; i < captures.size(); i++)
+			{
+				if (skewFamily)captures[i].skewGauge = &skewFamily->Add({ { "collector", names[i] } });
+				if (durationFamily)captures[i].durationGauge = &durationFamily->Add({ { "collector", names[i] } });
+			}
+#endif
+			if (collectors.size() > 1)pool = std::make_unique<ThreadPool>(collectors.size());
+			orderPublish();
+		}
+
+		spdlog::debug("Tick #{}", tick.seq);
+		context.begin(tick.seq);
+		capture();
+		bool keepRunning = publish();
+		flushLogStats();     // 输出到期的重复日志汇总与计数
+		if (!keepRunning)stop();
 	}
 
-	void Exposer::collect()
+	void Exposer::capture()
+	{
+		const std::size_t n = collectors.size();
+		if (!pool)
+		{
+			// 只有一个采集器时不需要屏障
+			tick.time = std::chrono::system_clock::now();
+			if (n == 1)captureOne(0);
+			return;
+		}
+
+		arrived.store(0, std::memory_order_relaxed);
+		released.store(false, std::memory_order_relaxed);
+		auto task = [this, n](std::size_t i) {
+			// 线程数等于任务数，每个任务占住一个线程等待其余任务就位，不会死锁
+			if (arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == n)
+			{
+				// 只记录时刻，需要文本的下游自行格式化
+				tick.time = std::chrono::system_clock::now();
+				released.store(true, std::memory_order_release);
+			}
+			else
+			{
+				while (!released.load(std::memory_order_acquire))std::this_thread::yield();
+			}
+			captureOne(i);
+		};
+		pool->parallelFor(n, task);
+
+		auto first = captures[0].skew, last = captures[0].skew;
+		for (auto& c : captures)
+		{
+			first = std::min(first, c.skew);
+			last = std::max(last, c.skew);
+		}
+		spdlog::debug("Tick #{} capture started within {:.3f} ms across {} collectors", tick.seq, (last - first).count() * 1e3, n);
+	}
+
+	void Exposer::captureOne(std::size_t i)
+	{
+		auto& state = captures[i];
+		auto begin = std::chrono::system_clock::now();
+		state.skew = begin - tick.time;
+		try
+		{
+			collectors[i]->capture(tick);
+			state.status = CaptureState::Ok;
+		}
+		catch (const hwgauge::RecoverableError& e)
+		{
+			// 记录错误，本轮跳过该 collector 的 publish
+			HWGAUGE_ERROR_LIMITED_BY(names[i], "Recoverable error from {}: {}", names[i], e.what());
+			state.status = CaptureState::Failed;
+		}
+		catch (const hwgauge::FatalError& e)
+		{
+			spdlog::critical("Fatal error from {}: {}", names[i], e.what());
+			state.status = CaptureState::Fatal;
+		}
+		state.duration = std::chrono::system_clock::now() - begin;
+#ifdef HWGAUGE_USE_PROMETHEUS
+		if (state.skewGauge)state.skewGauge->Set(state.skew.count());
+		if (state.durationGauge)state.durationGauge->Set(state.duration.count());
+#endif
+		// 起点偏差超过间隔的 1/10 时，各采集器的数据已经不能视为同一时刻
+		if (state.skew > interval * 0.1)
+			HWGAUGE_WARN_LIMITED_BY(names[i], "[Exposer] {} started capturing {:.1f} ms after the tick", names[i], state.skew.count() * 1e3);
+	}
+
+	void Exposer::orderPublish()
+	{
+		const std::size_t n = collectors.size();
+		std::vector<bool> placed(n, false);
+		publishOrder.clear();
+		while (publishOrder.size() < n)
+		{
+			// 取第一个依赖都已排好的采集器；存在循环依赖时按加入顺序取下一个
+			std::size_t pick = n;
+			for (std::size_t i = 0; i < n && pick == n; i++)
+			{
+				if (placed[i])continue;
+				bool ready = true;
+				for (std::size_t j = 0; j < n && ready; j++)
+				{
+					if (j != i && !placed[j] && (collectors[j]->contextProvides() & collectors[i]->contextConsumes()))ready = false;
+				}
+				if (ready)pick = i;
+			}
+			if (pick == n)
+			{
+				for (pick = 0; placed[pick]; pick++) {}
+				spdlog::warn("[Exposer] Circular context dependency at {}, publishing in registration order", names[pick]);
+			}
+			placed[pick] = true;
+			publishOrder.push_back(pick);
+		}
+
+		for (std::size_t k = 0; k < n; k++)
+		{
+			if (publishOrder[k] == k)continue;
+			std::string order;
+			for (std::size_t i : publishOrder)order += (order.empty() ? "" : ", ") + names[i];
+			spdlog::info("[Exposer] Publish order follows context dependencies: {}", order);
+			break;
+		}
+	}
+
+	bool Exposer::publish()
 	{
-		auto cur_time=getNowTime();
-		spdlog::debug("CurrentTime {}",cur_time);
-		for (auto& collector : collectors)
+		for (std::size_t i : publishOrder)
 		{
-			std::string name = collector->name();
+			// 记录错误，停止整个采集循环
+			if (captures[i].status == CaptureState::Fatal)return false;
+			if (captures[i].status == CaptureState::Failed)continue;
 			try
 			{
-				collector->collect(cur_time);
-				spdlog::debug("Retrieve metrics from {} successfully", name);
+				collectors[i]->publish(tick);
+				spdlog::debug("Retrieve metrics from {} successfully", names[i]);
 			}
 			catch (const hwgauge::RecoverableError& e)
 			{
 				// 记录错误，继续下一个 collector / 下一轮
-				spdlog::error("Recoverable error from {}: {}",name, e.what());
-				continue;
+				HWGAUGE_ERROR_LIMITED_BY(names[i], "Recoverable error from {}: {}", names[i], e.what());
 			}
 			catch (const hwgauge::FatalError& e)
 			{
 				// 记录错误，停止整个采集循环
-				spdlog::critical("Fatal error from {}: {}",name, e.what());
-				stop();
-				return;
+				spdlog::critical("Fatal error from {}: {}", names[i], e.what());
+				return false;
 			}
 		}
-		sharedPower.reSet(); // 每轮结束重置共享上下文，准备下一轮采集
+		return true;
 	}
 }
\ No newline at end of file
@@ -1,33 +1,59 @@
 #pragma once
 
 #include "Collector/Base/Collector.hpp"
+#include "Collector/Common/Context.hpp"
 #include "Collector/Common/Exception.hpp"
+#include "Collector/Common/ThreadPool.hpp"
 
 #include <vector>
 #include <memory>
 #include <utility>
 #include <atomic>
 #include <chrono>
+#include <string>
+#include <cstdint>
 #include <spdlog/spdlog.h>
 
+#ifdef HWGAUGE_USE_PROMETHEUS
+#include <prometheus/counter.h>
+#include <prometheus/gauge.h>
+#include <prometheus/registry.h>
+#endif
+
 namespace hwgauge
 {
+	/* 一轮采集超过间隔时的处理方式 */
+	enum class OverrunPolicy
+	{
+		Skip,      // 跳到下一个对齐的槽位，跳过的轮次计入 missed ticks
+		CatchUp,   // 连续补采错过的轮次，一次最多 kMaxCatchUp 轮，其余跳过
+		Stretch    // 按实际耗时拉长间隔，采集变快后逐步回到设定值
+	};
+
 	class Exposer
 	{
 	public:
-		Exposer(std::chrono::duration<double> interval) :
-			interval(interval) {}
+		static constexpr std::uint64_t kMaxCatchUp = 8;
+
+		explicit Exposer(std::chrono::duration<double> interval, OverrunPolicy policy = OverrunPolicy::Skip);
+		~Exposer();
 
+		Exposer(const Exposer&) = delete;
+		Exposer& operator=(const Exposer&) = delete;
+
+		// 返回是否加入成功，可恢复错误时调用方可以改用其它数据源
 		template<typename T, typename... Args>
-		void inline add_collector(Args&&... args)
+		bool inline add_collector(Args&&... args)
 		{
 			try
 			{
 				collectors.push_back(std::make_unique<T>(std::forward<Args>(args)...));
+				return true;
 			}
 			catch (const hwgauge::RecoverableError& e)
 			{
 				spdlog::error("Recoverable error: {}", e.what());
+				return false;
 			}
 			catch (const hwgauge::FatalError& e)
 			{
@@ -36,13 +62,72 @@ namespace hwgauge
 			}
 		}
 
+#ifdef HWGAUGE_USE_PROMETHEUS
+		// 导出 hwgauge_missed_ticks_total、hwgauge_tick_interval_seconds，
+		// 以及各采集器的 hwgauge_capture_skew_seconds、hwgauge_capture_duration_seconds
+		void exportStats(const std::shared_ptr<prometheus::Registry>& registry);
+#endif
+
+		// 阻塞到 stop() 或收到 SIGINT / SIGTERM（需先调用 installStopSignals）
 		void run();
+		// 可在任意线程调用，立即唤醒 run()
 		void stop();
+		// 采集耗时超过间隔而跳过的轮数
+		std::uint64_t missedTicks() const { return missed.load(std::memory_order_relaxed); }
 	private:
+		/* 一个采集器在本轮第一阶段的结果 */
+		struct CaptureState
+		{
+			enum Status { Ok, Failed, Fatal };
+			Status status = Ok;
+			std::chrono::duration<double> skew{};      // 实际开始读取时刻相对 tick.time
+			std::chrono::duration<double> duration{};  // capture 耗时
+#ifdef HWGAUGE_USE_PROMETHEUS
+			prometheus::Gauge* skewGauge = nullptr;
+			prometheus::Gauge* durationGauge = nullptr;
+#endif
+		};
+
 		void collect();
+		// 第一阶段：所有采集器在屏障后同时开始 capture，最后到达者记录 tick.time
+		void capture();
+		void captureOne(std::size_t i);
+		// 第二阶段：按 publishOrder 依次 publish，跳过 capture 失败的采集器；返回 false 表示需要停止
+		bool publish();
+		// 按上下文依赖排序：提供某个来源的采集器排在读取它的采集器之前，其余保持加入顺序
+		void orderPublish();
+		// 处理 due 个到期的调度槽位，按策略采集一轮或多轮
+		void onTick(std::uint64_t due);
+		// Stretch 策略下按本轮耗时调整 period，返回是否需要重新设置定时器
+		bool adapt(std::chrono::duration<double> took);
+		void addMissed(std::uint64_t n);
+#ifdef __linux__
+		bool runEventLoop();
+#endif
+		void runSleepLoop();
 	private:
 		std::atomic<bool> running = false;
 		std::chrono::duration<double> interval;
+		OverrunPolicy policy;
+		std::chrono::duration<double> period;   // 当前实际间隔，只有 Stretch 策略会偏离 interval
 		std::vector<std::unique_ptr<Collector>> collectors;
+		std::vector<std::string> names;        // 首轮缓存，避免每轮构造字符串
+		std::vector<CaptureState> captures;
+		std::vector<std::size_t> publishOrder;
+		std::unique_ptr<ThreadPool> pool;      // 线程数等于采集器数，每个采集器在屏障处独占一个线程
+		std::atomic<std::size_t> arrived{ 0 };
+		std::atomic<bool> released{ false };
+		TickContext context;    // 本轮共享上下文，每轮开始时清除功率
+		Tick tick;              // 本轮序号与共同采样时刻，context 指向上面的成员
+		std::atomic<std::uint64_t> missed{ 0 };
+#ifdef __linux__
+		int wakeFd = -1;        // eventfd，stop() 写入以唤醒 epoll_wait
+#endif
+#ifdef HWGAUGE_USE_PROMETHEUS
+		prometheus::Counter* missedCounter = nullptr;
+		prometheus::Gauge* periodGauge = nullptr;
+		prometheus::Family<prometheus::Gauge>* skewFamily = nullptr;
+		prometheus::Family<prometheus::Gauge>* durationFamily = nullptr;
+#endif
 	};
 }
\ No newline at end of file
@@ -0,0 +1,132 @@
+#include "StopSignal.hpp"
+#include "Collector/Common/Exception.hpp"
+
+#include <atomic>
+#include <csignal>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <pthread.h>
+#include <sys/eventfd.h>
+#include <sys/signalfd.h>
+#include <unistd.h>
+#else
+#include <chrono>
+#include <thread>
+#endif
+
+namespace hwgauge
+{
+	namespace
+	{
+		std::atomic<bool> requested{ false };
+#ifdef __linux__
+		int signalFd = -1;
+		int cancelFd = -1;
+#else
+		std::atomic<bool> cancelled{ false };
+
+		void onSignal(int signal)
+		{
+			if (signal == SIGINT || signal == SIGTERM)requested.store(true, std::memory_order_relaxed);
+		}
+#endif
+	}
+
+#ifdef __linux__
+	void installStopSignals()
+	{
+		sigset_t set;
+		sigemptyset(&set);
+		sigaddset(&set, SIGINT);
+		sigaddset(&set, SIGTERM);
+		int err = pthread_sigmask(SIG_BLOCK, &set, nullptr);
+		if (err != 0)throw FatalError(std::string("[StopSignal] pthread_sigmask failed: ") + std::strerror(err));
+
+		signalFd = signalfd(-1, &set, SFD_NONBLOCK | SFD_CLOEXEC);
+		if (signalFd < 0)throw FatalError(std::string("[StopSignal] signalfd failed: ") + std::strerror(errno));
+		cancelFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (cancelFd < 0)throw FatalError(std::string("[StopSignal] eventfd failed: ") + std::strerror(errno));
+	}
+
+	int stopSignalFd()
+	{
+		return signalFd;
+	}
+
+	int readStopSignal()
+	{
+		signalfd_siginfo info;
+		if (signalFd < 0 || read(signalFd, &info, sizeof(info)) != static_cast<ssize_t>(sizeof(info)))return 0;
+		requested.store(true, std::memory_order_relaxed);
+		return static_cast<int>(info.ssi_signo);
+	}
+
+	bool waitStopSignal()
+	{
+		if (signalFd < 0)return false;
+		pollfd fds[2] = { { signalFd, POLLIN, 0 }, { cancelFd, POLLIN, 0 } };
+		while (true)
+		{
+			if (poll(fds, 2, -1) < 0)
+			{
+				if (errno == EINTR)continue;
+				return false;
+			}
+			if ((fds[0].revents & POLLIN) && readStopSignal() != 0)return true;
+			if (fds[1].revents & POLLIN)
+			{
+				std::uint64_t value;
+				(void)read(cancelFd, &value, sizeof(value));
+				return false;
+			}
+		}
+	}
+
+	void cancelStopWait()
+	{
+		std::uint64_t one = 1;
+		if (cancelFd >= 0)(void)write(cancelFd, &one, sizeof(one));
+	}
+#else
+	void installStopSignals()
+	{
+		std::signal(SIGINT, onSignal);
+		std::signal(SIGTERM, onSignal);
+	}
+
+	int stopSignalFd()
+	{
+		return -1;
+	}
+
+	int readStopSignal()
+	{
+		return 0;
+	}
+
+	bool waitStopSignal()
+	{
+		while (!requested.load(std::memory_order_relaxed))
+		{
+			if (cancelled.exchange(false, std::memory_order_relaxed))return false;
+			std::this_thread::sleep_for(std::chrono::milliseconds(100));
+		}
+		return true;
+	}
+
+	void cancelStopWait()
+	{
+		cancelled.store(true, std::memory_order_relaxed);
+	}
+#endif
+
+	bool stopRequested()
+	{
+		return requested.load(std::memory_order_relaxed);
+	}
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+namespace hwgauge
+{
+	/**
+	 * SIGINT / SIGTERM 停止通知
+	 * Linux 下在所有线程中屏蔽这两个信号，改由 signalfd 接收：采集循环把它加入 epoll，
+	 * 聚合器与回放用 waitStopSignal 阻塞等待，不再轮询标志。其它平台退回到信号处理函数置位标志。
+	 */
+
+	// 必须在创建任何线程（异步日志、HTTP 服务、采样线程池）之前调用，子线程继承信号屏蔽字；失败时抛出 FatalError
+	void installStopSignals();
+
+	// 可加入 epoll 的 signalfd，可读时调用 readStopSignal；非 Linux 下为 -1
+	int stopSignalFd();
+
+	// 取出一个待处理的停止信号，返回信号编号，没有时返回 0
+	int readStopSignal();
+
+	// 是否已经收到过停止信号
+	bool stopRequested();
+
+	// 阻塞到收到停止信号（返回 true）或 cancelStopWait 被调用（返回 false）
+	bool waitStopSignal();
+	void cancelStopWait();
+}
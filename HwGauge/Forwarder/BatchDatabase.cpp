@@ -0,0 +1,253 @@
+#ifdef HWGAUGE_USE_POSTGRESQL
+
+#include "BatchDatabase.hpp"
+
+#include "Collector/Base/Database.hpp"
+#include "Collector/Common/Codec.hpp"
+#include "Collector/Common/Exception.hpp"
+#include "Collector/CPUCollector/CPUDatabase.hpp"
+#include "Collector/CPUCollector/CPUCoreDatabase.hpp"
+#include "Collector/GPUCollector/GPUDatabase.hpp"
+#include "Collector/GPUCollector/GPUSampleDatabase.hpp"
+#include "Collector/GPUProcessCollector/GPUProcessDatabase.hpp"
+#include "Collector/NPUCollector/NPUDatabase.hpp"
+#include "Collector/DerivedCollector/DerivedDatabase.hpp"
+#ifdef __linux__
+#include "Collector/SYSCollector/SYSDatabase.hpp"
+#include "Collector/HwmonCollector/HwmonDatabase.hpp"
+#include "Collector/PerfCollector/PerfDatabase.hpp"
+#endif
+
+#include "spdlog/spdlog.h"
+#include "Collector/Common/Log.hpp"
+#include <cctype>
+#include <cstdint>
+
+namespace hwgauge
+{
+    namespace
+    {
+        /* 解码到复用的缓冲区后调用对应 XDatabase 写入（不单独开启事务） */
+        template<typename LabelT, typename MetricT, typename DbT>
+        class TypedBatchWriter : public BatchWriter
+        {
+        public:
+            TypedBatchWriter(PGconn* conn, const DBConfig& config, const std::string& table_name_prefix)
+                : db(conn, config, table_name_prefix), infoWritten(false)
+            {}
+
+            void write(const MetricBatch& batch) override
+            {
+                decodePayload(batch.payload, labels, metrics);
+                // 设备数变化时重新写入静态信息
+                if (!infoWritten || labels.size() != infoCount)
+                {
+                    db.writeInfo(labels, false);
+                    infoWritten = true;
+                    infoCount = labels.size();
+                }
+                db.writeMetric(batch.time, batch.seq, labels, metrics, false);
+            }
+
+        private:
+            DbT db;
+            bool infoWritten;
+            size_t infoCount = 0;
+            std::vector<LabelT> labels;
+            std::vector<MetricT> metrics;
+        };
+
+        /* 表名前缀只保留字母、数字和下划线 */
+        std::string sanitizeIdentifier(const std::string& s)
+        {
+            std::string out;
+            out.reserve(s.size());
+            for (char c : s)
+            {
+                bool ok = (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+                out.push_back(ok ? c : '_');
+            }
+            return out;
+        }
+
+        /**
+         * 节点ID作为表名的一部分：已是小写标识符且不长的原样使用，
+         * 否则替换非法字符、截断并附加原始ID的哈希，避免 node-1 / node_1、Node1 / node1（PostgreSQL 不区分大小写）
+         * 以及超过 63 字节被截断后的长ID映射到同一张表
+         */
+        std::string nodeIdentifier(const std::string& node)
+        {
+            constexpr std::size_t kMaxPlain = 24;
+            bool plain = !node.empty() && node.size() <= kMaxPlain;
+            for (char c : node)
+                plain = plain && ((c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || c == '_');
+            if (plain)return node;
+
+            std::uint32_t hash = 2166136261u;         // FNV-1a
+            for (unsigned char c : node)hash = (hash ^ c) * 16777619u;
+            std::string out = sanitizeIdentifier(node.substr(0, kMaxPlain));
+            for (char& c : out)c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+            return fmt::format("{}_{:08x}", out, hash);
+        }
+    }
+
+    BatchDatabase::BatchDatabase(const DBConfig& config, const std::string& table_name_prefix)
+        : config_(config), prefix_(sanitizeIdentifier(table_name_prefix)), conn_(nullptr)
+    {
+        if (!ensureConnection())throw FatalError("[BatchDatabase] Connecect Failed");
+        spdlog::info("[BatchDatabase] Initialize successfully");
+    }
+
+    BatchDatabase::~BatchDatabase()
+    {
+        resetConnection();
+    }
+
+    bool BatchDatabase::ensureConnection()
+    {
+        if (conn_ && PQstatus(conn_) == CONNECTION_OK)return true;
+        resetConnection();
+        conn_ = connectDatabase(config_);
+        return conn_ != nullptr;
+    }
+
+    void BatchDatabase::resetConnection()
+    {
+        // 写入器持有连接指针，必须先于连接释放
+        writers_.clear();
+        if (conn_)
+        {
+            PQfinish(conn_);
+            conn_ = nullptr;
+            spdlog::info("[BatchDatabase] Disconnected from database");
+        }
+    }
+
+    bool BatchDatabase::exec(const char* sql)
+    {
+        PGresult* res = PQexec(conn_, sql);
+        bool ok = res && PQresultStatus(res) == PGRES_COMMAND_OK;
+        if (!ok)spdlog::warn("[BatchDatabase] {} failed: {}", sql, std::string(PQerrorMessage(conn_)));
+        PQclear(res);
+        return ok;
+    }
+
+    BatchWriter& BatchDatabase::writerFor(const MetricBatch& batch)
+    {
+        std::string key = batch.node + '\0' + batch.type;
+        auto it = writers_.find(key);
+        if (it != writers_.end())return *it->second;
+
+        std::string prefix = prefix_ + "_" + nodeIdentifier(batch.node);
+        std::unique_ptr<BatchWriter> writer;
+        if (batch.type == "cpu")
+            writer = std::make_unique<TypedBatchWriter<CPULabel, CPUMetrics, CPUDatabase>>(conn_, config_, prefix);
+        else if (batch.type == "cpu_core")
+            writer = std::make_unique<TypedBatchWriter<CPUCoreLabel, CPUCoreMetrics, CPUCoreDatabase>>(conn_, config_, prefix);
+        else if (batch.type == "gpu")
+            writer = std::make_unique<TypedBatchWriter<GPULabel, GPUMetrics, GPUDatabase>>(conn_, config_, prefix);
+        else if (batch.type == "gpu_samples")
+            writer = std::make_unique<TypedBatchWriter<GPUSampleLabel, GPUSample, GPUSampleDatabase>>(conn_, config_, prefix);
+        else if (batch.type == "gpu_process")
+            writer = std::make_unique<TypedBatchWriter<GPUProcessLabel, GPUProcessMetrics, GPUProcessDatabase>>(conn_, config_, prefix);
+        else if (batch.type == "npu")
+            writer = std::make_unique<TypedBatchWriter<NPULabel, NPUMetrics, NPUDatabase>>(conn_, config_, prefix);
+        else if (batch.type == "derived")
+            writer = std::make_unique<TypedBatchWriter<DerivedLabel, DerivedMetrics, DerivedDatabase>>(conn_, config_, prefix);
+#ifdef __linux__
+        else if (batch.type == "sys")
+            writer = std::make_unique<TypedBatchWriter<SYSLabel, SYSMetrics, SYSDatabase>>(conn_, config_, prefix);
+        else if (batch.type == "hwmon")
+            writer = std::make_unique<TypedBatchWriter<HwmonLabel, HwmonMetrics, HwmonDatabase>>(conn_, config_, prefix);
+        else if (batch.type == "perf")
+            writer = std::make_unique<TypedBatchWriter<PerfLabel, PerfMetrics, PerfDatabase>>(conn_, config_, prefix);
+#endif
+        else
+            throw RecoverableError("[BatchDatabase] Unknown metric type " + batch.type);
+
+        return *writers_.emplace(std::move(key), std::move(writer)).first->second;
+    }
+
+    bool BatchDatabase::write(const std::vector<const MetricBatch*>& batches, std::vector<BatchFailure>* failed)
+    {
+        if (batches.empty())return true;
+        if (!ensureConnection())return false;
+        if (!exec("BEGIN"))
+        {
+            resetConnection();
+            return false;
+        }
+
+        size_t written = 0;
+        for (size_t i = 0; i < batches.size(); i++)
+        {
+            const MetricBatch* batch = batches[i];
+            if (!exec("SAVEPOINT hwgauge_batch"))
+            {
+                exec("ROLLBACK");
+                resetConnection();
+                return false;
+            }
+
+            std::string reason;
+            try
+            {
+                writerFor(*batch).write(*batch);
+                // XDatabase 不抛出 SQL 错误，通过事务状态判断
+                if (PQtransactionStatus(conn_) == PQTRANS_INERROR)
+                {
+                    reason = PQerrorMessage(conn_);
+                    while (!reason.empty() && (reason.back() == '\n' || reason.back() == ' '))reason.pop_back();
+                    if (reason.empty())reason = "transaction aborted";
+                }
+            }
+            catch (const RecoverableError& e)
+            {
+                reason = e.what();
+            }
+            catch (const FatalError& e)
+            {
+                // 建表失败或连接断开，整批回滚后重试
+                spdlog::error("[BatchDatabase] {}", e.what());
+                exec("ROLLBACK");
+                resetConnection();
+                return false;
+            }
+
+            if (reason.empty())
+            {
+                // 连接断开时 RELEASE 失败，整批回滚后重试
+                if (!exec("RELEASE SAVEPOINT hwgauge_batch"))
+                {
+                    exec("ROLLBACK");
+                    resetConnection();
+                    return false;
+                }
+                ++written;
+                continue;
+            }
+
+            // 只回滚这一批；同一批数据重试也会失败，交给调用方确认或转存，不阻塞后续数据
+            HWGAUGE_WARN_LIMITED_BY(batch->node, "[BatchDatabase] Skip {} batch from {}: {}", batch->type, batch->node, reason);
+            if (!exec("ROLLBACK TO SAVEPOINT hwgauge_batch"))
+            {
+                exec("ROLLBACK");
+                resetConnection();
+                return false;
+            }
+            // 写入器的建表、静态信息状态可能随之回滚，下次重新创建
+            writers_.erase(batch->node + '\0' + batch->type);
+            if (failed)failed->push_back(BatchFailure{ i, std::move(reason) });
+        }
+
+        if (!exec("COMMIT"))
+        {
+            writers_.clear();
+            return false;
+        }
+        HWGAUGE_LOG_COUNT("BatchDatabase batches", written);
+        return true;
+    }
+}
+
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+
+#ifdef HWGAUGE_USE_POSTGRESQL
+
+#include "Collector/Common/Config.hpp"
+#include "Forwarder/BatchSink.hpp"
+
+#include <libpq-fe.h>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hwgauge
+{
+    /* 单个 (节点, 采集器) 的写入器，内部持有对应的 XDatabase */
+    class BatchWriter
+    {
+    public:
+        virtual ~BatchWriter() = default;
+
+        // 解码负载并写入，解码失败抛出 RecoverableError
+        virtual void write(const MetricBatch& batch) = 0;
+    };
+
+    /* 写入失败的一批数据：batches 中的下标与原因 */
+    struct BatchFailure
+    {
+        std::size_t index;
+        std::string reason;
+    };
+
+    /**
+     * 聚合器使用的批量写库
+     * 所有节点、所有类型共用一个 PGconn，表名为 <prefix>_<node>_<type>_metric / _info，
+     * 与节点直连数据库时 (--db-table <prefix>_<node>) 的表结构一致。
+     */
+    class BatchDatabase
+    {
+    public:
+        BatchDatabase(const DBConfig& config, const std::string& table_name_prefix);
+        ~BatchDatabase();
+
+        BatchDatabase(const BatchDatabase&) = delete;
+        BatchDatabase& operator=(const BatchDatabase&) = delete;
+
+        // 在一个事务中写入一批数据，每批数据各用一个 SAVEPOINT：
+        // SQL 错误（约束冲突、数值越界等）或无法解码的批只回滚自身，记入 failed 后继续，不影响其余批的提交；
+        // 连接断开、建表失败等整体错误时回滚全部并返回 false（调用方稍后重试）
+        bool write(const std::vector<const MetricBatch*>& batches, std::vector<BatchFailure>* failed = nullptr);
+
+    private:
+        bool ensureConnection();
+        void resetConnection();
+        bool exec(const char* sql);
+        BatchWriter& writerFor(const MetricBatch& batch);
+
+        DBConfig config_;
+        std::string prefix_;
+        PGconn* conn_;
+        std::unordered_map<std::string, std::unique_ptr<BatchWriter>> writers_;
+    };
+}
+
+#endif
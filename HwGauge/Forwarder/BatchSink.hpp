@@ -0,0 +1,29 @@
+#pragma once
+
+#include "Collector/Common/Time.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace hwgauge
+{
+    /* 单个节点、单个采集器一次采集的批量数据 */
+    struct MetricBatch
+    {
+        std::string node;       // 节点ID
+        std::string type;       // 采集器名称 (cpu/gpu/npu/sys)
+        TimePoint time;         // 采样时刻
+        std::uint64_t seq = 0;  // 发送方的采集轮次序号，0 表示未知（旧版本）
+        std::string payload;    // encodePayload 编码后的 labels + metrics
+    };
+
+    /* 批量数据下游接口（Redis Stream 等），由 DeviceCollector 每轮调用 */
+    class BatchSink
+    {
+    public:
+        virtual ~BatchSink() = default;
+
+        // 发送失败时只记录日志并丢弃，不影响本地其他输出
+        virtual void publish(const MetricBatch& batch) = 0;
+    };
+}
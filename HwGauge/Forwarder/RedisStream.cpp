@@ -0,0 +1,394 @@
+#ifdef HWGAUGE_USE_CLUSTER
+
+#include "RedisStream.hpp"
+
+#include "spdlog/spdlog.h"
+#include "Collector/Common/Log.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+
+namespace hwgauge
+{
+    namespace
+    {
+        constexpr std::chrono::milliseconds kMinBackoff{ 1000 };
+        constexpr std::chrono::milliseconds kMaxBackoff{ 30000 };
+
+        // ts 为自 epoch 起的微秒；旧版本节点写入的是本地时间文本
+        bool parseStreamTime(const std::string& value, TimePoint& time)
+        {
+            std::int64_t us = 0;
+            const char* end = value.data() + value.size();
+            auto [ptr, ec] = std::from_chars(value.data(), end, us);
+            if (ec == std::errc() && ptr == end)
+            {
+                time = fromEpochMicros(us);
+                return true;
+            }
+            return parseLocalTime(value, time);
+        }
+    }
+
+    /* ---------- RedisConnection ---------- */
+
+    RedisConnection::RedisConnection(const ClusterConfig& config)
+        : config_(config), ctx_(nullptr), backoff_(kMinBackoff)
+    {}
+
+    RedisConnection::~RedisConnection()
+    {
+        disconnect();
+    }
+
+    void RedisConnection::disconnect()
+    {
+        if (ctx_)
+        {
+            redisFree(ctx_);
+            ctx_ = nullptr;
+        }
+    }
+
+    bool RedisConnection::ensure()
+    {
+        if (ctx_)return true;
+
+        // Redis 宕机时每个采集器每轮都会调用，连接超时 1 秒会拖慢采集；失败后按指数退避（最长 30 秒）再尝试
+        auto now = std::chrono::steady_clock::now();
+        if (now < nextAttempt_)return false;
+        nextAttempt_ = now + backoff_;
+        backoff_ = std::min(backoff_ * 2, kMaxBackoff);
+
+        int portInt = 6379;
+        try {
+            portInt = std::stoi(config_.port);
+        } catch (...) {
+            spdlog::warn("[RedisConnection] Invalid port [{}], defaulting to 6379", config_.port);
+        }
+
+        struct timeval timeout = { 1, 0 }; // 连接超时 1秒
+        ctx_ = redisConnectWithTimeout(config_.host.c_str(), portInt, timeout);
+        if (ctx_ == nullptr || ctx_->err)
+        {
+            std::string errStr = (ctx_) ? ctx_->errstr : "can't allocate context";
+            HWGAUGE_WARN_LIMITED("[RedisConnection] Connection failed to {}:{}. Error: {}", config_.host, portInt, errStr);
+            disconnect();
+            return false;
+        }
+
+        // 处理密码认证
+        if (!config_.password.empty())
+        {
+            RedisReplyPtr reply(static_cast<redisReply*>(redisCommand(ctx_, "AUTH %s", config_.password.c_str())), freeReplyObject);
+            if (!reply || reply->type == REDIS_REPLY_ERROR)
+            {
+                spdlog::error("[RedisConnection] Authentication failed: {}", reply ? reply->str : "IO error");
+                disconnect();
+                return false;
+            }
+        }
+
+        // 设置读写超时 2s（需大于 XREADGROUP 的阻塞时间）
+        struct timeval io_timeout = { 2, 0 };
+        redisSetTimeout(ctx_, io_timeout);
+        backoff_ = kMinBackoff;
+        spdlog::info("[RedisConnection] Connected to {}:{}", config_.host, portInt);
+        return true;
+    }
+
+    RedisReplyPtr RedisConnection::command(const std::vector<const char*>& argv, const std::vector<size_t>& argvlen)
+    {
+        if (!ensure())return RedisReplyPtr(nullptr, freeReplyObject);
+
+        auto* raw = redisCommandArgv(ctx_, static_cast<int>(argv.size()), const_cast<const char**>(argv.data()), argvlen.data());
+        if (raw == nullptr)
+        {
+            spdlog::warn("[RedisConnection] IO error: {}. Connection marked down.", ctx_->errstr);
+            disconnect();
+        }
+        return RedisReplyPtr(static_cast<redisReply*>(raw), freeReplyObject);
+    }
+
+    /* ---------- RedisStreamPublisher ---------- */
+
+    RedisStreamPublisher::RedisStreamPublisher(const ClusterConfig& cluster, const StreamConfig& stream)
+        : stream_(stream), maxLen_(std::to_string(stream.maxLen)), conn_(cluster)
+    {
+        if (!conn_.ensure())spdlog::warn("[RedisStream] Redis unavailable at startup, will retry on publish");
+        spdlog::info("[RedisStream] Publishing to stream {} (MAXLEN ~ {})", stream_.key, stream_.maxLen);
+    }
+
+    void RedisStreamPublisher::publish(const MetricBatch& batch)
+    {
+        // XADD key MAXLEN ~ n * node <id> type <type> ts <epoch us> seq <seq> data <payload>
+        char ts[24];
+        auto tsEnd = std::to_chars(ts, ts + sizeof(ts), toEpochMicros(batch.time)).ptr;
+        char seq[24];
+        auto seqEnd = std::to_chars(seq, seq + sizeof(seq), batch.seq).ptr;
+        const std::vector<const char*> argv = {
+            "XADD", stream_.key.c_str(), "MAXLEN", "~", maxLen_.c_str(), "*",
+            "node", batch.node.data(),
+            "type", batch.type.data(),
+            "ts", ts,
+            "seq", seq,
+            "data", batch.payload.data()
+        };
+        const std::vector<size_t> argvlen = {
+            4, stream_.key.size(), 6, 1, maxLen_.size(), 1,
+            4, batch.node.size(),
+            4, batch.type.size(),
+            2, static_cast<size_t>(tsEnd - ts),
+            3, static_cast<size_t>(seqEnd - seq),
+            4, batch.payload.size()
+        };
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto reply = conn_.command(argv, argvlen);
+        if (!reply)
+        {
+            HWGAUGE_WARN_LIMITED("[RedisStream] Dropped {} batch: Redis unavailable", batch.type);
+            return;
+        }
+        if (reply->type == REDIS_REPLY_ERROR)
+        {
+            HWGAUGE_WARN_LIMITED("[RedisStream] XADD failed: {}", reply->str);
+            return;
+        }
+        spdlog::debug("[RedisStream] Published {} batch ({} bytes) as {}", batch.type, batch.payload.size(), reply->str);
+    }
+
+    /* ---------- RedisStreamConsumer ---------- */
+
+    RedisStreamConsumer::RedisStreamConsumer(const ClusterConfig& cluster, const StreamConfig& stream)
+        : stream_(stream), conn_(cluster), groupReady_(false), pendingDone_(false),
+          claimCursor_("0-0"), nextClaim_(std::chrono::steady_clock::now())
+    {
+        if (!conn_.ensure() || !ensureGroup())
+            spdlog::warn("[RedisStream] Redis unavailable at startup, will retry");
+    }
+
+    bool RedisStreamConsumer::ensureGroup()
+    {
+        if (groupReady_)return true;
+
+        // 从头创建消费组，聚合器启动前写入的数据也会被消费
+        const std::vector<const char*> argv = {
+            "XGROUP", "CREATE", stream_.key.c_str(), stream_.group.c_str(), "0", "MKSTREAM"
+        };
+        const std::vector<size_t> argvlen = { 6, 6, stream_.key.size(), stream_.group.size(), 1, 8 };
+        auto reply = conn_.command(argv, argvlen);
+        if (!reply)return false;
+        if (reply->type == REDIS_REPLY_ERROR && std::strncmp(reply->str, "BUSYGROUP", 9) != 0)
+        {
+            spdlog::error("[RedisStream] XGROUP CREATE failed: {}", reply->str);
+            return false;
+        }
+        groupReady_ = true;
+        spdlog::info("[RedisStream] Consuming stream {} as {}/{}", stream_.key, stream_.group, stream_.consumer);
+        return true;
+    }
+
+    bool RedisStreamConsumer::read(std::vector<StreamEntry>& out)
+    {
+        out.clear();
+        if (!conn_.ensure() || !ensureGroup())return false;
+
+        // 自己的未确认记录处理完后，再接管已退出的聚合器遗留的记录
+        if (pendingDone_)
+        {
+            if (!claim(out))return false;
+            if (!out.empty())return true;
+        }
+
+        // 先读取 "0"（已投递但未确认的记录），读空后再读取 ">"（新记录）
+        const char* startId = pendingDone_ ? ">" : "0";
+        const std::string count = std::to_string(stream_.batchSize);
+        const std::string block = std::to_string(stream_.blockMs);
+        const std::vector<const char*> argv = {
+            "XREADGROUP", "GROUP", stream_.group.c_str(), stream_.consumer.c_str(),
+            "COUNT", count.c_str(), "BLOCK", block.c_str(),
+            "STREAMS", stream_.key.c_str(), startId
+        };
+        const std::vector<size_t> argvlen = {
+            10, 5, stream_.group.size(), stream_.consumer.size(),
+            5, count.size(), 5, block.size(),
+            7, stream_.key.size(), std::strlen(startId)
+        };
+
+        auto reply = conn_.command(argv, argvlen);
+        if (!reply)
+        {
+            groupReady_ = false;
+            return false;
+        }
+        if (reply->type == REDIS_REPLY_ERROR)
+        {
+            // 例如 Stream 被删除导致 NOGROUP，下次重新创建消费组
+            spdlog::warn("[RedisStream] XREADGROUP failed: {}", reply->str);
+            groupReady_ = false;
+            return false;
+        }
+
+        parseEntries(reply.get(), out);
+        if (!pendingDone_ && out.empty())pendingDone_ = true;
+        return true;
+    }
+
+    bool RedisStreamConsumer::claim(std::vector<StreamEntry>& out)
+    {
+        // 一轮扫描分多次完成，每次最多接管 batchSize 条；扫描完整个列表后间隔半个空闲时长再开始下一轮
+        auto now = std::chrono::steady_clock::now();
+        if (claimCursor_ == "0-0" && now < nextClaim_)return true;
+
+        const std::string idle = std::to_string(stream_.claimIdleMs);
+        const std::string count = std::to_string(stream_.batchSize);
+        const std::vector<const char*> argv = {
+            "XAUTOCLAIM", stream_.key.c_str(), stream_.group.c_str(), stream_.consumer.c_str(),
+            idle.c_str(), claimCursor_.c_str(), "COUNT", count.c_str()
+        };
+        const std::vector<size_t> argvlen = {
+            10, stream_.key.size(), stream_.group.size(), stream_.consumer.size(),
+            idle.size(), claimCursor_.size(), 5, count.size()
+        };
+
+        auto reply = conn_.command(argv, argvlen);
+        if (!reply)
+        {
+            groupReady_ = false;
+            return false;
+        }
+        // [next-cursor, [[id, [field, value, ...]], ...], [deleted-id, ...] (Redis 7)]
+        if (reply->type != REDIS_REPLY_ARRAY || reply->elements < 2 || reply->element[0]->type != REDIS_REPLY_STRING)
+        {
+            // Redis 6.2 之前没有 XAUTOCLAIM，只能由原消费者重启后处理
+            HWGAUGE_WARN_LIMITED("[RedisStream] XAUTOCLAIM failed: {}", reply->type == REDIS_REPLY_ERROR ? reply->str : "unexpected reply");
+            claimCursor_ = "0-0";
+            nextClaim_ = now + std::chrono::milliseconds(stream_.claimIdleMs);
+            return true;
+        }
+
+        claimCursor_.assign(reply->element[0]->str, reply->element[0]->len);
+        if (claimCursor_ == "0-0")nextClaim_ = now + std::chrono::milliseconds(stream_.claimIdleMs / 2);
+        parseEntryList(reply->element[1], out);
+        if (!out.empty())spdlog::info("[RedisStream] Claimed {} entries idle for over {} ms", out.size(), stream_.claimIdleMs);
+        return true;
+    }
+
+    void RedisStreamConsumer::parseEntries(const redisReply* reply, std::vector<StreamEntry>& out)
+    {
+        // 超时返回 nil；否则为 [[key, [[id, [field, value, ...]], ...]]]
+        if (reply->type != REDIS_REPLY_ARRAY)return;
+
+        for (size_t s = 0; s < reply->elements; ++s)
+        {
+            const redisReply* stream = reply->element[s];
+            if (stream->type != REDIS_REPLY_ARRAY || stream->elements != 2)continue;
+            parseEntryList(stream->element[1], out);
+        }
+    }
+
+    void RedisStreamConsumer::parseEntryList(const redisReply* entries, std::vector<StreamEntry>& out)
+    {
+        if (entries->type != REDIS_REPLY_ARRAY)return;
+
+        for (size_t e = 0; e < entries->elements; ++e)
+        {
+            const redisReply* entry = entries->element[e];
+            if (entry->type != REDIS_REPLY_ARRAY || entry->elements != 2)continue;
+
+            StreamEntry item;
+            item.id.assign(entry->element[0]->str, entry->element[0]->len);
+
+            // 已被 MAXLEN 裁剪的未确认记录没有字段，保留 id 以便确认
+            const redisReply* fields = entry->element[1];
+            if (fields->type == REDIS_REPLY_ARRAY)
+            {
+                bool validTime = false;
+                for (size_t f = 0; f + 1 < fields->elements; f += 2)
+                {
+                    std::string name(fields->element[f]->str, fields->element[f]->len);
+                    std::string value(fields->element[f + 1]->str, fields->element[f + 1]->len);
+                    if (name == "node") item.batch.node = std::move(value);
+                    else if (name == "type") item.batch.type = std::move(value);
+                    else if (name == "ts") validTime = parseStreamTime(value, item.batch.time);
+                    else if (name == "seq") std::from_chars(value.data(), value.data() + value.size(), item.batch.seq);
+                    else if (name == "data") item.batch.payload = std::move(value);
+                }
+                // 时间戳无法识别的记录按空记录处理，只确认不写库
+                if (!validTime)
+                {
+                    HWGAUGE_WARN_LIMITED("[RedisStream] Skip entry {} with an invalid timestamp", item.id);
+                    item.batch.type.clear();
+                }
+            }
+            out.push_back(std::move(item));
+        }
+    }
+
+    bool RedisStreamConsumer::ack(const std::vector<StreamEntry>& entries)
+    {
+        if (entries.empty())return true;
+
+        std::vector<const char*> argv = { "XACK", stream_.key.c_str(), stream_.group.c_str() };
+        std::vector<size_t> argvlen = { 4, stream_.key.size(), stream_.group.size() };
+        argv.reserve(entries.size() + 3);
+        argvlen.reserve(entries.size() + 3);
+        for (const auto& entry : entries)
+        {
+            argv.push_back(entry.id.c_str());
+            argvlen.push_back(entry.id.size());
+        }
+
+        auto reply = conn_.command(argv, argvlen);
+        if (!reply || reply->type == REDIS_REPLY_ERROR)
+        {
+            spdlog::warn("[RedisStream] XACK failed: {}", reply ? reply->str : "IO error");
+            return false;
+        }
+        return true;
+    }
+
+    bool RedisStreamConsumer::deadLetter(const StreamEntry& entry, const std::string& reason)
+    {
+        // XADD <key>:dead MAXLEN ~ n * node <id> type <type> ts <epoch us> seq <seq> data <payload> id <原 ID> error <原因>
+        const std::string key = stream_.key + ":dead";
+        const std::string maxLen = std::to_string(stream_.maxLen);
+        const MetricBatch& batch = entry.batch;
+        char ts[24];
+        auto tsEnd = std::to_chars(ts, ts + sizeof(ts), toEpochMicros(batch.time)).ptr;
+        char seq[24];
+        auto seqEnd = std::to_chars(seq, seq + sizeof(seq), batch.seq).ptr;
+        const std::vector<const char*> argv = {
+            "XADD", key.c_str(), "MAXLEN", "~", maxLen.c_str(), "*",
+            "node", batch.node.data(),
+            "type", batch.type.data(),
+            "ts", ts,
+            "seq", seq,
+            "data", batch.payload.data(),
+            "id", entry.id.c_str(),
+            "error", reason.c_str()
+        };
+        const std::vector<size_t> argvlen = {
+            4, key.size(), 6, 1, maxLen.size(), 1,
+            4, batch.node.size(),
+            4, batch.type.size(),
+            2, static_cast<size_t>(tsEnd - ts),
+            3, static_cast<size_t>(seqEnd - seq),
+            4, batch.payload.size(),
+            2, entry.id.size(),
+            5, reason.size()
+        };
+
+        auto reply = conn_.command(argv, argvlen);
+        if (!reply || reply->type == REDIS_REPLY_ERROR)
+        {
+            spdlog::warn("[RedisStream] XADD to {} failed: {}", key, reply ? reply->str : "IO error");
+            return false;
+        }
+        spdlog::warn("[RedisStream] Moved {} batch {} from {} to {}: {}", batch.type, entry.id, batch.node, key, reason);
+        return true;
+    }
+}
+
+#endif
@@ -0,0 +1,100 @@
+#pragma once
+
+#ifdef HWGAUGE_USE_CLUSTER
+
+#include "Collector/Common/Config.hpp"
+#include "Forwarder/BatchSink.hpp"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <hiredis/hiredis.h>
+
+namespace hwgauge
+{
+    using RedisReplyPtr = std::unique_ptr<redisReply, decltype(&freeReplyObject)>;
+
+    /* 带断线重连的 Redis 连接（二进制安全的 argv 命令） */
+    class RedisConnection
+    {
+    public:
+        explicit RedisConnection(const ClusterConfig& config);
+        ~RedisConnection();
+
+        RedisConnection(const RedisConnection&) = delete;
+        RedisConnection& operator=(const RedisConnection&) = delete;
+
+        // 确保连接可用，失败返回 false；连接失败后按退避间隔重试，间隔内直接返回 false，不阻塞调用方
+        bool ensure();
+
+        // 执行命令，IO 错误时断开连接并返回空指针
+        RedisReplyPtr command(const std::vector<const char*>& argv, const std::vector<size_t>& argvlen);
+
+    private:
+        void disconnect();
+
+        ClusterConfig config_;
+        redisContext* ctx_;
+        std::chrono::steady_clock::time_point nextAttempt_;
+        std::chrono::milliseconds backoff_;     // 下次失败后的重连间隔，连接成功后重置
+    };
+
+    /* Redis Stream 发送端：每轮每个采集器 XADD 一条，Stream 按 MAXLEN ~ 限长 */
+    class RedisStreamPublisher : public BatchSink
+    {
+    public:
+        RedisStreamPublisher(const ClusterConfig& cluster, const StreamConfig& stream);
+
+        void publish(const MetricBatch& batch) override;
+
+    private:
+        StreamConfig stream_;
+        std::string maxLen_;
+        std::mutex mutex_;
+        RedisConnection conn_;
+    };
+
+    /* Stream 中的一条记录 */
+    struct StreamEntry
+    {
+        std::string id;
+        MetricBatch batch;
+    };
+
+    /* Redis Stream 消费端：基于消费组 (XREADGROUP)，处理成功后 XACK */
+    class RedisStreamConsumer
+    {
+    public:
+        RedisStreamConsumer(const ClusterConfig& cluster, const StreamConfig& stream);
+
+        // 读取一批记录（先读取本消费者未确认的记录，再接管其他消费者超时未确认的记录），Redis 不可用时返回 false
+        bool read(std::vector<StreamEntry>& out);
+
+        // 确认已处理的记录
+        bool ack(const std::vector<StreamEntry>& entries);
+
+        // 把无法写入的记录连同原因追加到 <key>:dead（MAXLEN ~ 与主 Stream 相同），Redis 错误时返回 false
+        bool deadLetter(const StreamEntry& entry, const std::string& reason);
+
+        // 处理失败时调用，下次 read 重新投递未确认的记录
+        void rewind() { pendingDone_ = false; }
+
+    private:
+        bool ensureGroup();
+        // 扫描消费组的待确认列表，把空闲超过 claimIdleMs 的记录转给本消费者，Redis 错误时返回 false
+        bool claim(std::vector<StreamEntry>& out);
+        static void parseEntries(const redisReply* reply, std::vector<StreamEntry>& out);
+        static void parseEntryList(const redisReply* entries, std::vector<StreamEntry>& out);
+
+        StreamConfig stream_;
+        RedisConnection conn_;
+        bool groupReady_;
+        bool pendingDone_;
+        std::string claimCursor_;      // 本轮扫描的位置，"0-0" 表示从头开始
+        std::chrono::steady_clock::time_point nextClaim_;
+    };
+}
+
+#endif
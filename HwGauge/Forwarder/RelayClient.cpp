@@ -0,0 +1,121 @@
+#ifdef __linux__
+
+#include "RelayClient.hpp"
+#include "RelayProtocol.hpp"
+#include "Collector/Common/Exception.hpp"
+
+#include "spdlog/spdlog.h"
+#include "Collector/Common/Log.hpp"
+#include <cerrno>
+#include <cstring>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+namespace hwgauge
+{
+    RelayClient::RelayClient(const std::string& upstream)
+        : port_(0), fd_(-1), nextRetry_(std::chrono::steady_clock::now())
+    {
+        if (!parseHostPort(upstream, "127.0.0.1", host_, port_))
+            throw FatalError("[RelayClient] Invalid upstream address " + upstream);
+        if (!ensureConnection())spdlog::warn("[RelayClient] Relay unavailable at startup, will retry on publish");
+    }
+
+    RelayClient::~RelayClient()
+    {
+        disconnect();
+    }
+
+    void RelayClient::disconnect()
+    {
+        if (fd_ >= 0)
+        {
+            ::close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    bool RelayClient::ensureConnection()
+    {
+        if (fd_ >= 0)return true;
+
+        // 重连间隔 1 秒，避免 relay 宕机时每轮都阻塞在连接上
+        auto now = std::chrono::steady_clock::now();
+        if (now < nextRetry_)return false;
+        nextRetry_ = now + std::chrono::seconds(1);
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        addrinfo* res = nullptr;
+        const std::string port = std::to_string(port_);
+        int rc = ::getaddrinfo(host_.c_str(), port.c_str(), &hints, &res);
+        if (rc != 0)
+        {
+            HWGAUGE_WARN_LIMITED("[RelayClient] Failed to resolve {}: {}", host_, gai_strerror(rc));
+            return false;
+        }
+
+        for (addrinfo* ai = res; ai != nullptr; ai = ai->ai_next)
+        {
+            int fd = ::socket(ai->ai_family, ai->ai_socktype | SOCK_CLOEXEC, ai->ai_protocol);
+            if (fd < 0)continue;
+
+            // 连接与发送超时 1 秒 (Linux 下 SO_SNDTIMEO 同样作用于 connect)
+            timeval timeout = { 1, 0 };
+            ::setsockopt(fd, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+            int one = 1;
+            ::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+            if (::connect(fd, ai->ai_addr, ai->ai_addrlen) == 0)
+            {
+                fd_ = fd;
+                break;
+            }
+            ::close(fd);
+        }
+        ::freeaddrinfo(res);
+
+        if (fd_ < 0)
+        {
+            HWGAUGE_WARN_LIMITED("[RelayClient] Connection failed to {}:{}", host_, port_);
+            return false;
+        }
+        spdlog::info("[RelayClient] Connected to relay {}:{}", host_, port_);
+        return true;
+    }
+
+    void RelayClient::publish(const MetricBatch& batch)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!ensureConnection())
+        {
+            spdlog::debug("[RelayClient] Dropped {} batch: relay unavailable", batch.type);
+            return;
+        }
+
+        frame_.clear();
+        encodeRelayFrame(frame_, batch);
+
+        size_t sent = 0;
+        while (sent < frame_.size())
+        {
+            ssize_t n = ::send(fd_, frame_.data() + sent, frame_.size() - sent, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR)continue;
+            if (n <= 0)
+            {
+                // 半帧已发出时必须断开，否则对端无法重新对齐帧边界
+                HWGAUGE_WARN_LIMITED("[RelayClient] Send failed: {}. Connection marked down.", std::strerror(errno));
+                disconnect();
+                return;
+            }
+            sent += static_cast<size_t>(n);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,35 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "Forwarder/BatchSink.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <string>
+
+namespace hwgauge
+{
+    /* 子节点发送端：通过 TCP 将每轮的批量数据推送给机架级 relay，断线后自动重连 */
+    class RelayClient : public BatchSink
+    {
+    public:
+        explicit RelayClient(const std::string& upstream);
+        ~RelayClient() override;
+
+        void publish(const MetricBatch& batch) override;
+
+    private:
+        bool ensureConnection();
+        void disconnect();
+
+        std::string host_;
+        int port_;
+        int fd_;
+        std::chrono::steady_clock::time_point nextRetry_;
+        std::string frame_;     // 复用的发送缓冲
+        std::mutex mutex_;
+    };
+}
+
+#endif
@@ -0,0 +1,105 @@
+#ifdef __linux__
+
+#include "RelayCollector.hpp"
+
+#include "spdlog/spdlog.h"
+#include "Collector/Common/Log.hpp"
+
+namespace hwgauge
+{
+    RelayCollector::RelayCollector(const CollectorConfig& cfg)
+        : rollup(cfg.relayConfig.rollup), sinks(cfg.batchSinks)
+    {
+#ifdef HWGAUGE_USE_POSTGRESQL
+        if (cfg.dbEnable)db = std::make_unique<BatchDatabase>(cfg.dbConfig, cfg.dbTableName);
+#endif
+        server = std::make_unique<RelayServer>(cfg.relayConfig.listen, [this](MetricBatch&& batch) { ingest(std::move(batch)); });
+        spdlog::info("[RelayCollector] Initialize successfully ({})", rollup ? "rollup" : "pass-through");
+    }
+
+    RelayCollector::~RelayCollector()
+    {
+        server.reset();
+    }
+
+    void RelayCollector::ingest(MetricBatch&& batch)
+    {
+        std::string key = batch.node + '\0' + batch.type;
+        std::lock_guard<std::mutex> lock(mutex_);
+        checkSeq(key, batch);
+        if (!rollup)
+        {
+            pending.push_back(std::move(batch));
+            return;
+        }
+
+        auto it = rollups.find(key);
+        if (it == rollups.end())it = rollups.emplace(std::move(key), makeRollup(batch.type)).first;
+
+        if (!it->second)
+        {
+            pending.push_back(std::move(batch));
+            return;
+        }
+        try
+        {
+            it->second->add(batch);
+        }
+        catch (const RecoverableError& e)
+        {
+            HWGAUGE_WARN_LIMITED_BY(batch.node, "[RelayCollector] Dropped {} batch from {}: {}", batch.type, batch.node, e.what());
+        }
+    }
+
+    void RelayCollector::checkSeq(const std::string& key, const MetricBatch& batch)
+    {
+        // 旧版本子节点没有序号
+        if (batch.seq == 0)return;
+        std::uint64_t& last = lastSeq[key];
+        if (last != 0 && batch.seq > last + 1)
+        {
+            std::uint64_t gap = batch.seq - last - 1;
+            HWGAUGE_WARN_LIMITED_BY(batch.node, "[RelayCollector] {} {} skipped {} tick(s) before #{}", batch.node, batch.type, gap, batch.seq);
+            HWGAUGE_LOG_COUNT("Relay missing child ticks", gap);
+        }
+        // 序号回退说明子节点重启，从新的序号重新开始
+        last = batch.seq;
+    }
+
+    void RelayCollector::publish(const Tick& tick)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            outgoing.clear();
+            outgoing.swap(pending);
+            MetricBatch merged;
+            for (auto& kv : rollups)
+            {
+                // 汇总后的数据由本 relay 产生，使用本轮的序号
+                if (kv.second && kv.second->flush(merged))
+                {
+                    merged.seq = tick.seq;
+                    outgoing.push_back(std::move(merged));
+                }
+            }
+        }
+        if (outgoing.empty())return;
+
+        for (const auto& batch : outgoing)
+        {
+            for (auto& sink : sinks)sink->publish(batch);
+        }
+#ifdef HWGAUGE_USE_POSTGRESQL
+        if (db)
+        {
+            std::vector<const MetricBatch*> batches;
+            batches.reserve(outgoing.size());
+            for (const auto& batch : outgoing)batches.push_back(&batch);
+            if (!db->write(batches))HWGAUGE_WARN_LIMITED("[RelayCollector] Dropped {} batches: database write failed", batches.size());
+        }
+#endif
+        spdlog::debug("[RelayCollector] Forwarded {} batches", outgoing.size());
+    }
+}
+
+#endif
@@ -0,0 +1,59 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "Collector/Base/Collector.hpp"
+#include "Collector/Common/Config.hpp"
+#include "Forwarder/BatchSink.hpp"
+#include "Forwarder/RelayServer.hpp"
+#include "Forwarder/Rollup.hpp"
+#ifdef HWGAUGE_USE_POSTGRESQL
+#include "Forwarder/BatchDatabase.hpp"
+#endif
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace hwgauge
+{
+    /**
+     * 机架级 relay：接收子节点推送的批量数据，按 (节点, 采集器) 合并/汇总，
+     * 每轮采集时一次性转发给本实例配置的下游 (Redis Stream、上级 relay、数据库)。
+     * 作为普通 Collector 挂在 Exposer 上，转发周期即 --interval。
+     */
+    class RelayCollector : public Collector
+    {
+    public:
+        explicit RelayCollector(const CollectorConfig& cfg);
+        ~RelayCollector() override;
+
+        std::string name() override { return "relay"; }
+        void publish(const Tick& tick) override;
+
+    private:
+        void ingest(MetricBatch&& batch);
+        // 按子节点的轮次序号检查缺失，调用方持有 mutex_
+        void checkSeq(const std::string& key, const MetricBatch& batch);
+
+        bool rollup;
+        std::vector<std::shared_ptr<BatchSink>> sinks;
+#ifdef HWGAUGE_USE_POSTGRESQL
+        std::unique_ptr<BatchDatabase> db;
+#endif
+
+        std::mutex mutex_;
+        std::unordered_map<std::string, std::unique_ptr<Rollup>> rollups;  // node + '\0' + type
+        std::unordered_map<std::string, std::uint64_t> lastSeq;            // node + '\0' + type
+        std::vector<MetricBatch> pending;      // 不汇总时的原始数据 / 未知类型
+        std::vector<MetricBatch> outgoing;     // 复用的转发缓冲
+
+        // 最后构造、最先析构，保证回调期间其他成员有效
+        std::unique_ptr<RelayServer> server;
+    };
+}
+
+#endif
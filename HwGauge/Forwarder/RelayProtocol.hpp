@@ -0,0 +1,87 @@
+#pragma once
+
+#include "Collector/Common/Codec.hpp"
+#include "Forwarder/BatchSink.hpp"
+
+#include <cstdint>
+#include <string>
+
+namespace hwgauge
+{
+    /**
+     * 子节点 -> 机架级 relay 的 TCP 二进制协议
+     * 每帧：4 字节小端长度 + 帧体，帧体为 BinaryWriter 编码的 (版本, node, type, time, seq, payload)
+     * time 为自 epoch 起的微秒；版本 1、2 的 time 为本地时间文本，版本 1 没有 seq，仍可接收
+     */
+    constexpr std::uint8_t kRelayVersion = 3;
+    constexpr std::uint32_t kRelayMaxFrame = 16u << 20;   // 单帧上限 16MB，超过视为协议错误
+    constexpr std::size_t kRelayHeaderSize = 4;
+
+    /* 追加一帧到 out（不清空 out，便于批量发送） */
+    inline void encodeRelayFrame(std::string& out, const MetricBatch& batch)
+    {
+        const std::size_t start = out.size();
+        out.append(kRelayHeaderSize, '\0');
+
+        BinaryWriter w(out);
+        w.put(kRelayVersion);
+        w.put(batch.node);
+        w.put(batch.type);
+        w.put(toEpochMicros(batch.time));
+        w.put(batch.seq);
+        w.put(batch.payload);
+
+        const auto len = static_cast<std::uint32_t>(out.size() - start - kRelayHeaderSize);
+        for (std::size_t i = 0; i < kRelayHeaderSize; ++i)
+            out[start + i] = static_cast<char>((len >> (8 * i)) & 0xFF);
+    }
+
+    /* 读取帧头中的长度，data 至少有 kRelayHeaderSize 字节 */
+    inline std::uint32_t relayFrameLength(const char* data)
+    {
+        std::uint32_t len = 0;
+        for (std::size_t i = 0; i < kRelayHeaderSize; ++i)
+            len |= static_cast<std::uint32_t>(static_cast<unsigned char>(data[i])) << (8 * i);
+        return len;
+    }
+
+    /* 解码帧体，格式错误抛出 RecoverableError */
+    inline void decodeRelayFrame(const char* body, std::size_t len, MetricBatch& batch)
+    {
+        BinaryReader r(body, len);
+        std::uint8_t version = 0;
+        r.get(version);
+        if (version < 1 || version > kRelayVersion)throw RecoverableError("[Relay] Unsupported frame version " + std::to_string(version));
+        r.get(batch.node);
+        r.get(batch.type);
+        if (version >= 3)
+        {
+            std::int64_t us = 0;
+            r.get(us);
+            batch.time = fromEpochMicros(us);
+        }
+        else
+        {
+            std::string text;
+            r.get(text);
+            if (!parseLocalTime(text, batch.time))throw RecoverableError("[Relay] Invalid timestamp \"" + text + "\"");
+        }
+        batch.seq = 0;
+        if (version >= 2)r.get(batch.seq);
+        r.get(batch.payload);
+    }
+
+    /* 解析 "host:port"，缺省 host 时返回 defaultHost */
+    inline bool parseHostPort(const std::string& s, const std::string& defaultHost, std::string& host, int& port)
+    {
+        auto pos = s.rfind(':');
+        std::string portStr = (pos == std::string::npos) ? s : s.substr(pos + 1);
+        host = (pos == std::string::npos || pos == 0) ? defaultHost : s.substr(0, pos);
+        try {
+            port = std::stoi(portStr);
+        } catch (...) {
+            return false;
+        }
+        return port > 0 && port < 65536;
+    }
+}
@@ -0,0 +1,198 @@
+#ifdef __linux__
+
+#include "RelayServer.hpp"
+#include "RelayProtocol.hpp"
+#include "Collector/Common/Exception.hpp"
+
+#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <arpa/inet.h>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace hwgauge
+{
+    namespace
+    {
+        // 每次唤醒每个连接最多读取的字节数：持续写满的子节点不会饿死其他连接，剩余数据留到下一轮 poll
+        constexpr std::size_t kReadBudget = 1u << 20;
+        // 未解析数据的上限：最多一个不完整的帧加一次读取的量，超过说明对端异常，断开连接
+        constexpr std::size_t kMaxBuffered = kRelayHeaderSize + kRelayMaxFrame + kReadBudget;
+    }
+
+    RelayServer::RelayServer(const std::string& listen, Handler handler)
+        : handler_(std::move(handler)), listenFd_(-1), wakeFd_{ -1, -1 }, running_(false)
+    {
+        std::string host;
+        int port = 0;
+        // 只给端口时只监听本机：协议没有认证，接收其他节点需显式指定 0.0.0.0 或网卡地址
+        if (!parseHostPort(listen, "127.0.0.1", host, port))
+            throw FatalError("[RelayServer] Invalid listen address " + listen);
+
+        addrinfo hints{};
+        hints.ai_family = AF_UNSPEC;
+        hints.ai_socktype = SOCK_STREAM;
+        hints.ai_flags = AI_PASSIVE;
+        addrinfo* res = nullptr;
+        const std::string portStr = std::to_string(port);
+        if (::getaddrinfo(host.c_str(), portStr.c_str(), &hints, &res) != 0 || res == nullptr)
+            throw FatalError("[RelayServer] Failed to resolve listen address " + listen);
+
+        listenFd_ = ::socket(res->ai_family, res->ai_socktype | SOCK_CLOEXEC | SOCK_NONBLOCK, res->ai_protocol);
+        int one = 1;
+        if (listenFd_ >= 0)::setsockopt(listenFd_, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        bool ok = listenFd_ >= 0
+            && ::bind(listenFd_, res->ai_addr, res->ai_addrlen) == 0
+            && ::listen(listenFd_, SOMAXCONN) == 0;
+        ::freeaddrinfo(res);
+        if (!ok)
+        {
+            std::string err = std::strerror(errno);
+            if (listenFd_ >= 0)::close(listenFd_);
+            throw FatalError("[RelayServer] Failed to listen on " + listen + ": " + err);
+        }
+
+        if (::pipe2(wakeFd_, O_CLOEXEC | O_NONBLOCK) != 0)
+        {
+            ::close(listenFd_);
+            throw FatalError("[RelayServer] Failed to create wake pipe");
+        }
+
+        running_.store(true, std::memory_order_release);
+        worker_ = std::thread(&RelayServer::loop, this);
+        spdlog::info("[RelayServer] Listening on {}:{}", host, port);
+    }
+
+    RelayServer::~RelayServer()
+    {
+        running_.store(false, std::memory_order_release);
+        char c = 0;
+        (void)!::write(wakeFd_[1], &c, 1);
+        if (worker_.joinable())worker_.join();
+
+        for (auto& client : clients_)::close(client.fd);
+        ::close(listenFd_);
+        ::close(wakeFd_[0]);
+        ::close(wakeFd_[1]);
+    }
+
+    void RelayServer::loop()
+    {
+        std::vector<pollfd> fds;
+        while (running_.load(std::memory_order_acquire))
+        {
+            fds.clear();
+            fds.push_back({ listenFd_, POLLIN, 0 });
+            fds.push_back({ wakeFd_[0], POLLIN, 0 });
+            for (const auto& client : clients_)fds.push_back({ client.fd, POLLIN, 0 });
+
+            int n = ::poll(fds.data(), fds.size(), -1);
+            if (n < 0)
+            {
+                if (errno == EINTR)continue;
+                spdlog::error("[RelayServer] poll failed: {}", std::strerror(errno));
+                break;
+            }
+
+            // clients_ 与 fds[2..] 一一对应，倒序处理便于删除
+            for (size_t i = clients_.size(); i-- > 0;)
+            {
+                if (!fds[i + 2].revents)continue;
+                if (!readClient(clients_[i]))
+                {
+                    spdlog::info("[RelayServer] Child {} disconnected", clients_[i].peer);
+                    ::close(clients_[i].fd);
+                    clients_.erase(clients_.begin() + static_cast<std::ptrdiff_t>(i));
+                }
+            }
+            if (fds[0].revents & POLLIN)acceptClients();
+        }
+    }
+
+    void RelayServer::acceptClients()
+    {
+        while (true)
+        {
+            sockaddr_storage addr{};
+            socklen_t len = sizeof(addr);
+            int fd = ::accept4(listenFd_, reinterpret_cast<sockaddr*>(&addr), &len, SOCK_CLOEXEC | SOCK_NONBLOCK);
+            if (fd < 0)
+            {
+                if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+                    spdlog::warn("[RelayServer] accept failed: {}", std::strerror(errno));
+                return;
+            }
+
+            char host[NI_MAXHOST] = { 0 };
+            char serv[NI_MAXSERV] = { 0 };
+            ::getnameinfo(reinterpret_cast<sockaddr*>(&addr), len, host, sizeof(host), serv, sizeof(serv), NI_NUMERICHOST | NI_NUMERICSERV);
+            std::string peer = std::string(host) + ":" + serv;
+            spdlog::info("[RelayServer] Child {} connected", peer);
+            clients_.push_back({ fd, std::move(peer), {} });
+        }
+    }
+
+    bool RelayServer::readClient(Client& client)
+    {
+        char chunk[64 * 1024];
+        bool open = true;
+        std::size_t budget = kReadBudget;
+        while (budget > 0)
+        {
+            ssize_t n = ::recv(client.fd, chunk, std::min(sizeof(chunk), budget), 0);
+            if (n > 0)
+            {
+                client.buf.append(chunk, static_cast<size_t>(n));
+                budget -= static_cast<size_t>(n);
+                continue;
+            }
+            if (n < 0 && errno == EINTR)continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))break;
+            // 对端关闭或出错：子节点退出前发出的最后几帧与关闭在同一次读取中到达，先解析完再断开
+            open = false;
+            break;
+        }
+
+        // 解析所有完整的帧
+        size_t pos = 0;
+        MetricBatch batch;
+        while (client.buf.size() - pos >= kRelayHeaderSize)
+        {
+            std::uint32_t len = relayFrameLength(client.buf.data() + pos);
+            if (len > kRelayMaxFrame)
+            {
+                spdlog::warn("[RelayServer] Frame of {} bytes from {} exceeds limit", len, client.peer);
+                return false;
+            }
+            if (client.buf.size() - pos - kRelayHeaderSize < len)break;
+
+            try
+            {
+                decodeRelayFrame(client.buf.data() + pos + kRelayHeaderSize, len, batch);
+                handler_(std::move(batch));
+            }
+            catch (const RecoverableError& e)
+            {
+                spdlog::warn("[RelayServer] Bad frame from {}: {}", client.peer, e.what());
+            }
+            pos += kRelayHeaderSize + len;
+        }
+        client.buf.erase(0, pos);
+        if (client.buf.size() > kMaxBuffered)
+        {
+            spdlog::warn("[RelayServer] {} buffered {} bytes without a complete frame", client.peer, client.buf.size());
+            return false;
+        }
+        if (!open && !client.buf.empty())
+            spdlog::warn("[RelayServer] Child {} closed with a partial frame ({} bytes dropped)", client.peer, client.buf.size());
+        return open;
+    }
+}
+
+#endif
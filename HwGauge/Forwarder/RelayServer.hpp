@@ -0,0 +1,48 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "Forwarder/BatchSink.hpp"
+
+#include <atomic>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace hwgauge
+{
+    /* 机架级 relay 的接收端：单线程 poll 所有子节点连接，按帧解码后交给回调 */
+    class RelayServer
+    {
+    public:
+        using Handler = std::function<void(MetricBatch&&)>;
+
+        RelayServer(const std::string& listen, Handler handler);
+        ~RelayServer();
+
+        RelayServer(const RelayServer&) = delete;
+        RelayServer& operator=(const RelayServer&) = delete;
+
+    private:
+        struct Client
+        {
+            int fd;
+            std::string peer;
+            std::string buf;    // 未解析完的数据
+        };
+
+        void loop();
+        void acceptClients();
+        bool readClient(Client& client);
+
+        Handler handler_;
+        int listenFd_;
+        int wakeFd_[2];         // 析构时唤醒 poll
+        std::atomic<bool> running_;
+        std::vector<Client> clients_;
+        std::thread worker_;
+    };
+}
+
+#endif
@@ -0,0 +1,31 @@
+#include "Rollup.hpp"
+
+#include "Collector/CPUCollector/CPUMetrics.hpp"
+#include "Collector/CPUCollector/CPUCoreMetrics.hpp"
+#include "Collector/GPUCollector/GPUMetrics.hpp"
+#include "Collector/NPUCollector/NPUMetrics.hpp"
+#include "Collector/DerivedCollector/DerivedMetrics.hpp"
+#ifdef __linux__
+#include "Collector/SYSCollector/SYSMetrics.hpp"
+#include "Collector/HwmonCollector/HwmonMetrics.hpp"
+#include "Collector/PerfCollector/PerfMetrics.hpp"
+#endif
+
+namespace hwgauge
+{
+    std::unique_ptr<Rollup> makeRollup(const std::string& type)
+    {
+        if (type == "cpu")return std::make_unique<AverageRollup<CPULabel, CPUMetrics>>();
+        if (type == "cpu_core")return std::make_unique<AverageRollup<CPUCoreLabel, CPUCoreMetrics>>();
+        if (type == "gpu")return std::make_unique<AverageRollup<GPULabel, GPUMetrics>>();
+        if (type == "npu")return std::make_unique<AverageRollup<NPULabel, NPUMetrics>>();
+        if (type == "derived")return std::make_unique<AverageRollup<DerivedLabel, DerivedMetrics>>();
+#ifdef __linux__
+        if (type == "sys")return std::make_unique<AverageRollup<SYSLabel, SYSMetrics>>();
+        if (type == "hwmon")return std::make_unique<AverageRollup<HwmonLabel, HwmonMetrics>>();
+        if (type == "perf")return std::make_unique<AverageRollup<PerfLabel, PerfMetrics>>();
+#endif
+        // gpu_samples 等原始子样本、gpu_process 等以进程为行的数据不做汇总，原样转发
+        return nullptr;
+    }
+}
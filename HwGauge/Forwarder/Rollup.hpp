@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Collector/Common/Codec.hpp"
+#include "Forwarder/BatchSink.hpp"
+
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace hwgauge
+{
+    /* 单个 (节点, 采集器) 在一个转发周期内的汇总 */
+    class Rollup
+    {
+    public:
+        virtual ~Rollup() = default;
+
+        // 累加一批数据，解码失败抛出 RecoverableError
+        virtual void add(const MetricBatch& batch) = 0;
+
+        // 输出周期内的汇总结果并清空，周期内没有数据时返回 false
+        virtual bool flush(MetricBatch& out) = 0;
+    };
+
+    /* 数值字段在周期内的合并方式 */
+    enum class RollupOp { Average, Min, Max, Last };
+
+    inline RollupOp rollupOp(FieldKind kind)
+    {
+        switch (kind)
+        {
+        case FieldKind::Counter: return RollupOp::Last;
+        case FieldKind::Min: return RollupOp::Min;
+        case FieldKind::Max:
+        case FieldKind::Percentile:
+        case FieldKind::Status: return RollupOp::Max;
+        default: return RollupOp::Average;
+        }
+    }
+
+    /**
+     * 按设备对数值字段求周期平均（-1 表示不可用，不参与平均），
+     * 极值字段取周期内的最小 / 最大值，分位数与状态码取最大值，
+     * 累计值字段、其余字段 (字符串/布尔) 以及 labels 取周期内最后一次的值
+     */
+    template<typename LabelT, typename MetricT>
+    class AverageRollup : public Rollup
+    {
+    public:
+        void add(const MetricBatch& batch) override
+        {
+            decodePayload(batch.payload, labels, metrics);
+
+            // 设备集合变化时丢弃之前的累加值
+            if (metrics.size() != sums.size())
+            {
+                sums.assign(metrics.size(), {});
+                counts.assign(metrics.size(), {});
+            }
+            for (size_t i = 0; i < metrics.size(); ++i)
+            {
+                auto& sum = sums[i];
+                auto& count = counts[i];
+                size_t k = 0;
+                Fields<MetricT>::visit(metrics[i], [&](const char*, const auto& field, auto... kind) {
+                    using F = std::decay_t<decltype(field)>;
+                    if constexpr (std::is_arithmetic_v<F> && !std::is_same_v<F, bool>)
+                    {
+                        if (sum.size() <= k) { sum.resize(k + 1, 0.0); count.resize(k + 1, 0); }
+                        double value = static_cast<double>(field);
+                        RollupOp op = rollupOp(fieldKind(kind...));
+                        if (value != -1.0 && op != RollupOp::Last)
+                        {
+                            if (op == RollupOp::Average)sum[k] += value;
+                            else if (count[k] == 0 || (op == RollupOp::Min ? value < sum[k] : value > sum[k]))sum[k] = value;
+                            ++count[k];
+                        }
+                        ++k;
+                    }
+                });
+            }
+            node = batch.node;
+            type = batch.type;
+            time = batch.time;
+            ++samples;
+        }
+
+        bool flush(MetricBatch& out) override
+        {
+            if (samples == 0)return false;
+
+            for (size_t i = 0; i < metrics.size(); ++i)
+            {
+                auto& sum = sums[i];
+                auto& count = counts[i];
+                size_t k = 0;
+                Fields<MetricT>::visit(metrics[i], [&](const char*, auto& field, auto... kind) {
+                    using F = std::decay_t<decltype(field)>;
+                    if constexpr (std::is_arithmetic_v<F> && !std::is_same_v<F, bool>)
+                    {
+                        if (count[k] > 0)field = static_cast<F>(rollupOp(fieldKind(kind...)) == RollupOp::Average ? sum[k] / count[k] : sum[k]);
+                        sum[k] = 0.0;
+                        count[k] = 0;
+                        ++k;
+                    }
+                });
+            }
+
+            out.node = node;
+            out.type = type;
+            out.time = time;
+            encodePayload(out.payload, labels, metrics);
+            samples = 0;
+            return true;
+        }
+
+    private:
+        std::string node;
+        std::string type;
+        TimePoint time;
+        size_t samples = 0;
+        std::vector<LabelT> labels;
+        std::vector<MetricT> metrics;                       // 最后一次的数据
+        std::vector<std::vector<double>> sums;              // [设备][数值字段]，极值与状态码字段保存当前极值
+        std::vector<std::vector<unsigned>> counts;
+    };
+
+    /* 按采集器名称创建汇总器，未知类型返回空指针（原样转发） */
+    std::unique_ptr<Rollup> makeRollup(const std::string& type);
+}
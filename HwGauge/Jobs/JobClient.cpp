@@ -0,0 +1,40 @@
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+
+#include "JobClient.hpp"
+#include "JobTracker.hpp"
+
+#include "httplib.h"
+#include "nlohmann/json.hpp"
+#include "spdlog/spdlog.h"
+#include <iostream>
+
+namespace hwgauge
+{
+    int runJobCommand(const std::string& host, int port, const std::string& action, const std::string& id)
+    {
+        if (!JobTracker::validId(id))
+        {
+            spdlog::error("[JobClient] Invalid job id \"{}\" (allowed: letters, digits and _.:-)", id);
+            return EXIT_FAILURE;
+        }
+
+        httplib::Client client(host, port);
+        client.set_connection_timeout(2);
+        client.set_read_timeout(5);
+
+        const std::string path = "/api/jobs/" + id;
+        auto res = action == "show" ? client.Get(path) : client.Post(path + "/" + action);
+        if (!res)
+        {
+            spdlog::error("[JobClient] Cannot reach HwGauge at {}:{} (is it running with --http-enable?)", host, port);
+            return EXIT_FAILURE;
+        }
+
+        // 服务端总是返回 JSON，格式化后输出
+        auto body = nlohmann::json::parse(res->body, nullptr, false);
+        std::cout << (body.is_discarded() ? res->body : body.dump(2)) << std::endl;
+        return res->status == 200 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
+}
+
+#endif
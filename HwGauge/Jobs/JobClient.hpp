@@ -0,0 +1,15 @@
+#pragma once
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+
+#include <string>
+
+namespace hwgauge
+{
+    /**
+     * `hwgauge job <start|stop|show> <id>` 命令行：
+     * 通过本机 HTTP 接口向正在运行的 HwGauge 发送作业标记并打印报告，返回进程退出码
+     */
+    int runJobCommand(const std::string& host, int port, const std::string& action, const std::string& id);
+}
+
+#endif
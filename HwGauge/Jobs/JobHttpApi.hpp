@@ -0,0 +1,95 @@
+#pragma once
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+
+#include "Collector/Base/HttpApi.hpp"
+#include "Jobs/JobTracker.hpp"
+
+#include <memory>
+#include <string>
+
+namespace hwgauge
+{
+    inline void to_json(nlohmann::json& j, const JobDeviceReport& d) {
+        j = nlohmann::json{
+            {"device", d.device},
+            {"energyJoules", d.energyJoules},
+            {"avgWatts", d.avgWatts},
+            {"peakWatts", d.peakWatts},
+            {"avgUtilization", d.avgUtilization}
+        };
+    }
+
+    inline void to_json(nlohmann::json& j, const JobReport& r) {
+        j = nlohmann::json{
+            {"id", r.id},
+            {"running", r.running},
+            {"startTime", r.startTime},
+            {"stopTime", r.stopTime},
+            {"durationSeconds", r.durationSeconds},
+            {"totalEnergyJoules", r.totalEnergyJoules},
+            {"devices", r.devices}
+        };
+    }
+
+    /**
+     * 作业能耗接口
+     *   POST /api/jobs/<id>/start   开始作业
+     *   POST /api/jobs/<id>/stop    结束作业，返回报告
+     *   GET  /api/jobs/<id>         查询报告（运行中的作业统计到当前时刻）
+     */
+    class JobHttpApi
+    {
+    public:
+        JobHttpApi(std::shared_ptr<LocalHttpServer> server, std::shared_ptr<JobTracker> tracker)
+            : server_(std::move(server)), tracker_(std::move(tracker))
+        {}
+
+        void init()
+        {
+            if (!server_ || !tracker_) return;
+            auto& srv = server_->get_server();
+
+            srv.Post(R"(/api/jobs/([^/]+)/(start|stop))", [this](const httplib::Request& req, httplib::Response& res) {
+                const std::string id = req.matches[1];
+                const std::string action = req.matches[2];
+                if (!JobTracker::validId(id)) return reply(res, 400, error("invalid job id"));
+
+                JobResult result = action == "start" ? tracker_->start(id) : tracker_->stop(id);
+                if (result == JobResult::NotFound) return reply(res, 404, error("job not found"));
+                if (result == JobResult::Conflict)
+                    return reply(res, 409, error(action == "start" ? "job is already running" : "job is not running"));
+                if (result == JobResult::TooMany) return reply(res, 429, error("too many running jobs"));
+                sendReport(res, id);
+            });
+
+            srv.Get(R"(/api/jobs/([^/]+))", [this](const httplib::Request& req, httplib::Response& res) {
+                const std::string id = req.matches[1];
+                if (!JobTracker::validId(id)) return reply(res, 400, error("invalid job id"));
+                sendReport(res, id);
+            });
+            spdlog::info("Registered HTTP endpoint: /api/jobs");
+        }
+
+    private:
+        static nlohmann::json error(const std::string& message) { return nlohmann::json{{"error", message}}; }
+
+        static void reply(httplib::Response& res, int status, const nlohmann::json& body)
+        {
+            res.status = status;
+            res.set_content(body.dump(), "application/json");
+            res.set_header("Access-Control-Allow-Origin", "*");
+        }
+
+        void sendReport(httplib::Response& res, const std::string& id)
+        {
+            JobReport report;
+            if (tracker_->report(id, report) != JobResult::Ok) return reply(res, 404, error("job not found"));
+            reply(res, 200, report);
+        }
+
+        std::shared_ptr<LocalHttpServer> server_;
+        std::shared_ptr<JobTracker> tracker_;
+    };
+}
+
+#endif
@@ -0,0 +1,186 @@
+#include "JobTracker.hpp"
+#include "Collector/Common/Log.hpp"
+
+#include "spdlog/spdlog.h"
+
+#include <algorithm>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+namespace hwgauge
+{
+    JobTracker::JobTracker(std::size_t maxFinished, std::size_t maxRunning)
+        : maxFinished_(maxFinished), maxRunning_(maxRunning)
+    {}
+
+    bool JobTracker::validId(const std::string& id)
+    {
+        if (id.empty() || id.size() > 128)return false;
+        return std::all_of(id.begin(), id.end(), [](char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ||
+                   c == '_' || c == '.' || c == ':' || c == '-';
+        });
+    }
+
+    double JobTracker::energyAt(const DeviceState& state, SteadyClock::time_point t)
+    {
+        if (state.energyJoules < 0.0)return -1.0;
+        double extra = 0.0;
+        if (state.powerWatts > 0.0 && t > state.time)
+            extra = state.powerWatts * std::chrono::duration<double>(t - state.time).count();
+        return state.energyJoules + extra;
+    }
+
+    std::string JobTracker::formatTime(SystemClock::time_point t)
+    {
+        // 与采集时间戳格式一致
+        std::time_t tt = SystemClock::to_time_t(t);
+        std::tm tm = *std::localtime(&tt);
+        auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(t.time_since_epoch()) % 1000;
+        std::ostringstream ss;
+        ss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S") << '.' << std::setw(3) << std::setfill('0') << ms.count();
+        return ss.str();
+    }
+
+    void JobTracker::record(const std::vector<JobSample>& samples)
+    {
+        if (samples.empty())return;
+        auto now = SteadyClock::now();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (const auto& sample : samples)
+        {
+            auto& state = latest_[sample.device];
+            // 能耗暂时不可用时保留上一次的计数器，外推也随之停止
+            if (sample.energyJoules >= 0.0)
+            {
+                state.energyJoules = sample.energyJoules;
+                state.powerWatts = sample.powerWatts;
+                state.time = now;
+            }
+
+            for (auto& [id, job] : jobs_)
+            {
+                if (!job.running)continue;
+                auto& window = job.devices[sample.device];
+                // 作业开始后才出现的设备，从第一次采样开始计算
+                if (window.startEnergy < 0.0)window.startEnergy = sample.energyJoules;
+                if (sample.powerWatts >= 0.0)window.peakWatts = std::max(window.peakWatts, sample.powerWatts);
+                if (sample.utilization >= 0.0)
+                {
+                    window.utilSum += sample.utilization;
+                    ++window.utilCount;
+                }
+            }
+        }
+    }
+
+    JobResult JobTracker::start(const std::string& id)
+    {
+        auto now = SteadyClock::now();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = jobs_.find(id);
+        if (it != jobs_.end() && it->second.running)return JobResult::Conflict;
+        if (running_ >= maxRunning_)
+        {
+            HWGAUGE_WARN_LIMITED("[JobTracker] Rejected job {}: {} jobs already running", id, running_);
+            return JobResult::TooMany;
+        }
+        if (it != jobs_.end())
+        {
+            finished_.erase(std::remove(finished_.begin(), finished_.end(), id), finished_.end());
+            jobs_.erase(it);
+        }
+
+        Job job;
+        job.start = now;
+        job.startWall = SystemClock::now();
+        for (const auto& [device, state] : latest_)
+            job.devices[device].startEnergy = energyAt(state, now);
+        jobs_.emplace(id, std::move(job));
+        ++running_;
+
+        spdlog::info("[JobTracker] Job {} started ({} devices)", id, latest_.size());
+        return JobResult::Ok;
+    }
+
+    JobResult JobTracker::stop(const std::string& id)
+    {
+        auto now = SteadyClock::now();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = jobs_.find(id);
+        if (it == jobs_.end())return JobResult::NotFound;
+        Job& job = it->second;
+        if (!job.running)return JobResult::Conflict;
+
+        for (auto& [device, window] : job.devices)
+        {
+            auto state = latest_.find(device);
+            if (state != latest_.end())window.stopEnergy = energyAt(state->second, now);
+        }
+        job.running = false;
+        --running_;
+        job.stop = now;
+        job.stopWall = SystemClock::now();
+        finished_.push_back(id);
+        evictFinished();
+
+        spdlog::info("[JobTracker] Job {} stopped after {:.1f}s", id, std::chrono::duration<double>(now - job.start).count());
+        return JobResult::Ok;
+    }
+
+    void JobTracker::evictFinished()
+    {
+        while (finished_.size() > maxFinished_)
+        {
+            jobs_.erase(finished_.front());
+            finished_.pop_front();
+        }
+    }
+
+    JobResult JobTracker::report(const std::string& id, JobReport& out) const
+    {
+        auto now = SteadyClock::now();
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        auto it = jobs_.find(id);
+        if (it == jobs_.end())return JobResult::NotFound;
+        const Job& job = it->second;
+
+        auto end = job.running ? now : job.stop;
+        double duration = std::chrono::duration<double>(end - job.start).count();
+
+        out.id = id;
+        out.running = job.running;
+        out.startTime = formatTime(job.startWall);
+        out.stopTime = job.running ? std::string() : formatTime(job.stopWall);
+        out.durationSeconds = duration;
+        out.totalEnergyJoules = 0.0;
+        out.devices.clear();
+        out.devices.reserve(job.devices.size());
+
+        for (const auto& [device, window] : job.devices)
+        {
+            double stopEnergy = window.stopEnergy;
+            if (job.running)
+            {
+                auto state = latest_.find(device);
+                stopEnergy = state != latest_.end() ? energyAt(state->second, now) : -1.0;
+            }
+
+            JobDeviceReport d;
+            d.device = device;
+            d.energyJoules = (window.startEnergy >= 0.0 && stopEnergy >= window.startEnergy)
+                ? stopEnergy - window.startEnergy : -1.0;
+            d.avgWatts = (d.energyJoules >= 0.0 && duration > 0.0) ? d.energyJoules / duration : -1.0;
+            d.peakWatts = window.peakWatts;
+            d.avgUtilization = window.utilCount > 0 ? window.utilSum / window.utilCount : -1.0;
+            if (d.energyJoules > 0.0)out.totalEnergyJoules += d.energyJoules;
+            out.devices.push_back(std::move(d));
+        }
+        return JobResult::Ok;
+    }
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /* 单个设备在一轮采集中提供给作业统计的数据，不可用的值为 -1 */
+    struct JobSample
+    {
+        std::string device;    // 设备标识，例如 "cpu0" / "gpu1" / "npu0-1"
+        double energyJoules;   // 累计能耗 (J)
+        double powerWatts;     // 当前功耗 (W)
+        double utilization;    // 利用率 (%)
+    };
+
+    /* 作业窗口内单个设备的统计结果，不可用的值为 -1 */
+    struct JobDeviceReport
+    {
+        std::string device;
+        double energyJoules;
+        double avgWatts;
+        double peakWatts;
+        double avgUtilization;
+    };
+
+    struct JobReport
+    {
+        std::string id;
+        bool running;
+        std::string startTime;
+        std::string stopTime;          // 运行中为空
+        double durationSeconds;
+        double totalEnergyJoules;      // 各设备能耗之和
+        std::vector<JobDeviceReport> devices;
+    };
+
+    enum class JobResult
+    {
+        Ok,
+        NotFound,     // 作业不存在
+        Conflict,     // 作业已在运行 / 已经结束
+        TooMany       // 运行中的作业已达上限
+    };
+
+    /**
+     * 作业能耗统计
+     * 采集线程每轮把各设备的累计能耗、功耗、利用率交给 record()；
+     * start/stop 时记录每个设备的能耗计数器（按最近一次的功耗外推到标记时刻），
+     * 窗口内的峰值功耗与平均利用率在 record() 中在线累加，不保存历史序列，也不查询数据库。
+     */
+    class JobTracker
+    {
+    public:
+        // maxFinished: 保留的已结束作业数量，超出时淘汰最早结束的
+        // maxRunning: 同时运行的作业上限，record() 每轮遍历所有运行中的作业，接口又无需认证，不能无限增长
+        explicit JobTracker(std::size_t maxFinished = 1024, std::size_t maxRunning = 256);
+
+        JobTracker(const JobTracker&) = delete;
+        JobTracker& operator=(const JobTracker&) = delete;
+
+        // 采集线程调用，每个采集器每轮一次
+        void record(const std::vector<JobSample>& samples);
+
+        // HTTP 线程调用；已结束的作业可以用同一 ID 重新开始
+        JobResult start(const std::string& id);
+        JobResult stop(const std::string& id);
+        JobResult report(const std::string& id, JobReport& out) const;
+
+        // 作业 ID 只允许字母、数字以及 "_.:-"，便于作为 URL 路径
+        static bool validId(const std::string& id);
+
+    private:
+        using SteadyClock = std::chrono::steady_clock;
+        using SystemClock = std::chrono::system_clock;
+
+        struct DeviceState
+        {
+            double energyJoules = -1.0;
+            double powerWatts = -1.0;
+            SteadyClock::time_point time;
+        };
+
+        struct DeviceWindow
+        {
+            double startEnergy = -1.0;
+            double stopEnergy = -1.0;
+            double peakWatts = -1.0;
+            double utilSum = 0.0;
+            unsigned utilCount = 0;
+        };
+
+        struct Job
+        {
+            bool running = true;
+            SteadyClock::time_point start;
+            SteadyClock::time_point stop;
+            SystemClock::time_point startWall;
+            SystemClock::time_point stopWall;
+            std::map<std::string, DeviceWindow> devices;
+        };
+
+        // 按最近一次功耗把累计能耗外推到时刻 t
+        static double energyAt(const DeviceState& state, SteadyClock::time_point t);
+        static std::string formatTime(SystemClock::time_point t);
+        void evictFinished();
+
+        std::size_t maxFinished_;
+        std::size_t maxRunning_;
+        std::size_t running_ = 0;
+        mutable std::mutex mutex_;
+        std::map<std::string, DeviceState> latest_;
+        std::map<std::string, Job> jobs_;
+        std::deque<std::string> finished_;     // 结束顺序，用于淘汰
+    };
+}
@@ -0,0 +1,218 @@
+#pragma once
+
+#include "Replay.hpp"
+#include "Collector/Base/DeviceCollector.hpp"
+#include "Collector/Common/CsvReader.hpp"
+#include "Collector/Common/Exception.hpp"
+#include "Collector/Common/Log.hpp"
+
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hwgauge
+{
+    /* 同一时间戳下一个采集器的所有设备 */
+    template<typename LabelT, typename MetricT>
+    struct ReplayFrame
+    {
+        std::string time;               // CSV 中的本地时间文本，相同的行属于同一帧
+        std::vector<LabelT> labels;
+        std::vector<MetricT> metrics;
+    };
+
+    /* 回放用的实现类：每次 sample 给出当前帧，名称与原采集器一致（批量数据类型、HTTP 路由不变） */
+    template<typename LabelT, typename MetricT>
+    class ReplayImpl
+    {
+    public:
+        ReplayImpl(std::string name_, std::shared_ptr<const ReplayFrame<LabelT, MetricT>> frame_)
+            : implName(std::move(name_)), frame(std::move(frame_)) {}
+
+        std::string name() { return implName; }
+        std::vector<LabelT> labels() { return frame->labels; }
+
+        // 设备数由 DeviceReplay 保证与首帧相同
+        void sample(std::vector<LabelT>& labels, std::vector<MetricT>& metrics)
+        {
+            for (std::size_t i = 0; i < labels.size(); i++)
+            {
+                labels[i] = frame->labels[i];
+                metrics[i] = frame->metrics[i];
+            }
+        }
+
+    private:
+        std::string implName;
+        std::shared_ptr<const ReplayFrame<LabelT, MetricT>> frame;
+    };
+
+    /**
+     * 读取 CsvT 写出的文件，按时间戳分帧回放。
+     * 每个启用的下游各用一个只开启该下游的 DeviceCollector，以便分别统计耗时。
+     */
+    template<typename LabelT, typename MetricT, typename CsvT, typename DbT, typename PromT, typename HttpT>
+    class DeviceReplay : public ReplaySource
+    {
+    public:
+        using Frame = ReplayFrame<LabelT, MetricT>;
+        using Impl = ReplayImpl<LabelT, MetricT>;
+        using CollectorT = DeviceCollector<LabelT, MetricT, Impl, DbT, CsvT, PromT, HttpT>;
+
+        // in 已经读过表头
+        DeviceReplay(std::string path_, std::ifstream in_, const std::string& name, const CollectorConfig& cfg)
+            : filePath(std::move(path_)), in(std::move(in_)), frame(std::make_shared<Frame>())
+        {
+            if (!readFrame(*frame))throw FatalError("[Replay] No rows in " + filePath);
+            devices = frame->labels.size();
+            hasFrame = parseLocalTime(frame->time, frameTime);
+            if (!hasFrame)throw FatalError("[Replay] Invalid timestamp \"" + frame->time + "\" in " + filePath);
+
+            CollectorConfig base = cfg;
+            base.outTer = false;
+            base.outFile = false;
+            base.batchSinks.clear();
+            base.jobTracker.reset();
+#ifdef HWGAUGE_USE_PROMETHEUS
+            base.pmEnable = false;
+#endif
+#ifdef HWGAUGE_USE_POSTGRESQL
+            base.dbEnable = false;
+#endif
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+            base.httpEnable = false;
+#endif
+
+            if (cfg.outFile) { CollectorConfig c = base; c.outFile = true; addSink("csv", c, name); }
+            if (!cfg.batchSinks.empty()) { CollectorConfig c = base; c.batchSinks = cfg.batchSinks; addSink("batch", c, name); }
+#ifdef HWGAUGE_USE_PROMETHEUS
+            if (cfg.pmEnable) { CollectorConfig c = base; c.pmEnable = true; addSink("prometheus", c, name); }
+#endif
+#ifdef HWGAUGE_USE_POSTGRESQL
+            if (cfg.dbEnable) { CollectorConfig c = base; c.dbEnable = true; addSink("postgresql", c, name); }
+#endif
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+            if (cfg.httpEnable) { CollectorConfig c = base; c.httpEnable = true; c.jobTracker = cfg.jobTracker; addSink("http", c, name); }
+#endif
+            // 没有启用任何下游时只测量解析与采集器本身
+            if (sinks.empty())addSink("none", base, name);
+        }
+
+        const std::string& path() const override { return filePath; }
+
+        bool peek(TimePoint& time) const override
+        {
+            time = frameTime;
+            return hasFrame;
+        }
+
+        void play() override
+        {
+            using clock = std::chrono::steady_clock;
+            // 帧序号作为轮次序号，被跳过的帧不占用序号
+            tick.seq++;
+            tick.time = frameTime;
+            for (std::size_t i = 0; i < sinks.size(); i++)
+            {
+                auto start = clock::now();
+                try
+                {
+                    sinks[i]->collect(tick);
+                }
+                catch (const RecoverableError& e)
+                {
+                    sinkStats[i].errors++;
+                    HWGAUGE_WARN_LIMITED("[Replay] {} sink failed: {}", sinkStats[i].sink, e.what());
+                }
+                sinkStats[i].add(devices, std::chrono::duration<double>(clock::now() - start).count());
+            }
+            advance();
+        }
+
+        std::vector<SinkStats>& stats() override { return sinkStats; }
+        std::uint64_t skippedRows() const override { return badRows; }
+        std::uint64_t skippedFrames() const override { return badFrames; }
+
+    private:
+        void addSink(const char* sink, const CollectorConfig& c, const std::string& name)
+        {
+            sinks.push_back(std::make_unique<CollectorT>(c, std::make_unique<Impl>(name, frame), false));
+            SinkStats s;
+            s.sink = sink;
+            sinkStats.push_back(std::move(s));
+        }
+
+        // 读取下一帧，跳过设备数与首帧不同的帧（采集器的设备列表在构造时固定）
+        void advance()
+        {
+            while ((hasFrame = readFrame(*frame)))
+            {
+                if (frame->labels.size() == devices && parseLocalTime(frame->time, frameTime))return;
+                badFrames++;
+                HWGAUGE_WARN_LIMITED("[Replay] Skip frame {} in {}: {} rows, expected {}", frame->time, filePath, frame->labels.size(), devices);
+            }
+        }
+
+        // 读一行到 pending；格式错误的行计数后跳过
+        bool readRow()
+        {
+            while (std::getline(in, line))
+            {
+                if (line.empty() || line == "\r")continue;
+                try
+                {
+                    CsvFieldReader r(line);
+                    r.get(pendingTime);
+                    CsvT::parseRow(r, pendingLabel, pendingMetric);
+                    r.finish();
+                    return true;
+                }
+                catch (const RecoverableError& e)
+                {
+                    badRows++;
+                    HWGAUGE_WARN_LIMITED("[Replay] Skip malformed row in {}: {}", filePath, e.what());
+                }
+            }
+            return false;
+        }
+
+        // 连续的同一时间戳的行组成一帧，读到下一帧的第一行时留在 pending 中
+        bool readFrame(Frame& f)
+        {
+            if (!hasPending && !readRow())return false;
+            f.time = pendingTime;
+            f.labels.clear();
+            f.metrics.clear();
+            do
+            {
+                f.labels.push_back(pendingLabel);
+                f.metrics.push_back(pendingMetric);
+                hasPending = readRow();
+            } while (hasPending && pendingTime == f.time);
+            return true;
+        }
+
+        std::string filePath;
+        std::ifstream in;
+        std::string line;
+
+        std::string pendingTime;
+        LabelT pendingLabel{};
+        MetricT pendingMetric{};
+        bool hasPending = false;
+
+        std::shared_ptr<Frame> frame;
+        Tick tick;
+        TimePoint frameTime;
+        bool hasFrame = false;
+        std::size_t devices = 0;
+
+        std::vector<std::unique_ptr<CollectorT>> sinks;
+        std::vector<SinkStats> sinkStats;
+        std::uint64_t badRows = 0;
+        std::uint64_t badFrames = 0;
+    };
+}
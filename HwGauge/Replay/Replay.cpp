@@ -0,0 +1,165 @@
+#include "Replay.hpp"
+#include "DeviceReplay.hpp"
+#include "Collector/Common/Exception.hpp"
+#include "Collector/Common/Log.hpp"
+
+#if defined(HWGAUGE_USE_INTEL_PCM) || defined(__linux__)
+#include "Collector/CPUCollector/CPUCollector.hpp"
+#endif
+#ifdef HWGAUGE_USE_NVML
+#include "Collector/GPUCollector/GPUCollector.hpp"
+#endif
+#ifdef HWGAUGE_USE_NPU
+#include "Collector/NPUCollector/NPUCollector.hpp"
+#endif
+#ifdef __linux__
+#include "Collector/SYSCollector/SYSCollector.hpp"
+#endif
+
+#include "spdlog/spdlog.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <thread>
+
+namespace hwgauge
+{
+    namespace
+    {
+        template<typename CsvT>
+        bool matches(const std::string& header)
+        {
+            return header == "Timestamp," + CsvT::header();
+        }
+
+        template<typename LabelT, typename MetricT, typename CsvT, typename DbT, typename PromT, typename HttpT>
+        std::unique_ptr<ReplaySource> make(const std::string& path, std::ifstream& in, const char* name, const CollectorConfig& cfg)
+        {
+            // 与 CsvLogger 的命名规则一致：metric.csv -> metric_gpu.csv
+            if (cfg.outFile)
+            {
+                std::filesystem::path out(cfg.filepath);
+                if (out.extension() != ".csv")out += ".csv";
+                out.replace_filename(out.stem().string() + "_" + name + ".csv");
+                std::error_code ec;
+                if (std::filesystem::equivalent(path, out, ec))
+                    throw FatalError("[Replay] CSV output " + out.string() + " is the file being replayed");
+            }
+            return std::make_unique<DeviceReplay<LabelT, MetricT, CsvT, DbT, PromT, HttpT>>(path, std::move(in), name, cfg);
+        }
+
+        void report(ReplaySource& source)
+        {
+            spdlog::info("[Replay] {}: {} malformed rows, {} frames with a different device count skipped",
+                source.path(), source.skippedRows(), source.skippedFrames());
+            for (auto& s : source.stats())
+            {
+                double rate = s.busySeconds > 0 ? s.rows / s.busySeconds : 0.0;
+                spdlog::info("[Replay]   {:<10} {} frames, {} rows, {} errors, {:.0f} rows/s sustained, latency p50 {:.0f} us, p99 {:.0f} us, max {:.0f} us",
+                    s.sink, s.frames, s.rows, s.errors, rate, s.percentile(0.5), s.percentile(0.99), s.percentile(1.0));
+            }
+        }
+    }
+
+    std::unique_ptr<ReplaySource> openReplay(const std::string& path, const CollectorConfig& cfg)
+    {
+        std::ifstream in(path);
+        if (!in.is_open())throw FatalError("[Replay] Failed to open " + path);
+
+        std::string header;
+        std::getline(in, header);
+        if (!header.empty() && header.back() == '\r')header.pop_back();
+
+#if defined(HWGAUGE_USE_INTEL_PCM) || defined(__linux__)
+        if (matches<CPUCsvLogger>(header))
+            return make<CPULabel, CPUMetrics, CPUCsvLogger, CPUDatabaseType, CPUPrometheusType, CPUHttpApiType>(path, in, "cpu", cfg);
+#endif
+#ifdef HWGAUGE_USE_NVML
+        if (matches<GPUCsvLogger>(header))
+            return make<GPULabel, GPUMetrics, GPUCsvLogger, GPUDatabaseType, GPUPrometheusType, GPUHttpApiType>(path, in, "gpu", cfg);
+#endif
+#ifdef HWGAUGE_USE_NPU
+        if (matches<NPUCsvLogger>(header))
+            return make<NPULabel, NPUMetrics, NPUCsvLogger, NPUDatabaseType, NPUPrometheusType, NPUHttpApiType>(path, in, "npu", cfg);
+#endif
+#ifdef __linux__
+        if (matches<SYSCsvLogger>(header))
+            return make<SYSLabel, SYSMetrics, SYSCsvLogger, SYSDatabaseType, SYSPrometheusType, SYSHttpApiType>(path, in, "sys", cfg);
+#endif
+        throw FatalError("[Replay] Unrecognized CSV header in " + path + " (supported: cpu, gpu, npu, sys loggers of this build)");
+    }
+
+    int runReplay(const ReplayConfig& config, const CollectorConfig& cfg, const std::atomic<bool>& stop)
+    {
+        using clock = std::chrono::steady_clock;
+
+        std::vector<std::unique_ptr<ReplaySource>> sources;
+        try
+        {
+            for (const auto& path : config.files)
+            {
+                sources.push_back(openReplay(path, cfg));
+                spdlog::info("[Replay] Opened {}", path);
+            }
+        }
+        catch (const FatalError& e)
+        {
+            spdlog::critical("Fatal error from: {}", e.what());
+            return EXIT_FAILURE;
+        }
+
+        // 记录时间 origin 对应回放开始时刻，倍速下按比例缩短间隔
+        TimePoint origin;
+        bool started = false;
+        for (auto& s : sources)
+        {
+            TimePoint t;
+            if (s->peek(t) && (!started || t < origin)) { origin = t; started = true; }
+        }
+
+        auto start = clock::now();
+        double maxLag = 0.0;
+        std::uint64_t frames = 0;
+        while (!stop.load(std::memory_order_relaxed))
+        {
+            // 多个文件按记录时间交错回放
+            ReplaySource* next = nullptr;
+            TimePoint nextTime;
+            for (auto& s : sources)
+            {
+                TimePoint t;
+                if (s->peek(t) && (!next || t < nextTime)) { next = s.get(); nextTime = t; }
+            }
+            if (!next)break;
+
+            if (config.speed > 0)
+            {
+                auto due = start + std::chrono::duration_cast<clock::duration>(
+                    std::chrono::duration<double>(nextTime - origin) / config.speed);
+                // 分段等待，以便及时响应 Ctrl+C
+                while (!stop.load(std::memory_order_relaxed) && clock::now() < due)
+                    std::this_thread::sleep_until(std::min(due, clock::now() + std::chrono::milliseconds(100)));
+                maxLag = std::max(maxLag, std::chrono::duration<double>(clock::now() - due).count());
+            }
+
+            try
+            {
+                next->play();
+            }
+            catch (const FatalError& e)
+            {
+                spdlog::critical("Fatal error from: {}", e.what());
+                return EXIT_FAILURE;
+            }
+            frames++;
+            flushLogStats();
+        }
+
+        double elapsed = std::chrono::duration<double>(clock::now() - start).count();
+        spdlog::info("[Replay] {} frames in {:.2f} s ({:.0f} frames/s){}", frames, elapsed, elapsed > 0 ? frames / elapsed : 0.0,
+            config.speed > 0 ? fmt::format(", max {:.1f} ms behind schedule", maxLag * 1e3) : std::string());
+        for (auto& s : sources)report(*s);
+        return 0;
+    }
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "Collector/Common/Config.hpp"
+#include "Collector/Common/Time.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /* 回放配置 */
+    struct ReplayConfig
+    {
+        std::vector<std::string> files;   // CsvLogger 写出的 *_cpu.csv / *_gpu.csv / *_npu.csv / *_sys.csv
+        double speed = 1.0;               // 1 为按记录的时间间隔实时回放，N 为 N 倍速，0 为不等待
+    };
+
+    /**
+     * 每帧耗时（微秒）的对数直方图：每个 2 的幂区间等分为 16 档，分位数的相对误差约 3%。
+     * 内存固定，长时间回放不随帧数增长；最大值单独记录，percentile(1) 是准确值
+     */
+    class LatencyHistogram
+    {
+    public:
+        void add(double us)
+        {
+            counts[bucket(us)]++;
+            total++;
+            maxUs = std::max(maxUs, us);
+        }
+
+        // 0~1 分位数，取所在档的中点，无数据时为 0
+        double percentile(double q) const
+        {
+            if (total == 0)return 0.0;
+            if (q >= 1.0)return maxUs;
+            std::uint64_t rank = static_cast<std::uint64_t>(std::max(q, 0.0) * static_cast<double>(total - 1));
+            std::uint64_t seen = 0;
+            for (std::size_t i = 0; i < counts.size(); i++)
+            {
+                seen += counts[i];
+                if (seen > rank)return std::min(midpoint(i), maxUs);
+            }
+            return maxUs;
+        }
+
+    private:
+        static constexpr int kSteps = 16;     // 每个 2 的幂区间的档数
+        static constexpr int kOctaves = 32;   // 1 us ~ 约 70 分钟，更大的值计入最后一档
+
+        // 第 0 档为 1 us 以下
+        static std::size_t bucket(double us)
+        {
+            if (!(us >= 1.0))return 0;
+            int exp = 0;
+            double m = std::frexp(us, &exp);   // us = m * 2^exp，m 在 [0.5, 1)
+            int octave = exp - 1;
+            if (octave >= kOctaves)return kSteps * kOctaves;
+            int step = std::min(static_cast<int>((m * 2.0 - 1.0) * kSteps), kSteps - 1);
+            return 1 + static_cast<std::size_t>(octave * kSteps + step);
+        }
+
+        static double midpoint(std::size_t i)
+        {
+            if (i == 0)return 0.5;
+            int octave = static_cast<int>((i - 1) / kSteps);
+            int step = static_cast<int>((i - 1) % kSteps);
+            return std::ldexp(1.0 + (step + 0.5) / kSteps, octave);
+        }
+
+        std::array<std::uint64_t, 1 + kSteps * kOctaves> counts{};
+        std::uint64_t total = 0;
+        double maxUs = 0.0;
+    };
+
+    /* 单个下游的回放统计 */
+    struct SinkStats
+    {
+        std::string sink;
+        std::uint64_t frames = 0;
+        std::uint64_t rows = 0;
+        std::uint64_t errors = 0;
+        double busySeconds = 0.0;         // 该下游处理所有帧的累计耗时
+        LatencyHistogram latencyUs;       // 每帧耗时
+
+        void add(std::size_t frameRows, double seconds)
+        {
+            frames++;
+            rows += frameRows;
+            busySeconds += seconds;
+            latencyUs.add(seconds * 1e6);
+        }
+
+        // 0~1 分位数（微秒），无数据时为 0
+        double percentile(double q) const { return latencyUs.percentile(q); }
+    };
+
+    /* 一个回放文件：按时间戳分帧，每帧依次送入各下游 */
+    class ReplaySource
+    {
+    public:
+        virtual ~ReplaySource() = default;
+
+        virtual const std::string& path() const = 0;
+        // 下一帧的记录时刻，文件读完时返回 false
+        virtual bool peek(TimePoint& time) const = 0;
+        // 把下一帧送入所有下游并读取下一帧
+        virtual void play() = 0;
+        virtual std::vector<SinkStats>& stats() = 0;
+        // 格式错误被跳过的行数与设备数和首帧不一致被跳过的帧数
+        virtual std::uint64_t skippedRows() const = 0;
+        virtual std::uint64_t skippedFrames() const = 0;
+    };
+
+    // 按表头识别文件类型并创建回放源，无法识别或读取失败时抛出 FatalError
+    std::unique_ptr<ReplaySource> openReplay(const std::string& path, const CollectorConfig& cfg);
+
+    // 回放所有文件直到结束或 stop 被置位，结束时输出各下游的吞吐与延迟，返回进程退出码
+    int runReplay(const ReplayConfig& config, const CollectorConfig& cfg, const std::atomic<bool>& stop);
+}
@@ -1,43 +1,63 @@
 #include "CLI/CLI.hpp"
 #include "spdlog/spdlog.h"
 #include <string>
-#include <csignal>
 #include <memory>
 #include <chrono>
 #include <atomic>
+#include <thread>
+#ifdef __linux__
+#include <unistd.h>
+#endif
 
 #include "Exposer/Exposer.hpp"
+#include "Exposer/StopSignal.hpp"
 #include "Collector/Common/Config.hpp"
+#include "Collector/Common/Log.hpp"
+#include "Replay/Replay.hpp"
+#include "Collector/DerivedCollector/DerivedCollector.hpp"
+#include "Alert/AlertCollector.hpp"
 
-#ifdef HWGAUGE_USE_INTEL_PCM
+#if defined(HWGAUGE_USE_INTEL_PCM) || defined(__linux__)
 #include "Collector/CPUCollector/CPUCollector.hpp"
+#include "Collector/CPUCollector/CPUCoreCollector.hpp"
 #endif
 
 #ifdef HWGAUGE_USE_NVML
 #include "Collector/GPUCollector/GPUCollector.hpp"
+#include "Collector/GPUProcessCollector/GPUProcessCollector.hpp"
+#include "Collector/GPUCollector/NVMLApi.hpp"
 #endif
 
 #ifdef HWGAUGE_USE_NPU
 #include "Collector/NPUCollector/NPUCollector.hpp"
+#include "Collector/NPUCollector/DCMIApi.hpp"
 #endif
 
 #ifdef __linux__
 #include "Collector/SYSCollector/SYSCollector.hpp"
+#include "Collector/HwmonCollector/HwmonCollector.hpp"
+#include "Collector/PerfCollector/PerfCollector.hpp"
+#include "Forwarder/RelayClient.hpp"
+#include "Forwarder/RelayCollector.hpp"
 #endif
 
 #ifdef HWGAUGE_USE_CLUSTER
 #include "Collector/ClusterCollector/ClusterCollector.hpp"
+#include "Forwarder/RedisStream.hpp"
+#endif
+
+#if defined(HWGAUGE_USE_CLUSTER) && defined(HWGAUGE_USE_POSTGRESQL)
+#include "Aggregator/Aggregator.hpp"
+#endif
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+#include "Jobs/JobClient.hpp"
+#include "Jobs/JobHttpApi.hpp"
 #endif
 
 std::unique_ptr<hwgauge::Exposer> exposer = nullptr;
 
 std::atomic<bool> g_stop_requested{false};
-static void signal_handler(int signal)
-{
-    if (signal == SIGINT) {
-        g_stop_requested.store(true, std::memory_order_relaxed);
-    }
-}
 
 int main(int argc, char* argv[])
 {
@@ -47,18 +67,30 @@ int main(int argc, char* argv[])
 	};
 	argv = application.ensure_utf8(argv);
 
-	// Initialize spdlog logger
-	spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] [tid %t] %v");
-	spdlog::set_level(spdlog::level::info); 
-	spdlog::info("Spdlog initialized successfully");
+	// Command-line arguments: logging
+	hwgauge::LogConfig log_config;
+	std::string log_level = "info";
+	long long log_repeat_window = log_config.repeatWindow.count();
+	application.add_option("--log-level", log_level, "Log level")->default_val("info")
+		->check(CLI::IsMember({"trace", "debug", "info", "warn", "error", "critical", "off"}));
+	application.add_option("--log-queue", log_config.queueSize, "Async log queue size; the oldest messages are dropped when full")
+		->default_val(log_config.queueSize)
+		->check(CLI::PositiveNumber);
+	application.add_option("--log-repeat-window", log_repeat_window, "Seconds to suppress repeated warnings and to sum success counters")
+		->default_val(log_repeat_window)
+		->check(CLI::PositiveNumber);
 
 	// Command-line arguments: interval
 	constexpr double default_interval = 5.0;
 	double interval_seconds = default_interval;
 
-	application.add_option("-i,--interval", interval_seconds, "Collection interval in seconds")
+	application.add_option("-i,--interval", interval_seconds, "Collection interval in seconds (>= 0.01)")
 		->default_val(default_interval)
-		->check(CLI::PositiveNumber);
+		->check(CLI::Range(0.01, 86400.0));
+	std::string overrun = "skip";
+	application.add_option("--overrun", overrun, "When a round takes longer than the interval: skip to the next slot, catch up back to back, or stretch the interval")
+		->default_val("skip")
+		->check(CLI::IsMember({"skip", "catchup", "stretch"}));
 
 	// Command-line arguments: address
 	constexpr char default_address[] = "127.0.0.1:8000";
@@ -69,7 +101,59 @@ int main(int argc, char* argv[])
 	bool sysInfo=false;
 	application.add_flag("--sysInfo", sysInfo, "Enable to out the system information");
 
+#ifdef __linux__
+	// Command-line arguments: hwmon
+	bool hwmonInfo=false;
+	application.add_flag("--hwmon", hwmonInfo, "Enable hwmon sensor metrics (temperatures, fans, voltages, currents, power)");
+	// Command-line arguments: perf
+	bool perfEvents=false;
+	application.add_flag("--perf", perfEvents, "Enable per-CPU perf_event counters (IPC, cache and branch misses, context switches); enabled automatically when PCM cannot run");
+#endif
+
+#if defined(HWGAUGE_USE_INTEL_PCM) || defined(__linux__)
+	// Command-line arguments: cpuCores
+	bool cpuCores=false;
+	application.add_flag("--cpu-cores", cpuCores, "Enable per-core CPU metrics (utilization, frequency, IPC, cache hit ratios, C-states)");
+#endif
+
+#if defined(HWGAUGE_USE_INTEL_PCM) && defined(__linux__)
+	// Command-line arguments: cpuSource
+	std::string cpuSource="auto";
+	application.add_option("--cpu-source", cpuSource, "CPU metric source: pcm (Intel PCM), proc (/proc/stat, cpufreq, powercap) or auto (pcm on Intel hosts)")
+		->default_val("auto")
+		->check(CLI::IsMember({"auto", "pcm", "proc"}));
+#endif
+
+	// Command-line arguments: replay
+	hwgauge::ReplayConfig replay_config;
+	application.add_option("--replay", replay_config.files, "Replay recorded CSV files (*_cpu/_gpu/_npu/_sys.csv) through the enabled sinks instead of sampling hardware")
+		->check(CLI::ExistingFile);
+	application.add_option("--replay-speed", replay_config.speed, "Replay speed: 1 = recorded intervals, N = N times faster, 0 = as fast as possible")
+		->default_val(1.0)
+		->check(CLI::NonNegativeNumber);
+
 	hwgauge::CollectorConfig cfg;
+#ifdef HWGAUGE_USE_NVML
+	// Command-line arguments: gpuRawSamples
+	application.add_flag("--gpu-raw-samples", cfg.rawSamples, "Forward raw sub-interval GPU power/utilization samples to the Redis Stream / relay sinks");
+	// Command-line arguments: gpuProcesses
+	bool gpuProcesses=false;
+	application.add_flag("--gpu-processes", gpuProcesses, "Enable per-process GPU metrics (compute processes, memory, utilization, container)");
+	application.add_option("--gpu-process-top", cfg.gpuProcessTopN, "Number of processes exported per GPU, ranked by memory used")
+		->default_val(5)
+		->check(CLI::Range(1, 64));
+#endif
+	// Command-line arguments: derive
+	application.add_option("--derive", cfg.derivedMetrics, "Derived metric evaluated every tick as name=expression over collector fields, e.g. gpu_share=gpu.powerUsage/sys.systemPowerWatts (repeatable)");
+
+	// Command-line arguments: alert
+	application.add_option("--alert", cfg.alertConfig.rules, "Alert rule as \"name: expression op threshold [for N|Ns] [clear value]\", e.g. \"gpu_hot: gpu.temperature > 85 for 3 clear 80\"; references without a function are checked per device (repeatable)");
+	application.add_option("--alert-file", cfg.alertConfig.file, "Append alert state changes to this file");
+#ifdef __linux__
+	application.add_option("--alert-exec", cfg.alertConfig.command, "Run this shell command on every alert state change (details in HWGAUGE_ALERT_* environment variables)");
+	application.add_option("--alert-webhook", cfg.alertConfig.webhook, "POST every alert state change as JSON to http://host:port/path");
+#endif
+
 	// Command-line arguments: outTer
 	application.add_flag("--outTer", cfg.outTer, "Enable to out the Collection Results to Terminal")->default_val(true);
 
@@ -77,6 +161,18 @@ int main(int argc, char* argv[])
 	application.add_flag("--outFile", cfg.outFile, "Enable to out the Collection Results to File")->default_val(false);
 	application.add_option("--file-path", cfg.filepath, "Out filename")->default_val("metric.csv");
 
+#ifdef __linux__
+	// Command-line arguments: hostRoot
+	application.add_option("--host-root", cfg.hostRoot, "Root prefix for /proc and /sys (e.g. /host when the host filesystem is mounted into a container)");
+
+	// Command-line arguments: relay
+	application.add_option("--node-id", cfg.nodeId, "Node ID attached to forwarded metric batches (default: --clu-nodeId or hostname)");
+	bool relayRaw=false;
+	application.add_option("--relay-listen", cfg.relayConfig.listen, "Run as rack-level relay listening on host:port (a bare port listens on 127.0.0.1 only; the protocol has no authentication)");
+	application.add_option("--relay-upstream", cfg.relayConfig.upstream, "Push metric batches to the relay at host:port");
+	application.add_flag("--relay-raw", relayRaw, "Forward every child batch as-is instead of averaging per interval");
+#endif
+
 #ifdef HWGAUGE_USE_CLUSTER
 	// Command-line arguments: clusterInfo
 	bool clusterInfo=false;
@@ -88,13 +184,15 @@ int main(int argc, char* argv[])
 	application.add_option("--clu-port", cfg.clusterConfig.port, "Cluster port")->default_val("6379");
 	application.add_option("--clu-password", cfg.clusterConfig.password, "Cluster password")->default_val("123456");
 	application.add_option("--clu-ttl", cfg.clusterConfig.ttlSeconds, "Heartbeat key TTL in seconds")->default_val(5);
+	// Command-line arguments: redis stream
+	application.add_flag("--stream-enable", cfg.streamConfig.enable, "Enable publishing metric batches to Redis Stream")->default_val(false);
+	application.add_option("--stream-key", cfg.streamConfig.key, "Redis Stream key")->default_val("hwgauge:metrics");
+	application.add_option("--stream-maxlen", cfg.streamConfig.maxLen, "Approximate max length of the Redis Stream")->default_val(100000);
 #endif
 
 #ifdef HWGAUGE_USE_PROMETHEUS
 	// Command-line arguments: prometheus
 	auto registry=std::make_shared<prometheus::Registry>();
-	prometheus::Exposer pm_exposer(std::move(address));
-	pm_exposer.RegisterCollectable(registry);
 	cfg.registry = registry;
 
 	cfg.pmEnable = false;
@@ -114,6 +212,18 @@ int main(int argc, char* argv[])
 	application.add_option("--db-table", cfg.dbTableName, "Database table name for device metrics")->default_val("test");
 #endif
 
+#if defined(HWGAUGE_USE_CLUSTER) && defined(HWGAUGE_USE_POSTGRESQL)
+	// Command-line arguments: aggregator
+	bool aggregator=false;
+	application.add_flag("--aggregator", aggregator, "Run as aggregator: consume Redis Stream and write to database");
+	application.add_option("--agg-group", cfg.streamConfig.group, "Consumer group of the aggregator")->default_val("hwgauge");
+	application.add_option("--agg-consumer", cfg.streamConfig.consumer, "Consumer name of the aggregator (default: node ID)");
+	application.add_option("--agg-batch", cfg.streamConfig.batchSize, "Max entries per read of the aggregator")->default_val(512)
+		->check(CLI::PositiveNumber);
+	application.add_option("--agg-claim-idle", cfg.streamConfig.claimIdleMs, "Take over entries left unacknowledged this long (ms) by another aggregator of the group")->default_val(60000)
+		->check(CLI::PositiveNumber);
+#endif
+
 #ifdef HWGAUGE_USE_LOCAL_HTTP
     // Command-line arguments: Local HTTP
     application.add_flag("--http-enable", cfg.httpEnable, "Enable Local JSON HTTP API")->default_val(false);
@@ -123,56 +233,212 @@ int main(int argc, char* argv[])
     application.add_option("--http-port", http_port, "Port for Local HTTP API")->default_val(8081);
 
     std::shared_ptr<hwgauge::LocalHttpServer> local_http_server = nullptr;
+    std::unique_ptr<hwgauge::JobHttpApi> job_http_api = nullptr;
+
+    // Subcommand: job markers sent to a running instance (e.g. hwgauge --http-port 8081 job start train-42)
+    std::string job_action, job_id;
+    auto* job_command = application.add_subcommand("job", "Mark job start/stop on a running HwGauge and print its energy report");
+    job_command->add_option("action", job_action, "start | stop | show")->required()
+        ->check(CLI::IsMember({"start", "stop", "show"}));
+    job_command->add_option("id", job_id, "Job ID (letters, digits and _.:-)")->required();
 #endif
 	CLI11_PARSE(application, argc, argv);
 
+	// 在异步日志、HTTP 服务等线程创建之前屏蔽 SIGINT / SIGTERM，之后由 signalfd 统一接收
+	try
+	{
+		hwgauge::installStopSignals();
+	}
+	catch (const hwgauge::FatalError& e)
+	{
+		spdlog::critical("Fatal error from: {}", e.what());
+		return EXIT_FAILURE;
+	}
+
+	// Initialize spdlog logger
+	log_config.level = spdlog::level::from_str(log_level);
+	log_config.repeatWindow = std::chrono::seconds(log_repeat_window);
+	hwgauge::initLogging(log_config);
+	spdlog::info("Spdlog initialized successfully");
+
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+	if (*job_command)return hwgauge::runJobCommand(http_host, http_port, job_action, job_id);
+#endif
+
+#ifdef HWGAUGE_USE_PROMETHEUS
+	// 参数解析之后再监听：--address 才能生效，job 子命令也不会与正在运行的实例抢端口
+	prometheus::Exposer pm_exposer(address);
+	pm_exposer.RegisterCollectable(registry);
+#endif
+
+#ifdef HWGAUGE_USE_CLUSTER
+	if (cfg.nodeId.empty())cfg.nodeId = cfg.clusterConfig.nodeId;
+#endif
+#ifdef __linux__
+	if (cfg.nodeId.empty())
+	{
+		char hostname[256] = { 0 };
+		if (gethostname(hostname, sizeof(hostname) - 1) == 0)cfg.nodeId = hostname;
+	}
+#endif
+
+#if defined(HWGAUGE_USE_CLUSTER) && defined(HWGAUGE_USE_POSTGRESQL)
+	if (aggregator)
+	{
+		if (cfg.streamConfig.consumer.empty())cfg.streamConfig.consumer = cfg.nodeId;
+
+		std::unique_ptr<hwgauge::Aggregator> agg;
+		try
+		{
+			agg = std::make_unique<hwgauge::Aggregator>(cfg.clusterConfig, cfg.streamConfig, cfg.dbConfig, cfg.dbTableName);
+		}
+		catch (const hwgauge::FatalError& e)
+		{
+			spdlog::critical("Fatal error from: {}", e.what());
+			return EXIT_FAILURE;
+		}
+
+		spdlog::info("Starting aggregator on stream \"{}\"", cfg.streamConfig.key);
+		spdlog::info("Press \"Ctrl+C\" to stop aggregator");
+
+		std::thread signal_watcher([&]{
+			if (!hwgauge::waitStopSignal())return;
+			spdlog::info("Stopping aggregator");
+			agg->stop();
+		});
+
+		agg->run();
+		hwgauge::cancelStopWait();
+		signal_watcher.join();
+		hwgauge::shutdownLogging();
+		return 0;
+	}
+#endif
+
+#ifdef HWGAUGE_USE_CLUSTER
+	if (cfg.streamConfig.enable)
+	{
+		cfg.batchSinks.push_back(std::make_shared<hwgauge::RedisStreamPublisher>(cfg.clusterConfig, cfg.streamConfig));
+	}
+#endif
+
+#ifdef __linux__
+	cfg.relayConfig.rollup = !relayRaw;
+	if (!cfg.relayConfig.upstream.empty())
+	{
+		try
+		{
+			cfg.batchSinks.push_back(std::make_shared<hwgauge::RelayClient>(cfg.relayConfig.upstream));
+		}
+		catch (const hwgauge::FatalError& e)
+		{
+			spdlog::critical("Fatal error from: {}", e.what());
+			return EXIT_FAILURE;
+		}
+	}
+#endif
+
 #ifdef HWGAUGE_USE_LOCAL_HTTP
     if (cfg.httpEnable) {
         local_http_server = std::make_shared<hwgauge::LocalHttpServer>();
         cfg.httpServer = local_http_server; // 注入给配置，供各 Collector 使用
+        cfg.jobTracker = std::make_shared<hwgauge::JobTracker>();
+        job_http_api = std::make_unique<hwgauge::JobHttpApi>(local_http_server, cfg.jobTracker);
+        job_http_api->init();
         local_http_server->start(http_host, http_port);
     }
 #endif
 
+	if (!replay_config.files.empty())
+	{
+		spdlog::info("Replaying {} file(s) at {}", replay_config.files.size(),
+			replay_config.speed > 0 ? fmt::format("{}x speed", replay_config.speed) : std::string("full speed"));
+		std::thread signal_watcher([]{
+			if (hwgauge::waitStopSignal())g_stop_requested.store(true, std::memory_order_relaxed);
+		});
+		int code = hwgauge::runReplay(replay_config, cfg, g_stop_requested);
+		hwgauge::cancelStopWait();
+		signal_watcher.join();
+#ifdef HWGAUGE_USE_LOCAL_HTTP
+		if (local_http_server)local_http_server->stop();
+#endif
+		hwgauge::shutdownLogging();
+		return code;
+	}
+
 	// Create exposer
-	exposer = std::make_unique<hwgauge::Exposer>(std::chrono::duration<double>(interval_seconds));
+	hwgauge::OverrunPolicy overrun_policy = hwgauge::OverrunPolicy::Skip;
+	if (overrun == "catchup")overrun_policy = hwgauge::OverrunPolicy::CatchUp;
+	else if (overrun == "stretch")overrun_policy = hwgauge::OverrunPolicy::Stretch;
+	exposer = std::make_unique<hwgauge::Exposer>(std::chrono::duration<double>(interval_seconds), overrun_policy);
+#ifdef HWGAUGE_USE_PROMETHEUS
+	if (cfg.pmEnable)exposer->exportStats(registry);
+#endif
+#if defined(HWGAUGE_USE_INTEL_PCM) && defined(__linux__)
+	bool usePCM = cpuSource == "pcm" || (cpuSource == "auto" && hwgauge::ProcCPU::isIntel(cfg.hostRoot));
+#elif defined(HWGAUGE_USE_INTEL_PCM)
+	bool usePCM = true;
+#endif
+#ifdef HWGAUGE_USE_INTEL_PCM
+	if(usePCM && !exposer->add_collector<hwgauge::CPUCollector>(cfg))
+	{
+#ifdef __linux__
+		// PCM 无法运行（MSR 不可访问、PMU 被占用等）时改用 /proc 数据源，IPC 与缓存指标由 perf_event 提供
+		spdlog::warn("PCM unavailable, falling back to /proc and perf_event CPU metrics");
+		perfEvents = true;
+#endif
+		usePCM = false;
+	}
+	if(usePCM && cpuCores)exposer->add_collector<hwgauge::CPUCoreCollector>(cfg);
+#endif
+#ifdef __linux__
 #ifdef HWGAUGE_USE_INTEL_PCM
-	exposer->add_collector<hwgauge::CPUCollector>(cfg);
+	if(!usePCM)
+#endif
+	{
+		exposer->add_collector<hwgauge::ProcCPUCollector>(cfg);
+		if(cpuCores)exposer->add_collector<hwgauge::ProcCPUCoreCollector>(cfg);
+	}
+	if(perfEvents)exposer->add_collector<hwgauge::PerfCollector>(cfg);
 #endif
 
+	// 厂商库在运行时加载，节点上没有对应的库时直接跳过，同一个可执行文件可部署到所有节点
 #ifdef HWGAUGE_USE_NVML
-	exposer->add_collector<hwgauge::GPUCollector>(cfg);
+	if(hwgauge::nvmlApi())
+	{
+		exposer->add_collector<hwgauge::GPUCollector>(cfg);
+		if(gpuProcesses)exposer->add_collector<hwgauge::GPUProcessCollector>(cfg);
+	}
 #endif
 
 #ifdef HWGAUGE_USE_NPU
-	exposer->add_collector<hwgauge::NPUCollector>(cfg);
+	if(hwgauge::dcmiApi())exposer->add_collector<hwgauge::NPUCollector>(cfg);
 #endif
 
 #ifdef __linux__
 	if(sysInfo)exposer->add_collector<hwgauge::SYSCollector>(cfg);
+	if(hwmonInfo)exposer->add_collector<hwgauge::HwmonCollector>(cfg);
 #endif
 
 #ifdef HWGAUGE_USE_CLUSTER
 	if(clusterInfo)exposer->add_collector<hwgauge::ClusterCollector>(cfg);
 #endif
 
+	// 派生指标读取其他采集器本轮的结果，publish 时自动排在它们之后
+	if(!cfg.derivedMetrics.empty())exposer->add_collector<hwgauge::DerivedCollector>(cfg);
+	// 告警规则同样读取本轮结果，排在派生指标之后
+	if(!cfg.alertConfig.rules.empty())exposer->add_collector<hwgauge::AlertCollector>(cfg);
+
+#ifdef __linux__
+	// relay 最后加入，本机采集器的数据同一轮内直接发往上游
+	if(!cfg.relayConfig.listen.empty())exposer->add_collector<hwgauge::RelayCollector>(cfg);
+#endif
+
 	spdlog::info("Staring exposer on \"{}\"", address);
 	spdlog::info("Press \"Ctrl+C\" to stop exposer");
 	
-	std::signal(SIGINT, signal_handler);
-	std::thread signal_watcher([&]{
-		while (!g_stop_requested.load(std::memory_order_relaxed))
-		{
-			std::this_thread::sleep_for(std::chrono::milliseconds(100));
-		}
-		spdlog::info("Stopping exposer");
-		exposer->stop();
-	});
-
+	// 定时器、停止信号都在 run() 的事件循环中处理，不需要额外的监视线程
 	exposer->run();
-	//g_stop_requested.store(true, std::memory_order_relaxed);
-
-	signal_watcher.join();
 	exposer.reset();
 
 #ifdef HWGAUGE_USE_LOCAL_HTTP
@@ -180,5 +446,6 @@ int main(int argc, char* argv[])
         local_http_server->stop();
     }
 #endif
+	hwgauge::shutdownLogging();
 	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,32 @@
+#!/bin/bash
+set -e
+
+# 本地 webhook 接收端，用于测试 --alert-webhook：打印收到的每条告警，并追加到文件（可选）
+# 用法: ./alert_webhook_stub.sh [端口，默认 9095] [输出文件]
+# 对应参数: --alert-webhook http://127.0.0.1:9095/alert
+PORT="${1:-9095}"
+OUT="${2:-}"
+
+echo "Listening for alerts on 127.0.0.1:${PORT}..."
+exec python3 - "$PORT" "$OUT" <<'PY'
+import sys
+from http.server import BaseHTTPRequestHandler, HTTPServer
+
+port, out = int(sys.argv[1]), sys.argv[2]
+
+class Handler(BaseHTTPRequestHandler):
+    def do_POST(self):
+        body = self.rfile.read(int(self.headers.get("Content-Length", 0))).decode("utf-8", "replace")
+        print(f"{self.path} {body}", flush=True)
+        if out:
+            with open(out, "a") as f:
+                f.write(body + "\n")
+        self.send_response(200)
+        self.send_header("Content-Length", "0")
+        self.end_headers()
+
+    def log_message(self, *args):
+        pass
+
+HTTPServer(("127.0.0.1", port), Handler).serve_forever()
+PY
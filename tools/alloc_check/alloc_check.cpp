@@ -0,0 +1,118 @@
+/*
+ * hwgauge_alloc_check：稳态采集零分配检查，由 ctest 运行。
+ *
+ * 用真实的实现类驱动 DeviceCollector：ProcCPU、ProcCPUCore、SYSImpl（读本机 /proc、/sys），
+ * 以及构建时启用模拟库的 NVML / DCMI 采集器。首轮建立缓冲区，之后每轮 collect 都不应调用 operator new。
+ * 只检查采样与共享上下文，不接 CSV / 数据库等按行格式化的下游。
+ *
+ * 退出码：0 通过，1 有采集器在首轮之后仍然分配。当前环境无法创建的采集器（没有 /proc 等）跳过。
+ */
+#include "Collector/CPUCollector/CPUCollector.hpp"
+#include "Collector/CPUCollector/CPUCoreCollector.hpp"
+#include "Collector/SYSCollector/SYSCollector.hpp"
+#ifdef HWGAUGE_USE_NVML
+#include "Collector/GPUCollector/GPUCollector.hpp"
+#endif
+#ifdef HWGAUGE_USE_NPU
+#include "Collector/NPUCollector/NPUCollector.hpp"
+#endif
+#include "Collector/Common/Context.hpp"
+#include "Collector/Common/Exception.hpp"
+#include "AllocCounter.hpp"
+
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <cstdio>
+#include <exception>
+
+namespace hwgauge
+{
+    namespace
+    {
+        constexpr int kTicks = 20;
+
+        enum class Result { Passed, Failed, Skipped };
+
+        template<typename CollectorT>
+        Result check(const char* name)
+        {
+            CollectorConfig cfg;
+            cfg.outTer = false;
+            cfg.nodeId = "alloc-check";
+
+            std::uint64_t allocs = 0, bytes = 0, worst = 0;
+            try
+            {
+                CollectorT collector(cfg);
+                TickContext context;
+                Tick tick;
+                tick.seq = 1;
+                tick.time = std::chrono::system_clock::now();
+                tick.context = &context;
+                context.begin(tick.seq);
+                // 首轮建立指标缓冲区与上下文视图，不计入
+                collector.collect(tick);
+
+                for (int i = 0; i < kTicks; i++)
+                {
+                    tick.seq++;
+                    tick.time = std::chrono::system_clock::now();
+                    context.begin(tick.seq);
+                    AllocStats before = allocStats();
+                    collector.collect(tick);
+                    AllocStats after = allocStats();
+                    allocs += after.count - before.count;
+                    bytes += after.bytes - before.bytes;
+                    worst = std::max<std::uint64_t>(worst, after.count - before.count);
+                }
+            }
+            catch (const std::exception& e)
+            {
+                std::printf("%-8s SKIP  %s\n", name, e.what());
+                return Result::Skipped;
+            }
+
+            bool ok = allocs == 0;
+            std::printf("%-8s %s  %llu allocs (%llu bytes) in %d ticks, at most %llu per tick\n", name, ok ? "OK  " : "FAIL",
+                static_cast<unsigned long long>(allocs), static_cast<unsigned long long>(bytes), kTicks,
+                static_cast<unsigned long long>(worst));
+            return ok ? Result::Passed : Result::Failed;
+        }
+    }
+}
+
+int main()
+{
+    using namespace hwgauge;
+
+    // 采集器的启动日志与本检查的输出无关
+    spdlog::set_level(spdlog::level::warn);
+
+    Result results[] = {
+        check<ProcCPUCollector>("cpu"),
+        check<ProcCPUCoreCollector>("cpucore"),
+        check<SYSCollector>("sys"),
+#ifdef HWGAUGE_USE_NVML
+        check<GPUCollector>("gpu"),
+#endif
+#ifdef HWGAUGE_USE_NPU
+        check<NPUCollector>("npu"),
+#endif
+    };
+
+    int failed = 0, passed = 0;
+    for (Result r : results)
+    {
+        if (r == Result::Failed)failed++;
+        if (r == Result::Passed)passed++;
+    }
+    if (failed > 0)return 1;
+    // 一个采集器都没有运行时没有检查到任何东西
+    if (passed == 0)
+    {
+        std::printf("no collector could be created\n");
+        return 1;
+    }
+    return 0;
+}
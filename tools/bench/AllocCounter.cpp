@@ -0,0 +1,32 @@
+// 全局 operator new/delete 的替换单独放在一个编译单元，避免与调用方内联后触发 -Wmismatched-new-delete
+#include "AllocCounter.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+    std::atomic<std::uint64_t> allocCount{ 0 };
+    std::atomic<std::uint64_t> allocBytes{ 0 };
+}
+
+// operator new[] 与 nothrow 版本默认转发到这里
+void* operator new(std::size_t size)
+{
+    allocCount.fetch_add(1, std::memory_order_relaxed);
+    allocBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1))return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace hwgauge
+{
+    AllocStats allocStats()
+    {
+        return AllocStats{ allocCount.load(std::memory_order_relaxed), allocBytes.load(std::memory_order_relaxed) };
+    }
+}
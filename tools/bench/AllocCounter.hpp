@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+namespace hwgauge
+{
+    /* 进程内 operator new 的累计调用次数与字节数 */
+    struct AllocStats
+    {
+        std::uint64_t count;
+        std::uint64_t bytes;
+    };
+
+    AllocStats allocStats();
+}
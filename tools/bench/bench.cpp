@@ -0,0 +1,212 @@
+/*
+ * hwgauge_bench：用模拟实现驱动真实的 DeviceCollector，测量每轮采集 (collect) 的耗时与堆分配。
+ *
+ * 每个基准名为 "<采集器>/<下游>/<设备数>"，设备数取 1、4、16 … 1024。
+ * 计数器：
+ *   allocs/tick  每轮 operator new 调用次数（首轮建立缓冲区不计入）
+ *   bytes/tick   每轮分配的字节数
+ *   devices/s    每秒处理的设备数
+ *
+ * 下游：none（只采样与汇总上下文）、csv（写临时目录）、batch（编码后交给空的 BatchSink）、
+ * prometheus（构建时启用 HWGAUGE_USE_PROMETHEUS 才有）。
+ */
+#include "SimCPU.hpp"
+#include "SimGPU.hpp"
+#include "SimNPU.hpp"
+#include "SimSYS.hpp"
+#include "SimCluster.hpp"
+#include "Collector/CPUCollector/CPUCollector.hpp"
+#include "Collector/GPUCollector/GPUCollector.hpp"
+#include "Collector/NPUCollector/NPUCollector.hpp"
+#include "Collector/SYSCollector/SYSCollector.hpp"
+#include "Forwarder/BatchSink.hpp"
+#include "AllocCounter.hpp"
+
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    namespace
+    {
+        namespace fs = std::filesystem;
+
+        enum class Sink { None, Csv, Batch, Prometheus };
+
+        const char* sinkName(Sink sink)
+        {
+            switch (sink)
+            {
+            case Sink::Csv: return "csv";
+            case Sink::Batch: return "batch";
+            case Sink::Prometheus: return "prometheus";
+            default: return "none";
+            }
+        }
+
+        /* 只统计字节数的批量下游，衡量编码本身的开销 */
+        class NullBatchSink : public BatchSink
+        {
+        public:
+            void publish(const MetricBatch& batch) override
+            {
+                bytes += batch.payload.size();
+                benchmark::DoNotOptimize(bytes);
+            }
+
+        private:
+            std::size_t bytes = 0;
+        };
+
+        template<typename L, typename M, typename Impl, typename Csv, typename Prom>
+        using SimCollector = DeviceCollector<L, M, Impl, NullType, Csv, Prom, NullType>;
+
+        using SimCPUCollector = SimCollector<CPULabel, CPUMetrics, SimCPU, CPUCsvLogger, CPUPrometheusType>;
+        using SimGPUCollector = SimCollector<GPULabel, GPUMetrics, SimGPU, GPUCsvLogger, GPUPrometheusType>;
+        using SimNPUCollector = SimCollector<NPULabel, NPUMetrics, SimNPU, NPUCsvLogger, NPUPrometheusType>;
+        using SimSYSCollector = SimCollector<SYSLabel, SYSMetrics, SimSYS, SYSCsvLogger, SYSPrometheusType>;
+
+        void configure(benchmark::State& state)
+        {
+            SimConfig& sim = simConfig();
+            sim = SimConfig{};
+            sim.devices = static_cast<std::size_t>(state.range(0));
+            sim.seed = 42;
+        }
+
+        void report(benchmark::State& state, std::uint64_t allocs, std::uint64_t bytes)
+        {
+            state.counters["allocs/tick"] = benchmark::Counter(static_cast<double>(allocs), benchmark::Counter::kAvgIterations);
+            state.counters["bytes/tick"] = benchmark::Counter(static_cast<double>(bytes), benchmark::Counter::kAvgIterations);
+            state.counters["devices/s"] = benchmark::Counter(static_cast<double>(state.iterations() * state.range(0)), benchmark::Counter::kIsRate);
+        }
+
+        template<typename CollectorT>
+        void tick(benchmark::State& state, Sink sink, const std::string& file)
+        {
+            configure(state);
+
+            CollectorConfig cfg;
+            cfg.outTer = false;
+            cfg.nodeId = "bench";
+            switch (sink)
+            {
+            case Sink::Csv:
+                cfg.outFile = true;
+                cfg.filepath = (fs::temp_directory_path() / file).string();
+                break;
+            case Sink::Batch:
+                cfg.batchSinks.push_back(std::make_shared<NullBatchSink>());
+                break;
+            case Sink::Prometheus:
+#ifdef HWGAUGE_USE_PROMETHEUS
+                cfg.pmEnable = true;
+                cfg.registry = std::make_shared<prometheus::Registry>();
+#endif
+                break;
+            default:
+                break;
+            }
+
+            std::uint64_t allocs = 0, bytes = 0;
+            {
+                CollectorT collector(cfg);
+                TickContext context;
+                Tick tick;
+                tick.seq = 1;
+                tick.time = std::chrono::system_clock::now();
+                tick.context = &context;
+                // 首轮建立指标缓冲区、序列缓存等，不计入
+                collector.collect(tick);
+
+                for (auto _ : state)
+                {
+                    tick.seq++;
+                    context.begin(tick.seq);
+                    AllocStats before = allocStats();
+                    collector.collect(tick);
+                    AllocStats after = allocStats();
+                    allocs += after.count - before.count;
+                    bytes += after.bytes - before.bytes;
+                }
+            }
+            report(state, allocs, bytes);
+
+            if (sink == Sink::Csv)
+            {
+                std::error_code ec;
+                fs::remove(cfg.filepath + ".csv", ec);
+            }
+        }
+
+        // 集群采集器不经过 DeviceCollector，只测量实现本身
+        void clusterTick(benchmark::State& state)
+        {
+            configure(state);
+            SimCluster impl;
+            std::vector<ClusterLabel> labels = impl.labels();
+            std::vector<ClusterMetrics> metrics(labels.size());
+            impl.sample(labels, metrics);
+
+            std::uint64_t allocs = 0, bytes = 0;
+            for (auto _ : state)
+            {
+                AllocStats before = allocStats();
+                impl.sample(labels, metrics);
+                benchmark::DoNotOptimize(metrics.data());
+                AllocStats after = allocStats();
+                allocs += after.count - before.count;
+                bytes += after.bytes - before.bytes;
+            }
+            report(state, allocs, bytes);
+        }
+
+        template<typename B>
+        void configureRange(B* b)
+        {
+            b->RangeMultiplier(4)->Range(1, 1024)->Unit(benchmark::kMicrosecond);
+        }
+
+        template<typename CollectorT>
+        void add(const std::string& collector)
+        {
+            std::vector<Sink> sinks = { Sink::None, Sink::Csv, Sink::Batch };
+#ifdef HWGAUGE_USE_PROMETHEUS
+            sinks.push_back(Sink::Prometheus);
+#endif
+            for (Sink sink : sinks)
+            {
+                std::string name = collector + "/" + sinkName(sink);
+                std::string file = "hwgauge_bench_" + collector + "_" + sinkName(sink);
+                configureRange(benchmark::RegisterBenchmark(name.c_str(),
+                    [sink, file](benchmark::State& state) { tick<CollectorT>(state, sink, file); }));
+            }
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    using namespace hwgauge;
+
+    // CSV 等下游的 info 日志会干扰基准输出
+    spdlog::set_level(spdlog::level::warn);
+
+    add<SimCPUCollector>("cpu");
+    add<SimGPUCollector>("gpu");
+    add<SimNPUCollector>("npu");
+    add<SimSYSCollector>("sys");
+    configureRange(benchmark::RegisterBenchmark("cluster/none", clusterTick));
+
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
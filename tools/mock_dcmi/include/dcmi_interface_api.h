@@ -0,0 +1,89 @@
+/*
+ * Mock DCMI 头文件：只声明 HwGauge 用到的 DCMI 子集，结构体字段与昇腾驱动的 dcmi_interface_api.h 保持一致。
+ * 仅在 HWGAUGE_MOCK_DCMI=ON 时替代真实的头文件；HwGauge 运行时通过 dlopen 加载模拟库，也可以用
+ * HWGAUGE_DCMI_LIBRARY 环境变量指向它。
+ */
+#ifndef HWGAUGE_MOCK_DCMI_H
+#define HWGAUGE_MOCK_DCMI_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#  if defined(HWGAUGE_MOCK_DCMI_BUILD)
+#    define MOCK_DCMI_API __declspec(dllexport)
+#  else
+#    define MOCK_DCMI_API __declspec(dllimport)
+#  endif
+#else
+#  define MOCK_DCMI_API __attribute__((visibility("default")))
+#endif
+
+#define MAX_CARD_NUM 64
+#define MAX_CHIP_NAME_LEN 32
+#define MAX_CORE_NUM 64
+
+#define DCMI_OK 0
+#define DCMI_ERR_CODE_INVALID_PARAMETER (-8001)
+#define DCMI_ERR_CODE_INNER_ERR (-8005)
+#define DCMI_ERR_CODE_NOT_SUPPORT (-8255)
+
+enum dcmi_freq_type
+{
+    DCMI_FREQ_TYPE_DDR = 1,
+    DCMI_FREQ_TYPE_CTRLCPU = 2,
+    DCMI_FREQ_TYPE_HBM = 6,
+    DCMI_FREQ_TYPE_AICORE_CURRENT = 7,
+};
+
+struct dcmi_chip_info
+{
+    unsigned char chip_type[MAX_CHIP_NAME_LEN];
+    unsigned char chip_name[MAX_CHIP_NAME_LEN];
+    unsigned char chip_ver[MAX_CHIP_NAME_LEN];
+    unsigned int aicore_cnt;
+};
+
+struct dcmi_aicore_info
+{
+    unsigned int freq;
+    unsigned int cur_freq;
+};
+
+struct dcmi_aicpu_info
+{
+    unsigned int max_freq;
+    unsigned int cur_freq;
+    unsigned int aicpu_num;
+    unsigned int util_rate[MAX_CORE_NUM];
+};
+
+struct dcmi_hbm_info
+{
+    unsigned long long memory_size;     // MB
+    unsigned int freq;                  // MHz
+    unsigned long long memory_usage;    // MB
+    int temp;
+    unsigned int bandwith_util_rate;    // %
+};
+
+MOCK_DCMI_API int dcmi_init(void);
+MOCK_DCMI_API int dcmi_get_card_list(int* card_num, int* card_list, int list_len);
+MOCK_DCMI_API int dcmi_get_device_id_in_card(int card_id, int* device_id_max, int* mcu_id, int* cpu_id);
+MOCK_DCMI_API int dcmi_get_device_chip_info(int card_id, int device_id, struct dcmi_chip_info* chip_info);
+MOCK_DCMI_API int dcmi_get_device_aicore_info(int card_id, int device_id, struct dcmi_aicore_info* aicore_info);
+MOCK_DCMI_API int dcmi_get_device_aicpu_info(int card_id, int device_id, struct dcmi_aicpu_info* aicpu_info);
+MOCK_DCMI_API int dcmi_get_device_frequency(int card_id, int device_id, enum dcmi_freq_type input_type, unsigned int* frequency);
+MOCK_DCMI_API int dcmi_get_device_utilization_rate(int card_id, int device_id, int input_type, unsigned int* utilization_rate);
+MOCK_DCMI_API int dcmi_get_device_hbm_info(int card_id, int device_id, struct dcmi_hbm_info* hbm_info);
+MOCK_DCMI_API int dcmi_get_device_power_info(int card_id, int device_id, int* power);
+MOCK_DCMI_API int dcmi_get_device_health(int card_id, int device_id, unsigned int* health);
+MOCK_DCMI_API int dcmi_get_device_temperature(int card_id, int device_id, int* temperature);
+MOCK_DCMI_API int dcmi_get_device_voltage(int card_id, int device_id, unsigned int* voltage);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
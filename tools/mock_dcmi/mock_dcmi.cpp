@@ -0,0 +1,236 @@
+/*
+ * Mock DCMI：在没有昇腾 NPU 的机器上模拟 DCMI，用于开发与采样性能对比。
+ *
+ * 环境变量：
+ *   HWGAUGE_MOCK_DCMI_CARDS             模拟的卡数量，默认 8
+ *   HWGAUGE_MOCK_DCMI_DEVICES_PER_CARD  每张卡上的芯片数，默认 1
+ *   HWGAUGE_MOCK_DCMI_LATENCY_US        每次设备查询调用的延迟（微秒），默认 2000，模拟驱动 ioctl 的耗时
+ *   HWGAUGE_MOCK_DCMI_FAIL_DEVICE       该序号（按卡、芯片顺序编号）的设备温度查询失败，HBM 读数异常（已用 > 总量），默认 -1 不注入
+ *   HWGAUGE_MOCK_DCMI_FAIL_PERCENT      所有设备查询随机失败的百分比，默认 0
+ */
+#define HWGAUGE_MOCK_DCMI_BUILD
+#include "dcmi_interface_api.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct MockState
+    {
+        int cards = 8;
+        int devicesPerCard = 1;
+        std::chrono::microseconds latency{ 0 };
+        long failDevice = -1;
+        long failPercent = 0;
+        Clock::time_point start;
+    };
+
+    MockState state;
+    std::atomic<bool> initialized{ false };
+    std::atomic<unsigned long long> calls{ 0 };
+
+    long envLong(const char* name, long fallback)
+    {
+        const char* value = std::getenv(name);
+        if (value == nullptr || *value == '\0')return fallback;
+        char* end = nullptr;
+        long result = std::strtol(value, &end, 10);
+        return end == value ? fallback : result;
+    }
+
+    void report()
+    {
+        std::fprintf(stderr, "[MockDCMI] exit after %llu device calls\n", calls.load());
+    }
+
+    long flatIndex(int card, int device)
+    {
+        return static_cast<long>(card) * state.devicesPerCard + device;
+    }
+
+    // 模拟一次驱动调用：校验参数、计数、延迟与随机失败
+    int enter(int card, int device)
+    {
+        if (!initialized.load())return DCMI_ERR_CODE_INNER_ERR;
+        if (card < 0 || card >= state.cards || device < 0 || device >= state.devicesPerCard)return DCMI_ERR_CODE_INVALID_PARAMETER;
+        calls.fetch_add(1, std::memory_order_relaxed);
+        if (state.latency.count() > 0)std::this_thread::sleep_for(state.latency);
+        if (state.failPercent > 0)
+        {
+            thread_local std::minstd_rand rng(std::random_device{}());
+            if (static_cast<long>(rng() % 100) < state.failPercent)return DCMI_ERR_CODE_INNER_ERR;
+        }
+        return DCMI_OK;
+    }
+
+    bool injected(int card, int device)
+    {
+        return state.failDevice >= 0 && flatIndex(card, device) == state.failDevice;
+    }
+
+    // 每个设备相位不同的周期负载，取值 0..1
+    double load(int card, int device)
+    {
+        double t = std::chrono::duration<double>(Clock::now() - state.start).count();
+        return 0.5 + 0.5 * std::sin(t / 10.0 + static_cast<double>(flatIndex(card, device)));
+    }
+}
+
+extern "C" {
+
+int dcmi_init(void)
+{
+    bool expected = false;
+    if (initialized.compare_exchange_strong(expected, true))
+    {
+        state.cards = static_cast<int>(envLong("HWGAUGE_MOCK_DCMI_CARDS", 8));
+        state.devicesPerCard = static_cast<int>(envLong("HWGAUGE_MOCK_DCMI_DEVICES_PER_CARD", 1));
+        if (state.cards > MAX_CARD_NUM)state.cards = MAX_CARD_NUM;
+        state.latency = std::chrono::microseconds(envLong("HWGAUGE_MOCK_DCMI_LATENCY_US", 2000));
+        state.failDevice = envLong("HWGAUGE_MOCK_DCMI_FAIL_DEVICE", -1);
+        state.failPercent = envLong("HWGAUGE_MOCK_DCMI_FAIL_PERCENT", 0);
+        state.start = Clock::now();
+        // DCMI 没有对应的 shutdown，退出时报告调用次数
+        std::atexit(report);
+        std::fprintf(stderr, "[MockDCMI] %d cards x %d devices, %lld us per call, fail device %ld, fail %ld%%\n",
+            state.cards, state.devicesPerCard, static_cast<long long>(state.latency.count()), state.failDevice, state.failPercent);
+    }
+    return DCMI_OK;
+}
+
+int dcmi_get_card_list(int* card_num, int* card_list, int list_len)
+{
+    if (!initialized.load())return DCMI_ERR_CODE_INNER_ERR;
+    if (card_num == nullptr || card_list == nullptr)return DCMI_ERR_CODE_INVALID_PARAMETER;
+    int count = state.cards < list_len ? state.cards : list_len;
+    for (int i = 0; i < count; ++i)card_list[i] = i;
+    *card_num = count;
+    return DCMI_OK;
+}
+
+int dcmi_get_device_id_in_card(int card_id, int* device_id_max, int* mcu_id, int* cpu_id)
+{
+    int ret = enter(card_id, 0);
+    if (ret != DCMI_OK)return ret;
+    if (device_id_max == nullptr || mcu_id == nullptr || cpu_id == nullptr)return DCMI_ERR_CODE_INVALID_PARAMETER;
+    *device_id_max = state.devicesPerCard;
+    *mcu_id = -1;
+    *cpu_id = -1;
+    return DCMI_OK;
+}
+
+int dcmi_get_device_chip_info(int card_id, int device_id, struct dcmi_chip_info* chip_info)
+{
+    int ret = enter(card_id, device_id);
+    if (ret != DCMI_OK)return ret;
+    if (chip_info == nullptr)return DCMI_ERR_CODE_INVALID_PARAMETER;
+    *chip_info = dcmi_chip_info{};
+    std::snprintf(reinterpret_cast<char*>(chip_info->chip_type), MAX_CHIP_NAME_LEN, "Ascend");
+    std::snprintf(reinterpret_cast<char*>(chip_info->chip_name), MAX_CHIP_NAME_LEN, "Mock910B");
+    std::snprintf(reinterpret_cast<char*>(chip_info->chip_ver), MAX_CHIP_NAME_LEN, "V1");
+    chip_info->aicore_cnt = 24;
+    return DCMI_OK;
+}
+
+int dcmi_get_device_aicore_info(int card_id, int device_id, struct dcmi_aicore_info* aicore_info)
+{
+    int ret = enter(card_id, device_id);
+    if (ret != DCMI_OK)return ret;
+    if (aicore_info == nullptr)return DCMI_ERR_CODE_INVALID_PARAMETER;
+    aicore_info->freq = 1800;
+    aicore_info->cur_freq = static_cast<unsigned int>(800 + 1000 * load(card_id, device_id));
+    return DCMI_OK;
+}
+
+int dcmi_get_device_aicpu_info(int card_id, int device_id, struct dcmi_aicpu_info* aicpu_info)
+{
+    int ret = enter(card_id, device_id);
+    if (ret != DCMI_OK)return ret;
+    if (aicpu_info == nullptr)return DCMI_ERR_CODE_INVALID_PARAMETER;
+    *aicpu_info = dcmi_aicpu_info{};
+    aicpu_info->max_freq = 1900;
+    aicpu_info->cur_freq = 1900;
+    aicpu_info->aicpu_num = 6;
+    return DCMI_OK;
+}
+
+int dcmi_get_device_frequency(int card_id, int device_id, enum dcmi_freq_type input_type, unsigned int* frequency)
+{
+    int ret = enter(card_id, device_id);
+    if (ret != DCMI_OK)return ret;
+    if (frequency == nullptr)return DCMI_ERR_CODE_INVALID_PARAMETER;
+    *frequency = input_type == DCMI_FREQ_TYPE_CTRLCPU ? 1900 : 1600;
+    return DCMI_OK;
+}
+
+int dcmi_get_device_utilization_rate(int card_id, int device_id, int input_type, unsigned int* utilization_rate)
+{
+    int ret = enter(card_id, device_id);
+    if (ret != DCMI_OK)return ret;
+    if (utilization_rate == nullptr)return DCMI_ERR_CODE_INVALID_PARAMETER;
+    double scale = input_type == 2 ? 100.0 : (input_type == 12 ? 80.0 : 30.0);
+    *utilization_rate = static_cast<unsigned int>(scale * load(card_id, device_id));
+    return DCMI_OK;
+}
+
+int dcmi_get_device_hbm_info(int card_id, int device_id, struct dcmi_hbm_info* hbm_info)
+{
+    int ret = enter(card_id, device_id);
+    if (ret != DCMI_OK)return ret;
+    if (hbm_info == nullptr)return DCMI_ERR_CODE_INVALID_PARAMETER;
+    *hbm_info = dcmi_hbm_info{};
+    hbm_info->memory_size = 65536;
+    hbm_info->memory_usage = injected(card_id, device_id)
+        ? 70000 : static_cast<unsigned long long>(4096 + 50000 * load(card_id, device_id));
+    hbm_info->freq = 1600;
+    hbm_info->temp = 45;
+    hbm_info->bandwith_util_rate = static_cast<unsigned int>(60 * load(card_id, device_id));
+    return DCMI_OK;
+}
+
+int dcmi_get_device_power_info(int card_id, int device_id, int* power)
+{
+    int ret = enter(card_id, device_id);
+    if (ret != DCMI_OK)return ret;
+    if (power == nullptr)return DCMI_ERR_CODE_INVALID_PARAMETER;
+    *power = static_cast<int>((90.0 + 260.0 * load(card_id, device_id)) * 10.0);  // 0.1 W
+    return DCMI_OK;
+}
+
+int dcmi_get_device_health(int card_id, int device_id, unsigned int* health)
+{
+    int ret = enter(card_id, device_id);
+    if (ret != DCMI_OK)return ret;
+    if (health == nullptr)return DCMI_ERR_CODE_INVALID_PARAMETER;
+    *health = 0;
+    return DCMI_OK;
+}
+
+int dcmi_get_device_temperature(int card_id, int device_id, int* temperature)
+{
+    int ret = enter(card_id, device_id);
+    if (ret != DCMI_OK)return ret;
+    if (temperature == nullptr)return DCMI_ERR_CODE_INVALID_PARAMETER;
+    if (injected(card_id, device_id))return DCMI_ERR_CODE_INNER_ERR;
+    *temperature = static_cast<int>(40 + 30 * load(card_id, device_id));
+    return DCMI_OK;
+}
+
+int dcmi_get_device_voltage(int card_id, int device_id, unsigned int* voltage)
+{
+    int ret = enter(card_id, device_id);
+    if (ret != DCMI_OK)return ret;
+    if (voltage == nullptr)return DCMI_ERR_CODE_INVALID_PARAMETER;
+    *voltage = 1200;  // 0.01 V
+    return DCMI_OK;
+}
+
+}
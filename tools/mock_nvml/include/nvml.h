@@ -0,0 +1,152 @@
+/*
+ * Mock NVML 头文件：只声明 HwGauge 用到的 NVML 子集，常量与结构布局与 NVIDIA nvml.h 保持一致。
+ * 仅在 HWGAUGE_MOCK_NVML=ON 时替代真实的 nvml.h；HwGauge 运行时通过 dlopen 加载模拟库，也可以用
+ * HWGAUGE_NVML_LIBRARY 环境变量指向它。
+ */
+#ifndef HWGAUGE_MOCK_NVML_H
+#define HWGAUGE_MOCK_NVML_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#if defined(_WIN32)
+#  if defined(HWGAUGE_MOCK_NVML_BUILD)
+#    define MOCK_NVML_API __declspec(dllexport)
+#  else
+#    define MOCK_NVML_API __declspec(dllimport)
+#  endif
+#else
+#  define MOCK_NVML_API __attribute__((visibility("default")))
+#endif
+
+typedef enum nvmlReturn_enum
+{
+    NVML_SUCCESS = 0,
+    NVML_ERROR_UNINITIALIZED = 1,
+    NVML_ERROR_INVALID_ARGUMENT = 2,
+    NVML_ERROR_NOT_SUPPORTED = 3,
+    NVML_ERROR_NO_PERMISSION = 4,
+    NVML_ERROR_NOT_FOUND = 6,
+    NVML_ERROR_INSUFFICIENT_SIZE = 7,
+    NVML_ERROR_FUNCTION_NOT_FOUND = 13,
+    NVML_ERROR_GPU_IS_LOST = 15,
+    NVML_ERROR_UNKNOWN = 999
+} nvmlReturn_t;
+
+typedef struct nvmlDevice_st* nvmlDevice_t;
+
+typedef struct nvmlUtilization_st
+{
+    unsigned int gpu;
+    unsigned int memory;
+} nvmlUtilization_t;
+
+typedef enum nvmlClockType_enum
+{
+    NVML_CLOCK_GRAPHICS = 0,
+    NVML_CLOCK_SM = 1,
+    NVML_CLOCK_MEM = 2,
+    NVML_CLOCK_VIDEO = 3
+} nvmlClockType_t;
+
+typedef enum nvmlTemperatureSensors_enum
+{
+    NVML_TEMPERATURE_GPU = 0
+} nvmlTemperatureSensors_t;
+
+#define NVML_DEVICE_NAME_BUFFER_SIZE 64
+
+/* 字段查询 */
+#define NVML_FI_DEV_TOTAL_ENERGY_CONSUMPTION 83
+#define NVML_FI_DEV_POWER_INSTANT 186
+
+typedef enum nvmlValueType_enum
+{
+    NVML_VALUE_TYPE_DOUBLE = 0,
+    NVML_VALUE_TYPE_UNSIGNED_INT = 1,
+    NVML_VALUE_TYPE_UNSIGNED_LONG = 2,
+    NVML_VALUE_TYPE_UNSIGNED_LONG_LONG = 3,
+    NVML_VALUE_TYPE_SIGNED_LONG_LONG = 4
+} nvmlValueType_t;
+
+typedef union nvmlValue_st
+{
+    double dVal;
+    unsigned int uiVal;
+    unsigned long ulVal;
+    unsigned long long ullVal;
+    signed long long sllVal;
+} nvmlValue_t;
+
+typedef struct nvmlFieldValue_st
+{
+    unsigned int fieldId;
+    unsigned int scopeId;
+    long long timestamp;
+    long long latencyUsec;
+    nvmlValueType_t valueType;
+    nvmlReturn_t nvmlReturn;
+    nvmlValue_t value;
+} nvmlFieldValue_t;
+
+/* 驱动采样缓冲区 */
+typedef enum nvmlSamplingType_enum
+{
+    NVML_TOTAL_POWER_SAMPLES = 0,
+    NVML_GPU_UTILIZATION_SAMPLES = 1,
+    NVML_MEMORY_UTILIZATION_SAMPLES = 2
+} nvmlSamplingType_t;
+
+typedef struct nvmlSample_st
+{
+    unsigned long long timeStamp;
+    nvmlValue_t sampleValue;
+} nvmlSample_t;
+
+/* 进程 */
+#define NVML_VALUE_NOT_AVAILABLE (-1)
+
+typedef struct nvmlProcessInfo_st
+{
+    unsigned int pid;
+    unsigned long long usedGpuMemory;
+    unsigned int gpuInstanceId;
+    unsigned int computeInstanceId;
+} nvmlProcessInfo_t;
+
+typedef struct nvmlProcessUtilizationSample_st
+{
+    unsigned int pid;
+    unsigned long long timeStamp;
+    unsigned int smUtil;
+    unsigned int memUtil;
+    unsigned int encUtil;
+    unsigned int decUtil;
+} nvmlProcessUtilizationSample_t;
+
+MOCK_NVML_API nvmlReturn_t nvmlInit(void);
+MOCK_NVML_API nvmlReturn_t nvmlShutdown(void);
+MOCK_NVML_API const char* nvmlErrorString(nvmlReturn_t result);
+
+MOCK_NVML_API nvmlReturn_t nvmlDeviceGetCount(unsigned int* deviceCount);
+MOCK_NVML_API nvmlReturn_t nvmlDeviceGetHandleByIndex(unsigned int index, nvmlDevice_t* device);
+MOCK_NVML_API nvmlReturn_t nvmlDeviceGetName(nvmlDevice_t device, char* name, unsigned int length);
+
+MOCK_NVML_API nvmlReturn_t nvmlDeviceGetUtilizationRates(nvmlDevice_t device, nvmlUtilization_t* utilization);
+MOCK_NVML_API nvmlReturn_t nvmlDeviceGetClockInfo(nvmlDevice_t device, nvmlClockType_t type, unsigned int* clock);
+MOCK_NVML_API nvmlReturn_t nvmlDeviceGetPowerUsage(nvmlDevice_t device, unsigned int* power);
+MOCK_NVML_API nvmlReturn_t nvmlDeviceGetTemperature(nvmlDevice_t device, nvmlTemperatureSensors_t sensorType, unsigned int* temp);
+MOCK_NVML_API nvmlReturn_t nvmlDeviceGetTotalEnergyConsumption(nvmlDevice_t device, unsigned long long* energy);
+MOCK_NVML_API nvmlReturn_t nvmlDeviceGetFieldValues(nvmlDevice_t device, int valuesCount, nvmlFieldValue_t* values);
+MOCK_NVML_API nvmlReturn_t nvmlDeviceGetSamples(nvmlDevice_t device, nvmlSamplingType_t type, unsigned long long lastSeenTimeStamp,
+                                                nvmlValueType_t* sampleValType, unsigned int* sampleCount, nvmlSample_t* samples);
+MOCK_NVML_API nvmlReturn_t nvmlDeviceGetComputeRunningProcesses(nvmlDevice_t device, unsigned int* infoCount, nvmlProcessInfo_t* infos);
+MOCK_NVML_API nvmlReturn_t nvmlDeviceGetProcessUtilization(nvmlDevice_t device, nvmlProcessUtilizationSample_t* utilization,
+                                                           unsigned int* processSamplesCount, unsigned long long lastSeenTimeStamp);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,350 @@
+/*
+ * Mock NVML：在没有 GPU 的机器上模拟 NVML，用于开发与采样性能对比。
+ *
+ * 环境变量：
+ *   HWGAUGE_MOCK_NVML_DEVICES     模拟的 GPU 数量，默认 8
+ *   HWGAUGE_MOCK_NVML_LATENCY_US  每次设备查询调用的延迟（微秒），默认 1000，模拟驱动 ioctl 的耗时
+ *   HWGAUGE_MOCK_NVML_NO_FIELDS   设为 1 时 nvmlDeviceGetFieldValues 返回 NOT_SUPPORTED，模拟旧驱动
+ *   HWGAUGE_MOCK_NVML_PROCESSES   每块 GPU 上的计算进程数，默认 3
+ *
+ * 采样缓冲区 (nvmlDeviceGetSamples) 每 20ms 一个样本，保留最近 100 个；功率每 50 个样本出现一次尖峰。
+ * 每块 GPU 的第一个进程是调用方自身 (getpid)，便于验证 /proc 关联；其余进程的 PID 每 30 秒轮换一次。
+ */
+#define HWGAUGE_MOCK_NVML_BUILD
+#include "nvml.h"
+
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+struct nvmlDevice_st
+{
+    unsigned int index;
+    double basePower;   // W
+};
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    struct MockState
+    {
+        std::vector<nvmlDevice_st> devices;
+        std::chrono::microseconds latency{ 0 };
+        bool fieldValues = true;
+        unsigned int processes = 3;
+        Clock::time_point start;
+    };
+
+    MockState state;
+    std::atomic<int> initCount{ 0 };
+    std::atomic<unsigned long long> calls{ 0 };
+
+    long envLong(const char* name, long fallback)
+    {
+        const char* value = std::getenv(name);
+        if (value == nullptr || *value == '\0')return fallback;
+        char* end = nullptr;
+        long result = std::strtol(value, &end, 10);
+        return (end == value || result < 0) ? fallback : result;
+    }
+
+    // 模拟一次驱动调用
+    nvmlReturn_t enter(nvmlDevice_t device)
+    {
+        if (initCount.load() <= 0)return NVML_ERROR_UNINITIALIZED;
+        if (device == nullptr)return NVML_ERROR_INVALID_ARGUMENT;
+        calls.fetch_add(1, std::memory_order_relaxed);
+        if (state.latency.count() > 0)std::this_thread::sleep_for(state.latency);
+        return NVML_SUCCESS;
+    }
+
+    double elapsed()
+    {
+        return std::chrono::duration<double>(Clock::now() - state.start).count();
+    }
+
+    // 每块卡相位不同的周期负载，取值 0..1
+    double load(const nvmlDevice_st* device)
+    {
+        return 0.5 + 0.5 * std::sin(elapsed() / 10.0 + device->index);
+    }
+
+    unsigned int powerMilliwatts(const nvmlDevice_st* device)
+    {
+        return static_cast<unsigned int>((device->basePower * (0.4 + 0.6 * load(device))) * 1e3);
+    }
+
+    constexpr unsigned long long kSamplePeriodUs = 20000;
+    constexpr unsigned int kSampleDepth = 100;
+
+    unsigned long long epochMicros()
+    {
+        return static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+    }
+
+    unsigned int processPid(const nvmlDevice_st* device, unsigned int j)
+    {
+        if (j == 0)return static_cast<unsigned int>(getpid());
+        unsigned int epoch = static_cast<unsigned int>(elapsed() / 30.0);
+        return 400000u + device->index * 1000u + j * 10u + epoch % 10u;
+    }
+
+    // 与功率曲线大致一致的累计能耗 (mJ)，单调递增
+    unsigned long long energyMillijoules(const nvmlDevice_st* device)
+    {
+        return static_cast<unsigned long long>(device->basePower * 0.7 * elapsed() * 1e3);
+    }
+}
+
+extern "C" {
+
+nvmlReturn_t nvmlInit(void)
+{
+    if (initCount.fetch_add(1) == 0)
+    {
+        long count = envLong("HWGAUGE_MOCK_NVML_DEVICES", 8);
+        state.devices.clear();
+        for (long i = 0; i < count; ++i)
+            state.devices.push_back(nvmlDevice_st{ static_cast<unsigned int>(i), 250.0 + 25.0 * static_cast<double>(i % 4) });
+        state.latency = std::chrono::microseconds(envLong("HWGAUGE_MOCK_NVML_LATENCY_US", 1000));
+        state.fieldValues = envLong("HWGAUGE_MOCK_NVML_NO_FIELDS", 0) == 0;
+        state.processes = static_cast<unsigned int>(envLong("HWGAUGE_MOCK_NVML_PROCESSES", 3));
+        state.start = Clock::now();
+        std::fprintf(stderr, "[MockNVML] %zu devices, %lld us per call, field values %s\n",
+            state.devices.size(), static_cast<long long>(state.latency.count()), state.fieldValues ? "on" : "off");
+    }
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlShutdown(void)
+{
+    if (initCount.load() <= 0)return NVML_ERROR_UNINITIALIZED;
+    if (initCount.fetch_sub(1) == 1)
+        std::fprintf(stderr, "[MockNVML] shutdown after %llu device calls\n", calls.load());
+    return NVML_SUCCESS;
+}
+
+const char* nvmlErrorString(nvmlReturn_t result)
+{
+    switch (result)
+    {
+    case NVML_SUCCESS: return "Success";
+    case NVML_ERROR_UNINITIALIZED: return "Uninitialized";
+    case NVML_ERROR_INVALID_ARGUMENT: return "Invalid Argument";
+    case NVML_ERROR_NOT_SUPPORTED: return "Not Supported";
+    case NVML_ERROR_NOT_FOUND: return "Not Found";
+    default: return "Unknown Error";
+    }
+}
+
+nvmlReturn_t nvmlDeviceGetCount(unsigned int* deviceCount)
+{
+    if (initCount.load() <= 0)return NVML_ERROR_UNINITIALIZED;
+    if (deviceCount == nullptr)return NVML_ERROR_INVALID_ARGUMENT;
+    *deviceCount = static_cast<unsigned int>(state.devices.size());
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetHandleByIndex(unsigned int index, nvmlDevice_t* device)
+{
+    if (initCount.load() <= 0)return NVML_ERROR_UNINITIALIZED;
+    if (device == nullptr || index >= state.devices.size())return NVML_ERROR_INVALID_ARGUMENT;
+    calls.fetch_add(1, std::memory_order_relaxed);
+    if (state.latency.count() > 0)std::this_thread::sleep_for(state.latency);
+    *device = &state.devices[index];
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetName(nvmlDevice_t device, char* name, unsigned int length)
+{
+    nvmlReturn_t status = enter(device);
+    if (status != NVML_SUCCESS)return status;
+    if (name == nullptr || length == 0)return NVML_ERROR_INVALID_ARGUMENT;
+    std::snprintf(name, length, "Mock GPU %u", device->index);
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetUtilizationRates(nvmlDevice_t device, nvmlUtilization_t* utilization)
+{
+    nvmlReturn_t status = enter(device);
+    if (status != NVML_SUCCESS)return status;
+    if (utilization == nullptr)return NVML_ERROR_INVALID_ARGUMENT;
+    utilization->gpu = static_cast<unsigned int>(load(device) * 100.0);
+    utilization->memory = static_cast<unsigned int>(load(device) * 60.0);
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetClockInfo(nvmlDevice_t device, nvmlClockType_t type, unsigned int* clock)
+{
+    nvmlReturn_t status = enter(device);
+    if (status != NVML_SUCCESS)return status;
+    if (clock == nullptr)return NVML_ERROR_INVALID_ARGUMENT;
+    switch (type)
+    {
+    case NVML_CLOCK_MEM: *clock = 1593; break;
+    default: *clock = static_cast<unsigned int>(1100.0 + 310.0 * load(device)); break;
+    }
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetPowerUsage(nvmlDevice_t device, unsigned int* power)
+{
+    nvmlReturn_t status = enter(device);
+    if (status != NVML_SUCCESS)return status;
+    if (power == nullptr)return NVML_ERROR_INVALID_ARGUMENT;
+    *power = powerMilliwatts(device);
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetTemperature(nvmlDevice_t device, nvmlTemperatureSensors_t sensorType, unsigned int* temp)
+{
+    nvmlReturn_t status = enter(device);
+    if (status != NVML_SUCCESS)return status;
+    if (temp == nullptr || sensorType != NVML_TEMPERATURE_GPU)return NVML_ERROR_INVALID_ARGUMENT;
+    *temp = static_cast<unsigned int>(35.0 + 40.0 * load(device));
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetTotalEnergyConsumption(nvmlDevice_t device, unsigned long long* energy)
+{
+    nvmlReturn_t status = enter(device);
+    if (status != NVML_SUCCESS)return status;
+    if (energy == nullptr)return NVML_ERROR_INVALID_ARGUMENT;
+    *energy = energyMillijoules(device);
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetFieldValues(nvmlDevice_t device, int valuesCount, nvmlFieldValue_t* values)
+{
+    nvmlReturn_t status = enter(device);
+    if (status != NVML_SUCCESS)return status;
+    if (!state.fieldValues)return NVML_ERROR_NOT_SUPPORTED;
+    if (values == nullptr || valuesCount < 0)return NVML_ERROR_INVALID_ARGUMENT;
+
+    long long timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    for (int i = 0; i < valuesCount; ++i)
+    {
+        nvmlFieldValue_t& field = values[i];
+        field.timestamp = timestamp;
+        field.latencyUsec = 0;
+        switch (field.fieldId)
+        {
+        case NVML_FI_DEV_POWER_INSTANT:
+            field.valueType = NVML_VALUE_TYPE_UNSIGNED_INT;
+            field.value.uiVal = powerMilliwatts(device);
+            field.nvmlReturn = NVML_SUCCESS;
+            break;
+        case NVML_FI_DEV_TOTAL_ENERGY_CONSUMPTION:
+            field.valueType = NVML_VALUE_TYPE_UNSIGNED_LONG_LONG;
+            field.value.ullVal = energyMillijoules(device);
+            field.nvmlReturn = NVML_SUCCESS;
+            break;
+        default:
+            field.nvmlReturn = NVML_ERROR_NOT_SUPPORTED;
+            break;
+        }
+    }
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetSamples(nvmlDevice_t device, nvmlSamplingType_t type, unsigned long long lastSeenTimeStamp,
+                                  nvmlValueType_t* sampleValType, unsigned int* sampleCount, nvmlSample_t* samples)
+{
+    nvmlReturn_t status = enter(device);
+    if (status != NVML_SUCCESS)return status;
+    if (sampleValType == nullptr || sampleCount == nullptr)return NVML_ERROR_INVALID_ARGUMENT;
+    if (type != NVML_TOTAL_POWER_SAMPLES && type != NVML_GPU_UTILIZATION_SAMPLES)return NVML_ERROR_NOT_SUPPORTED;
+
+    // 缓冲区中的样本时间戳：对齐到采样周期，保留最近 kSampleDepth 个
+    unsigned long long newest = epochMicros() / kSamplePeriodUs * kSamplePeriodUs;
+    unsigned long long oldest = newest - (kSampleDepth - 1) * kSamplePeriodUs;
+    unsigned long long first = lastSeenTimeStamp < oldest ? oldest : (lastSeenTimeStamp / kSamplePeriodUs + 1) * kSamplePeriodUs;
+    if (first > newest)return NVML_ERROR_NOT_FOUND;
+    unsigned int available = static_cast<unsigned int>((newest - first) / kSamplePeriodUs + 1);
+
+    if (samples == nullptr)
+    {
+        *sampleCount = available;
+        return NVML_SUCCESS;
+    }
+    if (*sampleCount < available)return NVML_ERROR_INSUFFICIENT_SIZE;
+
+    *sampleValType = NVML_VALUE_TYPE_UNSIGNED_INT;
+    double base = type == NVML_TOTAL_POWER_SAMPLES ? powerMilliwatts(device) : load(device) * 100.0;
+    for (unsigned int i = 0; i < available; ++i)
+    {
+        unsigned long long ts = first + i * kSamplePeriodUs;
+        unsigned long long tick = ts / kSamplePeriodUs + device->index;
+        double value = base * (0.95 + 0.1 * static_cast<double>(tick % 7) / 6.0);
+        if (type == NVML_TOTAL_POWER_SAMPLES && tick % 50 == 0)value *= 1.6;
+        if (type == NVML_GPU_UTILIZATION_SAMPLES && value > 100.0)value = 100.0;
+        samples[i].timeStamp = ts;
+        samples[i].sampleValue.uiVal = static_cast<unsigned int>(value);
+    }
+    *sampleCount = available;
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetComputeRunningProcesses(nvmlDevice_t device, unsigned int* infoCount, nvmlProcessInfo_t* infos)
+{
+    nvmlReturn_t status = enter(device);
+    if (status != NVML_SUCCESS)return status;
+    if (infoCount == nullptr)return NVML_ERROR_INVALID_ARGUMENT;
+
+    unsigned int capacity = *infoCount;
+    *infoCount = state.processes;
+    if (capacity < state.processes || (infos == nullptr && state.processes > 0))return NVML_ERROR_INSUFFICIENT_SIZE;
+
+    for (unsigned int j = 0; j < state.processes; ++j)
+    {
+        infos[j].pid = processPid(device, j);
+        infos[j].usedGpuMemory = (512ull + 1024ull * ((j * 7 + device->index) % 11)) * 1024 * 1024;
+        infos[j].gpuInstanceId = 0xFFFFFFFFu;
+        infos[j].computeInstanceId = 0xFFFFFFFFu;
+    }
+    return NVML_SUCCESS;
+}
+
+nvmlReturn_t nvmlDeviceGetProcessUtilization(nvmlDevice_t device, nvmlProcessUtilizationSample_t* utilization,
+                                             unsigned int* processSamplesCount, unsigned long long lastSeenTimeStamp)
+{
+    nvmlReturn_t status = enter(device);
+    if (status != NVML_SUCCESS)return status;
+    if (processSamplesCount == nullptr)return NVML_ERROR_INVALID_ARGUMENT;
+
+    // 每个进程一个最新样本
+    unsigned long long now = epochMicros();
+    if (lastSeenTimeStamp >= now || state.processes == 0)return NVML_ERROR_NOT_FOUND;
+
+    unsigned int capacity = *processSamplesCount;
+    *processSamplesCount = state.processes;
+    if (utilization == nullptr || capacity < state.processes)return NVML_ERROR_INSUFFICIENT_SIZE;
+
+    double gpuLoad = load(device);
+    for (unsigned int j = 0; j < state.processes; ++j)
+    {
+        double share = 1.0 / static_cast<double>(j + 2);
+        utilization[j].pid = processPid(device, j);
+        utilization[j].timeStamp = now;
+        utilization[j].smUtil = static_cast<unsigned int>(gpuLoad * 100.0 * share);
+        utilization[j].memUtil = static_cast<unsigned int>(gpuLoad * 60.0 * share);
+        utilization[j].encUtil = 0;
+        utilization[j].decUtil = 0;
+    }
+    return NVML_SUCCESS;
+}
+
+}
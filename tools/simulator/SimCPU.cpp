@@ -0,0 +1,67 @@
+#include "SimCPU.hpp"
+
+namespace hwgauge
+{
+    namespace
+    {
+        // 按 2 路至强服务器的量级取值
+        constexpr double kIdlePower = 45.0, kMaxPower = 270.0;        // W
+        constexpr double kIdleMemPower = 6.0, kMaxMemPower = 28.0;    // W
+        constexpr double kBaseFreq = 800.0, kMaxFreq = 3500.0;        // MHz
+        constexpr double kMaxReadBw = 120000.0;                       // MB/s
+        constexpr double kIdleTemp = 35.0, kMaxTemp = 88.0, kThermalTau = 20.0;
+    }
+
+    SimCPU::SimCPU(const SimConfig& cfg)
+        : step(cfg.stepSeconds)
+    {
+        sockets.reserve(cfg.devices);
+        for (std::size_t i = 0; i < cfg.devices; i++)
+            sockets.push_back(Socket{ Workload(cfg.seed, i), kIdleTemp, 0.0, 0.0 });
+    }
+
+    std::vector<CPULabel> SimCPU::labels()
+    {
+        std::vector<CPULabel> result;
+        result.reserve(sockets.size());
+        for (std::size_t i = 0; i < sockets.size(); i++)
+            result.push_back(CPULabel{ i, "Simulated CPU" });
+        return result;
+    }
+
+    void SimCPU::sample(std::vector<CPULabel>& labels, std::vector<CPUMetrics>& metrics)
+    {
+        for (std::size_t i = 0; i < labels.size(); i++)
+        {
+            Socket& s = sockets[i];
+            CPUMetrics& m = metrics[i];
+            double load = s.workload.step(step);
+            double noise = s.workload.random().normal();
+
+            m.cpuUtilization = 100.0 * load;
+            m.c0Residency = m.cpuUtilization;
+            m.c6Residency = 0.85 * (100.0 - m.cpuUtilization);
+            // 轻负载时也会睿频，满载后受功耗墙限制回落
+            m.cpuFrequency = kBaseFreq + (kMaxFreq - kBaseFreq) * (load < 0.3 ? load / 0.3 : 1.0 - 0.15 * (load - 0.3));
+            m.powerUsage = kIdlePower + (kMaxPower - kIdlePower) * load;
+
+            m.memoryReadBandwidth = kMaxReadBw * load * (0.8 + 0.05 * noise) + 300.0;
+            m.memoryWriteBandwidth = 0.4 * m.memoryReadBandwidth;
+            m.memoryPowerUsage = kIdleMemPower + (kMaxMemPower - kIdleMemPower) * load;
+
+            s.temperature = lag(s.temperature, kIdleTemp + (kMaxTemp - kIdleTemp) * load, step, kThermalTau);
+            m.temperature = s.temperature;
+
+            m.ipc = 1.9 - 0.7 * load + 0.05 * noise;
+            m.l3HitRatio = 0.95 - 0.35 * load;
+            m.l3Misses = 180.0 * load;
+            m.upiUtilization = 35.0 * load;
+            m.ioBandwidth = 2500.0 * load;
+
+            s.energy += m.powerUsage * step;
+            s.memoryEnergy += m.memoryPowerUsage * step;
+            m.energyJoules = s.energy;
+            m.memoryEnergyJoules = s.memoryEnergy;
+        }
+    }
+}
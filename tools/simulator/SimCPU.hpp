@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Workload.hpp"
+#include "Collector/CPUCollector/CPUMetrics.hpp"
+
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /* 模拟 PCM：每个设备是一个 CPU 插槽，给出 PCM 能采到的全部指标 */
+    class SimCPU
+    {
+    public:
+        explicit SimCPU(const SimConfig& cfg = simConfig());
+
+        std::string name() { return "cpu"; }
+
+        std::vector<CPULabel> labels();
+        void sample(std::vector<CPULabel>& labels, std::vector<CPUMetrics>& metrics);
+
+    private:
+        struct Socket
+        {
+            Workload workload;
+            double temperature;
+            double energy;
+            double memoryEnergy;
+        };
+
+        double step;
+        std::vector<Socket> sockets;
+    };
+}
@@ -0,0 +1,70 @@
+#ifdef HWGAUGE_USE_CLUSTER
+
+#include "SimCluster.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace hwgauge
+{
+    namespace
+    {
+        constexpr double kOutageRate = 1e-4;    // 每秒开始断连的概率
+        constexpr double kSpikeRate = 0.02;     // 每次 PING 出现长尾延迟的概率
+    }
+
+    SimCluster::SimCluster(const SimConfig& cfg)
+        : step(cfg.stepSeconds)
+    {
+        clusters.reserve(cfg.devices);
+        for (std::size_t i = 0; i < cfg.devices; i++)
+        {
+            SimRandom rng(deviceSeed(cfg.seed, i));
+            int nodes = 16 << (rng.next() % 4);
+            clusters.push_back(Cluster{ rng, nodes, 0, 0.0 });
+        }
+    }
+
+    std::vector<ClusterLabel> SimCluster::labels()
+    {
+        std::vector<ClusterLabel> result;
+        result.reserve(clusters.size());
+        for (std::size_t i = 0; i < clusters.size(); i++)
+            result.push_back(ClusterLabel{ "sim-cluster-" + std::to_string(i) });
+        return result;
+    }
+
+    void SimCluster::sample(std::vector<ClusterLabel>& labels, std::vector<ClusterMetrics>& metrics)
+    {
+        for (std::size_t i = 0; i < labels.size(); i++)
+        {
+            Cluster& c = clusters[i];
+            ClusterMetrics& m = metrics[i];
+
+            if (c.outage <= 0.0 && c.rng.uniform() < kOutageRate * step)c.outage = c.rng.uniform(5.0, 60.0);
+            if (c.outage > 0.0)
+            {
+                // 与 ClusterImpl 一致：断连期间节点数为 0，延迟不可用
+                c.outage -= step;
+                m.activeNodeCount = 0.0;
+                m.redisLatencyMs = -1.0;
+                m.redisConnected = 0.0;
+                continue;
+            }
+
+            // 心跳过期的节点按 TTL 逐步恢复
+            if (c.rng.uniform() < 0.05)c.missing = std::min(c.nodes, c.missing + 1);
+            else if (c.missing > 0 && c.rng.uniform() < 0.2)c.missing--;
+
+            double latency = 0.25 + 0.05 * std::fabs(c.rng.normal());
+            if (c.rng.uniform() < kSpikeRate)latency += c.rng.uniform(2.0, 20.0);
+
+            m.activeNodeCount = static_cast<double>(c.nodes - c.missing);
+            m.redisLatencyMs = latency;
+            m.redisConnected = 1.0;
+        }
+    }
+}
+
+#endif
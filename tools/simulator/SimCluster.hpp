@@ -0,0 +1,38 @@
+#pragma once
+
+#ifdef HWGAUGE_USE_CLUSTER
+
+#include "Workload.hpp"
+#include "Collector/ClusterCollector/ClusterMetrics.hpp"
+
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /* 模拟 Redis 集群状态：每个设备是一个集群，节点心跳偶尔丢失，Redis 延迟有长尾并偶发断连 */
+    class SimCluster
+    {
+    public:
+        explicit SimCluster(const SimConfig& cfg = simConfig());
+
+        std::string name() { return "cluster"; }
+
+        std::vector<ClusterLabel> labels();
+        void sample(std::vector<ClusterLabel>& labels, std::vector<ClusterMetrics>& metrics);
+
+    private:
+        struct Cluster
+        {
+            SimRandom rng;
+            int nodes;
+            int missing;        // 心跳已过期的节点数
+            double outage;      // 剩余断连时间 (s)
+        };
+
+        double step;
+        std::vector<Cluster> clusters;
+    };
+}
+
+#endif
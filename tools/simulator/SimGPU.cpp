@@ -0,0 +1,81 @@
+#include "SimGPU.hpp"
+
+#include <algorithm>
+
+namespace hwgauge
+{
+    namespace
+    {
+        // 按 A100 SXM 的量级取值
+        constexpr double kIdlePower = 55.0, kMaxPower = 400.0;        // W
+        constexpr double kBaseFreq = 210.0, kMaxFreq = 1410.0;        // MHz
+        constexpr double kIdleMemFreq = 405.0, kMemFreq = 1593.0;     // MHz
+        constexpr double kIdleTemp = 30.0, kMaxTemp = 82.0, kThermalTau = 25.0;
+
+        // 每个采样周期的子样本数，对应驱动采样缓冲区；样本少于 100 个时 P99 即最大值
+        constexpr int kSubSamples = 10;
+    }
+
+    SimGPU::SimGPU(const SimConfig& cfg)
+        : step(cfg.stepSeconds)
+    {
+        devices.reserve(cfg.devices);
+        for (std::size_t i = 0; i < cfg.devices; i++)
+            devices.push_back(Device{ Workload(cfg.seed, i), kIdleTemp, 0.0 });
+    }
+
+    std::vector<GPULabel> SimGPU::labels()
+    {
+        std::vector<GPULabel> result;
+        result.reserve(devices.size());
+        for (std::size_t i = 0; i < devices.size(); i++)
+            result.push_back(GPULabel{ i, "Simulated GPU" });
+        return result;
+    }
+
+    void SimGPU::sample(std::vector<GPULabel>& labels, std::vector<GPUMetrics>& metrics)
+    {
+        const double dt = step / kSubSamples;
+        for (std::size_t i = 0; i < labels.size(); i++)
+        {
+            Device& d = devices[i];
+            GPUMetrics& m = metrics[i];
+
+            double powerMin = kMaxPower, powerMax = 0.0, powerSum = 0.0;
+            double utilMin = 100.0, utilMax = 0.0, utilSum = 0.0;
+            double load = 0.0, power = 0.0;
+            for (int k = 0; k < kSubSamples; k++)
+            {
+                load = d.workload.step(dt);
+                power = kIdlePower + (kMaxPower - kIdlePower) * load;
+                double util = 100.0 * load;
+                powerMin = std::min(powerMin, power);
+                powerMax = std::max(powerMax, power);
+                powerSum += power;
+                utilMin = std::min(utilMin, util);
+                utilMax = std::max(utilMax, util);
+                utilSum += util;
+                d.energy += power * dt;
+            }
+
+            m.gpuUtilization = 100.0 * load;
+            m.memoryUtilization = 60.0 * load;
+            m.gpuFrequency = kBaseFreq + (kMaxFreq - kBaseFreq) * std::min(1.0, 1.5 * load);
+            m.memoryFrequency = d.workload.busy() ? kMemFreq : kIdleMemFreq;
+            m.powerUsage = power;
+
+            d.temperature = lag(d.temperature, kIdleTemp + (kMaxTemp - kIdleTemp) * load, step, kThermalTau);
+            m.temperature = d.temperature;
+            m.energyJoules = d.energy;
+
+            m.powerMin = powerMin;
+            m.powerMax = powerMax;
+            m.powerMean = powerSum / kSubSamples;
+            m.powerP99 = powerMax;
+            m.utilizationMin = utilMin;
+            m.utilizationMax = utilMax;
+            m.utilizationMean = utilSum / kSubSamples;
+            m.utilizationP99 = utilMax;
+        }
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "Workload.hpp"
+#include "Collector/GPUCollector/GPUMetrics.hpp"
+
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /* 模拟 NVML：每个采样周期内部再推进若干子样本，给出与驱动采样缓冲区一致的功率/利用率统计 */
+    class SimGPU
+    {
+    public:
+        explicit SimGPU(const SimConfig& cfg = simConfig());
+
+        std::string name() { return "gpu"; }
+
+        std::vector<GPULabel> labels();
+        void sample(std::vector<GPULabel>& labels, std::vector<GPUMetrics>& metrics);
+
+    private:
+        struct Device
+        {
+            Workload workload;
+            double temperature;
+            double energy;
+        };
+
+        double step;
+        std::vector<Device> devices;
+    };
+}
@@ -0,0 +1,71 @@
+#include "SimNPU.hpp"
+
+#include <cmath>
+
+namespace hwgauge
+{
+    namespace
+    {
+        // 按 Ascend 910B 的量级取值
+        constexpr double kIdlePower = 85.0, kMaxPower = 350.0;        // W
+        constexpr double kIdleFreq = 1000.0, kMaxFreq = 1800.0;       // MHz
+        constexpr long long kMemTotalMb = 65536;
+        constexpr double kIdleTemp = 38.0, kMaxTemp = 90.0, kThermalTau = 25.0;
+        constexpr double kMemTau = 5.0;     // 作业加载/释放显存的时间常数 (s)
+        constexpr int kWarnTemp = 85;
+
+        int toInt(double v) { return static_cast<int>(std::lround(v)); }
+    }
+
+    SimNPU::SimNPU(const SimConfig& cfg)
+        : step(cfg.stepSeconds)
+    {
+        devices.reserve(cfg.devices);
+        for (std::size_t i = 0; i < cfg.devices; i++)
+            devices.push_back(Device{ Workload(cfg.seed, i), kIdleTemp, 0.05, 0.0 });
+    }
+
+    std::vector<NPULabel> SimNPU::labels()
+    {
+        std::vector<NPULabel> result;
+        result.reserve(devices.size());
+        for (std::size_t i = 0; i < devices.size(); i++)
+            result.push_back(NPULabel{ static_cast<int>(i), 0, "Ascend", "Simulated NPU" });
+        return result;
+    }
+
+    void SimNPU::sample(std::vector<NPULabel>& labels, std::vector<NPUMetrics>& metrics)
+    {
+        for (std::size_t i = 0; i < labels.size(); i++)
+        {
+            Device& d = devices[i];
+            NPUMetrics& m = metrics[i];
+            double load = d.workload.step(step);
+
+            m.freq_aicore = toInt(kIdleFreq + (kMaxFreq - kIdleFreq) * load);
+            m.freq_aicpu = 1900;
+            m.freq_ctrlcpu = 1900;
+
+            m.util_aicore = toInt(100.0 * load);
+            m.util_aicpu = toInt(20.0 * load);
+            m.util_ctrlcpu = toInt(5.0 + 10.0 * load);
+            m.util_vec = toInt(80.0 * load);
+
+            d.memoryFraction = lag(d.memoryFraction, d.workload.busy() ? 0.85 : 0.05, step, kMemTau);
+            m.mem_total_mb = kMemTotalMb;
+            m.mem_usage_mb = static_cast<long long>(kMemTotalMb * d.memoryFraction);
+            m.util_mem = 100.0 * m.mem_usage_mb / kMemTotalMb;
+            m.util_membw = toInt(70.0 * load);
+            m.freq_mem = 1600;
+
+            m.chip_power = kIdlePower + (kMaxPower - kIdlePower) * load;
+            d.energy += m.chip_power * step;
+            m.energy_joules = d.energy;
+
+            d.temperature = lag(d.temperature, kIdleTemp + (kMaxTemp - kIdleTemp) * load, step, kThermalTau);
+            m.temperature = toInt(d.temperature);
+            m.health = m.temperature >= kWarnTemp ? 1 : 0;
+            m.voltage = 0.75 + 0.15 * load;
+        }
+    }
+}
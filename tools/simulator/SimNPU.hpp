@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Workload.hpp"
+#include "Collector/NPUCollector/NPUMetrics.hpp"
+
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /* 模拟 DCMI：每张卡一个设备，显存占用随作业启停缓慢变化，过热时健康状态变为 WARN */
+    class SimNPU
+    {
+    public:
+        explicit SimNPU(const SimConfig& cfg = simConfig());
+
+        std::string name() { return "npu"; }
+
+        std::vector<NPULabel> labels();
+        void sample(std::vector<NPULabel>& labels, std::vector<NPUMetrics>& metrics);
+
+    private:
+        struct Device
+        {
+            Workload workload;
+            double temperature;
+            double memoryFraction;
+            double energy;
+        };
+
+        double step;
+        std::vector<Device> devices;
+    };
+}
@@ -0,0 +1,67 @@
+#ifdef __linux__
+
+#include "SimSYS.hpp"
+
+#include <algorithm>
+#include <string>
+
+namespace hwgauge
+{
+    namespace
+    {
+        // 按 8 卡训练节点的量级取值
+        constexpr double kMemTotalGB = 1024.0;
+        constexpr double kIdlePower = 650.0, kMaxPower = 5200.0;      // W，IPMI 整机读数
+        constexpr double kMemTau = 10.0;
+    }
+
+    SimSYS::SimSYS(const SimConfig& cfg)
+        : step(cfg.stepSeconds)
+    {
+        nodes.reserve(cfg.devices);
+        for (std::size_t i = 0; i < cfg.devices; i++)
+            nodes.push_back(Node{ Workload(cfg.seed, i), 0.05 * kMemTotalGB, 0.0 });
+    }
+
+    std::vector<SYSLabel> SimSYS::labels()
+    {
+        std::vector<SYSLabel> result;
+        result.reserve(nodes.size());
+        for (std::size_t i = 0; i < nodes.size(); i++)
+            result.push_back(SYSLabel{ "sim-node-" + std::to_string(i) });
+        return result;
+    }
+
+    void SimSYS::sample(std::vector<SYSLabel>& labels, std::vector<SYSMetrics>& metrics)
+    {
+        for (std::size_t i = 0; i < labels.size(); i++)
+        {
+            Node& n = nodes[i];
+            SYSMetrics& m = metrics[i];
+            double load = n.workload.step(step);
+            SimRandom& rng = n.workload.random();
+
+            n.memUsedGB = lag(n.memUsedGB, (n.workload.busy() ? 0.6 : 0.05) * kMemTotalGB, step, kMemTau);
+            m.memTotalGB = kMemTotalGB;
+            m.memUsedGB = n.memUsedGB;
+            m.memUtilizationPercent = 100.0 * n.memUsedGB / kMemTotalGB;
+
+            // 检查点写盘与数据集读取都是突发的
+            m.diskReadMBps = std::max(0.0, 1800.0 * load * rng.uniform());
+            m.diskWriteMBps = rng.uniform() < 0.05 ? rng.uniform(500.0, 3000.0) : 20.0 * load;
+            m.maxDiskUtilPercent = std::min(100.0, (m.diskReadMBps + m.diskWriteMBps) / 35.0);
+
+            m.netDownloadMBps = 12000.0 * load * (0.9 + 0.1 * rng.uniform());
+            m.netUploadMBps = 0.95 * m.netDownloadMBps;
+
+            m.systemPowerWatts = kIdlePower + (kMaxPower - kIdlePower) * load;
+            n.energy += m.systemPowerWatts * step;
+            m.systemEnergyJoules = n.energy;
+
+            m.totalPowerWatts = -1.0;
+            m.totalEnergyJoules = -1.0;
+        }
+    }
+}
+
+#endif
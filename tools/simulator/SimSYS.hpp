@@ -0,0 +1,37 @@
+#pragma once
+
+#ifdef __linux__
+
+#include "Workload.hpp"
+#include "Collector/SYSCollector/SYSMetrics.hpp"
+
+#include <string>
+#include <vector>
+
+namespace hwgauge
+{
+    /* 模拟整机指标：每个设备是一台节点，totalPowerWatts/totalEnergyJoules 仍由 setContextInfo 汇总 */
+    class SimSYS
+    {
+    public:
+        explicit SimSYS(const SimConfig& cfg = simConfig());
+
+        std::string name() { return "sys"; }
+
+        std::vector<SYSLabel> labels();
+        void sample(std::vector<SYSLabel>& labels, std::vector<SYSMetrics>& metrics);
+
+    private:
+        struct Node
+        {
+            Workload workload;
+            double memUsedGB;
+            double energy;
+        };
+
+        double step;
+        std::vector<Node> nodes;
+    };
+}
+
+#endif
@@ -0,0 +1,72 @@
+#include "Workload.hpp"
+
+#include <algorithm>
+
+namespace hwgauge
+{
+    namespace
+    {
+        constexpr std::uint64_t kGolden = 0x9E3779B97F4A7C15ULL;
+
+        // 作业/空闲阶段的时长范围 (s)
+        constexpr double kJobMin = 30.0, kJobMax = 600.0;
+        constexpr double kIdleMin = 10.0, kIdleMax = 120.0;
+
+        constexpr double kRampTau = 3.0;    // 负载爬升/回落的时间常数 (s)
+        constexpr double kNoise = 0.03;     // 负载噪声的标准差
+    }
+
+    SimConfig& simConfig()
+    {
+        static SimConfig config;
+        return config;
+    }
+
+    std::uint64_t deviceSeed(std::uint64_t seed, std::size_t device)
+    {
+        return SimRandom(seed ^ (kGolden * (device + 1))).next();
+    }
+
+    std::uint64_t SimRandom::next()
+    {
+        std::uint64_t z = (state += kGolden);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    double SimRandom::uniform()
+    {
+        return static_cast<double>(next() >> 11) * 0x1.0p-53;
+    }
+
+    double SimRandom::normal()
+    {
+        // Irwin-Hall：4 个 U(0,1) 之和的方差为 1/3
+        double sum = uniform() + uniform() + uniform() + uniform();
+        return (sum - 2.0) * 1.7320508075688772;
+    }
+
+    Workload::Workload(std::uint64_t seed, std::size_t device)
+        : rng(deviceSeed(seed, device))
+    {
+        // 初始时各设备处于不同阶段，避免所有设备同时切换
+        running = rng.uniform() < 0.6;
+        intensity = running ? rng.uniform(0.55, 1.0) : rng.uniform(0.0, 0.08);
+        remaining = running ? rng.uniform(0.0, kJobMax) : rng.uniform(0.0, kIdleMax);
+        level = intensity;
+    }
+
+    double Workload::step(double dt)
+    {
+        remaining -= dt;
+        if (remaining <= 0.0)
+        {
+            running = !running;
+            intensity = running ? rng.uniform(0.55, 1.0) : rng.uniform(0.0, 0.08);
+            remaining = running ? rng.uniform(kJobMin, kJobMax) : rng.uniform(kIdleMin, kIdleMax);
+        }
+        level = lag(level, intensity, dt, kRampTau);
+        return std::clamp(level + kNoise * rng.normal(), 0.0, 1.0);
+    }
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+namespace hwgauge
+{
+    /* 模拟器参数 */
+    struct SimConfig
+    {
+        std::size_t devices = 8;    // 模拟的设备数（CPU 插槽、GPU、NPU、节点或集群）
+        std::uint64_t seed = 1;     // 相同种子下指标流完全相同
+        double stepSeconds = 1.0;   // 每次 sample 推进的模拟时间，与真实时钟无关
+    };
+
+    // DeviceCollector 只用默认构造函数或 CollectorConfig 创建实现类，模拟实现默认从这里取参数
+    SimConfig& simConfig();
+
+    /* 可复现的随机数 (splitmix64)，不使用标准库分布，换编译器/标准库后结果不变 */
+    class SimRandom
+    {
+    public:
+        explicit SimRandom(std::uint64_t seed) : state(seed) {}
+
+        std::uint64_t next();
+        // [0, 1)
+        double uniform();
+        double uniform(double lo, double hi) { return lo + (hi - lo) * uniform(); }
+        // 近似标准正态 (4 个均匀分布求和)
+        double normal();
+
+    private:
+        std::uint64_t state;
+    };
+
+    // 由 (seed, device) 派生每个设备独立的随机流种子
+    std::uint64_t deviceSeed(std::uint64_t seed, std::size_t device);
+
+    /**
+     * 单个设备的负载：在空闲和作业之间交替，作业强度与时长随机，负载按一阶惯性趋近当前强度并叠加噪声。
+     * 每个设备由 (seed, device) 派生独立的随机流，设备数改变不影响已有设备的指标。
+     */
+    class Workload
+    {
+    public:
+        Workload(std::uint64_t seed, std::size_t device);
+
+        // 推进 dt 秒，返回 0~1 的负载
+        double step(double dt);
+
+        bool busy() const { return running; }
+        SimRandom& random() { return rng; }
+
+    private:
+        SimRandom rng;
+        bool running;
+        double remaining;   // 当前阶段剩余时间 (s)
+        double intensity;   // 当前阶段的目标负载
+        double level;       // 平滑后的负载（不含噪声）
+    };
+
+    /* 一阶惯性：温度、显存占用等慢变量以时间常数 tau 趋近目标 */
+    inline double lag(double current, double target, double dt, double tau)
+    {
+        return current + (target - current) * (1.0 - std::exp(-dt / tau));
+    }
+}